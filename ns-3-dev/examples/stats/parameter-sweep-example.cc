@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Sweep the data rate of an on/off source over a point-to-point link,
+ * for several runs, in parallel worker processes.
+ *
+ * The topology is built once; ParameterSweep then forks a worker for
+ * each data rate and run, which sets the rate of the existing source,
+ * simulates, and writes the number of bytes received to a single output.
+ *
+ *   ./waf --run "parameter-sweep-example --rates=1Mbps,2Mbps,4Mbps --runs=1:8 --parallel=4"
+ *
+ * Other attributes or global values can be swept with --sweep, for
+ * instance --sweep="ns3::PointToPointChannel::Delay=2ms,20ms".
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/stats-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("ParameterSweepExample");
+
+/// The sink of the on/off source
+static Ptr<PacketSink> g_sink;
+/// Duration of a simulation, in seconds
+static double g_duration = 10;
+
+static void
+Simulate (DataCollector &dc)
+{
+  Simulator::Stop (Seconds (g_duration));
+  Simulator::Run ();
+
+  Ptr<CounterCalculator<uint32_t> > received = CreateObject<CounterCalculator<uint32_t> > ();
+  received->SetKey ("rx-bytes");
+  received->SetContext ("sink");
+  received->Update (g_sink->GetTotalRx ());
+  dc.AddDataCalculator (received);
+}
+
+int main (int argc, char *argv[])
+{
+  std::string rates ("1Mbps,2Mbps,4Mbps");
+  std::string format ("omnet");
+  std::string prefix ("parameter-sweep");
+
+  ParameterSweep sweep;
+  CommandLine cmd;
+  cmd.AddValue ("rates", "Data rates of the source, separated by commas", rates);
+  cmd.AddValue ("duration", "Duration of each simulation, in seconds", g_duration);
+  cmd.AddValue ("format", "Format of the output, omnet or db", format);
+  cmd.AddValue ("prefix", "Prefix of the output files", prefix);
+  sweep.AddCommandLine (cmd);
+  cmd.Parse (argc, argv);
+
+  Ptr<DataOutputInterface> output;
+  if (format == "omnet")
+    {
+      output = CreateObject<OmnetDataOutput> ();
+    }
+#ifdef STATS_HAS_SQLITE3
+  else if (format == "db")
+    {
+      output = CreateObject<SqliteDataOutput> ();
+    }
+#endif
+  else
+    {
+      NS_FATAL_ERROR ("Unknown or unsupported output format " << format);
+    }
+  output->SetFilePrefix (prefix);
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  PointToPointHelper pointToPoint;
+  pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
+  pointToPoint.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  NetDeviceContainer devices = pointToPoint.Install (nodes);
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  uint16_t port = 9;
+  OnOffHelper onOff ("ns3::UdpSocketFactory", InetSocketAddress (interfaces.GetAddress (1), port));
+  onOff.SetAttribute ("OnTime", StringValue ("ns3::ExponentialRandomVariable[Mean=0.5]"));
+  onOff.SetAttribute ("OffTime", StringValue ("ns3::ExponentialRandomVariable[Mean=0.5]"));
+  ApplicationContainer sources = onOff.Install (nodes.Get (0));
+  sources.Start (Seconds (1.0));
+  PacketSinkHelper sinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer sinks = sinkHelper.Install (nodes.Get (1));
+  sinks.Start (Seconds (0.0));
+  g_sink = DynamicCast<PacketSink> (sinks.Get (0));
+
+  sweep.AddParameter ("/NodeList/0/ApplicationList/0/$ns3::OnOffApplication/DataRate", rates);
+  sweep.SetExperiment ("parameter-sweep-example", "on-off");
+  sweep.SetOutput (output);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  uint32_t failed = sweep.Run (MakeCallback (&Simulate));
+  double wallTime = clock.End () / 1000.0;
+  std::cout << "Simulations: " << sweep.GetNPoints () << std::endl
+            << "Failed simulations: " << failed << std::endl
+            << "Wall-clock time: " << wallTime << " s" << std::endl;
+
+  g_sink = 0;
+  Simulator::Destroy ();
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,235 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/aodv-module.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/wifi-module.h"
+#include <iostream>
+#include <sstream>
+#include <cmath>
+
+using namespace ns3;
+
+/**
+ * \brief Benchmark of AODV in a large MANET.
+ *
+ * This script places a large number of nodes (1000 by default) uniformly
+ * at random in a square whose size keeps the node density constant, lets
+ * them move according to the random waypoint model, and starts UDP flows
+ * between random pairs of nodes. Every new flow floods the network with
+ * route requests, which stresses the routing table, the request queue and
+ * the duplicate caches of AODV.
+ *
+ * At the end, the script reports the wall-clock time of the simulation
+ * and the number of events processed per second, as counted by
+ * Simulator::GetEventCount (cancelled events included).
+ *
+ * Usage: ./waf --run "aodv-large-scale --size=1000 --flows=50 --time=20"
+ */
+class AodvLargeScale
+{
+public:
+  AodvLargeScale ();
+  /// Configure script parameters, \return true on successful configuration
+  bool Configure (int argc, char **argv);
+  /// Run simulation
+  void Run ();
+  /// Report results
+  void Report (std::ostream & os);
+
+private:
+  ///\name parameters
+  //\{
+  /// Number of nodes
+  uint32_t size;
+  /// Number of UDP flows
+  uint32_t flows;
+  /// Average distance between neighbor nodes, meters
+  double step;
+  /// Maximum node speed, m/s
+  double speed;
+  /// Simulation time, seconds
+  double totalTime;
+  //\}
+
+  ///\name results
+  //\{
+  /// Wall-clock duration of the simulation, seconds
+  double wallTime;
+  /// Number of events processed, cancelled events included
+  uint64_t events;
+  //\}
+
+  ///\name network
+  //\{
+  NodeContainer nodes;
+  NetDeviceContainer devices;
+  Ipv4InterfaceContainer interfaces;
+  //\}
+
+private:
+  void CreateNodes ();
+  void CreateDevices ();
+  void InstallInternetStack ();
+  void InstallApplications ();
+};
+
+int main (int argc, char **argv)
+{
+  AodvLargeScale test;
+  if (!test.Configure (argc, argv))
+    NS_FATAL_ERROR ("Configuration failed. Aborted.");
+
+  test.Run ();
+  test.Report (std::cout);
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+AodvLargeScale::AodvLargeScale () :
+  size (1000),
+  flows (50),
+  step (100),
+  speed (5),
+  totalTime (20),
+  wallTime (0),
+  events (0)
+{
+}
+
+bool
+AodvLargeScale::Configure (int argc, char **argv)
+{
+  SeedManager::SetSeed (12345);
+  CommandLine cmd;
+
+  cmd.AddValue ("size", "Number of nodes.", size);
+  cmd.AddValue ("flows", "Number of UDP flows.", flows);
+  cmd.AddValue ("step", "Average distance between neighbor nodes, m.", step);
+  cmd.AddValue ("speed", "Maximum node speed, m/s.", speed);
+  cmd.AddValue ("time", "Simulation time, s.", totalTime);
+
+  cmd.Parse (argc, argv);
+  return (size > 1);
+}
+
+void
+AodvLargeScale::Run ()
+{
+  CreateNodes ();
+  CreateDevices ();
+  InstallInternetStack ();
+  InstallApplications ();
+
+  std::cout << "Starting simulation for " << totalTime << " s ...\n";
+
+  Simulator::Stop (Seconds (totalTime));
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  wallTime = clock.End () / 1000.0;
+  events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+}
+
+void
+AodvLargeScale::Report (std::ostream & os)
+{
+  os << "Nodes: " << size << ", flows: " << flows << "\n"
+     << "Events processed (cancelled included): " << events << "\n"
+     << "Wall-clock time: " << wallTime << " s\n"
+     << "Events processed per second: " << (wallTime > 0 ? events / wallTime : 0) << "\n";
+}
+
+void
+AodvLargeScale::CreateNodes ()
+{
+  double side = step * std::sqrt (static_cast<double> (size));
+  std::cout << "Creating " << size << " nodes in a " << side << " m square.\n";
+  nodes.Create (size);
+
+  std::ostringstream bound;
+  bound << "ns3::UniformRandomVariable[Min=0.0|Max=" << side << "]";
+  ObjectFactory pos;
+  pos.SetTypeId ("ns3::RandomRectanglePositionAllocator");
+  pos.Set ("X", StringValue (bound.str ()));
+  pos.Set ("Y", StringValue (bound.str ()));
+  Ptr<PositionAllocator> positionAlloc = pos.Create ()->GetObject<PositionAllocator> ();
+
+  std::ostringstream speedVariable;
+  speedVariable << "ns3::UniformRandomVariable[Min=0.0|Max=" << speed << "]";
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::RandomWaypointMobilityModel",
+                             "Speed", StringValue (speedVariable.str ()),
+                             "Pause", StringValue ("ns3::ConstantRandomVariable[Constant=0.0]"),
+                             "PositionAllocator", PointerValue (positionAlloc));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (nodes);
+}
+
+void
+AodvLargeScale::CreateDevices ()
+{
+  NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default ();
+  wifiMac.SetType ("ns3::AdhocWifiMac");
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager", "DataMode", StringValue ("OfdmRate6Mbps"), "RtsCtsThreshold", UintegerValue (0));
+  devices = wifi.Install (wifiPhy, wifiMac, nodes);
+}
+
+void
+AodvLargeScale::InstallInternetStack ()
+{
+  AodvHelper aodv;
+  InternetStackHelper stack;
+  stack.SetRoutingHelper (aodv); // has effect on the next Install ()
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.0.0.0");
+  interfaces = address.Assign (devices);
+}
+
+void
+AodvLargeScale::InstallApplications ()
+{
+  uint16_t port = 9;
+  Ptr<UniformRandomVariable> node = CreateObject<UniformRandomVariable> ();
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable> ();
+  PacketSinkHelper sink ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
+  sink.Install (nodes).Start (Seconds (0));
+
+  for (uint32_t i = 0; i < flows; ++i)
+    {
+      uint32_t src = node->GetInteger (0, size - 1);
+      uint32_t dst = node->GetInteger (0, size - 2);
+      if (dst >= src)
+        {
+          dst++;
+        }
+      OnOffHelper onoff ("ns3::UdpSocketFactory", InetSocketAddress (interfaces.GetAddress (dst), port));
+      onoff.SetConstantRate (DataRate ("2kbps"), 64);
+      ApplicationContainer app = onoff.Install (nodes.Get (src));
+      app.Start (Seconds (start->GetValue (1, 1 + totalTime / 4)));
+      app.Stop (Seconds (totalTime));
+    }
+}
@@ -26,7 +26,6 @@
  *          Pavel Boyko <boyko@iitp.ru>
  */
 #include "aodv-id-cache.h"
-#include <algorithm>
 
 namespace ns3
 {
@@ -36,27 +35,46 @@ bool
 IdCache::IsDuplicate (Ipv4Address addr, uint32_t id)
 {
   Purge ();
-  for (std::vector<UniqueId>::const_iterator i = m_idCache.begin ();
-       i != m_idCache.end (); ++i)
-    if (i->m_context == addr && i->m_id == id)
-      return true;
-  struct UniqueId uniqueId =
-  { addr, id, m_lifetime + Simulator::Now () };
-  m_idCache.push_back (uniqueId);
+  Time now = Simulator::Now ();
+  UniqueId uniqueId = std::make_pair (addr, id);
+  sgi::hash_map<UniqueId, Time, UniqueIdHash>::iterator i = m_idCache.find (uniqueId);
+  if (i != m_idCache.end ())
+    {
+      // Records are not always expired in order, if the lifetime was reduced.
+      if (!(i->second < now))
+        return true;
+      i->second = m_lifetime + now;
+    }
+  else
+    m_idCache.insert (std::make_pair (uniqueId, m_lifetime + now));
+  m_expiry.push_back (std::make_pair (uniqueId, m_lifetime + now));
   return false;
 }
 void
 IdCache::Purge ()
 {
-  m_idCache.erase (remove_if (m_idCache.begin (), m_idCache.end (),
-                              IsExpired ()), m_idCache.end ());
+  Time now = Simulator::Now ();
+  while (!m_expiry.empty () && m_expiry.front ().second < now)
+    {
+      // Records whose expiration time changed are stale
+      sgi::hash_map<UniqueId, Time, UniqueIdHash>::iterator i = m_idCache.find (m_expiry.front ().first);
+      if (i != m_idCache.end () && i->second == m_expiry.front ().second)
+        m_idCache.erase (i);
+      m_expiry.pop_front ();
+    }
 }
 
 uint32_t
 IdCache::GetSize ()
 {
   Purge ();
-  return m_idCache.size ();
+  Time now = Simulator::Now ();
+  uint32_t size = 0;
+  for (sgi::hash_map<UniqueId, Time, UniqueIdHash>::const_iterator i = m_idCache.begin ();
+       i != m_idCache.end (); ++i)
+    if (!(i->second < now))
+      size++;
+  return size;
 }
 
 }
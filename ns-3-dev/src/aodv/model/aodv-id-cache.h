@@ -31,7 +31,9 @@
 
 #include "ns3/ipv4-address.h"
 #include "ns3/simulator.h"
-#include <vector>
+#include "ns3/sgi-hashmap.h"
+#include <deque>
+#include <utility>
 
 namespace ns3
 {
@@ -41,6 +43,10 @@ namespace aodv
  * \ingroup aodv
  * 
  * \brief Unique packets identification cache used for simple duplicate detection.
+ *
+ * Records are kept in a hash table for constant time lookups, and in a
+ * queue in the order of their insertion, from which the expired records
+ * are removed: checking for a duplicate does not scan the whole cache.
  */
 class IdCache
 {
@@ -58,25 +64,19 @@ public:
   /// Return lifetime for existing entries in cache
   Time GetLifeTime () const { return m_lifetime; }
 private:
-  /// Unique packet ID
-  struct UniqueId
-  {
-    /// ID is supposed to be unique in single address context (e.g. sender address)
-    Ipv4Address m_context;
-    /// The id
-    uint32_t m_id;
-    /// When record will expire
-    Time m_expire;
-  };
-  struct IsExpired
+  /// Unique packet ID: the id is supposed to be unique in single address context (e.g. sender address)
+  typedef std::pair<Ipv4Address, uint32_t> UniqueId;
+  struct UniqueIdHash
   {
-    bool operator() (const struct UniqueId & u) const
+    size_t operator() (const UniqueId &u) const
     {
-      return (u.m_expire < Simulator::Now ());
+      return Ipv4AddressHash () (u.first) * 31 + u.second;
     }
   };
-  /// Already seen IDs
-  std::vector<UniqueId> m_idCache;
+  /// Already seen IDs, with the time at which they expire
+  sgi::hash_map<UniqueId, Time, UniqueIdHash> m_idCache;
+  /// Already seen IDs in insertion order, with the time at which they expire
+  std::deque<std::pair<UniqueId, Time> > m_expiry;
   /// Default lifetime for ID records
   Time m_lifetime;
 };
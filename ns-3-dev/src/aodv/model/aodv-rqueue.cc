@@ -27,7 +27,6 @@
  */
 #include "aodv-rqueue.h"
 #include <algorithm>
-#include <functional>
 #include "ns3/ipv4-route.h"
 #include "ns3/socket.h"
 #include "ns3/log.h"
@@ -42,99 +41,131 @@ uint32_t
 RequestQueue::GetSize ()
 {
   Purge ();
-  return m_queue.size ();
+  return m_size;
 }
 
 bool
 RequestQueue::Enqueue (QueueEntry & entry)
 {
   Purge ();
-  for (std::vector<QueueEntry>::const_iterator i = m_queue.begin (); i
-       != m_queue.end (); ++i)
+  Ipv4Address dst = entry.GetIpv4Header ().GetDestination ();
+  DestinationIndex::const_iterator d = m_dstIndex.find (dst);
+  if (d != m_dstIndex.end ())
     {
-      if ((i->GetPacket ()->GetUid () == entry.GetPacket ()->GetUid ())
-          && (i->GetIpv4Header ().GetDestination ()
-              == entry.GetIpv4Header ().GetDestination ()))
-        return false;
+      for (std::deque<Queue::iterator>::const_iterator i = d->second.begin (); i
+           != d->second.end (); ++i)
+        {
+          if ((*i)->GetPacket ()->GetUid () == entry.GetPacket ()->GetUid ())
+            return false;
+        }
     }
   entry.SetExpireTime (m_queueTimeout);
-  if (m_queue.size () == m_maxLen)
+  if (m_size == m_maxLen)
     {
       Drop (m_queue.front (), "Drop the most aged packet"); // Drop the most aged packet
-      m_queue.erase (m_queue.begin ());
+      RemoveOldest ();
     }
+  Time expire = entry.GetExpireTime () + Simulator::Now ();
+  if (m_size == 0 || expire < m_nextExpire)
+    m_nextExpire = expire;
   m_queue.push_back (entry);
+  m_dstIndex[dst].push_back (--m_queue.end ());
+  m_size++;
   return true;
 }
 
+void
+RequestQueue::RemoveOldest ()
+{
+  DestinationIndex::iterator d = m_dstIndex.find (m_queue.front ().GetIpv4Header ().GetDestination ());
+  NS_ASSERT (d != m_dstIndex.end () && d->second.front () == m_queue.begin ());
+  d->second.pop_front ();
+  if (d->second.empty ())
+    m_dstIndex.erase (d);
+  m_queue.pop_front ();
+  m_size--;
+}
+
 void
 RequestQueue::DropPacketWithDst (Ipv4Address dst)
 {
   NS_LOG_FUNCTION (this << dst);
   Purge ();
-  for (std::vector<QueueEntry>::iterator i = m_queue.begin (); i
-       != m_queue.end (); ++i)
+  DestinationIndex::iterator d = m_dstIndex.find (dst);
+  if (d == m_dstIndex.end ())
+    return;
+  for (std::deque<Queue::iterator>::const_iterator i = d->second.begin (); i
+       != d->second.end (); ++i)
     {
-      if (IsEqual (*i, dst))
-        {
-          Drop (*i, "DropPacketWithDst ");
-        }
+      Drop (**i, "DropPacketWithDst ");
+    }
+  for (std::deque<Queue::iterator>::const_iterator i = d->second.begin (); i
+       != d->second.end (); ++i)
+    {
+      m_queue.erase (*i);
+      m_size--;
     }
-  m_queue.erase (std::remove_if (m_queue.begin (), m_queue.end (),
-                                 std::bind2nd (std::ptr_fun (RequestQueue::IsEqual), dst)), m_queue.end ());
+  m_dstIndex.erase (d);
 }
 
 bool
 RequestQueue::Dequeue (Ipv4Address dst, QueueEntry & entry)
 {
   Purge ();
-  for (std::vector<QueueEntry>::iterator i = m_queue.begin (); i != m_queue.end (); ++i)
-    {
-      if (i->GetIpv4Header ().GetDestination () == dst)
-        {
-          entry = *i;
-          m_queue.erase (i);
-          return true;
-        }
-    }
-  return false;
+  DestinationIndex::iterator d = m_dstIndex.find (dst);
+  if (d == m_dstIndex.end ())
+    return false;
+  Queue::iterator i = d->second.front ();
+  entry = *i;
+  m_queue.erase (i);
+  m_size--;
+  d->second.pop_front ();
+  if (d->second.empty ())
+    m_dstIndex.erase (d);
+  return true;
 }
 
 bool
 RequestQueue::Find (Ipv4Address dst)
 {
-  for (std::vector<QueueEntry>::const_iterator i = m_queue.begin (); i
-       != m_queue.end (); ++i)
-    {
-      if (i->GetIpv4Header ().GetDestination () == dst)
-        return true;
-    }
-  return false;
+  return m_dstIndex.find (dst) != m_dstIndex.end ();
 }
 
-struct IsExpired
+void
+RequestQueue::RebuildIndex ()
 {
-  bool
-  operator() (QueueEntry const & e) const
-  {
-    return (e.GetExpireTime () < Seconds (0));
-  }
-};
+  m_dstIndex.clear ();
+  for (Queue::iterator i = m_queue.begin (); i != m_queue.end (); ++i)
+    {
+      m_dstIndex[i->GetIpv4Header ().GetDestination ()].push_back (i);
+    }
+}
 
 void
 RequestQueue::Purge ()
 {
-  IsExpired pred;
-  for (std::vector<QueueEntry>::iterator i = m_queue.begin (); i
-       != m_queue.end (); ++i)
+  Time now = Simulator::Now ();
+  if (m_size == 0 || !(m_nextExpire < now))
+    return;
+  bool dropped = false;
+  m_nextExpire = Time::Max ();
+  for (Queue::iterator i = m_queue.begin (); i != m_queue.end (); )
     {
-      if (pred (*i))
+      if (i->GetExpireTime () < Seconds (0))
         {
           Drop (*i, "Drop outdated packet ");
+          i = m_queue.erase (i);
+          m_size--;
+          dropped = true;
+        }
+      else
+        {
+          m_nextExpire = std::min (m_nextExpire, i->GetExpireTime () + now);
+          ++i;
         }
     }
-  m_queue.erase (std::remove_if (m_queue.begin (), m_queue.end (), pred),
-                 m_queue.end ());
+  if (dropped)
+    RebuildIndex ();
 }
 
 void
@@ -28,9 +28,11 @@
 #ifndef AODV_RQUEUE_H
 #define AODV_RQUEUE_H
 
-#include <vector>
+#include <list>
+#include <deque>
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/simulator.h"
+#include "ns3/sgi-hashmap.h"
 
 
 namespace ns3 {
@@ -91,13 +93,18 @@ private:
  * \brief AODV route request queue
  * 
  * Since AODV is an on demand routing we queue requests while looking for route.
+ *
+ * Entries are indexed by destination, so that looking up, dequeuing or
+ * dropping the packets of a destination does not scan the whole queue.
+ * The queue is only scanned for expired entries when the earliest
+ * expiration time has passed.
  */
 class RequestQueue
 {
 public:
   /// Default c-tor
   RequestQueue (uint32_t maxLen, Time routeToQueueTimeout) :
-    m_maxLen (maxLen), m_queueTimeout (routeToQueueTimeout)
+    m_size (0), m_maxLen (maxLen), m_queueTimeout (routeToQueueTimeout)
   {
   }
   /// Push entry in queue, if there is no entry with the same packet and destination address in queue.
@@ -119,16 +126,28 @@ public:
   //\}
 
 private:
-  std::vector<QueueEntry> m_queue;
+  typedef std::list<QueueEntry> Queue;
+  typedef sgi::hash_map<Ipv4Address, std::deque<Queue::iterator>, Ipv4AddressHash> DestinationIndex;
+  /// Queued entries, oldest first
+  Queue m_queue;
+  /// Number of queued entries
+  uint32_t m_size;
+  /// Queued entries of each destination, oldest first
+  DestinationIndex m_dstIndex;
+  /// No entry expires before this time
+  Time m_nextExpire;
   /// Remove all expired entries
   void Purge ();
+  /// Remove the oldest entry, which must be the oldest of its destination
+  void RemoveOldest ();
+  /// Rebuild the index of the entries by destination
+  void RebuildIndex ();
   /// Notify that packet is dropped from queue by timeout
   void Drop (QueueEntry en, std::string reason);
   /// The maximum number of packets that we allow a routing protocol to buffer.
   uint32_t m_maxLen;
   /// The maximum period of time that a routing protocol is allowed to buffer a packet for, seconds.
   Time m_queueTimeout;
-  static bool IsEqual (QueueEntry en, const Ipv4Address dst) { return (en.GetIpv4Header ().GetDestination () == dst); }
 };
 
 
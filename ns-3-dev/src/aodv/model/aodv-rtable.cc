@@ -190,11 +190,31 @@ RoutingTableEntry::Print (Ptr<OutputStreamWrapper> stream) const
  The Routing Table
  */
 
+/// Width of the time interval covered by an expiry bucket
+static Time
+GetExpiryBucketWidth ()
+{
+  static const Time width = MilliSeconds (100);
+  return width;
+}
+
 RoutingTable::RoutingTable (Time t) : 
   m_badLinkLifetime (t)
 {
 }
 
+void
+RoutingTable::ScheduleExpiry (RoutingTableEntry const & rt)
+{
+  Time expire = rt.GetLifeTime () + Simulator::Now ();
+  int64_t width = GetExpiryBucketWidth ().GetTimeStep ();
+  int64_t bucket = expire.GetTimeStep () / width;
+  // round down, so that the bucket starts at or before the expiry time
+  if (expire.IsStrictlyNegative () && expire.GetTimeStep () % width != 0)
+    bucket--;
+  m_expiry[bucket].push_back (std::make_pair (rt.GetDestination (), expire));
+}
+
 bool
 RoutingTable::LookupRoute (Ipv4Address id, RoutingTableEntry & rt)
 {
@@ -205,7 +225,7 @@ RoutingTable::LookupRoute (Ipv4Address id, RoutingTableEntry & rt)
       NS_LOG_LOGIC ("Route to " << id << " not found; m_ipv4AddressEntry is empty");
       return false;
     }
-  std::map<Ipv4Address, RoutingTableEntry>::const_iterator i =
+  EntryMap::const_iterator i =
     m_ipv4AddressEntry.find (id);
   if (i == m_ipv4AddressEntry.end ())
     {
@@ -251,8 +271,10 @@ RoutingTable::AddRoute (RoutingTableEntry & rt)
   Purge ();
   if (rt.GetFlag () != IN_SEARCH)
     rt.SetRreqCnt (0);
-  std::pair<std::map<Ipv4Address, RoutingTableEntry>::iterator, bool> result =
+  std::pair<EntryMap::iterator, bool> result =
     m_ipv4AddressEntry.insert (std::make_pair (rt.GetDestination (), rt));
+  if (result.second)
+    ScheduleExpiry (rt);
   return result.second;
 }
 
@@ -260,14 +282,17 @@ bool
 RoutingTable::Update (RoutingTableEntry & rt)
 {
   NS_LOG_FUNCTION (this);
-  std::map<Ipv4Address, RoutingTableEntry>::iterator i =
+  EntryMap::iterator i =
     m_ipv4AddressEntry.find (rt.GetDestination ());
   if (i == m_ipv4AddressEntry.end ())
     {
       NS_LOG_LOGIC ("Route update to " << rt.GetDestination () << " fails; not found");
       return false;
     }
+  bool reschedule = (i->second.GetLifeTime () != rt.GetLifeTime ()) || (i->second.GetFlag () != rt.GetFlag ());
   i->second = rt;
+  if (reschedule)
+    ScheduleExpiry (rt);
   if (i->second.GetFlag () != IN_SEARCH)
     {
       NS_LOG_LOGIC ("Route update to " << rt.GetDestination () << " set RreqCnt to 0");
@@ -280,14 +305,19 @@ bool
 RoutingTable::SetEntryState (Ipv4Address id, RouteFlags state)
 {
   NS_LOG_FUNCTION (this);
-  std::map<Ipv4Address, RoutingTableEntry>::iterator i =
+  EntryMap::iterator i =
     m_ipv4AddressEntry.find (id);
   if (i == m_ipv4AddressEntry.end ())
     {
       NS_LOG_LOGIC ("Route set entry state to " << id << " fails; not found");
       return false;
     }
-  i->second.SetFlag (state);
+  if (i->second.GetFlag () != state)
+    {
+      // An expired entry in search is deleted once invalid
+      i->second.SetFlag (state);
+      ScheduleExpiry (i->second);
+    }
   i->second.SetRreqCnt (0);
   NS_LOG_LOGIC ("Route set entry state to " << id << ": new state is " << state);
   return true;
@@ -299,7 +329,7 @@ RoutingTable::GetListOfDestinationWithNextHop (Ipv4Address nextHop, std::map<Ipv
   NS_LOG_FUNCTION (this);
   Purge ();
   unreachable.clear ();
-  for (std::map<Ipv4Address, RoutingTableEntry>::const_iterator i =
+  for (EntryMap::const_iterator i =
          m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end (); ++i)
     {
       if (i->second.GetNextHop () == nextHop)
@@ -315,17 +345,15 @@ RoutingTable::InvalidateRoutesWithDst (const std::map<Ipv4Address, uint32_t> & u
 {
   NS_LOG_FUNCTION (this);
   Purge ();
-  for (std::map<Ipv4Address, RoutingTableEntry>::iterator i =
-         m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end (); ++i)
+  for (std::map<Ipv4Address, uint32_t>::const_iterator j =
+         unreachable.begin (); j != unreachable.end (); ++j)
     {
-      for (std::map<Ipv4Address, uint32_t>::const_iterator j =
-             unreachable.begin (); j != unreachable.end (); ++j)
+      EntryMap::iterator i = m_ipv4AddressEntry.find (j->first);
+      if ((i != m_ipv4AddressEntry.end ()) && (i->second.GetFlag () == VALID))
         {
-          if ((i->first == j->first) && (i->second.GetFlag () == VALID))
-            {
-              NS_LOG_LOGIC ("Invalidate route with destination address " << i->first);
-              i->second.Invalidate (m_badLinkLifetime);
-            }
+          NS_LOG_LOGIC ("Invalidate route with destination address " << i->first);
+          i->second.Invalidate (m_badLinkLifetime);
+          ScheduleExpiry (i->second);
         }
     }
 }
@@ -336,12 +364,12 @@ RoutingTable::DeleteAllRoutesFromInterface (Ipv4InterfaceAddress iface)
   NS_LOG_FUNCTION (this);
   if (m_ipv4AddressEntry.empty ())
     return;
-  for (std::map<Ipv4Address, RoutingTableEntry>::iterator i =
+  for (EntryMap::iterator i =
          m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end ();)
     {
       if (i->second.GetInterface () == iface)
         {
-          std::map<Ipv4Address, RoutingTableEntry>::iterator tmp = i;
+          EntryMap::iterator tmp = i;
           ++i;
           m_ipv4AddressEntry.erase (tmp);
         }
@@ -350,35 +378,55 @@ RoutingTable::DeleteAllRoutesFromInterface (Ipv4InterfaceAddress iface)
     }
 }
 
+void
+RoutingTable::Expire (EntryMap::iterator i)
+{
+  if (i->second.GetLifeTime () < Seconds (0))
+    {
+      if (i->second.GetFlag () == INVALID)
+        {
+          m_ipv4AddressEntry.erase (i);
+        }
+      else if (i->second.GetFlag () == VALID)
+        {
+          NS_LOG_LOGIC ("Invalidate route with destination address " << i->first);
+          i->second.Invalidate (m_badLinkLifetime);
+          ScheduleExpiry (i->second);
+        }
+    }
+}
+
 void
 RoutingTable::Purge ()
 {
   NS_LOG_FUNCTION (this);
-  if (m_ipv4AddressEntry.empty ())
-    return;
-  for (std::map<Ipv4Address, RoutingTableEntry>::iterator i =
-         m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end ();)
+  Time now = Simulator::Now ();
+  while (!m_expiry.empty ())
     {
-      if (i->second.GetLifeTime () < Seconds (0))
+      ExpiryBuckets::iterator bucket = m_expiry.begin ();
+      int64_t index = bucket->first;
+      if (!(index * GetExpiryBucketWidth () < now))
+        break;
+      std::vector<ExpiryRecord> records;
+      records.swap (bucket->second);
+      m_expiry.erase (bucket);
+      std::vector<ExpiryRecord> pending;
+      for (std::vector<ExpiryRecord>::const_iterator r = records.begin (); r != records.end (); ++r)
         {
-          if (i->second.GetFlag () == INVALID)
-            {
-              std::map<Ipv4Address, RoutingTableEntry>::iterator tmp = i;
-              ++i;
-              m_ipv4AddressEntry.erase (tmp);
-            }
-          else if (i->second.GetFlag () == VALID)
-            {
-              NS_LOG_LOGIC ("Invalidate route with destination address " << i->first);
-              i->second.Invalidate (m_badLinkLifetime);
-              ++i;
-            }
+          EntryMap::iterator i = m_ipv4AddressEntry.find (r->first);
+          if (i == m_ipv4AddressEntry.end () || i->second.GetLifeTime () + now != r->second)
+            continue;
+          if (r->second < now)
+            Expire (i);
           else
-            ++i;
+            pending.push_back (*r);
         }
-      else 
+      if (!pending.empty ())
         {
-          ++i;
+          // This is the bucket of the current time: the next ones have not expired yet
+          std::vector<ExpiryRecord> &current = m_expiry[index];
+          current.insert (current.end (), pending.begin (), pending.end ());
+          break;
         }
     }
 }
@@ -420,7 +468,7 @@ bool
 RoutingTable::MarkLinkAsUnidirectional (Ipv4Address neighbor, Time blacklistTimeout)
 {
   NS_LOG_FUNCTION (this << neighbor << blacklistTimeout.GetSeconds ());
-  std::map<Ipv4Address, RoutingTableEntry>::iterator i =
+  EntryMap::iterator i =
     m_ipv4AddressEntry.find (neighbor);
   if (i == m_ipv4AddressEntry.end ())
     {
@@ -437,7 +485,7 @@ RoutingTable::MarkLinkAsUnidirectional (Ipv4Address neighbor, Time blacklistTime
 void
 RoutingTable::Print (Ptr<OutputStreamWrapper> stream) const
 {
-  std::map<Ipv4Address, RoutingTableEntry> table = m_ipv4AddressEntry;
+  std::map<Ipv4Address, RoutingTableEntry> table (m_ipv4AddressEntry.begin (), m_ipv4AddressEntry.end ());
   Purge (table);
   *stream->GetStream () << "\nAODV Routing table\n"
                         << "Destination\tGateway\t\tInterface\tFlag\tExpire\t\tHops\n";
@@ -31,12 +31,14 @@
 #include <stdint.h>
 #include <cassert>
 #include <map>
+#include <vector>
 #include <sys/types.h>
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-route.h"
 #include "ns3/timer.h"
 #include "ns3/net-device.h"
 #include "ns3/output-stream-wrapper.h"
+#include "ns3/sgi-hashmap.h"
 
 namespace ns3 {
 namespace aodv {
@@ -184,6 +186,11 @@ private:
 /**
  * \ingroup aodv
  * \brief The Routing table used by AODV protocol
+ *
+ * Entries are kept in a hash table. The destinations are also filed in
+ * buckets by the time at which their entry expires, so that purging the
+ * table only visits the entries of the buckets whose time has come,
+ * instead of every entry on every access.
  */
 class RoutingTable
 {
@@ -233,7 +240,7 @@ public:
   /// Delete all route from interface with address iface
   void DeleteAllRoutesFromInterface (Ipv4InterfaceAddress iface);
   /// Delete all entries from routing table
-  void Clear () { m_ipv4AddressEntry.clear (); }
+  void Clear () { m_ipv4AddressEntry.clear (); m_expiry.clear (); }
   /// Delete all outdated entries and invalidate valid entry if Lifetime is expired
   void Purge ();
   /** Mark entry as unidirectional (e.g. add this neighbor to "blacklist" for blacklistTimeout period)
@@ -246,9 +253,21 @@ public:
   void Print (Ptr<OutputStreamWrapper> stream) const;
 
 private:
-  std::map<Ipv4Address, RoutingTableEntry> m_ipv4AddressEntry;
+  typedef sgi::hash_map<Ipv4Address, RoutingTableEntry, Ipv4AddressHash> EntryMap;
+  /// A destination filed in an expiry bucket, with the expiration time of its entry when filed
+  typedef std::pair<Ipv4Address, Time> ExpiryRecord;
+  /// Expiry buckets, by index of the time interval they cover
+  typedef std::map<int64_t, std::vector<ExpiryRecord> > ExpiryBuckets;
+
+  EntryMap m_ipv4AddressEntry;
+  /// Destinations by expiration time. Records of entries since updated or removed are stale, and skipped.
+  ExpiryBuckets m_expiry;
   /// Deletion time for invalid routes
   Time m_badLinkLifetime;
+  /// File the entry in the bucket of its expiration time
+  void ScheduleExpiry (RoutingTableEntry const & rt);
+  /// Invalidate or delete the entry if it has expired
+  void Expire (EntryMap::iterator i);
   /// const version of Purge, for use by Print() method
   void Purge (std::map<Ipv4Address, RoutingTableEntry> &table) const;
 };
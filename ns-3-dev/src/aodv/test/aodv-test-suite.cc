@@ -520,6 +520,57 @@ struct AodvRtableTest : public TestCase
   }
 };
 //-----------------------------------------------------------------------------
+/// Unit test for the expiration of AODV routing table entries
+struct AodvRtableExpiryTest : public TestCase
+{
+  AodvRtableExpiryTest () : TestCase ("Rtable expiry"), rtable (Seconds (1)) {}
+  virtual void DoRun ()
+  {
+    Ptr<NetDevice> dev;
+    Ipv4InterfaceAddress iface;
+    RoutingTableEntry rt1 (dev, Ipv4Address ("1.1.1.1"), true, 1, iface, 1, Ipv4Address ("1.1.1.1"), Seconds (1));
+    RoutingTableEntry rt2 (dev, Ipv4Address ("2.2.2.2"), true, 1, iface, 2, Ipv4Address ("1.1.1.1"), Seconds (1));
+    RoutingTableEntry rt3 (dev, Ipv4Address ("3.3.3.3"), true, 1, iface, 3, Ipv4Address ("1.1.1.1"), Seconds (1));
+    rtable.AddRoute (rt1);
+    rtable.AddRoute (rt2);
+    rt3.SetFlag (IN_SEARCH);
+    rtable.AddRoute (rt3);
+    // Extend the lifetime of the second entry
+    rt2.SetLifeTime (Seconds (5));
+    rtable.Update (rt2);
+
+    Simulator::Schedule (Seconds (0.5), &AodvRtableExpiryTest::CheckValid, this, Ipv4Address ("1.1.1.1"), VALID);
+    Simulator::Schedule (Seconds (1.5), &AodvRtableExpiryTest::CheckValid, this, Ipv4Address ("1.1.1.1"), INVALID);
+    Simulator::Schedule (Seconds (1.5), &AodvRtableExpiryTest::CheckValid, this, Ipv4Address ("2.2.2.2"), VALID);
+    Simulator::Schedule (Seconds (1.5), &AodvRtableExpiryTest::CheckValid, this, Ipv4Address ("3.3.3.3"), IN_SEARCH);
+    Simulator::Schedule (Seconds (2), &AodvRtableExpiryTest::Invalidate, this, Ipv4Address ("3.3.3.3"));
+    Simulator::Schedule (Seconds (3), &AodvRtableExpiryTest::CheckDeleted, this, Ipv4Address ("1.1.1.1"));
+    Simulator::Schedule (Seconds (3), &AodvRtableExpiryTest::CheckDeleted, this, Ipv4Address ("3.3.3.3"));
+    Simulator::Schedule (Seconds (3), &AodvRtableExpiryTest::CheckValid, this, Ipv4Address ("2.2.2.2"), VALID);
+    Simulator::Schedule (Seconds (5.5), &AodvRtableExpiryTest::CheckValid, this, Ipv4Address ("2.2.2.2"), INVALID);
+    Simulator::Schedule (Seconds (7), &AodvRtableExpiryTest::CheckDeleted, this, Ipv4Address ("2.2.2.2"));
+    Simulator::Run ();
+    Simulator::Destroy ();
+  }
+  void CheckValid (Ipv4Address dst, RouteFlags flag)
+  {
+    RoutingTableEntry rt;
+    NS_TEST_EXPECT_MSG_EQ (rtable.LookupRoute (dst, rt), true, "Route to " << dst << " not found");
+    NS_TEST_EXPECT_MSG_EQ (rt.GetFlag (), flag, "Wrong state of route to " << dst);
+  }
+  void CheckDeleted (Ipv4Address dst)
+  {
+    RoutingTableEntry rt;
+    NS_TEST_EXPECT_MSG_EQ (rtable.LookupRoute (dst, rt), false, "Route to " << dst << " not deleted");
+  }
+  void Invalidate (Ipv4Address dst)
+  {
+    NS_TEST_EXPECT_MSG_EQ (rtable.SetEntryState (dst, INVALID), true, "Route to " << dst << " not found");
+  }
+
+  RoutingTable rtable;
+};
+//-----------------------------------------------------------------------------
 class AodvTestSuite : public TestSuite
 {
 public:
@@ -535,6 +586,7 @@ public:
     AddTestCase (new AodvRqueueTest, TestCase::QUICK);
     AddTestCase (new AodvRtableEntryTest, TestCase::QUICK);
     AddTestCase (new AodvRtableTest, TestCase::QUICK);
+    AddTestCase (new AodvRtableExpiryTest, TestCase::QUICK);
   }
 } g_aodvTestSuite;
 
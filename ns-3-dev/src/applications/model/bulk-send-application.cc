@@ -153,6 +153,7 @@ void BulkSendApplication::StopApplication (void) // Called at time specified by
 {
   NS_LOG_FUNCTION (this);
 
+  Simulator::Cancel (m_sendEvent);
   if (m_socket != 0)
     {
       m_socket->Close ();
@@ -221,9 +222,12 @@ void BulkSendApplication::DataSend (Ptr<Socket>, uint32_t)
 {
   NS_LOG_FUNCTION (this);
 
-  if (m_connected)
-    { // Only send new data if the connection has completed
-      Simulator::ScheduleNow (&BulkSendApplication::SendData, this);
+  // Only send new data if the connection has completed. The socket
+  // notifies every acknowledgement: a single pending event fills the
+  // buffer for all the notifications of the same instant.
+  if (m_connected && !m_sendEvent.IsRunning ())
+    {
+      m_sendEvent = Simulator::ScheduleNow (&BulkSendApplication::SendData, this);
     }
 }
 
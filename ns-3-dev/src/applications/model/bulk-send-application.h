@@ -117,6 +117,7 @@ private:
   uint32_t        m_sendSize;     //!< Size of data to send each time
   uint32_t        m_maxBytes;     //!< Limit total number of bytes sent
   uint32_t        m_totBytes;     //!< Total bytes sent so far
+  EventId         m_sendEvent;    //!< Event id of the pending SendData event
   TypeId          m_tid;          //!< The type of protocol to use.
 
   /// Traced Callback: sent packets
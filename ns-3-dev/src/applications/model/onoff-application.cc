@@ -41,6 +41,7 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/string.h"
 #include "ns3/pointer.h"
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("OnOffApplication");
 
@@ -81,6 +82,13 @@ OnOffApplication::GetTypeId (void)
                    UintegerValue (0),
                    MakeUintegerAccessor (&OnOffApplication::m_maxBytes),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("TrainLength",
+                   "The number of packets sent back-to-back by each transmission event. "
+                   "The events are spaced so as to keep the data rate: longer trains "
+                   "model the same load with fewer events, at a coarser time granularity.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&OnOffApplication::m_trainLength),
+                   MakeUintegerChecker<uint32_t> (1))
     .AddAttribute ("Protocol", "The type of protocol to use.",
                    TypeIdValue (UdpSocketFactory::GetTypeId ()),
                    MakeTypeIdAccessor (&OnOffApplication::m_tid),
@@ -231,7 +239,16 @@ void OnOffApplication::ScheduleNextTx ()
 
   if (m_maxBytes == 0 || m_totBytes < m_maxBytes)
     {
-      uint32_t bits = m_pktSize * 8 - m_residualBits;
+      uint32_t train = m_trainLength;
+      if (m_maxBytes > 0)
+        {
+          // The last train may be shorter
+          train = std::min (train, (m_maxBytes - m_totBytes + m_pktSize - 1) / m_pktSize);
+        }
+      // The residual bits may exceed a shorter train, after MaxBytes or
+      // PacketSize changed while the application was off
+      uint64_t trainBits = static_cast<uint64_t> (train) * m_pktSize * 8;
+      uint64_t bits = trainBits > m_residualBits ? trainBits - m_residualBits : 0;
       NS_LOG_LOGIC ("bits = " << bits);
       Time nextTime (Seconds (bits /
                               static_cast<double>(m_cbrRate.GetBitRate ()))); // Time till next packet
@@ -269,27 +286,30 @@ void OnOffApplication::SendPacket ()
   NS_LOG_FUNCTION (this);
 
   NS_ASSERT (m_sendEvent.IsExpired ());
-  Ptr<Packet> packet = Create<Packet> (m_pktSize);
-  m_txTrace (packet);
-  m_socket->Send (packet);
-  m_totBytes += m_pktSize;
-  if (InetSocketAddress::IsMatchingType (m_peer))
-    {
-      NS_LOG_INFO ("At time " << Simulator::Now ().GetSeconds ()
-                   << "s on-off application sent "
-                   <<  packet->GetSize () << " bytes to "
-                   << InetSocketAddress::ConvertFrom(m_peer).GetIpv4 ()
-                   << " port " << InetSocketAddress::ConvertFrom (m_peer).GetPort ()
-                   << " total Tx " << m_totBytes << " bytes");
-    }
-  else if (Inet6SocketAddress::IsMatchingType (m_peer))
+  for (uint32_t i = 0; i < m_trainLength && (m_maxBytes == 0 || m_totBytes < m_maxBytes); ++i)
     {
-      NS_LOG_INFO ("At time " << Simulator::Now ().GetSeconds ()
-                   << "s on-off application sent "
-                   <<  packet->GetSize () << " bytes to "
-                   << Inet6SocketAddress::ConvertFrom(m_peer).GetIpv6 ()
-                   << " port " << Inet6SocketAddress::ConvertFrom (m_peer).GetPort ()
-                   << " total Tx " << m_totBytes << " bytes");
+      Ptr<Packet> packet = Create<Packet> (m_pktSize);
+      m_txTrace (packet);
+      m_socket->Send (packet);
+      m_totBytes += m_pktSize;
+      if (InetSocketAddress::IsMatchingType (m_peer))
+        {
+          NS_LOG_INFO ("At time " << Simulator::Now ().GetSeconds ()
+                       << "s on-off application sent "
+                       <<  packet->GetSize () << " bytes to "
+                       << InetSocketAddress::ConvertFrom(m_peer).GetIpv4 ()
+                       << " port " << InetSocketAddress::ConvertFrom (m_peer).GetPort ()
+                       << " total Tx " << m_totBytes << " bytes");
+        }
+      else if (Inet6SocketAddress::IsMatchingType (m_peer))
+        {
+          NS_LOG_INFO ("At time " << Simulator::Now ().GetSeconds ()
+                       << "s on-off application sent "
+                       <<  packet->GetSize () << " bytes to "
+                       << Inet6SocketAddress::ConvertFrom(m_peer).GetIpv6 ()
+                       << " port " << Inet6SocketAddress::ConvertFrom (m_peer).GetPort ()
+                       << " total Tx " << m_totBytes << " bytes");
+        }
     }
   m_lastStartTime = Simulator::Now ();
   m_residualBits = 0;
@@ -82,6 +82,11 @@ class Socket;
 *
 * If the underlying socket type supports broadcast, this application
 * will automatically enable the SetAllowBroadcast(true) socket option.
+*
+* To model heavy background traffic with fewer events, the TrainLength
+* attribute makes each transmission event send several packets
+* back-to-back; the events are then spaced by the time needed to send
+* the whole train at the data rate.
 */
 class OnOffApplication : public Application 
 {
@@ -144,7 +149,7 @@ private:
    */
   void StopSending ();
   /**
-   * \brief Send a packet
+   * \brief Send a train of packets
    */
   void SendPacket ();
 
@@ -156,6 +161,7 @@ private:
   DataRate        m_cbrRate;      //!< Rate that data is generated
   DataRate        m_cbrRateFailSafe;      //!< Rate that data is generated (check copy)
   uint32_t        m_pktSize;      //!< Size of packets
+  uint32_t        m_trainLength;  //!< Number of packets sent by each transmission event
   uint32_t        m_residualBits; //!< Number of generated, but not sent, bits
   Time            m_lastStartTime; //!< Time last packet sent
   uint32_t        m_maxBytes;     //!< Limit total number of bytes sent
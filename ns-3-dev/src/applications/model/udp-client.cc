@@ -67,6 +67,13 @@ UdpClient::GetTypeId (void)
                    UintegerValue (1024),
                    MakeUintegerAccessor (&UdpClient::m_size),
                    MakeUintegerChecker<uint32_t> (12,1500))
+    .AddAttribute ("TrainLength",
+                   "The number of packets sent back-to-back by each transmission event. "
+                   "The events are then spaced by Interval times TrainLength, so as "
+                   "to keep the same packet rate with fewer events.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&UdpClient::m_trainLength),
+                   MakeUintegerChecker<uint32_t> (1))
   ;
   return tid;
 }
@@ -152,10 +159,6 @@ UdpClient::Send (void)
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (m_sendEvent.IsExpired ());
-  SeqTsHeader seqTs;
-  seqTs.SetSeq (m_sent);
-  Ptr<Packet> p = Create<Packet> (m_size-(8+4)); // 8+4 : the size of the seqTs header
-  p->AddHeader (seqTs);
 
   std::stringstream peerAddressStringStream;
   if (Ipv4Address::IsMatchingType (m_peerAddress))
@@ -167,24 +170,33 @@ UdpClient::Send (void)
       peerAddressStringStream << Ipv6Address::ConvertFrom (m_peerAddress);
     }
 
-  if ((m_socket->Send (p)) >= 0)
+  for (uint32_t i = 0; i < m_trainLength && m_sent < m_count; ++i)
     {
-      ++m_sent;
-      NS_LOG_INFO ("TraceDelay TX " << m_size << " bytes to "
-                                    << peerAddressStringStream.str () << " Uid: "
-                                    << p->GetUid () << " Time: "
-                                    << (Simulator::Now ()).GetSeconds ());
+      SeqTsHeader seqTs;
+      seqTs.SetSeq (m_sent);
+      Ptr<Packet> p = Create<Packet> (m_size-(8+4)); // 8+4 : the size of the seqTs header
+      p->AddHeader (seqTs);
 
-    }
-  else
-    {
-      NS_LOG_INFO ("Error while sending " << m_size << " bytes to "
-                                          << peerAddressStringStream.str ());
+      if ((m_socket->Send (p)) >= 0)
+        {
+          ++m_sent;
+          NS_LOG_INFO ("TraceDelay TX " << m_size << " bytes to "
+                                        << peerAddressStringStream.str () << " Uid: "
+                                        << p->GetUid () << " Time: "
+                                        << (Simulator::Now ()).GetSeconds ());
+
+        }
+      else
+        {
+          NS_LOG_INFO ("Error while sending " << m_size << " bytes to "
+                                              << peerAddressStringStream.str ());
+        }
     }
 
   if (m_sent < m_count)
     {
-      m_sendEvent = Simulator::Schedule (m_interval, &UdpClient::Send, this);
+      m_sendEvent = Simulator::Schedule (m_interval * static_cast<int64_t> (m_trainLength),
+                                         &UdpClient::Send, this);
     }
 }
 
@@ -81,13 +81,14 @@ private:
   virtual void StopApplication (void);
 
   /**
-   * \brief Send a packet
+   * \brief Send a train of packets
    */
   void Send (void);
 
   uint32_t m_count; //!< Maximum number of packets the application will send
   Time m_interval; //!< Packet inter-send time
   uint32_t m_size; //!< Size of the sent packet (including the SeqTsHeader)
+  uint32_t m_trainLength; //!< Number of packets sent by each transmission event
 
   uint32_t m_sent; //!< Counter for sent packets
   Ptr<Socket> m_socket; //!< Socket
@@ -0,0 +1,272 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+#include "ns3/data-rate.h"
+#include "ns3/double.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/on-off-helper.h"
+#include "ns3/onoff-application.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+/**
+ * Base class of the OnOffApplication tests: installs an OnOffApplication
+ * sending 100 byte packets at 8 kb/s, that is one packet every 0.1 s
+ * of on state, and records the times of its transmissions.
+ */
+class OnOffTestCase : public TestCase
+{
+public:
+  OnOffTestCase (std::string name);
+
+protected:
+  /**
+   * Install the application, started at 1 s.
+   *
+   * \param onTime the duration of the on states
+   * \param offTime the duration of the off states
+   * \param trainLength the number of packets of each train
+   * \param maxBytes the total number of bytes to send
+   * \param stop the time the application stops
+   * \return the application
+   */
+  Ptr<OnOffApplication> Install (double onTime, double offTime, uint32_t trainLength,
+                                 uint32_t maxBytes, double stop);
+  /**
+   * Check the time of a transmission.
+   *
+   * \param i the index of the transmission
+   * \param time the expected time, in seconds
+   */
+  void CheckTx (uint32_t i, double time);
+
+  std::vector<Time> m_times;  //!< Times of the transmissions
+
+private:
+  void Tx (Ptr<const Packet> packet);
+};
+
+OnOffTestCase::OnOffTestCase (std::string name)
+  : TestCase (name)
+{
+}
+
+void
+OnOffTestCase::Tx (Ptr<const Packet> packet)
+{
+  m_times.push_back (Simulator::Now ());
+}
+
+Ptr<OnOffApplication>
+OnOffTestCase::Install (double onTime, double offTime, uint32_t trainLength,
+                        uint32_t maxBytes, double stop)
+{
+  NodeContainer n;
+  n.Create (2);
+
+  InternetStackHelper internet;
+  internet.Install (n);
+
+  // link the two nodes
+  Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice> ();
+  Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice> ();
+  n.Get (0)->AddDevice (txDev);
+  n.Get (1)->AddDevice (rxDev);
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  rxDev->SetChannel (channel);
+  txDev->SetChannel (channel);
+  NetDeviceContainer d;
+  d.Add (txDev);
+  d.Add (rxDev);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer i = ipv4.Assign (d);
+
+  OnOffHelper onoff ("ns3::UdpSocketFactory", InetSocketAddress (i.GetAddress (1), 9));
+  onoff.SetConstantRate (DataRate ("8kb/s"), 100);
+  onoff.SetAttribute ("OnTime", PointerValue (CreateObjectWithAttributes<ConstantRandomVariable> ("Constant", DoubleValue (onTime))));
+  onoff.SetAttribute ("OffTime", PointerValue (CreateObjectWithAttributes<ConstantRandomVariable> ("Constant", DoubleValue (offTime))));
+  onoff.SetAttribute ("TrainLength", UintegerValue (trainLength));
+  onoff.SetAttribute ("MaxBytes", UintegerValue (maxBytes));
+  ApplicationContainer apps = onoff.Install (n.Get (0));
+  apps.Start (Seconds (1.0));
+  apps.Stop (Seconds (stop));
+
+  Ptr<OnOffApplication> app = DynamicCast<OnOffApplication> (apps.Get (0));
+  app->TraceConnectWithoutContext ("Tx", MakeCallback (&OnOffTestCase::Tx, this));
+  return app;
+}
+
+void
+OnOffTestCase::CheckTx (uint32_t i, double time)
+{
+  if (i >= m_times.size ())
+    {
+      return;
+    }
+  // The residual bits are rounded down to whole bits
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_times[i].GetSeconds (), time, 0.001, "wrong time of packet " << i);
+}
+
+/**
+ * Test that the packets are sent in trains spaced so as to keep the
+ * data rate.
+ */
+class OnOffTrainTestCase : public OnOffTestCase
+{
+public:
+  OnOffTrainTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+OnOffTrainTestCase::OnOffTrainTestCase ()
+  : OnOffTestCase ("Test that an OnOffApplication sends trains of packets at the data rate")
+{
+}
+
+void
+OnOffTrainTestCase::DoRun (void)
+{
+  // Trains of 4 packets every 0.4 s, at 1.4, 1.8 and 2.2 s
+  Install (100.0, 0.0, 4, 0, 2.3);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_times.size (), 12, "wrong number of packets");
+  for (uint32_t i = 0; i < m_times.size (); i++)
+    {
+      CheckTx (i, 1.4 + (i / 4) * 0.4);
+    }
+}
+
+/**
+ * Test that the last train is cut short so as not to send more than
+ * MaxBytes, and is sent earlier than a whole train.
+ */
+class OnOffMaxBytesTestCase : public OnOffTestCase
+{
+public:
+  OnOffMaxBytesTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+OnOffMaxBytesTestCase::OnOffMaxBytesTestCase ()
+  : OnOffTestCase ("Test that an OnOffApplication sends at most MaxBytes in trains")
+{
+}
+
+void
+OnOffMaxBytesTestCase::DoRun (void)
+{
+  // Trains of 4, 4 and 2 packets, at 1.4, 1.8 and 2.0 s
+  Install (100.0, 0.0, 4, 1000, 10.0);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_times.size (), 10, "wrong number of packets");
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      CheckTx (i, 1.4 + (i / 4) * 0.4);
+    }
+  CheckTx (8, 2.0);
+  CheckTx (9, 2.0);
+}
+
+/**
+ * Test that the bits generated but not sent during an on state are
+ * carried over to the next on state, even when they exceed the next
+ * train.
+ */
+class OnOffResidualTestCase : public OnOffTestCase
+{
+public:
+  OnOffResidualTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+OnOffResidualTestCase::OnOffResidualTestCase ()
+  : OnOffTestCase ("Test that an OnOffApplication carries the residual bits over its off states")
+{
+}
+
+void
+OnOffResidualTestCase::DoRun (void)
+{
+  // On from 1.1 to 1.4 s: 2400 of the 3200 bits of a train are generated.
+  // On from 1.5 s: the train is sent at 1.6 s.  On again from 1.9 s, after
+  // 1600 bits generated from 1.6 to 1.8 s: the train is sent at 2.1 s.
+  Install (0.3, 0.1, 4, 0, 2.15);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_times.size (), 8, "wrong number of packets");
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      CheckTx (i, 1.6);
+      CheckTx (4 + i, 2.1);
+    }
+
+  // The same first on state, then MaxBytes is set while the application
+  // is off: the 2400 residual bits exceed the last train of a packet,
+  // which is sent as soon as the application is on again, at 1.5 s.
+  m_times.clear ();
+  Ptr<OnOffApplication> app = Install (0.3, 0.1, 4, 0, 3.0);
+  Simulator::Schedule (Seconds (1.45), &OnOffApplication::SetMaxBytes, app, 100);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_times.size (), 1, "wrong number of packets");
+  CheckTx (0, 1.5);
+}
+
+class OnOffApplicationTestSuite : public TestSuite
+{
+public:
+  OnOffApplicationTestSuite ();
+};
+
+OnOffApplicationTestSuite::OnOffApplicationTestSuite ()
+  : TestSuite ("onoff-application", UNIT)
+{
+  AddTestCase (new OnOffTrainTestCase, TestCase::QUICK);
+  AddTestCase (new OnOffMaxBytesTestCase, TestCase::QUICK);
+  AddTestCase (new OnOffResidualTestCase, TestCase::QUICK);
+}
+
+static OnOffApplicationTestSuite onOffApplicationTestSuite;
@@ -111,6 +111,80 @@ void UdpClientServerTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (server.GetServer ()->GetReceived (), 8, "Did not receive expected number of packets !");
 }
 
+/**
+ * Test that the udp packets generated in trains by an udpClient application
+ * are all correctly received, in sequence, by an udpServer application
+ */
+
+class UdpClientTrainTestCase : public TestCase
+{
+public:
+  UdpClientTrainTestCase ();
+  virtual ~UdpClientTrainTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+};
+
+UdpClientTrainTestCase::UdpClientTrainTestCase ()
+  : TestCase ("Test that the udp packets sent in trains by an udpClient application are correctly received by an udpServer application")
+{
+}
+
+UdpClientTrainTestCase::~UdpClientTrainTestCase ()
+{
+}
+
+void UdpClientTrainTestCase::DoRun (void)
+{
+  NodeContainer n;
+  n.Create (2);
+
+  InternetStackHelper internet;
+  internet.Install (n);
+
+  // link the two nodes
+  Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice> ();
+  Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice> ();
+  n.Get (0)->AddDevice (txDev);
+  n.Get (1)->AddDevice (rxDev);
+  Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel> ();
+  rxDev->SetChannel (channel1);
+  txDev->SetChannel (channel1);
+  NetDeviceContainer d;
+  d.Add (txDev);
+  d.Add (rxDev);
+
+  Ipv4AddressHelper ipv4;
+
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer i = ipv4.Assign (d);
+
+  uint16_t port = 4000;
+  UdpServerHelper server (port);
+  ApplicationContainer apps = server.Install (n.Get (1));
+  apps.Start (Seconds (1.0));
+  apps.Stop (Seconds (10.0));
+
+  // Trains of 4 packets every 1.6 s, sent at 2, 3.6 and 5.2 s before the
+  // client stops: the train of the last 2 packets is never sent
+  UdpClientHelper client (i.GetAddress (1), port);
+  client.SetAttribute ("MaxPackets", UintegerValue (14));
+  client.SetAttribute ("Interval", TimeValue (Seconds (0.4)));
+  client.SetAttribute ("PacketSize", UintegerValue (1024));
+  client.SetAttribute ("TrainLength", UintegerValue (4));
+  apps = client.Install (n.Get (0));
+  apps.Start (Seconds (2.0));
+  apps.Stop (Seconds (6.0));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (server.GetServer ()->GetLost (), 0, "Packets were lost !");
+  NS_TEST_ASSERT_MSG_EQ (server.GetServer ()->GetReceived (), 12, "Did not receive expected number of packets !");
+}
+
 /**
  * Test that all the udp packets generated by an udpTraceClient application are
  * correctly received by an udpServer application
@@ -342,6 +416,7 @@ UdpClientServerTestSuite::UdpClientServerTestSuite ()
 {
   AddTestCase (new UdpTraceClientServerTestCase, TestCase::QUICK);
   AddTestCase (new UdpClientServerTestCase, TestCase::QUICK);
+  AddTestCase (new UdpClientTrainTestCase, TestCase::QUICK);
   AddTestCase (new PacketLossCounterTestCase, TestCase::QUICK);
   AddTestCase (new UdpEchoClientSetFillTestCase, TestCase::QUICK);
 }
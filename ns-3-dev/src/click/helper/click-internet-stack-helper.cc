@@ -346,8 +346,16 @@ Ipv4L3ProtocolDropSinkWithoutContext (
       return;
     }
 
+  if (!stream->MayAccept (packet))
+    {
+      return;
+    }
   Ptr<Packet> p = packet->Copy ();
   p->AddHeader (header);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -374,8 +382,16 @@ Ipv4L3ProtocolDropSinkWithContext (
       return;
     }
 
+  if (!stream->MayAccept (packet))
+    {
+      return;
+    }
   Ptr<Packet> p = packet->Copy ();
   p->AddHeader (header);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
 #ifdef INTERFACE_CONTEXT
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << context << "(" << interface << ") "
                         << *p << std::endl;
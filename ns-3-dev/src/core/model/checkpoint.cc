@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "checkpoint.h"
+#include "process-pool.h"
+#include "simulator.h"
+#include "assert.h"
+#include "log.h"
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::Checkpoint implementation.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("Checkpoint");
+
+namespace ns3 {
+
+/// Whether the current process runs a variant
+static bool g_isVariant = false;
+/// The index of the variant of the current process
+static uint32_t g_variant = 0;
+/// The number of variants of the last checkpoint which failed
+static uint32_t g_nFailed = 0;
+
+void
+Checkpoint::Schedule (Time const &delay, uint32_t variants,
+                      Callback<void, uint32_t> callback, uint32_t parallel)
+{
+  NS_LOG_FUNCTION (delay << variants << parallel);
+  Simulator::Schedule (delay, &Checkpoint::Take, variants, callback, parallel);
+}
+
+void
+Checkpoint::Take (uint32_t variants, Callback<void, uint32_t> callback, uint32_t parallel)
+{
+  NS_LOG_FUNCTION (variants << parallel);
+  NS_ASSERT (parallel > 0);
+
+  ProcessPool pool (parallel);
+  for (uint32_t i = 0; i < variants; i++)
+    {
+      pid_t pid = pool.Fork ();
+      if (pid == 0)
+        {
+          // resume the simulation with this variant
+          g_isVariant = true;
+          g_variant = i;
+          callback (i);
+          return;
+        }
+      NS_LOG_INFO ("Variant " << i << " runs in process " << pid);
+    }
+  pool.Wait ();
+  g_nFailed = pool.GetNFailed ();
+  g_isVariant = false;
+  Simulator::Stop ();
+}
+
+bool
+Checkpoint::IsVariant (void)
+{
+  return g_isVariant;
+}
+
+uint32_t
+Checkpoint::GetVariant (void)
+{
+  return g_variant;
+}
+
+uint32_t
+Checkpoint::GetNFailed (void)
+{
+  return g_nFailed;
+}
+
+} // namespace ns3
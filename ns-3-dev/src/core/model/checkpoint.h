@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdint.h>
+#include "callback.h"
+#include "nstime.h"
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::Checkpoint declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Resume several variants of a simulation from a common state
+ *
+ * A checkpoint suspends the simulation, and resumes it in one child
+ * process per variant. Each child process starts from a copy of the
+ * whole state of the simulation at the checkpoint: the pending events,
+ * the states of the random variable streams, the attributes and state of
+ * the nodes and protocols, and the packets in the queues. The callback
+ * passed for the variants is called in each child process with the index
+ * of its variant, before the simulation resumes, so that it can change
+ * attributes, traces or applications. A long warm-up phase is thus only
+ * simulated once for all the variants.
+ *
+ * The variants run one at a time, or up to a given number of them in
+ * parallel. Once they have all exited, Simulator::Run returns in the
+ * parent process, which should then not report results: see IsVariant.
+ *
+ * \code
+ *   Checkpoint::Schedule (Seconds (60), 10, MakeCallback (&SetVariant), 4);
+ *   Simulator::Run ();
+ *   if (Checkpoint::IsVariant ())
+ *     {
+ *       Report (Checkpoint::GetVariant ());
+ *     }
+ *   Simulator::Destroy ();
+ * \endcode
+ *
+ * The child processes share the files opened before the checkpoint, such
+ * as trace files, with the parent process. Traces should be enabled in
+ * the callback of the variants, with file names depending on the
+ * variant. The checkpoint relies on fork, and thus cannot be used with
+ * the real-time or distributed simulators, or while other threads run.
+ */
+class Checkpoint
+{
+public:
+  /**
+   * Take a checkpoint once the simulation reaches a given time.
+   *
+   * \param delay the delay after which the checkpoint is taken
+   * \param variants the number of variants resumed from the checkpoint
+   * \param callback called with the index of the variant in each child process
+   * \param parallel the maximum number of variants running at the same time
+   */
+  static void Schedule (Time const &delay, uint32_t variants,
+                        Callback<void, uint32_t> callback, uint32_t parallel = 1);
+
+  /**
+   * Take a checkpoint now. In the parent process, this method returns
+   * once all the variants have exited, and stops the simulation.
+   *
+   * \param variants the number of variants resumed from the checkpoint
+   * \param callback called with the index of the variant in each child process
+   * \param parallel the maximum number of variants running at the same time
+   */
+  static void Take (uint32_t variants, Callback<void, uint32_t> callback, uint32_t parallel = 1);
+
+  /**
+   * \return true in the process of a variant, false in the process
+   *         which took the last checkpoint.
+   */
+  static bool IsVariant (void);
+
+  /**
+   * \return the index of the variant of the current process, if IsVariant.
+   */
+  static uint32_t GetVariant (void);
+
+  /**
+   * \return the number of variants of the last checkpoint which did not
+   *         exit with a zero status.
+   */
+  static uint32_t GetNFailed (void);
+};
+
+} // namespace ns3
+
+#endif /* CHECKPOINT_H */
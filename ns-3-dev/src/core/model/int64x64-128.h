@@ -208,11 +208,21 @@ public:
    * Multiply this value by a Q0.128 value, presumably representing an inverse,
    * completing a division operation.
    *
+   * This is inline, as Time conversions to coarser units call it on
+   * every use.
+   *
    * \param [in] o The inverse operand.
    *
    * \see Invert
    */
-  void MulByInvert (const int64x64_t & o);
+  inline void MulByInvert (const int64x64_t & o)
+  {
+    bool negResult = _v < 0;
+    uint128_t a = negResult ? -_v : _v;
+    uint128_t result = UmulByInvert (a, o._v);
+
+    _v = negResult ? -result : result;
+  }
 
   /**
    * Compute the inverse of an integer value.
@@ -297,7 +307,20 @@ private:
    *
    * \see Invert
    */
-  static uint128_t UmulByInvert (const uint128_t a, const uint128_t b);
+  static inline uint128_t UmulByInvert (const uint128_t a, const uint128_t b)
+  {
+    uint128_t result, ah, bh, al, bl;
+    uint128_t hi, mid;
+    ah = a >> 64;
+    bh = b >> 64;
+    al = a & HP_MASK_LO;
+    bl = b & HP_MASK_LO;
+    hi = ah * bh;
+    mid = ah * bl + al * bh;
+    mid >>= 64;
+    result = hi + mid;
+    return result;
+  }
 
   /**
    * Construct from an integral type.
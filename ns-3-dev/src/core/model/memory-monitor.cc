@@ -0,0 +1,283 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "memory-monitor.h"
+#include "simulator.h"
+#include "log.h"
+#include <algorithm>
+#include <iomanip>
+
+NS_LOG_COMPONENT_DEFINE ("MemoryMonitor");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (MemoryMonitor);
+
+bool MemoryMonitor::m_enabled = false;
+
+namespace {
+
+/**
+ * Order usages by decreasing number of bytes, then by name.
+ */
+bool
+CompareUsage (const struct MemoryMonitor::Usage &a, const struct MemoryMonitor::Usage &b)
+{
+  if (a.bytes != b.bytes)
+    {
+      return a.bytes > b.bytes;
+    }
+  return a.name < b.name;
+}
+
+} // anonymous namespace
+
+TypeId
+MemoryMonitor::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MemoryMonitor")
+    .SetParent<Object> ()
+    .AddConstructor<MemoryMonitor> ()
+    .AddAttribute ("Interval",
+                   "The interval between two samples of the memory usage.",
+                   TimeValue (Seconds (1.0)),
+                   MakeTimeAccessor (&MemoryMonitor::m_interval),
+                   MakeTimeChecker ())
+    .AddTraceSource ("Sample",
+                     "The memory usage by TypeId and counter, and the number of events in the event list "
+                     "of the simulator, cancelled events included.",
+                     MakeTraceSourceAccessor (&MemoryMonitor::m_sampleTrace))
+  ;
+  return tid;
+}
+
+MemoryMonitor::MemoryMonitor ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MemoryMonitor::~MemoryMonitor ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MemoryMonitor::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_event.Cancel ();
+  Object::DoDispose ();
+}
+
+void
+MemoryMonitor::Enable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled = true;
+}
+
+void
+MemoryMonitor::Disable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled = false;
+  // The blocks accounted so far would never be released
+  GetCounterEntries ().clear ();
+}
+
+uint32_t
+MemoryMonitor::RegisterCounter (std::string name)
+{
+  NS_LOG_FUNCTION (name);
+  std::vector<std::string> &names = GetCounterNames ();
+  names.push_back (name);
+  return names.size () - 1;
+}
+
+std::vector<std::string> &
+MemoryMonitor::GetCounterNames (void)
+{
+  static std::vector<std::string> names;
+  return names;
+}
+
+std::vector<struct MemoryMonitor::Entry> &
+MemoryMonitor::GetObjectEntries (void)
+{
+  // Never destroyed, as objects may be deleted during the destruction
+  // of static variables.
+  static std::vector<struct Entry> *entries = new std::vector<struct Entry> ();
+  return *entries;
+}
+
+std::vector<struct MemoryMonitor::Entry> &
+MemoryMonitor::GetCounterEntries (void)
+{
+  static std::vector<struct Entry> *entries = new std::vector<struct Entry> ();
+  return *entries;
+}
+
+void
+MemoryMonitor::NotifyObjectCreated (TypeId tid, uint32_t size)
+{
+  DoNotifyAllocate (GetObjectEntries (), tid.GetUid (), size);
+}
+
+void
+MemoryMonitor::NotifyObjectDeleted (TypeId tid, uint32_t size)
+{
+  DoNotifyDeallocate (GetObjectEntries (), tid.GetUid (), size);
+}
+
+void
+MemoryMonitor::DoNotifyAllocate (std::vector<struct Entry> &entries, uint32_t index, uint32_t bytes)
+{
+  if (index >= entries.size ())
+    {
+      struct Entry empty = { 0, 0, 0 };
+      entries.resize (index + 1, empty);
+    }
+  struct Entry &entry = entries[index];
+  entry.count++;
+  entry.bytes += bytes;
+  entry.peakBytes = std::max (entry.peakBytes, entry.bytes);
+}
+
+void
+MemoryMonitor::DoNotifyDeallocate (std::vector<struct Entry> &entries, uint32_t index, uint32_t bytes)
+{
+  // Ignore the blocks which were allocated before the monitor was
+  // enabled.
+  if (index >= entries.size ())
+    {
+      return;
+    }
+  struct Entry &entry = entries[index];
+  if (entry.count == 0 || entry.bytes < bytes)
+    {
+      return;
+    }
+  entry.count--;
+  entry.bytes -= bytes;
+}
+
+MemoryMonitor::UsageList
+MemoryMonitor::GetUsage (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  UsageList usages;
+  const std::vector<struct Entry> &objects = GetObjectEntries ();
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      if (objects[i].peakBytes == 0)
+        {
+          continue;
+        }
+      TypeId tid;
+      tid.SetUid (i);
+      struct Usage usage;
+      usage.name = tid.GetName ();
+      usage.count = objects[i].count;
+      usage.bytes = objects[i].bytes;
+      usage.peakBytes = objects[i].peakBytes;
+      usages.push_back (usage);
+    }
+  const std::vector<std::string> &names = GetCounterNames ();
+  const std::vector<struct Entry> &counters = GetCounterEntries ();
+  for (uint32_t i = 0; i < counters.size (); i++)
+    {
+      if (counters[i].peakBytes == 0)
+        {
+          continue;
+        }
+      struct Usage usage;
+      usage.name = names[i];
+      usage.count = counters[i].count;
+      usage.bytes = counters[i].bytes;
+      usage.peakBytes = counters[i].peakBytes;
+      usages.push_back (usage);
+    }
+  std::sort (usages.begin (), usages.end (), &CompareUsage);
+  return usages;
+}
+
+uint64_t
+MemoryMonitor::GetTotalBytes (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  uint64_t total = 0;
+  const std::vector<struct Entry> &objects = GetObjectEntries ();
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      total += objects[i].bytes;
+    }
+  const std::vector<struct Entry> &counters = GetCounterEntries ();
+  for (uint32_t i = 0; i < counters.size (); i++)
+    {
+      total += counters[i].bytes;
+    }
+  return total;
+}
+
+void
+MemoryMonitor::Print (std::ostream &os)
+{
+  NS_LOG_FUNCTION (&os);
+  UsageList usages = GetUsage ();
+  os << "Memory usage at " << Simulator::Now ().GetSeconds () << " s: "
+     << GetTotalBytes () << " bytes, "
+     << Simulator::GetPendingEventCount () << " pending events" << std::endl;
+  os << std::left << std::setw (48) << "Type"
+     << std::right << std::setw (12) << "Live"
+     << std::setw (16) << "Bytes"
+     << std::setw (16) << "Peak bytes" << std::endl;
+  for (UsageList::const_iterator i = usages.begin (); i != usages.end (); ++i)
+    {
+      os << std::left << std::setw (48) << i->name
+         << std::right << std::setw (12) << i->count
+         << std::setw (16) << i->bytes
+         << std::setw (16) << i->peakBytes << std::endl;
+    }
+}
+
+void
+MemoryMonitor::Start (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_interval.IsStrictlyPositive (), "MemoryMonitor::Interval must be positive");
+  m_event.Cancel ();
+  m_event = Simulator::Schedule (m_interval, &MemoryMonitor::Sample, this);
+}
+
+void
+MemoryMonitor::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_event.Cancel ();
+}
+
+void
+MemoryMonitor::Sample (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_sampleTrace.IsEmpty ())
+    {
+      m_sampleTrace (GetUsage (), Simulator::GetPendingEventCount ());
+    }
+  m_event = Simulator::Schedule (m_interval, &MemoryMonitor::Sample, this);
+}
+
+} // namespace ns3
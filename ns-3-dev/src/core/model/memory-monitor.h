@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef MEMORY_MONITOR_H
+#define MEMORY_MONITOR_H
+
+#include "object.h"
+#include "nstime.h"
+#include "event-id.h"
+#include "traced-callback.h"
+#include <string>
+#include <vector>
+#include <ostream>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ *
+ * \brief account the memory used by the objects of a simulation
+ *
+ * Once enabled with MemoryMonitor::Enable, the monitor keeps, for
+ * each TypeId, the number of live Object instances created by
+ * CreateObject, CopyObject or an ObjectFactory, and the bytes they
+ * occupy. Only the size of the instances themselves is accounted,
+ * not the memory they own.
+ *
+ * Other frequently allocated blocks, such as the packet buffers,
+ * metadata and tag lists, are accounted in named counters which the
+ * modules which allocate them register with RegisterCounter and
+ * update with NotifyAllocate and NotifyDeallocate.
+ *
+ * The usage can be printed at any time with Print, is printed on
+ * std::clog by Simulator::Destroy while the monitor is enabled, and
+ * can be sampled periodically by a MemoryMonitor instance, which
+ * reports it through its Sample trace source.
+ *
+ * The monitor should be enabled at the start of the program: the
+ * objects and blocks allocated before are not accounted. The counters
+ * are not protected against updates from threads other than the
+ * simulation thread, which may make them slightly inaccurate in
+ * emulations.
+ */
+class MemoryMonitor : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief the memory accounted to a TypeId or a counter
+   */
+  struct Usage
+  {
+    std::string name;     //!< name of the TypeId or counter
+    uint64_t count;       //!< number of live instances or blocks
+    uint64_t bytes;       //!< number of live bytes
+    uint64_t peakBytes;   //!< largest number of live bytes
+  };
+  /** A list of Usage, in decreasing number of live bytes */
+  typedef std::vector<struct Usage> UsageList;
+
+  MemoryMonitor ();
+  virtual ~MemoryMonitor ();
+
+  /**
+   * Start the accounting of the objects and blocks allocated from now.
+   */
+  static void Enable (void);
+  /**
+   * Stop the accounting. The objects accounted so far are still
+   * released from the accounting when they are deleted, but the
+   * counters are reset, as the release of their blocks is no longer
+   * notified.
+   */
+  static void Disable (void);
+  /**
+   * \returns true if the accounting is enabled.
+   */
+  static bool IsEnabled (void);
+
+  /**
+   * \param name the name of the counter
+   * \returns the identifier of the counter, to be passed to
+   *          NotifyAllocate and NotifyDeallocate.
+   *
+   * Counters may be registered before the monitor is enabled,
+   * typically during the initialization of static variables.
+   */
+  static uint32_t RegisterCounter (std::string name);
+  /**
+   * \param counter a counter returned by RegisterCounter
+   * \param bytes the size of the allocated block
+   */
+  static void NotifyAllocate (uint32_t counter, uint32_t bytes);
+  /**
+   * \param counter a counter returned by RegisterCounter
+   * \param bytes the size of the released block
+   */
+  static void NotifyDeallocate (uint32_t counter, uint32_t bytes);
+
+  /**
+   * \returns the usage of all the TypeIds and counters with live
+   *          instances or blocks, in decreasing number of bytes.
+   */
+  static UsageList GetUsage (void);
+  /**
+   * \returns the number of live bytes accounted in all the TypeIds
+   *          and counters.
+   */
+  static uint64_t GetTotalBytes (void);
+  /**
+   * \param os the stream to print to
+   *
+   * Print the usage of all the TypeIds and counters, and the number
+   * of events in the event list of the simulator, as returned by
+   * Simulator::GetPendingEventCount.
+   */
+  static void Print (std::ostream &os);
+
+  /**
+   * Start sampling the usage every Interval. The sampling keeps
+   * the simulator busy until Stop is called or the simulator is
+   * stopped with Simulator::Stop.
+   */
+  void Start (void);
+  /**
+   * Stop sampling the usage.
+   */
+  void Stop (void);
+
+private:
+  friend class Object;
+
+  /// The accounting of a TypeId or counter
+  struct Entry
+  {
+    uint64_t count;       //!< number of live instances or blocks
+    uint64_t bytes;       //!< number of live bytes
+    uint64_t peakBytes;   //!< largest number of live bytes
+  };
+
+  /**
+   * \param tid the TypeId of the new instance
+   * \param size the size of the instance
+   */
+  static void NotifyObjectCreated (TypeId tid, uint32_t size);
+  /**
+   * \param tid the TypeId of the deleted instance
+   * \param size the size of the instance
+   */
+  static void NotifyObjectDeleted (TypeId tid, uint32_t size);
+  static void DoNotifyAllocate (std::vector<struct Entry> &entries, uint32_t index, uint32_t bytes);
+  static void DoNotifyDeallocate (std::vector<struct Entry> &entries, uint32_t index, uint32_t bytes);
+  /** \returns the names of the counters */
+  static std::vector<std::string> &GetCounterNames (void);
+  /** \returns the accounting of the TypeIds, indexed by uid */
+  static std::vector<struct Entry> &GetObjectEntries (void);
+  /** \returns the accounting of the counters */
+  static std::vector<struct Entry> &GetCounterEntries (void);
+  virtual void DoDispose (void);
+  void Sample (void);
+
+  static bool m_enabled;
+
+  Time m_interval;
+  EventId m_event;
+  TracedCallback<const UsageList &, uint32_t> m_sampleTrace;
+};
+
+} // namespace ns3
+
+namespace ns3 {
+
+inline bool
+MemoryMonitor::IsEnabled (void)
+{
+  return m_enabled;
+}
+
+inline void
+MemoryMonitor::NotifyAllocate (uint32_t counter, uint32_t bytes)
+{
+  if (m_enabled)
+    {
+      DoNotifyAllocate (GetCounterEntries (), counter, bytes);
+    }
+}
+
+inline void
+MemoryMonitor::NotifyDeallocate (uint32_t counter, uint32_t bytes)
+{
+  if (m_enabled)
+    {
+      DoNotifyDeallocate (GetCounterEntries (), counter, bytes);
+    }
+}
+
+} // namespace ns3
+
+#endif /* MEMORY_MONITOR_H */
@@ -430,6 +430,25 @@ public:
    */
   inline static Time FromDouble (double value, enum Unit timeUnit)
   {
+    struct Information *info = PeekInformation (timeUnit);
+    if (info->fromExact)
+      {
+        // A value above 2^-12 is exactly represented by int64x64_t, so
+        // From () returns the floor of its exact product by the factor.
+        // That is the floor of the rounded double product, unless the
+        // rounding reached an integer, which is only exact if the
+        // value itself is an integer.
+        double product = value * info->fromFactor;
+        double magnitude = std::fabs (value);
+        if (magnitude >= 0.000244140625 && std::fabs (product) < 4503599627370496.0)
+          {
+            double integral = std::floor (product);
+            if (integral != product || value == std::floor (value))
+              {
+                return Time (static_cast<int64_t> (integral));
+              }
+          }
+      }
     return From (int64x64_t (value), timeUnit);
   }
   /**
@@ -441,6 +460,12 @@ public:
    */
   inline double ToDouble (enum Unit timeUnit) const
   {
+    struct Information *info = PeekInformation (timeUnit);
+    // The product of two integers below 2^53 is exact in double
+    if (m_data <= info->toExactMax && m_data >= -info->toExactMax)
+      {
+        return static_cast<double> (m_data) * info->toFactor;
+      }
     return To (timeUnit).GetDouble ();
   }
   static inline Time From (const int64x64_t & from, enum Unit timeUnit)
@@ -515,6 +540,10 @@ private:
     int64_t factor;                 //!< Ratio of this unit / current unit
     int64x64_t timeTo;              //!< Multiplier to convert to this unit
     int64x64_t timeFrom;            //!< Multiplier to convert from this unit
+    bool fromExact;                 //!< FromDouble may multiply by fromFactor in double
+    double fromFactor;              //!< factor, as a double
+    int64_t toExactMax;             //!< Largest value ToDouble may multiply by toFactor, -1 if none
+    double toFactor;                //!< factor, as a double
   };
   /**
    * Current time unit, and conversion info.
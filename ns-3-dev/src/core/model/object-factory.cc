@@ -94,6 +94,7 @@ ObjectFactory::Create (void) const
   Object *derived = dynamic_cast<Object *> (base);
   NS_ASSERT (derived != 0);
   derived->SetTypeId (m_tid);
+  derived->SetInstanceSize (m_tid.GetSize ());
   derived->Construct (m_parameters);
   Ptr<Object> object = Ptr<Object> (derived, false);
   return object;
@@ -21,6 +21,7 @@
 
 #include "object.h"
 #include "object-factory.h"
+#include "memory-monitor.h"
 #include "assert.h"
 #include "singleton.h"
 #include "attribute.h"
@@ -94,7 +95,8 @@ Object::Object ()
     m_disposed (false),
     m_initialized (false),
     m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
-    m_getObjectCount (0)
+    m_getObjectCount (0),
+    m_accountedSize (0)
 {
   NS_LOG_FUNCTION (this);
   m_aggregates->n = 1;
@@ -123,13 +125,18 @@ Object::~Object ()
       std::free (m_aggregates);
     }
   m_aggregates = 0;
+  if (m_accountedSize != 0)
+    {
+      MemoryMonitor::NotifyObjectDeleted (m_tid, m_accountedSize);
+    }
 }
 Object::Object (const Object &o)
   : m_tid (o.m_tid),
     m_disposed (false),
     m_initialized (false),
     m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
-    m_getObjectCount (0)
+    m_getObjectCount (0),
+    m_accountedSize (0)
 {
   m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
@@ -331,6 +338,17 @@ Object::SetTypeId (TypeId tid)
   m_tid = tid;
 }
 
+void
+Object::SetInstanceSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  if (MemoryMonitor::IsEnabled () && m_accountedSize == 0)
+    {
+      m_accountedSize = size;
+      MemoryMonitor::NotifyObjectCreated (m_tid, size);
+    }
+}
+
 void
 Object::DoDispose (void)
 {
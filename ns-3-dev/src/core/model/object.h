@@ -276,6 +276,15 @@ private:
    * keep track of the type of this object instance.
    */
   void SetTypeId (TypeId tid);
+  /**
+   * \param size the size of this object instance, in bytes
+   *
+   * Invoked from ns3::CreateObject, ns3::CopyObject and
+   * ns3::ObjectFactory::Create only. If the MemoryMonitor is
+   * enabled, account this instance to its TypeId until it is
+   * deleted.
+   */
+  void SetInstanceSize (uint32_t size);
   /**
   * \param attributes the attribute values used to initialize
   *        the member variables of this object's instance.
@@ -329,6 +338,11 @@ private:
    * of the array the most-frequently accessed elements.
    */
   uint32_t m_getObjectCount;
+  /**
+   * The size of this object instance accounted in the MemoryMonitor,
+   * or zero if it is not accounted.
+   */
+  uint32_t m_accountedSize;
 };
 
 /**
@@ -398,6 +412,7 @@ Ptr<T> CopyObject (Ptr<T> object)
 {
   Ptr<T> p = Ptr<T> (new T (*PeekPointer (object)), false);
   NS_ASSERT (p->GetInstanceTypeId () == object->GetInstanceTypeId ());
+  p->SetInstanceSize (sizeof (T));
   return p;
 }
 
@@ -406,6 +421,7 @@ Ptr<T> CopyObject (Ptr<const T> object)
 {
   Ptr<T> p = Ptr<T> (new T (*PeekPointer (object)), false);
   NS_ASSERT (p->GetInstanceTypeId () == object->GetInstanceTypeId ());
+  p->SetInstanceSize (sizeof (T));
   return p;
 }
 
@@ -413,6 +429,7 @@ template <typename T>
 Ptr<T> CompleteConstruct (T *p)
 {
   p->SetTypeId (T::GetTypeId ());
+  p->SetInstanceSize (sizeof (T));
   p->Object::Construct (AttributeConstructionList ());
   return Ptr<T> (p, false);
 }
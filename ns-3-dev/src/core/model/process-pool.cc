@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "process-pool.h"
+#include "fatal-error.h"
+#include "assert.h"
+#include "log.h"
+#include <iostream>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::ProcessPool implementation.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("ProcessPool");
+
+namespace ns3 {
+
+ProcessPool::ProcessPool (uint32_t parallel)
+  : m_parallel (parallel),
+    m_nFailed (0)
+{
+  NS_LOG_FUNCTION (this << parallel);
+  NS_ASSERT (parallel > 0);
+}
+
+ProcessPool::~ProcessPool ()
+{
+  NS_LOG_FUNCTION (this);
+  Wait ();
+}
+
+pid_t
+ProcessPool::Fork (void)
+{
+  NS_LOG_FUNCTION (this);
+  while (m_running.size () >= m_parallel)
+    {
+      WaitOne ();
+    }
+
+  // the buffered output would otherwise be written by every process
+  std::cout.flush ();
+  std::cerr.flush ();
+  std::fflush (0);
+
+  int fds[2];
+  if (::pipe (fds) < 0)
+    {
+      NS_FATAL_ERROR ("ProcessPool::Fork(): pipe() failed: " << std::strerror (errno));
+    }
+  // the programs the workers may execute must not hold the pipe
+  ::fcntl (fds[0], F_SETFD, FD_CLOEXEC);
+  ::fcntl (fds[1], F_SETFD, FD_CLOEXEC);
+
+  pid_t pid = ::fork ();
+  if (pid < 0)
+    {
+      NS_FATAL_ERROR ("ProcessPool::Fork(): fork() failed: " << std::strerror (errno));
+    }
+  if (pid == 0)
+    {
+      // The write end stays open until the worker exits.
+      ::close (fds[0]);
+      for (std::vector<struct Worker>::const_iterator i = m_running.begin (); i != m_running.end (); ++i)
+        {
+          ::close (i->fd);
+        }
+      m_running.clear ();
+      return 0;
+    }
+  ::close (fds[1]);
+  struct Worker worker;
+  worker.pid = pid;
+  worker.fd = fds[0];
+  m_running.push_back (worker);
+  return pid;
+}
+
+void
+ProcessPool::Wait (void)
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_running.empty ())
+    {
+      WaitOne ();
+    }
+}
+
+uint32_t
+ProcessPool::GetNFailed (void) const
+{
+  return m_nFailed;
+}
+
+void
+ProcessPool::WaitOne (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<struct pollfd> fds (m_running.size ());
+  for (uint32_t i = 0; i < m_running.size (); i++)
+    {
+      fds[i].fd = m_running[i].fd;
+      fds[i].events = POLLIN;
+      fds[i].revents = 0;
+    }
+  while (::poll (&fds[0], fds.size (), -1) < 0)
+    {
+      if (errno != EINTR)
+        {
+          NS_FATAL_ERROR ("ProcessPool::Wait(): poll() failed: " << std::strerror (errno));
+        }
+    }
+
+  for (uint32_t i = 0; i < fds.size (); i++)
+    {
+      if (fds[i].revents == 0)
+        {
+          continue;
+        }
+      char byte;
+      if (::read (fds[i].fd, &byte, 1) != 0)
+        {
+          // not the end of file yet
+          continue;
+        }
+      pid_t pid = m_running[i].pid;
+      int status;
+      while (::waitpid (pid, &status, 0) < 0)
+        {
+          if (errno != EINTR)
+            {
+              NS_FATAL_ERROR ("ProcessPool::Wait(): waitpid() failed: " << std::strerror (errno));
+            }
+        }
+      if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+        {
+          NS_LOG_WARN ("Process " << pid << " failed with status " << status);
+          m_nFailed++;
+        }
+      ::close (fds[i].fd);
+      m_running.erase (m_running.begin () + i);
+      return;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PROCESS_POOL_H
+#define PROCESS_POOL_H
+
+#include <stdint.h>
+#include <vector>
+#include <sys/types.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::ProcessPool declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Fork worker processes, a bounded number of them at a time
+ *
+ * Fork first flushes the buffered output, which every process would
+ * otherwise write, and waits for a worker to exit if the maximum number
+ * of workers already run. Wait waits for all the workers to exit.
+ *
+ * Only the workers forked by the pool are waited for: the other children
+ * of the process, such as the tap device creators, are left to their
+ * owners. Each worker keeps the write end of a pipe open until it exits,
+ * and the pool waits for a worker once the read end of its pipe reports
+ * the end of file.
+ */
+class ProcessPool
+{
+public:
+  /**
+   * \param parallel the maximum number of workers running at the same time
+   */
+  ProcessPool (uint32_t parallel);
+  ~ProcessPool ();
+
+  /**
+   * Fork a worker process.
+   *
+   * \return zero in the worker, the process id of the worker in the
+   *         parent process
+   */
+  pid_t Fork (void);
+
+  /**
+   * Wait for all the workers to exit.
+   */
+  void Wait (void);
+
+  /**
+   * \return the number of workers which did not exit with a zero status
+   */
+  uint32_t GetNFailed (void) const;
+
+private:
+  /// A worker process running
+  struct Worker
+  {
+    pid_t pid;  //!< process id of the worker
+    int fd;     //!< read end of the pipe held by the worker
+  };
+
+  /**
+   * Wait for one of the workers to exit.
+   */
+  void WaitOne (void);
+
+  uint32_t m_parallel;              //!< Maximum number of workers running
+  uint32_t m_nFailed;               //!< Number of workers which failed
+  std::vector<struct Worker> m_running;  //!< Workers running
+};
+
+} // namespace ns3
+
+#endif /* PROCESS_POOL_H */
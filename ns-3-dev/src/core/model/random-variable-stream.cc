@@ -33,8 +33,10 @@
 #include "log.h"
 #include "rng-stream.h"
 #include "rng-seed-manager.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <set>
 
 NS_LOG_COMPONENT_DEFINE ("RandomVariableStream");
 
@@ -64,17 +66,53 @@ RandomVariableStream::GetTypeId (void)
   return tid;
 }
 
+/**
+ * \return the random variables which exist, for ResetAllStreams
+ */
+static std::set<RandomVariableStream *> &
+GetRandomVariables (void)
+{
+  // never deleted, since random variables held by static objects may
+  // be destroyed after it at exit
+  static std::set<RandomVariableStream *> *variables = new std::set<RandomVariableStream *> ();
+  return *variables;
+}
+
 RandomVariableStream::RandomVariableStream()
-  : m_rng (0)
+  : m_rng (0),
+    m_rngStream (0)
 {
   NS_LOG_FUNCTION (this);
+  GetRandomVariables ().insert (this);
 }
 RandomVariableStream::~RandomVariableStream()
 {
   NS_LOG_FUNCTION (this);
+  GetRandomVariables ().erase (this);
   delete m_rng;
 }
 
+void
+RandomVariableStream::ResetAllStreams (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  std::set<RandomVariableStream *> &variables = GetRandomVariables ();
+  for (std::set<RandomVariableStream *>::iterator i = variables.begin (); i != variables.end (); ++i)
+    {
+      RandomVariableStream *variable = *i;
+      if (variable->m_rng == 0)
+        {
+          continue;
+        }
+      delete variable->m_rng;
+      variable->m_rng = new RngStream (RngSeedManager::GetSeed (),
+                                       variable->m_rngStream,
+                                       RngSeedManager::GetRun (),
+                                       RngSeedManager::GetGenerator ());
+      variable->ResetCachedValues ();
+    }
+}
+
 void
 RandomVariableStream::SetAntithetic(bool isAntithetic)
 {
@@ -100,9 +138,11 @@ RandomVariableStream::SetStream (int64_t stream)
       // number assignment.
       uint64_t nextStream = RngSeedManager::GetNextStreamIndex ();
       NS_ASSERT(nextStream <= ((1ULL)<<63));
+      m_rngStream = nextStream;
       m_rng = new RngStream (RngSeedManager::GetSeed (),
                              nextStream,
-                             RngSeedManager::GetRun ());
+                             RngSeedManager::GetRun (),
+                             RngSeedManager::GetGenerator ());
     }
   else
     {
@@ -110,9 +150,11 @@ RandomVariableStream::SetStream (int64_t stream)
       // number assignment.
       uint64_t base = ((1ULL)<<63);
       uint64_t target = base + stream;
+      m_rngStream = target;
       m_rng = new RngStream (RngSeedManager::GetSeed (),
                              target,
-                             RngSeedManager::GetRun ());
+                             RngSeedManager::GetRun (),
+                             RngSeedManager::GetGenerator ());
     }
   m_stream = stream;
 }
@@ -123,6 +165,16 @@ RandomVariableStream::GetStream(void) const
   return m_stream;
 }
 
+void
+RandomVariableStream::GetValues (double *values, uint32_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      values[i] = GetValue ();
+    }
+}
+
 RngStream *
 RandomVariableStream::Peek(void) const
 {
@@ -130,6 +182,12 @@ RandomVariableStream::Peek(void) const
   return m_rng;
 }
 
+void
+RandomVariableStream::ResetCachedValues (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(UniformRandomVariable);
 
 TypeId 
@@ -199,6 +257,25 @@ UniformRandomVariable::GetInteger (void)
   NS_LOG_FUNCTION (this);
   return (uint32_t)GetValue (m_min, m_max + 1);
 }
+void
+UniformRandomVariable::GetValues (double *values, uint32_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  Peek ()->RandU01 (values, n);
+  double min = m_min;
+  double max = m_max;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      values[i] = min + values[i] * (max - min);
+    }
+  if (IsAntithetic ())
+    {
+      for (uint32_t i = 0; i < n; ++i)
+        {
+          values[i] = min + (max - values[i]);
+        }
+    }
+}
 
 NS_OBJECT_ENSURE_REGISTERED(ConstantRandomVariable);
 
@@ -433,6 +510,31 @@ ExponentialRandomVariable::GetInteger (void)
   NS_LOG_FUNCTION (this);
   return (uint32_t)GetValue (m_mean, m_bound);
 }
+void
+ExponentialRandomVariable::GetValues (double *values, uint32_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  uint32_t done = 0;
+  while (done < n)
+    {
+      // Each uniform number gives at most one value: draw as many as
+      // values are missing, and pack the accepted values in place, so
+      // that no uniform number is drawn past the last value returned.
+      uint32_t count = n - done;
+      Peek ()->RandU01 (&values[done], count);
+      uint32_t end = done + count;
+      bool antithetic = IsAntithetic ();
+      for (uint32_t i = done; i < end; ++i)
+        {
+          double v = antithetic ? (1 - values[i]) : values[i];
+          double r = -m_mean * std::log (v);
+          if (m_bound == 0 || r <= m_bound)
+            {
+              values[done++] = r;
+            }
+        }
+    }
+}
 
 NS_OBJECT_ENSURE_REGISTERED(ParetoRandomVariable);
 
@@ -656,6 +758,13 @@ NormalRandomVariable::NormalRandomVariable ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+NormalRandomVariable::ResetCachedValues (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_nextValid = false;
+}
+
 double 
 NormalRandomVariable::GetMean (void) const
 {
@@ -740,6 +849,59 @@ NormalRandomVariable::GetInteger (void)
   NS_LOG_FUNCTION (this);
   return (uint32_t)GetValue (m_mean, m_variance, m_bound);
 }
+void
+NormalRandomVariable::GetValues (double *values, uint32_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  const uint32_t maxPairs = 64;
+  double u[2 * maxPairs];
+  double stddev = std::sqrt (m_variance);
+  bool antithetic = IsAntithetic ();
+  uint32_t done = 0;
+  if (m_nextValid && n > 0)
+    {
+      m_nextValid = false;
+      values[done++] = m_next;
+    }
+  while (done < n)
+    {
+      // Each pair of uniform numbers gives at most two values: draw
+      // no more pairs than needed to complete the array, so that the
+      // stream is consumed as by GetValue ().
+      uint32_t pairs = std::min ((n - done + 1) / 2, maxPairs);
+      Peek ()->RandU01 (u, 2 * pairs);
+      for (uint32_t i = 0; i < 2 * pairs; i += 2)
+        {
+          double u1 = antithetic ? (1 - u[i]) : u[i];
+          double u2 = antithetic ? (1 - u[i + 1]) : u[i + 1];
+          double v1 = 2 * u1 - 1;
+          double v2 = 2 * u2 - 1;
+          double w = v1 * v1 + v2 * v2;
+          if (w <= 1.0)
+            {
+              double y = std::sqrt ((-2 * std::log (w)) / w);
+              double x1 = m_mean + v1 * y * stddev;
+              double x2 = m_mean + v2 * y * stddev;
+              if (std::fabs (x1 - m_mean) <= m_bound)
+                {
+                  values[done++] = x1;
+                }
+              if (std::fabs (x2 - m_mean) <= m_bound)
+                {
+                  if (done < n)
+                    {
+                      values[done++] = x2;
+                    }
+                  else
+                    {
+                      m_next = x2;
+                      m_nextValid = true;
+                    }
+                }
+            }
+        }
+    }
+}
 
 NS_OBJECT_ENSURE_REGISTERED(LogNormalRandomVariable);
 
@@ -888,6 +1050,13 @@ GammaRandomVariable::GammaRandomVariable ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+GammaRandomVariable::ResetCachedValues (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_nextValid = false;
+}
+
 double 
 GammaRandomVariable::GetAlpha (void) const
 {
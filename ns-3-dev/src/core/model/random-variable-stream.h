@@ -103,6 +103,19 @@ public:
    */
   int64_t GetStream(void) const;
 
+  /**
+   * \brief Restart the RNG streams of all the random variables.
+   *
+   * The RNG stream of each random variable is created again, with the
+   * same stream number but the current seed and run number, and the
+   * values which the random variable cached from its previous stream are
+   * dropped (see ResetCachedValues), as if the random variable was
+   * created now. This lets a process which changed
+   * the run number, such as a worker of a parameter sweep, draw the
+   * values of the new run from the random variables already created.
+   */
+  static void ResetAllStreams (void);
+
   /**
    * \brief Specifies whether antithetic values should be generated.
    * \param isAntithetic Set equal to true if antithetic values should
@@ -129,12 +142,32 @@ public:
    */
   virtual uint32_t GetInteger (void) = 0;
 
+  /**
+   * \brief Fills an array with random doubles from the underlying distribution
+   * \param values the array to fill
+   * \param n the number of values
+   *
+   * This is equivalent to n calls to GetValue (), and consumes the RNG
+   * stream in the same way.  Distributions with a simple transform
+   * override it to draw the uniform numbers in bulk.
+   */
+  virtual void GetValues (double *values, uint32_t n);
+
 protected:
   /**
    * \brief Returns a pointer to the underlying RNG stream.
    */
   RngStream *Peek(void) const;
 
+  /**
+   * \brief Drops the values drawn in advance from the RNG stream.
+   *
+   * Called by ResetAllStreams after the RNG stream was created again.
+   * Distributions which keep values for the next calls to GetValue
+   * override it to forget them.
+   */
+  virtual void ResetCachedValues (void);
+
 private:
   // you can't copy these objects.
   // Theoretically, it is possible to give them good copy semantics
@@ -150,6 +183,9 @@ private:
 
   /// The stream number for this RNG stream.
   int64_t m_stream;
+
+  /// The number of the underlying RNG stream, automatic or not.
+  uint64_t m_rngStream;
 };
 
 /**
@@ -286,6 +322,17 @@ public:
    * upper bound.
    */
   virtual uint32_t GetInteger (void);
+
+  /**
+   * \brief Fills an array with random values from a uniform distribution with the current lower and upper bounds.
+   * \param values the array to fill
+   * \param n the number of values
+   *
+   * The uniform numbers are drawn in bulk from the RNG stream, and
+   * transformed in a tight loop.  The values are the same as those of
+   * n calls to GetValue ().
+   */
+  virtual void GetValues (double *values, uint32_t n);
 private:
   /// The lower bound on values that can be returned by this RNG stream.
   double m_min;
@@ -595,6 +642,17 @@ public:
    */
   virtual uint32_t GetInteger (void);
 
+  /**
+   * \brief Fills an array with random values from an exponential distribution with the current mean and upper bound.
+   * \param values the array to fill
+   * \param n the number of values
+   *
+   * The uniform numbers are drawn in bulk from the RNG stream, and
+   * transformed in a tight loop.  The values are the same as those of
+   * n calls to GetValue ().
+   */
+  virtual void GetValues (double *values, uint32_t n);
+
 private:
   /// The mean value of the random variables returned by this RNG stream.
   double m_mean;
@@ -1233,6 +1291,23 @@ public:
    */
   virtual uint32_t GetInteger (void);
 
+  /**
+   * \brief Fills an array with random values from a normal distribution with the current mean, variance, and bound.
+   * \param values the array to fill
+   * \param n the number of values
+   *
+   * The uniform numbers are drawn in bulk from the RNG stream, and
+   * transformed in a tight loop.  The values are the same as those of
+   * n calls to GetValue ().
+   */
+  virtual void GetValues (double *values, uint32_t n);
+
+protected:
+  /**
+   * \brief Forgets the second value of the last pair drawn.
+   */
+  virtual void ResetCachedValues (void);
+
 private:
   /// The mean value for the normal distribution returned by this RNG stream.
   double m_mean;
@@ -1580,6 +1655,12 @@ public:
    */
   virtual uint32_t GetInteger (void);
 
+protected:
+  /**
+   * \brief Forgets the second normal value of the last pair drawn.
+   */
+  virtual void ResetCachedValues (void);
+
 private:
   /**
    * \brief Returns a random double from a normal distribution with the specified mean, variance, and bound.
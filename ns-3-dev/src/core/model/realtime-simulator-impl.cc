@@ -34,6 +34,7 @@
 
 
 #include <cmath>
+#include <algorithm>
 
 // Note:  Logging in this file is largely avoided due to the
 // number of calls that are made to these functions and the possibility
@@ -82,7 +83,9 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   m_currentUid = 0;
   m_currentTs = 0;
   m_currentContext = 0xffffffff;
+  m_eventCount = 0;
   m_unscheduledEvents = 0;
+  m_injected = 0;
 
   m_main = SystemThread::Self();
 
@@ -100,6 +103,7 @@ void
 RealtimeSimulatorImpl::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
+  ProcessInjectedEvents ();
   while (!m_events->IsEmpty ())
     {
       Scheduler::Event next = m_events->RemoveNext ();
@@ -214,6 +218,16 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
         NS_ASSERT_MSG (m_synchronizer->Realtime (), 
                        "RealtimeSimulatorImpl::ProcessOneEvent (): Synchronizer reports not Realtime ()");
 
+        //
+        // Reset the synchronizer so that any future event will cause it to
+        // interrupt, then pick up the events injected by other threads.  The
+        // order matters: an event injected after the stack has been taken
+        // signals the synchronizer after this reset, and interrupts the wait
+        // below.
+        //
+        m_synchronizer->SetCondition (false);
+        ProcessInjectedEvents ();
+
         //
         // tsNow is set to the normalized current real time.  When the simulation was
         // started, the current real time was effectively set to zero; so tsNow is
@@ -242,14 +256,6 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
             tsDelay = tsNext - tsNow;
           }
 
-        //
-        // We've figured out how long we need to delay in order to pace the 
-        // simulation time with the real time.  We're going to sleep, but need
-        // to work with the synchronizer to make sure we're awakened if something 
-        // external happens (like a packet is received).  This next line resets
-        // the synchronizer so that any future event will cause it to interrupt.
-        //
-        m_synchronizer->SetCondition (false);
       }
 
       //
@@ -339,9 +345,10 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
     // executing.  From the rest of the simulation's point of view, simulation time
     // is frozen until the next event is executed.
     //
-    m_currentTs = next.key.m_ts;
+    __atomic_store_n (&m_currentTs, next.key.m_ts, __ATOMIC_RELEASE);
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
+    m_eventCount++;
 
     // 
     // We're about to run the event and we've done our best to synchronize this
@@ -392,7 +399,7 @@ RealtimeSimulatorImpl::IsFinished (void) const
   bool rc;
   {
     CriticalSection cs (m_mutex);
-    rc = m_events->IsEmpty () || m_stop;
+    rc = (m_events->IsEmpty () && m_injected == 0) || m_stop;
   }
 
   return rc;
@@ -422,8 +429,9 @@ RealtimeSimulatorImpl::Run (void)
   m_main = SystemThread::Self();
 
   m_stop = false;
-  m_running = true;
   m_synchronizer->SetOrigin (m_currentTs);
+  // The other threads read the realtime clock once the origin is set
+  __atomic_store_n (&m_running, true, __ATOMIC_RELEASE);
 
   // Sleep until signalled
   uint64_t tsNow;
@@ -435,6 +443,7 @@ RealtimeSimulatorImpl::Run (void)
       {
         CriticalSection cs (m_mutex);
 
+        ProcessInjectedEvents ();
         if (!m_events->IsEmpty ())
           {
             process = true;
@@ -469,13 +478,13 @@ RealtimeSimulatorImpl::Run (void)
                    "RealtimeSimulatorImpl::Run(): Empty queue and unprocessed events");
   }
 
-  m_running = false;
+  __atomic_store_n (&m_running, false, __ATOMIC_RELEASE);
 }
 
 bool
 RealtimeSimulatorImpl::Running (void) const
 {
-  return m_running;
+  return __atomic_load_n (&m_running, __ATOMIC_ACQUIRE);
 }
 
 bool
@@ -536,23 +545,15 @@ RealtimeSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time,
 {
   NS_LOG_FUNCTION (this << context << time << impl);
 
+  if (!SystemThread::Equals (m_main))
+    {
+      Inject (GetInjectionTs () + time.GetTimeStep (), context, impl);
+      return;
+    }
+
   {
     CriticalSection cs (m_mutex);
-    uint64_t ts;
-
-    if (SystemThread::Equals (m_main))
-      {
-        ts = m_currentTs + time.GetTimeStep ();
-      }
-    else
-      {
-        //
-        // If the simulator is running, we're pacing and have a meaningful 
-        // realtime clock.  If we're not, then m_currentTs is where we stopped.
-        // 
-        ts = m_running ? m_synchronizer->GetCurrentRealtime () : m_currentTs;
-        ts += time.GetTimeStep ();
-      }
+    uint64_t ts = m_currentTs + time.GetTimeStep ();
 
     NS_ASSERT_MSG (ts >= m_currentTs, "RealtimeSimulatorImpl::ScheduleRealtime(): schedule for time < m_currentTs");
     Scheduler::Event ev;
@@ -588,6 +589,89 @@ RealtimeSimulatorImpl::ScheduleNow (EventImpl *impl)
   return EventId (impl, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
+void
+RealtimeSimulatorImpl::Inject (uint64_t ts, uint32_t context, EventImpl *impl)
+{
+  InjectedEvent *injected = new InjectedEvent;
+  injected->impl = impl;
+  injected->ts = ts;
+  injected->context = context;
+
+  InjectedEvent *head;
+  do
+    {
+      head = m_injected;
+      injected->next = head;
+    }
+  while (__sync_val_compare_and_swap (&m_injected, head, injected) != head);
+
+  //
+  // Only the thread which finds the stack empty needs to wake up the
+  // simulation thread: the events pushed after it are taken along with its
+  // own, and the first event pushed after the stack is taken finds it empty
+  // again.
+  //
+  if (head == 0)
+    {
+      m_synchronizer->Signal ();
+    }
+}
+
+uint64_t
+RealtimeSimulatorImpl::GetInjectionTs (void) const
+{
+  //
+  // If the simulator is running, we're pacing and have a meaningful 
+  // realtime clock.  If we're not, then m_currentTs is where we stopped.
+  // 
+  if (__atomic_load_n (&m_running, __ATOMIC_ACQUIRE))
+    {
+      return m_synchronizer->GetCurrentRealtime ();
+    }
+  return __atomic_load_n (&m_currentTs, __ATOMIC_ACQUIRE);
+}
+
+void
+RealtimeSimulatorImpl::ProcessInjectedEvents (void)
+{
+  InjectedEvent *injected;
+  do
+    {
+      injected = m_injected;
+    }
+  while (injected != 0 && __sync_val_compare_and_swap (&m_injected, injected, (InjectedEvent *)0) != injected);
+
+  // Restore the injection order, most recent last
+  InjectedEvent *batch = 0;
+  while (injected != 0)
+    {
+      InjectedEvent *next = injected->next;
+      injected->next = batch;
+      batch = injected;
+      injected = next;
+    }
+
+  while (batch != 0)
+    {
+      Scheduler::Event ev;
+      ev.impl = batch->impl;
+      //
+      // The timestamp was read from the realtime clock when the event was
+      // injected; the simulation may have moved past it since then.
+      //
+      ev.key.m_ts = std::max (batch->ts, m_currentTs);
+      ev.key.m_context = batch->context;
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_unscheduledEvents++;
+      m_events->Insert (ev);
+
+      InjectedEvent *next = batch->next;
+      delete batch;
+      batch = next;
+    }
+}
+
 Time
 RealtimeSimulatorImpl::Now (void) const
 {
@@ -602,6 +686,12 @@ RealtimeSimulatorImpl::ScheduleRealtimeWithContext (uint32_t context, Time const
 {
   NS_LOG_FUNCTION (this << context << time << impl);
 
+  if (!SystemThread::Equals (m_main))
+    {
+      Inject (m_synchronizer->GetCurrentRealtime () + time.GetTimeStep (), context, impl);
+      return;
+    }
+
   {
     CriticalSection cs (m_mutex);
 
@@ -629,6 +719,13 @@ void
 RealtimeSimulatorImpl::ScheduleRealtimeNowWithContext (uint32_t context, EventImpl *impl)
 {
   NS_LOG_FUNCTION (this << context << impl);
+
+  if (!SystemThread::Equals (m_main))
+    {
+      Inject (GetInjectionTs (), context, impl);
+      return;
+    }
+
   {
     CriticalSection cs (m_mutex);
 
@@ -813,6 +910,18 @@ RealtimeSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+uint64_t
+RealtimeSimulatorImpl::GetEventCount (void) const
+{
+  return m_eventCount;
+}
+
+uint32_t
+RealtimeSimulatorImpl::GetPendingEventCount (void) const
+{
+  return m_unscheduledEvents;
+}
+
 void 
 RealtimeSimulatorImpl::SetSynchronizationMode (enum SynchronizationMode mode)
 {
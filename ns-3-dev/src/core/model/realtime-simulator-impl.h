@@ -73,6 +73,8 @@ public:
   virtual void SetScheduler (ObjectFactory schedulerFactory);
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+  virtual uint32_t GetPendingEventCount (void) const;
 
   void ScheduleRealtimeWithContext (uint32_t context, Time const &time, EventImpl *event);
   void ScheduleRealtime (Time const &time, EventImpl *event);
@@ -93,9 +95,40 @@ private:
   void ProcessOneEvent (void);
   virtual void DoDispose (void);
 
+  /**
+   * An event scheduled by a thread other than the simulation thread,
+   * waiting to be inserted in m_events.
+   */
+  struct InjectedEvent
+  {
+    EventImpl *impl;
+    uint64_t ts;
+    uint32_t context;
+    InjectedEvent *next;
+  };
+  /**
+   * Push an event on the injection stack, without taking m_mutex.
+   * May be called from any thread.
+   */
+  void Inject (uint64_t ts, uint32_t context, EventImpl *impl);
+  /**
+   * Move all the injected events to m_events, in the order in which they
+   * were injected.  Must be called by the simulation thread, with m_mutex
+   * locked.
+   */
+  void ProcessInjectedEvents (void);
+  /**
+   * The timestamp of the events scheduled now by a thread other than the
+   * simulation thread: the realtime clock if the simulator is running,
+   * the time where it stopped otherwise.  Reads m_running and
+   * m_currentTs atomically, without taking m_mutex.
+   */
+  uint64_t GetInjectionTs (void) const;
+
   typedef std::list<EventId> DestroyEvents;
   DestroyEvents m_destroyEvents;
   bool m_stop;
+  /// Written atomically by the simulation thread, read by any thread
   bool m_running;
 
   // The following variables are protected using the m_mutex
@@ -103,11 +136,21 @@ private:
   int m_unscheduledEvents;
   uint32_t m_uid;
   uint32_t m_currentUid;
+  /// Also written atomically, for GetInjectionTs
   uint64_t m_currentTs;
   uint32_t m_currentContext;
+  /// Number of events executed
+  uint64_t m_eventCount;
 
   mutable SystemMutex m_mutex;
 
+  /**
+   * Lock-free stack of the events scheduled by other threads, most recent
+   * first.  Producers push with a compare-and-swap; the simulation thread
+   * takes the whole stack at once.
+   */
+  InjectedEvent * volatile m_injected;
+
   Ptr<Synchronizer> m_synchronizer;
 
   /**
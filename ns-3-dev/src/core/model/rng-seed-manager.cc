@@ -2,6 +2,7 @@
 #include "global-value.h"
 #include "attribute-helper.h"
 #include "integer.h"
+#include "enum.h"
 #include "config.h"
 #include "log.h"
 
@@ -18,6 +19,11 @@ static ns3::GlobalValue g_rngRun ("RngRun",
                                   "The run number used to modify the global seed",
                                   ns3::IntegerValue (1),
                                   ns3::MakeIntegerChecker<int64_t> ());
+static ns3::GlobalValue g_rngGenerator ("RngGenerator",
+                                        "The generator of all rng streams",
+                                        ns3::EnumValue (RngSeedManager::MRG32K3A),
+                                        ns3::MakeEnumChecker (RngSeedManager::MRG32K3A, "MRG32k3a",
+                                                              RngSeedManager::PHILOX, "Philox"));
 
 
 uint32_t RngSeedManager::GetSeed (void)
@@ -49,6 +55,22 @@ uint64_t RngSeedManager::GetRun ()
   return run;
 }
 
+void
+RngSeedManager::SetGenerator (enum Generator generator)
+{
+  NS_LOG_FUNCTION (generator);
+  Config::SetGlobal ("RngGenerator", EnumValue (generator));
+}
+
+enum RngSeedManager::Generator
+RngSeedManager::GetGenerator (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  EnumValue value;
+  g_rngGenerator.GetValue (value);
+  return static_cast<enum Generator> (value.Get ());
+}
+
 uint64_t RngSeedManager::GetNextStreamIndex (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -8,6 +8,15 @@ namespace ns3 {
 class RngSeedManager
 {
 public:
+  /**
+   * \brief The generators which can back the random variable streams
+   */
+  enum Generator
+  {
+    MRG32K3A, //!< L'Ecuyer's combined multiple-recursive generator (default)
+    PHILOX    //!< Philox4x32-10 counter-based generator
+  };
+
   /**
    * \brief set the seed
    * it will duplicate the seed value 6 times
@@ -60,6 +69,26 @@ public:
    */
   static uint64_t GetRun (void);
 
+  /**
+   * \brief Set the generator of the random variable streams
+   *
+   * \code
+   * RngSeedManager::SetGenerator (RngSeedManager::PHILOX);
+   * Ptr<ExponentialRandomVariable> x = CreateObject<ExponentialRandomVariable> ();
+   * \endcode
+   * The generator is chosen when the stream number of a random variable
+   * stream is set, so this must be called before the random variables
+   * are created. It is also the global value RngGenerator, so that it
+   * can be set with --RngGenerator=Philox on the command line.
+   * \param generator the generator
+   */
+  static void SetGenerator (enum Generator generator);
+  /**
+   * \returns the generator of the random variable streams
+   * @sa SetGenerator
+   */
+  static enum Generator GetGenerator (void);
+
   static uint64_t GetNextStreamIndex(void);
 
 };
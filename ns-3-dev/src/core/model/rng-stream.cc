@@ -46,6 +46,20 @@ const double a23n =       1370589.0;
 const double two17 =      131072.0;
 const double two53 =      9007199254740992.0;
 
+// Philox4x32 multipliers and Weyl sequence increments of the key
+const uint32_t philoxM0 = 0xD2511F53;
+const uint32_t philoxM1 = 0xCD9E8D57;
+const uint32_t philoxW0 = 0x9E3779B9;
+const uint32_t philoxW1 = 0xBB67AE85;
+
+// Builds a double in (0,1) out of the 53 upper bits of two words
+inline double
+PhiloxToU01 (uint32_t hi, uint32_t lo)
+{
+  uint64_t bits = (static_cast<uint64_t> (hi) << 21) | (lo >> 11);
+  return (bits + 0.5) / two53;
+}
+
 const Matrix A1p0 = {
   {       0.0,        1.0,       0.0 },
   {       0.0,        0.0,       1.0 },
@@ -248,6 +262,20 @@ namespace ns3 {
 //
 double RngStream::RandU01 ()
 {
+  if (m_philox)
+    {
+      if (m_nextValid)
+        {
+          m_nextValid = false;
+          return m_next;
+        }
+      double values[2];
+      PhiloxBlock (values);
+      m_next = values[1];
+      m_nextValid = true;
+      return values[0];
+    }
+
   int32_t k;
   double p1, p2, u;
 
@@ -277,8 +305,95 @@ double RngStream::RandU01 ()
   return u;
 }
 
-RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
+void
+RngStream::RandU01 (double *values, uint32_t n)
 {
+  if (!m_philox)
+    {
+      for (uint32_t i = 0; i < n; ++i)
+        {
+          values[i] = RandU01 ();
+        }
+      return;
+    }
+  uint32_t i = 0;
+  if (m_nextValid && n > 0)
+    {
+      m_nextValid = false;
+      values[i++] = m_next;
+    }
+  for (; i + 1 < n; i += 2)
+    {
+      PhiloxBlock (&values[i]);
+    }
+  if (i < n)
+    {
+      values[i] = RandU01 ();
+    }
+}
+
+void
+RngStream::Philox (uint32_t counter[4], const uint32_t key[2])
+{
+  uint32_t k0 = key[0];
+  uint32_t k1 = key[1];
+  uint32_t c0 = counter[0];
+  uint32_t c1 = counter[1];
+  uint32_t c2 = counter[2];
+  uint32_t c3 = counter[3];
+  for (int round = 0; round < 10; ++round)
+    {
+      uint64_t p0 = static_cast<uint64_t> (philoxM0) * c0;
+      uint64_t p1 = static_cast<uint64_t> (philoxM1) * c2;
+      uint32_t hi0 = static_cast<uint32_t> (p0 >> 32);
+      uint32_t hi1 = static_cast<uint32_t> (p1 >> 32);
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = static_cast<uint32_t> (p1);
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = static_cast<uint32_t> (p0);
+      k0 += philoxW0;
+      k1 += philoxW1;
+    }
+  counter[0] = c0;
+  counter[1] = c1;
+  counter[2] = c2;
+  counter[3] = c3;
+}
+
+void
+RngStream::PhiloxBlock (double values[2])
+{
+  uint32_t block[4] = {
+    static_cast<uint32_t> (m_counter),
+    static_cast<uint32_t> (m_counter >> 32),
+    static_cast<uint32_t> (m_stream),
+    static_cast<uint32_t> (m_stream >> 32)
+  };
+  Philox (block, m_key);
+  m_counter++;
+  values[0] = PhiloxToU01 (block[0], block[1]);
+  values[1] = PhiloxToU01 (block[2], block[3]);
+}
+
+RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream,
+                      enum RngSeedManager::Generator generator)
+  : m_philox (generator == RngSeedManager::PHILOX),
+    m_stream (stream),
+    m_counter (0),
+    m_next (0),
+    m_nextValid (false)
+{
+  // The 64-bit substream is folded in the second word of the key
+  m_key[0] = seedNumber;
+  m_key[1] = static_cast<uint32_t> (substream) ^ static_cast<uint32_t> (substream >> 32);
+  if (m_philox)
+    {
+      for (int i = 0; i < 6; ++i)
+        {
+          m_currentState[i] = 0;
+        }
+      return;
+    }
   if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
     {
       NS_FATAL_ERROR ("invalid Seed " << seedNumber);
@@ -292,11 +407,18 @@ RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
 }
 
 RngStream::RngStream(const RngStream& r)
+  : m_philox (r.m_philox),
+    m_stream (r.m_stream),
+    m_counter (r.m_counter),
+    m_next (r.m_next),
+    m_nextValid (r.m_nextValid)
 {
   for (int i = 0; i < 6; ++i)
     {
       m_currentState[i] = r.m_currentState[i];
     }
+  m_key[0] = r.m_key[0];
+  m_key[1] = r.m_key[1];
 }
 
 void 
@@ -21,35 +21,93 @@
 #define RNGSTREAM_H
 #include <string>
 #include <stdint.h>
+#include "rng-seed-manager.h"
 
 namespace ns3 {
 
 /**
  * \ingroup randomvariable 
  *
- * \brief Combined Multiple-Recursive Generator MRG32k3a
+ * \brief Combined Multiple-Recursive Generator MRG32k3a, or
+ * counter-based generator Philox4x32-10
  *
- * This class is the combined multiple-recursive random number
- * generator called MRG32k3a.  The ns3::RandomVariableBase class
+ * By default, this class is the combined multiple-recursive random
+ * number generator called MRG32k3a.  The ns3::RandomVariableBase class
  * holds a static instance of this class.  The details of this
  * class are explained in:
  * http://www.iro.umontreal.ca/~lecuyer/myftp/papers/streams00.pdf
+ *
+ * It can also be the counter-based generator Philox4x32-10, explained in
+ * "Parallel Random Numbers: As Easy as 1, 2, 3" (Salmon et al., SC'11).
+ * Philox has no state other than a counter: the n-th number of a
+ * stream is a function of the seed, the substream (run number), the
+ * stream number and n, so that it can be computed without generating
+ * the numbers which precede it, and it does not depend on the order in
+ * which streams are used.  Each number is made of 53 random bits and
+ * lies in the open interval (0,1).  The key of Philox has room for only
+ * 32 bits of the run number: the two halves of the 64-bit run number
+ * are folded together with an exclusive or, so that runs with the same
+ * folded value, such as 1 and 2^32, give the same numbers.
  */
 class RngStream
 {
 public:
-  RngStream (uint32_t seed, uint64_t stream, uint64_t substream);
+  /**
+   * \param seed the seed, which must be positive for MRG32k3a
+   * \param stream the stream number
+   * \param substream the substream number, usually the run number
+   * \param generator the generator producing the numbers
+   */
+  RngStream (uint32_t seed, uint64_t stream, uint64_t substream,
+             enum RngSeedManager::Generator generator = RngSeedManager::MRG32K3A);
   RngStream (const RngStream&);
   /**
    * Generate the next random number for this stream.
    * Uniformly distributed between 0 and 1.
    */
   double RandU01 (void);
+  /**
+   * Generate the next random numbers for this stream.
+   * Uniformly distributed between 0 and 1.
+   *
+   * \param values the array to fill
+   * \param n the number of values to generate
+   *
+   * This is equivalent to n calls to RandU01 (), but the Philox
+   * generator then produces whole blocks of numbers in a tight loop.
+   */
+  void RandU01 (double *values, uint32_t n);
+
+  /**
+   * \param counter the counter, replaced by the output block
+   * \param key the key
+   *
+   * Apply the ten rounds of Philox4x32 to a counter.
+   */
+  static void Philox (uint32_t counter[4], const uint32_t key[2]);
 
 private:
   void AdvanceNthBy (uint64_t nth, int by, double state[6]);
+  /**
+   * Generate the next two numbers of a Philox stream.
+   * \param values the array of the two numbers
+   */
+  void PhiloxBlock (double values[2]);
 
+  /// True for Philox, false for MRG32k3a
+  bool m_philox;
+  /// State of MRG32k3a
   double m_currentState[6];
+  /// Key of Philox: the seed and the substream
+  uint32_t m_key[2];
+  /// Stream number of Philox
+  uint64_t m_stream;
+  /// Index of the next block of Philox
+  uint64_t m_counter;
+  /// Second number of the current block of Philox
+  double m_next;
+  /// True if m_next has not been returned yet
+  bool m_nextValid;
 };
 
 } // namespace ns3
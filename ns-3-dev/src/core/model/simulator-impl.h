@@ -182,6 +182,16 @@ public:
    * \return the current simulation context
    */
   virtual uint32_t GetContext (void) const = 0;
+  /**
+   * \return the number of events taken from the event list so far,
+   *         cancelled events included
+   */
+  virtual uint64_t GetEventCount (void) const = 0;
+  /**
+   * \return the number of events in the event list, cancelled events
+   *         included, destroy events excluded
+   */
+  virtual uint32_t GetPendingEventCount (void) const = 0;
 };
 
 } // namespace ns3
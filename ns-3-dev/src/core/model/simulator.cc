@@ -28,6 +28,7 @@
 #include "string.h"
 #include "object-factory.h"
 #include "global-value.h"
+#include "memory-monitor.h"
 #include "assert.h"
 #include "log.h"
 
@@ -127,6 +128,10 @@ Simulator::Destroy (void)
     {
       return;
     }
+  if (MemoryMonitor::IsEnabled ())
+    {
+      MemoryMonitor::Print (std::clog);
+    }
   /* Note: we have to call LogSetTimePrinter (0) below because if we do not do
    * this, and restart a simulation after this call to Destroy, (which is 
    * legal), Simulator::GetImpl will trigger again an infinite recursion until
@@ -302,6 +307,18 @@ Simulator::GetContext (void)
   return GetImpl ()->GetContext ();
 }
 
+uint64_t
+Simulator::GetEventCount (void)
+{
+  return GetImpl ()->GetEventCount ();
+}
+
+uint32_t
+Simulator::GetPendingEventCount (void)
+{
+  return GetImpl ()->GetPendingEventCount ();
+}
+
 uint32_t
 Simulator::GetSystemId (void)
 {
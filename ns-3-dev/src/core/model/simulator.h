@@ -749,6 +749,25 @@ public:
    */
   static uint32_t GetContext (void);
 
+  /**
+   * \returns the number of events taken from the event list so far.
+   *
+   * The cancelled events are counted too: they stay in the event list
+   * and are taken from it, without being invoked, when their time comes.
+   */
+  static uint64_t GetEventCount (void);
+
+  /**
+   * \returns the number of events in the event list.
+   *
+   * These are the events scheduled and not taken from the list yet.
+   * The cancelled events are counted until their time comes, while the
+   * events removed with Simulator::Remove and the destroy events are
+   * not. Events scheduled from other threads may be counted only once
+   * the simulation thread has inserted them.
+   */
+  static uint32_t GetPendingEventCount (void);
+
   /**
    * \param time delay until the event expires
    * \param event the event to schedule
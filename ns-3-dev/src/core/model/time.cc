@@ -218,6 +218,15 @@ Time::SetResolution (enum Unit unit, struct Resolution *resolution,
       NS_LOG_DEBUG ("SetResolution factor " << factor << " real factor " << realFactor);
       struct Information *info = &resolution->info[i];
       info->factor = factor;
+      // Fast paths of FromDouble and ToDouble, when the double arithmetic
+      // gives the same results as int64x64_t, which require an exact factor.
+      // The long double implementation of int64x64_t rounds the products
+      // itself, so FromDouble must go through it.
+      const int64_t maxExact = static_cast<int64_t> (1) << 53;
+      bool exactFactor = factor < maxExact;
+      bool exactFrom = exactFactor && (int64x64_t::implementation != int64x64_t::ld_impl);
+      info->fromFactor = static_cast<double> (factor);
+      info->toFactor = static_cast<double> (factor);
       // here we could equivalently check for realFactor == 1.0 but it's better
       // to avoid checking equality of doubles
       if (shift == 0 && quotient == 1)
@@ -226,6 +235,8 @@ Time::SetResolution (enum Unit unit, struct Resolution *resolution,
           info->timeTo = int64x64_t (1);
           info->toMul = true;
           info->fromMul = true;
+          info->fromExact = (int64x64_t::implementation != int64x64_t::ld_impl);
+          info->toExactMax = maxExact;
         }
       else if (realFactor > 1)
         {
@@ -233,6 +244,8 @@ Time::SetResolution (enum Unit unit, struct Resolution *resolution,
           info->timeTo = int64x64_t::Invert (factor);
           info->toMul = false;
           info->fromMul = true;
+          info->fromExact = exactFrom;
+          info->toExactMax = -1;
         }
       else
         {
@@ -241,6 +254,8 @@ Time::SetResolution (enum Unit unit, struct Resolution *resolution,
           info->timeTo = int64x64_t (factor);
           info->toMul = true;
           info->fromMul = false;
+          info->fromExact = false;
+          info->toExactMax = exactFactor ? maxExact / factor : -1;
         }
     }
   resolution->unit = unit;
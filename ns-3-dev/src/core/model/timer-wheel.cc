@@ -0,0 +1,534 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "timer-wheel.h"
+#include "simulator.h"
+#include "global-value.h"
+#include "assert.h"
+#include "log.h"
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE ("TimerWheel");
+
+namespace ns3 {
+
+static GlobalValue g_timerWheelGranularity = GlobalValue ("TimerWheelGranularity",
+                                                          "The granularity of the default TimerWheel used by every Timer "
+                                                          "without an explicit wheel. Zero disables the default wheel.",
+                                                          TimeValue (Seconds (0)),
+                                                          MakeTimeChecker ());
+
+static Ptr<TimerWheel> g_defaultWheel = 0;
+static bool g_defaultWheelChecked = false;
+
+/**
+ * \param word a non-zero word
+ * \returns the index of the lowest bit set in the word
+ */
+static uint32_t
+LowestBit (uint64_t word)
+{
+  uint32_t bit = 0;
+  for (uint32_t width = 32; width > 0; width >>= 1)
+    {
+      if ((word & ((1ULL << width) - 1)) == 0)
+        {
+          word >>= width;
+          bit += width;
+        }
+    }
+  return bit;
+}
+
+TimerWheel::Handle::Handle ()
+  : m_index (TimerWheel::NONE),
+    m_generation (0)
+{
+}
+
+TimerWheel::Handle::Handle (uint32_t index, uint32_t generation)
+  : m_index (index),
+    m_generation (generation)
+{
+}
+
+TimerWheel::TimerWheel (Time granularity)
+  : m_granularity (granularity.GetTimeStep ()),
+    m_current (0),
+    m_nPending (0),
+    m_free (NONE),
+    m_wakeup (),
+    m_wakeupTick (0),
+    m_expiring (false)
+{
+  NS_LOG_FUNCTION (this << granularity);
+  NS_ASSERT_MSG (m_granularity > 0, "The granularity of a TimerWheel must be strictly positive");
+  for (uint32_t i = 0; i < LEVELS * SLOTS; i++)
+    {
+      m_slots[i] = NONE;
+    }
+  for (uint32_t i = 0; i < WORDS; i++)
+    {
+      m_occupied[i] = 0;
+    }
+}
+
+TimerWheel::~TimerWheel ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+Time
+TimerWheel::GetGranularity (void) const
+{
+  return TimeStep (m_granularity);
+}
+
+uint64_t
+TimerWheel::GetTick (const Time &time) const
+{
+  // round up: a timer never expires before its delay
+  return (time.GetTimeStep () + m_granularity - 1) / m_granularity;
+}
+
+uint32_t
+TimerWheel::Allocate (void)
+{
+  if (m_free == NONE)
+    {
+      Entry entry;
+      entry.m_expires = 0;
+      entry.m_event = 0;
+      entry.m_prev = NONE;
+      entry.m_next = NONE;
+      entry.m_slot = NONE;
+      entry.m_generation = 0;
+      entry.m_context = 0;
+      m_entries.push_back (entry);
+      return m_entries.size () - 1;
+    }
+  uint32_t index = m_free;
+  m_free = m_entries[index].m_next;
+  return index;
+}
+
+void
+TimerWheel::Release (uint32_t index)
+{
+  Entry &entry = m_entries[index];
+  entry.m_event = 0;
+  entry.m_generation++;
+  entry.m_slot = NONE;
+  entry.m_prev = NONE;
+  entry.m_next = m_free;
+  m_free = index;
+}
+
+void
+TimerWheel::Link (uint32_t index)
+{
+  Entry &entry = m_entries[index];
+  uint64_t expires = std::max (entry.m_expires, m_current);
+  uint64_t delta = expires - m_current;
+  uint32_t slot;
+  if (delta < (1ULL << SLOT_BITS))
+    {
+      slot = expires & SLOT_MASK;
+    }
+  else if (delta < (1ULL << (2 * SLOT_BITS)))
+    {
+      slot = SLOTS + ((expires >> SLOT_BITS) & SLOT_MASK);
+    }
+  else if (delta < (1ULL << (3 * SLOT_BITS)))
+    {
+      slot = 2 * SLOTS + ((expires >> (2 * SLOT_BITS)) & SLOT_MASK);
+    }
+  else
+    {
+      // Timers beyond the range of the wheel are parked in its last
+      // level and linked again each time they are cascaded down.
+      if (delta >= (1ULL << (4 * SLOT_BITS)))
+        {
+          expires = m_current + (1ULL << (4 * SLOT_BITS)) - 1;
+        }
+      slot = 3 * SLOTS + ((expires >> (3 * SLOT_BITS)) & SLOT_MASK);
+    }
+  entry.m_slot = slot;
+  entry.m_prev = NONE;
+  m_occupied[slot >> 6] |= 1ULL << (slot & 63);
+  entry.m_next = m_slots[slot];
+  if (entry.m_next != NONE)
+    {
+      m_entries[entry.m_next].m_prev = index;
+    }
+  m_slots[slot] = index;
+}
+
+void
+TimerWheel::Unlink (uint32_t index)
+{
+  Entry &entry = m_entries[index];
+  if (entry.m_slot == FIRING)
+    {
+      entry.m_slot = NONE;
+      return;
+    }
+  if (entry.m_prev == NONE)
+    {
+      m_slots[entry.m_slot] = entry.m_next;
+      if (entry.m_next == NONE)
+        {
+          m_occupied[entry.m_slot >> 6] &= ~(1ULL << (entry.m_slot & 63));
+        }
+    }
+  else
+    {
+      m_entries[entry.m_prev].m_next = entry.m_next;
+    }
+  if (entry.m_next != NONE)
+    {
+      m_entries[entry.m_next].m_prev = entry.m_prev;
+    }
+  entry.m_prev = NONE;
+  entry.m_next = NONE;
+  entry.m_slot = NONE;
+}
+
+void
+TimerWheel::Cascade (uint32_t level)
+{
+  uint32_t slot = level * SLOTS + ((m_current >> (level * SLOT_BITS)) & SLOT_MASK);
+  uint32_t index = m_slots[slot];
+  m_slots[slot] = NONE;
+  m_occupied[slot >> 6] &= ~(1ULL << (slot & 63));
+  while (index != NONE)
+    {
+      uint32_t next = m_entries[index].m_next;
+      Link (index);
+      index = next;
+    }
+}
+
+TimerWheel::Handle
+TimerWheel::Schedule (const Time &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay << event);
+  NS_ASSERT_MSG (!delay.IsStrictlyNegative (), "TimerWheel::Schedule(): negative delay");
+  Time now = Simulator::Now ();
+  Catchup ();
+  uint32_t index = Allocate ();
+  Entry &entry = m_entries[index];
+  entry.m_expires = GetTick (now + delay);
+  entry.m_event = event;
+  entry.m_context = Simulator::GetContext ();
+  Link (index);
+  m_nPending++;
+  UpdateWakeup (index);
+  return Handle (index, entry.m_generation);
+}
+
+TimerWheel::Handle
+TimerWheel::Schedule (const Time &delay, void (*f)(void))
+{
+  return Schedule (delay, MakeEvent (f));
+}
+
+bool
+TimerWheel::IsValid (const Handle &handle) const
+{
+  return handle.m_index < m_entries.size ()
+         && m_entries[handle.m_index].m_generation == handle.m_generation
+         && m_entries[handle.m_index].m_event != 0;
+}
+
+void
+TimerWheel::Cancel (const Handle &handle)
+{
+  NS_LOG_FUNCTION (this);
+  if (!IsValid (handle))
+    {
+      return;
+    }
+  EventImpl *event = m_entries[handle.m_index].m_event;
+  Unlink (handle.m_index);
+  Release (handle.m_index);
+  m_nPending--;
+  // The wakeup event is left alone: if it was scheduled for this
+  // timer, it will simply find nothing to expire.
+  event->Unref ();
+}
+
+bool
+TimerWheel::IsRunning (const Handle &handle) const
+{
+  return IsValid (handle);
+}
+
+Time
+TimerWheel::GetDelayLeft (const Handle &handle) const
+{
+  if (!IsValid (handle))
+    {
+      return TimeStep (0);
+    }
+  Time expires = TimeStep (m_entries[handle.m_index].m_expires * m_granularity);
+  return std::max (expires - Simulator::Now (), TimeStep (0));
+}
+
+uint32_t
+TimerWheel::GetNPending (void) const
+{
+  return m_nPending;
+}
+
+void
+TimerWheel::Catchup (void)
+{
+  if (!m_expiring)
+    {
+      // The wakeup event is scheduled at the first tick which needs to be
+      // processed, so that nothing happens in the ticks elapsed since the
+      // last expiration: skip them.
+      m_current = std::max (m_current, static_cast<uint64_t> (Simulator::Now ().GetTimeStep () / m_granularity));
+    }
+}
+
+uint64_t
+TimerWheel::GetProcessTick (uint32_t slot) const
+{
+  uint32_t level = slot / SLOTS;
+  uint64_t index = slot & SLOT_MASK;
+  if (level == 0)
+    {
+      // the tick at which the slot expires
+      return m_current + ((index - m_current) & SLOT_MASK);
+    }
+  // the tick at which the slot is cascaded to the lower levels
+  uint32_t shift = level * SLOT_BITS;
+  uint64_t round = (m_current + (1ULL << shift) - 1) >> shift;
+  round += (index - round) & SLOT_MASK;
+  return round << shift;
+}
+
+uint32_t
+TimerWheel::FindOccupied (uint32_t from, uint32_t to) const
+{
+  uint32_t slot = from;
+  while (slot < to)
+    {
+      uint64_t word = m_occupied[slot >> 6] >> (slot & 63);
+      if (word != 0)
+        {
+          slot += LowestBit (word);
+          return slot < to ? slot : NONE;
+        }
+      slot = (slot | 63) + 1;
+    }
+  return NONE;
+}
+
+uint64_t
+TimerWheel::GetNextTick (void) const
+{
+  // The slots of a level are processed in circular order from the
+  // current position of the level, so the first non-empty slot from
+  // that position is the next one of the level.
+  uint64_t next = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t level = 0; level < LEVELS; level++)
+    {
+      uint32_t shift = level * SLOT_BITS;
+      uint64_t round = (m_current + (1ULL << shift) - 1) >> shift;
+      uint32_t base = level * SLOTS;
+      uint32_t start = base + (round & SLOT_MASK);
+      uint32_t slot = FindOccupied (start, base + SLOTS);
+      if (slot == NONE)
+        {
+          slot = FindOccupied (base, start);
+        }
+      if (slot != NONE)
+        {
+          next = std::min (next, GetProcessTick (slot));
+        }
+    }
+  return next;
+}
+
+void
+TimerWheel::ScheduleWakeup (uint64_t tick)
+{
+  if (m_wakeup.IsRunning ())
+    {
+      if (m_wakeupTick <= tick)
+        {
+          return;
+        }
+      m_wakeup.Cancel ();
+    }
+  Time now = Simulator::Now ();
+  Time wakeup = std::max (TimeStep (tick * m_granularity), now);
+  m_wakeupTick = tick;
+  m_wakeup = Simulator::Schedule (wakeup - now, &TimerWheel::Expire, this);
+}
+
+void
+TimerWheel::UpdateWakeup (uint32_t index)
+{
+  if (m_expiring)
+    {
+      // Expire () updates the wakeup once it is done.
+      return;
+    }
+  ScheduleWakeup (GetProcessTick (m_entries[index].m_slot));
+}
+
+void
+TimerWheel::Expire (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t now = Simulator::Now ().GetTimeStep () / m_granularity;
+  // Nothing needs to be processed in the ticks before the wakeup.
+  m_current = std::max (m_current, now);
+  m_expiring = true;
+  while (m_current <= now)
+    {
+      uint32_t slot = m_current & SLOT_MASK;
+      if (slot == 0)
+        {
+          for (uint32_t level = 1; level < LEVELS; level++)
+            {
+              Cascade (level);
+              if (((m_current >> (level * SLOT_BITS)) & SLOT_MASK) != 0)
+                {
+                  break;
+                }
+            }
+        }
+      uint64_t tick = m_current;
+      m_current++;
+      while (m_slots[slot] != NONE)
+        {
+          uint32_t index = m_slots[slot];
+          Unlink (index);
+          if (m_entries[index].m_expires > tick)
+            {
+              Link (index);
+              continue;
+            }
+          if (m_entries[index].m_context != Simulator::GetContext ())
+            {
+              // expire in the context of the node which owns the timer
+              m_entries[index].m_slot = FIRING;
+              Simulator::ScheduleWithContext (m_entries[index].m_context, TimeStep (0),
+                                              &TimerWheel::Fire, Ptr<TimerWheel> (this),
+                                              index, m_entries[index].m_generation);
+              continue;
+            }
+          EventImpl *event = m_entries[index].m_event;
+          Release (index);
+          m_nPending--;
+          event->Invoke ();
+          event->Unref ();
+        }
+    }
+  m_expiring = false;
+
+  // Wake up at the first expiration in the first level, or at the
+  // first cascade of a non-empty slot of the upper levels.
+  uint64_t next = GetNextTick ();
+  if (next != std::numeric_limits<uint64_t>::max ())
+    {
+      ScheduleWakeup (next);
+    }
+}
+
+void
+TimerWheel::Fire (uint32_t index, uint32_t generation)
+{
+  NS_LOG_FUNCTION (this << index << generation);
+  if (m_entries[index].m_generation != generation || m_entries[index].m_slot != FIRING)
+    {
+      // cancelled, or cleared, since it was passed on
+      return;
+    }
+  EventImpl *event = m_entries[index].m_event;
+  Release (index);
+  m_nPending--;
+  event->Invoke ();
+  event->Unref ();
+}
+
+void
+TimerWheel::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_wakeup.Cancel ();
+  for (uint32_t i = 0; i < LEVELS * SLOTS; i++)
+    {
+      uint32_t index = m_slots[i];
+      m_slots[i] = NONE;
+      while (index != NONE)
+        {
+          uint32_t next = m_entries[index].m_next;
+          m_entries[index].m_event->Unref ();
+          Release (index);
+          index = next;
+        }
+    }
+  for (uint32_t i = 0; i < WORDS; i++)
+    {
+      m_occupied[i] = 0;
+    }
+  for (uint32_t i = 0; i < m_entries.size (); i++)
+    {
+      if (m_entries[i].m_slot == FIRING)
+        {
+          m_entries[i].m_event->Unref ();
+          Release (i);
+        }
+    }
+  m_nPending = 0;
+}
+
+Ptr<TimerWheel>
+TimerWheel::GetDefault (void)
+{
+  if (!g_defaultWheelChecked)
+    {
+      g_defaultWheelChecked = true;
+      TimeValue granularity;
+      g_timerWheelGranularity.GetValue (granularity);
+      if (granularity.Get ().IsStrictlyPositive ())
+        {
+          NS_LOG_LOGIC ("Creating default timer wheel of granularity " << granularity.Get ());
+          g_defaultWheel = Create<TimerWheel> (granularity.Get ());
+        }
+      Simulator::ScheduleDestroy (&TimerWheel::DestroyDefault);
+    }
+  return g_defaultWheel;
+}
+
+void
+TimerWheel::DestroyDefault (void)
+{
+  if (g_defaultWheel != 0)
+    {
+      g_defaultWheel->Clear ();
+      g_defaultWheel = 0;
+    }
+  g_defaultWheelChecked = false;
+}
+
+} // namespace ns3
@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "simple-ref-count.h"
+#include "ptr.h"
+#include "nstime.h"
+#include "event-id.h"
+#include "event-impl.h"
+#include "make-event.h"
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ *
+ * \brief a hierarchical timing wheel for coarse-grained protocol timers
+ *
+ * Protocol timers (retransmission, hello, neighbor hold timers) are
+ * rescheduled or cancelled far more often than they expire. Scheduling
+ * them directly with the Simulator costs one removal and one insertion
+ * in the main scheduler each time. A TimerWheel keeps them instead in
+ * four levels of 256 slots each, indexed by expiration tick, so that
+ * insertion, cancellation and rescheduling are O(1), and the entries
+ * are recycled from a pool rather than allocated.
+ *
+ * Time is divided in ticks of fixed granularity. The wheel schedules a
+ * single Simulator event for the next tick which holds expiring timers,
+ * or at which timers of an upper level must be cascaded, and fires all
+ * the timers of the tick from that event. Timers thus never expire
+ * early, but may expire up to one granularity late: the wheel is meant
+ * for timers whose delay is large compared with the granularity.
+ *
+ * Each timer expires in the context in which it was scheduled. When
+ * the wheel event runs in another context, the timer is passed on to
+ * its own context by a Simulator event of the same time, and remains
+ * pending, and cancellable, until that event runs.
+ *
+ * A Timer can be told to use a TimerWheel with Timer::SetTimerWheel.
+ * Setting the global value TimerWheelGranularity to a non-zero value
+ * makes every Timer which was not given an explicit wheel use a
+ * default wheel of that granularity, destroyed with the Simulator.
+ */
+class TimerWheel : public SimpleRefCount<TimerWheel>
+{
+public:
+  /**
+   * \brief identifies an event scheduled in a TimerWheel
+   *
+   * A default-constructed Handle does not identify any event.
+   */
+  class Handle
+  {
+public:
+    Handle ();
+private:
+    friend class TimerWheel;
+    Handle (uint32_t index, uint32_t generation);
+    uint32_t m_index;
+    uint32_t m_generation;
+  };
+
+  /**
+   * \param granularity the duration of one tick of the wheel
+   */
+  TimerWheel (Time granularity);
+  ~TimerWheel ();
+
+  /**
+   * \returns the duration of one tick of the wheel
+   */
+  Time GetGranularity (void) const;
+
+  /**
+   * \param delay the delay after which the event expires
+   * \param event the event to invoke. The wheel takes ownership
+   *        of the reference held by the caller.
+   * \returns a handle to the scheduled event
+   */
+  Handle Schedule (const Time &delay, EventImpl *event);
+  /**
+   * \param delay the delay after which the event expires
+   * \param mem_ptr member method pointer to invoke
+   * \param obj the object on which to invoke the member method
+   * \returns a handle to the scheduled event
+   */
+  template <typename MEM, typename OBJ>
+  Handle Schedule (const Time &delay, MEM mem_ptr, OBJ obj);
+  /**
+   * \param delay the delay after which the event expires
+   * \param mem_ptr member method pointer to invoke
+   * \param obj the object on which to invoke the member method
+   * \param a1 the first argument to pass to the invoked method
+   * \returns a handle to the scheduled event
+   */
+  template <typename MEM, typename OBJ, typename T1>
+  Handle Schedule (const Time &delay, MEM mem_ptr, OBJ obj, T1 a1);
+  /**
+   * \param delay the delay after which the event expires
+   * \param f the function to invoke
+   * \returns a handle to the scheduled event
+   */
+  Handle Schedule (const Time &delay, void (*f)(void));
+
+  /**
+   * \param handle the event to cancel
+   *
+   * Remove the event from the wheel if it is still pending.
+   * Do nothing otherwise.
+   */
+  void Cancel (const Handle &handle);
+  /**
+   * \param handle the event to check
+   * \returns true if the event has not expired nor been cancelled yet.
+   */
+  bool IsRunning (const Handle &handle) const;
+  /**
+   * \param handle the event to check
+   * \returns the time left until the tick at which the event expires,
+   *          or zero if the event is not pending.
+   */
+  Time GetDelayLeft (const Handle &handle) const;
+  /**
+   * \returns the number of events pending in the wheel
+   */
+  uint32_t GetNPending (void) const;
+  /**
+   * Cancel all the pending events, and the Simulator event of the wheel.
+   */
+  void Clear (void);
+
+  /**
+   * \returns the default wheel used by Timer instances, or zero if
+   *          the global value TimerWheelGranularity is zero.
+   *
+   * The default wheel is created on the first call after the global
+   * value has been set, and released by Simulator::Destroy.
+   */
+  static Ptr<TimerWheel> GetDefault (void);
+
+private:
+  TimerWheel (const TimerWheel &o);
+  TimerWheel &operator = (const TimerWheel &o);
+
+  enum
+  {
+    SLOT_BITS = 8,
+    SLOTS = 1 << SLOT_BITS,
+    SLOT_MASK = SLOTS - 1,
+    LEVELS = 4,
+    WORDS = LEVELS * SLOTS / 64,
+    NONE = 0xffffffff,
+    /// The slot of an entry whose event is passed on to its context
+    FIRING = 0xfffffffe
+  };
+
+  /// A pending event, linked in the list of its slot.
+  struct Entry
+  {
+    uint64_t m_expires;
+    EventImpl *m_event;
+    uint32_t m_prev;
+    uint32_t m_next;
+    uint32_t m_slot;
+    uint32_t m_generation;
+    uint32_t m_context;
+  };
+
+  static void DestroyDefault (void);
+  uint64_t GetTick (const Time &time) const;
+  uint32_t Allocate (void);
+  void Release (uint32_t index);
+  void Link (uint32_t index);
+  void Unlink (uint32_t index);
+  void Cascade (uint32_t level);
+  void Catchup (void);
+  /**
+   * \param slot the index of a slot, all levels included
+   * \returns the next tick at which the slot must be processed
+   */
+  uint64_t GetProcessTick (uint32_t slot) const;
+  /**
+   * \param from the first slot to check
+   * \param to the slot after the last one to check
+   * \returns the first non-empty slot in [from, to), or NONE
+   */
+  uint32_t FindOccupied (uint32_t from, uint32_t to) const;
+  /**
+   * \returns the next tick at which a non-empty slot must be processed,
+   *          or the maximum tick if the wheel is empty.
+   */
+  uint64_t GetNextTick (void) const;
+  void ScheduleWakeup (uint64_t tick);
+  void UpdateWakeup (uint32_t index);
+  void Expire (void);
+  /**
+   * \param index the entry to expire
+   * \param generation the generation of the entry when it was passed on
+   *
+   * Invoke an event passed on to its context, unless it was cancelled.
+   */
+  void Fire (uint32_t index, uint32_t generation);
+  bool IsValid (const Handle &handle) const;
+
+  int64_t m_granularity;
+  /// The next tick to process
+  uint64_t m_current;
+  uint32_t m_nPending;
+  /// Head of the list of each slot, level by level
+  uint32_t m_slots[LEVELS * SLOTS];
+  /// One bit per slot, set if the slot is not empty
+  uint64_t m_occupied[WORDS];
+  std::vector<Entry> m_entries;
+  /// Head of the list of unused entries
+  uint32_t m_free;
+  EventId m_wakeup;
+  uint64_t m_wakeupTick;
+  bool m_expiring;
+};
+
+} // namespace ns3
+
+namespace ns3 {
+
+template <typename MEM, typename OBJ>
+TimerWheel::Handle
+TimerWheel::Schedule (const Time &delay, MEM mem_ptr, OBJ obj)
+{
+  return Schedule (delay, MakeEvent (mem_ptr, obj));
+}
+
+template <typename MEM, typename OBJ, typename T1>
+TimerWheel::Handle
+TimerWheel::Schedule (const Time &delay, MEM mem_ptr, OBJ obj, T1 a1)
+{
+  return Schedule (delay, MakeEvent (mem_ptr, obj, a1));
+}
+
+} // namespace ns3
+
+#endif /* TIMER_WHEEL_H */
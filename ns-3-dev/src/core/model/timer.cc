@@ -49,11 +49,15 @@ Timer::~Timer ()
   NS_LOG_FUNCTION (this);
   if (m_flags & CHECK_ON_DESTROY)
     {
-      if (m_event.IsRunning ())
+      if (IsEventRunning ())
         {
           NS_FATAL_ERROR ("Event is still running while destroying.");
         }
     }
+  else if (m_eventWheel != 0)
+    {
+      m_eventWheel->Cancel (m_wheelEvent);
+    }
   else if (m_flags & CANCEL_ON_DESTROY)
     {
       m_event.Cancel ();
@@ -84,6 +88,10 @@ Timer::GetDelayLeft (void) const
   switch (GetState ())
     {
     case Timer::RUNNING:
+      if (m_eventWheel != 0)
+        {
+          return m_eventWheel->GetDelayLeft (m_wheelEvent);
+        }
       return Simulator::GetDelayLeft (m_event);
       break;
     case Timer::EXPIRED:
@@ -103,25 +111,46 @@ void
 Timer::Cancel (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_eventWheel != 0)
+    {
+      m_eventWheel->Cancel (m_wheelEvent);
+      m_eventWheel = 0;
+      return;
+    }
   Simulator::Cancel (m_event);
 }
 void
 Timer::Remove (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_eventWheel != 0)
+    {
+      m_eventWheel->Cancel (m_wheelEvent);
+      m_eventWheel = 0;
+      return;
+    }
   Simulator::Remove (m_event);
 }
 bool
 Timer::IsExpired (void) const
 {
   NS_LOG_FUNCTION (this);
-  return !IsSuspended () && m_event.IsExpired ();
+  return !IsSuspended () && !IsEventRunning ();
 }
 bool
 Timer::IsRunning (void) const
 {
   NS_LOG_FUNCTION (this);
-  return !IsSuspended () && m_event.IsRunning ();
+  return !IsSuspended () && IsEventRunning ();
+}
+bool
+Timer::IsEventRunning (void) const
+{
+  if (m_eventWheel != 0)
+    {
+      return m_eventWheel->IsRunning (m_wheelEvent);
+    }
+  return m_event.IsRunning ();
 }
 bool
 Timer::IsSuspended (void) const
@@ -160,11 +189,27 @@ Timer::Schedule (Time delay)
 {
   NS_LOG_FUNCTION (this << delay);
   NS_ASSERT (m_impl != 0);
-  if (m_event.IsRunning ())
+  if (IsEventRunning ())
     {
       NS_FATAL_ERROR ("Event is still running while re-scheduling.");
     }
-  m_event = m_impl->Schedule (delay);
+  DoSchedule (delay);
+}
+
+void
+Timer::DoSchedule (const Time &delay)
+{
+  // the default wheel is looked up each time, since it is replaced
+  // after Simulator::Destroy
+  m_eventWheel = (m_flags & TIMER_WHEEL_SET) ? m_wheel : TimerWheel::GetDefault ();
+  if (m_eventWheel != 0)
+    {
+      m_wheelEvent = m_eventWheel->Schedule (delay, &Timer::WheelExpire, this);
+    }
+  else
+    {
+      m_event = m_impl->Schedule (delay);
+    }
 }
 
 void
@@ -172,8 +217,8 @@ Timer::Suspend (void)
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (IsRunning ());
-  m_delayLeft = Simulator::GetDelayLeft (m_event);
-  Simulator::Remove (m_event);
+  m_delayLeft = GetDelayLeft ();
+  Remove ();
   m_flags |= TIMER_SUSPENDED;
 }
 
@@ -182,10 +227,27 @@ Timer::Resume (void)
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (m_flags & TIMER_SUSPENDED);
-  m_event = m_impl->Schedule (m_delayLeft);
+  DoSchedule (m_delayLeft);
   m_flags &= ~TIMER_SUSPENDED;
 }
 
+void
+Timer::WheelExpire (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_eventWheel = 0;
+  m_impl->Invoke ();
+}
+
+void
+Timer::SetTimerWheel (Ptr<TimerWheel> wheel)
+{
+  NS_LOG_FUNCTION (this << wheel);
+  NS_ASSERT_MSG (!IsEventRunning () && !IsSuspended (), "Cannot change the wheel of a running timer");
+  m_wheel = wheel;
+  m_flags |= TIMER_WHEEL_SET;
+}
+
 
 } // namespace ns3
 
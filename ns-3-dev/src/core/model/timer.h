@@ -24,6 +24,7 @@
 #include "nstime.h"
 #include "event-id.h"
 #include "int-to-type.h"
+#include "timer-wheel.h"
 
 namespace ns3 {
 
@@ -41,6 +42,13 @@ class TimerImpl;
  * A timer can also be used to enforce a set of predefined event lifetime
  * management policies. These policies are specified at construction time
  * and cannot be changed after.
+ *
+ * By default, the expiration event of a timer is scheduled with the
+ * Simulator. It can instead be kept in a TimerWheel, either explicitly
+ * with Timer::SetTimerWheel, or for every timer by setting the global
+ * value TimerWheelGranularity (see TimerWheel::GetDefault). The timer
+ * then expires at the end of the wheel tick which contains its
+ * expiration time.
  */
 class Timer
 {
@@ -229,17 +237,50 @@ public:
    */
   void Resume (void);
 
+  /**
+   * \param wheel the timer wheel to use, or zero to schedule the
+   *        timer with the Simulator.
+   *
+   * Use the specified wheel rather than the default one for the
+   * next schedules of this timer.
+   * Calling SetTimerWheel on a running or suspended timer is an error.
+   */
+  void SetTimerWheel (Ptr<TimerWheel> wheel);
+
 private:
   enum
   {
-    TIMER_SUSPENDED = (1 << 7)
+    TIMER_SUSPENDED = (1 << 7),
+    TIMER_WHEEL_SET = (1 << 8)
   };
 
+  /**
+   * \param delay the delay
+   *
+   * Schedule the expiration event in the timer wheel, if any, or in the
+   * Simulator otherwise.
+   */
+  void DoSchedule (const Time &delay);
+  /**
+   * \returns true if the expiration event is pending, regardless of the
+   *          suspended state.
+   */
+  bool IsEventRunning (void) const;
+  /**
+   * Invoke the function of the timer when its wheel event expires.
+   */
+  void WheelExpire (void);
+
   int m_flags;
   Time m_delay;
   EventId m_event;
   TimerImpl *m_impl;
   Time m_delayLeft;
+  /// The wheel given by SetTimerWheel
+  Ptr<TimerWheel> m_wheel;
+  /// The wheel which holds the pending expiration event, if any
+  Ptr<TimerWheel> m_eventWheel;
+  TimerWheel::Handle m_wheelEvent;
 };
 
 } // namespace ns3
@@ -21,11 +21,30 @@
 #ifndef TRACED_CALLBACK_H
 #define TRACED_CALLBACK_H
 
-#include <list>
+#include <vector>
 #include "callback.h"
 
 namespace ns3 {
 
+/**
+ * \ingroup tracing
+ *
+ * The type with which TracedCallback::operator() takes an argument
+ * of type T: a const reference, so that invoking a trace source
+ * with no sinks connected does not copy its arguments.
+ */
+template <typename T>
+struct TracedCallbackArgument
+{
+  typedef T const &Type; //!< Argument type
+};
+/** Reference arguments are passed through as they are. */
+template <typename T>
+struct TracedCallbackArgument<T &>
+{
+  typedef T &Type; //!< Argument type
+};
+
 /**
  * \brief forward calls to a chain of Callback
  * \ingroup tracing
@@ -35,6 +54,11 @@ namespace ns3 {
  * it forwards calls to a chain of ns3::Callback. TracedCallback::Connect adds a ns3::Callback
  * at the end of the chain of callbacks. TracedCallback::Disconnect removes a ns3::Callback from
  * the chain of callbacks.
+ *
+ * The callbacks are kept in a vector, and the arguments of the
+ * trace are passed by reference up to the call of each callback,
+ * so that a trace source with no sinks connected costs no more than
+ * a test of IsEmpty.
  */
 template<typename T1 = empty, typename T2 = empty, 
          typename T3 = empty, typename T4 = empty,
@@ -78,19 +102,28 @@ public:
    * of the TracedCallback::Connect method.
    */
   void Disconnect (const CallbackBase & callback, std::string path);
+  /**
+   * \returns true if no callback is connected to this trace source
+   */
+  bool IsEmpty (void) const;
+  /**
+   * \brief Invoke each callback of the chain, in connection order
+   * @{
+   */
   void operator() (void) const;
-  void operator() (T1 a1) const;
-  void operator() (T1 a1, T2 a2) const;
-  void operator() (T1 a1, T2 a2, T3 a3) const;
-  void operator() (T1 a1, T2 a2, T3 a3, T4 a4) const;
-  void operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5) const;
-  void operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6) const;
-  void operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7) const;
-  void operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8) const;
+  void operator() (typename TracedCallbackArgument<T1>::Type a1) const;
+  void operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2) const;
+  void operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3) const;
+  void operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3, typename TracedCallbackArgument<T4>::Type a4) const;
+  void operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3, typename TracedCallbackArgument<T4>::Type a4, typename TracedCallbackArgument<T5>::Type a5) const;
+  void operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3, typename TracedCallbackArgument<T4>::Type a4, typename TracedCallbackArgument<T5>::Type a5, typename TracedCallbackArgument<T6>::Type a6) const;
+  void operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3, typename TracedCallbackArgument<T4>::Type a4, typename TracedCallbackArgument<T5>::Type a5, typename TracedCallbackArgument<T6>::Type a6, typename TracedCallbackArgument<T7>::Type a7) const;
+  void operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3, typename TracedCallbackArgument<T4>::Type a4, typename TracedCallbackArgument<T5>::Type a5, typename TracedCallbackArgument<T6>::Type a6, typename TracedCallbackArgument<T7>::Type a7, typename TracedCallbackArgument<T8>::Type a8) const;
+  /**@}*/
 
 private:
-  typedef std::list<Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> > CallbackList;
-  CallbackList m_callbackList;
+  typedef std::vector<Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> > CallbackList;
+  CallbackList m_callbackList; //!< the chain of callbacks
 };
 
 } // namespace ns3
@@ -162,6 +195,15 @@ TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::Disconnect (const CallbackBase & callba
   Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> realCb = cb.Bind (path);
   DisconnectWithoutContext (realCb);
 }
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+bool
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::IsEmpty (void) const
+{
+  return m_callbackList.empty ();
+}
 template<typename T1, typename T2, 
          typename T3, typename T4,
          typename T5, typename T6,
@@ -169,10 +211,11 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (void) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  // Iterate by index: a sink may connect another sink to this trace
+  // source, which reallocates the vector.
+  for (typename CallbackList::size_type i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)();
+      m_callbackList[i] ();
     }
 }
 template<typename T1, typename T2, 
@@ -180,12 +223,11 @@ template<typename T1, typename T2,
          typename T5, typename T6,
          typename T7, typename T8>
 void 
-TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1) const
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (typename TracedCallbackArgument<T1>::Type a1) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (typename CallbackList::size_type i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1);
+      m_callbackList[i] (a1);
     }
 }
 template<typename T1, typename T2, 
@@ -193,12 +235,11 @@ template<typename T1, typename T2,
          typename T5, typename T6,
          typename T7, typename T8>
 void 
-TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2) const
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (typename CallbackList::size_type i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2);
+      m_callbackList[i] (a1, a2);
     }
 }
 template<typename T1, typename T2, 
@@ -206,12 +247,11 @@ template<typename T1, typename T2,
          typename T5, typename T6,
          typename T7, typename T8>
 void 
-TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3) const
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (typename CallbackList::size_type i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3);
+      m_callbackList[i] (a1, a2, a3);
     }
 }
 template<typename T1, typename T2, 
@@ -219,12 +259,11 @@ template<typename T1, typename T2,
          typename T5, typename T6,
          typename T7, typename T8>
 void 
-TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4) const
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3, typename TracedCallbackArgument<T4>::Type a4) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (typename CallbackList::size_type i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3, a4);
+      m_callbackList[i] (a1, a2, a3, a4);
     }
 }
 template<typename T1, typename T2, 
@@ -232,12 +271,11 @@ template<typename T1, typename T2,
          typename T5, typename T6,
          typename T7, typename T8>
 void 
-TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5) const
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3, typename TracedCallbackArgument<T4>::Type a4, typename TracedCallbackArgument<T5>::Type a5) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (typename CallbackList::size_type i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3, a4, a5);
+      m_callbackList[i] (a1, a2, a3, a4, a5);
     }
 }
 template<typename T1, typename T2, 
@@ -245,12 +283,11 @@ template<typename T1, typename T2,
          typename T5, typename T6,
          typename T7, typename T8>
 void 
-TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6) const
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3, typename TracedCallbackArgument<T4>::Type a4, typename TracedCallbackArgument<T5>::Type a5, typename TracedCallbackArgument<T6>::Type a6) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (typename CallbackList::size_type i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3, a4, a5, a6);
+      m_callbackList[i] (a1, a2, a3, a4, a5, a6);
     }
 }
 template<typename T1, typename T2, 
@@ -258,12 +295,11 @@ template<typename T1, typename T2,
          typename T5, typename T6,
          typename T7, typename T8>
 void 
-TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7) const
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3, typename TracedCallbackArgument<T4>::Type a4, typename TracedCallbackArgument<T5>::Type a5, typename TracedCallbackArgument<T6>::Type a6, typename TracedCallbackArgument<T7>::Type a7) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (typename CallbackList::size_type i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3, a4, a5, a6, a7);
+      m_callbackList[i] (a1, a2, a3, a4, a5, a6, a7);
     }
 }
 template<typename T1, typename T2, 
@@ -271,12 +307,11 @@ template<typename T1, typename T2,
          typename T5, typename T6,
          typename T7, typename T8>
 void 
-TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8) const
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (typename TracedCallbackArgument<T1>::Type a1, typename TracedCallbackArgument<T2>::Type a2, typename TracedCallbackArgument<T3>::Type a3, typename TracedCallbackArgument<T4>::Type a4, typename TracedCallbackArgument<T5>::Type a5, typename TracedCallbackArgument<T6>::Type a6, typename TracedCallbackArgument<T7>::Type a7, typename TracedCallbackArgument<T8>::Type a8) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  for (typename CallbackList::size_type i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(a1, a2, a3, a4, a5, a6, a7, a8);
+      m_callbackList[i] (a1, a2, a3, a4, a5, a6, a7, a8);
     }
 }
 
@@ -45,6 +45,15 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
  * Information records are stored in a vector.  Name and hash lookup
  * are performed by maps to the vector index.
  *
+ * Each record also indexes its own attributes and trace sources by
+ * the hash of their names, so that checking a name for duplicates
+ * while the types register does not scan all the names of the
+ * inheritance chain.  The lookups by name of TypeId use a second
+ * index per record, covering the whole inheritance chain, which is
+ * only built by the first lookup on the type, and rebuilt when a
+ * type has gained attributes or trace sources since.  Most types
+ * are never looked up by attribute name, and do not pay for it.
+ *
  * \internal
  * <b>Hash Chaining</b>
  *
@@ -74,6 +83,7 @@ public:
   uint16_t AllocateUid (std::string name);
   void SetParent (uint16_t uid, uint16_t parent);
   void SetGroupName (uint16_t uid, std::string groupName);
+  void SetSize (uint16_t uid, std::size_t size);
   void AddConstructor (uint16_t uid, Callback<ObjectBase *> callback);
   void HideFromDocumentation (uint16_t uid);
   uint16_t GetUid (std::string name) const;
@@ -82,6 +92,7 @@ public:
   TypeId::hash_t GetHash (uint16_t uid) const;
   uint16_t GetParent (uint16_t uid) const;
   std::string GetGroupName (uint16_t uid) const;
+  std::size_t GetSize (uint16_t uid) const;
   Callback<ObjectBase *> GetConstructor (uint16_t uid) const;
   bool HasConstructor (uint16_t uid) const;
   uint32_t GetRegisteredN (void) const;
@@ -105,28 +116,77 @@ public:
   uint32_t GetTraceSourceN (uint16_t uid) const;
   struct TypeId::TraceSourceInformation GetTraceSource(uint16_t uid, uint32_t i) const;
   bool MustHideFromDocumentation (uint16_t uid) const;
+  bool LookupAttribute (uint16_t uid, std::string name,
+                        struct TypeId::AttributeInformation *info) const;
+  Ptr<const TraceSourceAccessor> LookupTraceSource (uint16_t uid, std::string name) const;
 
 private:
-  bool HasTraceSource (uint16_t uid, std::string name);
-  bool HasAttribute (uint16_t uid, std::string name);
+  bool HasTraceSource (uint16_t uid, std::string name, TypeId::hash_t hash);
+  bool HasAttribute (uint16_t uid, std::string name, TypeId::hash_t hash);
   static TypeId::hash_t Hasher (const std::string name);
 
+  /// Hash of a name to the index of an attribute or trace source of a type
+  typedef std::multimap<TypeId::hash_t, uint32_t> indexmap_t;
+  /// Hash of a name to the uid of a type and the index of its attribute or trace source
+  typedef std::multimap<TypeId::hash_t, std::pair<uint16_t, uint32_t> > lookupmap_t;
+
+  /**
+   * \param index the index of the items of a type
+   * \param items the attributes or trace sources of the type
+   * \param name the name of the item
+   * \param hash the hash of the name
+   * \param i the index of the item, if found
+   * \return true if the type has an item with this name
+   */
+  template <typename T>
+  static bool FindIndex (const indexmap_t &index, const std::vector<T> &items,
+                         std::string name, TypeId::hash_t hash, uint32_t *i);
+
   struct IidInformation {
     std::string name;
     TypeId::hash_t hash;
     uint16_t parent;
     std::string groupName;
+    std::size_t size;
     bool hasConstructor;
     Callback<ObjectBase *> constructor;
     bool mustHideFromDocumentation;
     std::vector<struct TypeId::AttributeInformation> attributes;
     std::vector<struct TypeId::TraceSourceInformation> traceSources;
+    indexmap_t attributeIndex;
+    indexmap_t traceSourceIndex;
+    // the indexes of the inheritance chain, built on the first lookup
+    lookupmap_t attributeLookup;
+    lookupmap_t traceSourceLookup;
+    uint32_t lookupGeneration;
   };
   typedef std::vector<struct IidInformation>::const_iterator Iterator;
 
   struct IidManager::IidInformation *LookupInformation (uint16_t uid) const;
+  /**
+   * Build the indexes of the inheritance chain of a type, unless they
+   * are up to date.
+   *
+   * \param uid the uid of the type
+   */
+  void MaterializeLookup (uint16_t uid) const;
+  /**
+   * Add the items of a type to the index of the inheritance chain of
+   * one of its subtypes, unless the subtype has items with the same
+   * names.
+   *
+   * \param lookup the index of the subtype
+   * \param uid the uid of the type
+   * \param index the index of the items of the type
+   * \param items the attributes or trace sources of a record
+   */
+  template <typename T>
+  void MergeLookup (lookupmap_t &lookup, uint16_t uid, const indexmap_t &index,
+                    std::vector<T> IidInformation::*items) const;
 
   std::vector<struct IidInformation> m_information;
+  /// Incremented when a type gains a parent, an attribute or a trace source
+  uint32_t m_generation;
 
   typedef std::map<std::string, uint16_t> namemap_t;
   namemap_t m_namemap;
@@ -141,6 +201,7 @@ private:
 };
 
 IidManager::IidManager ()
+  : m_generation (1)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -211,8 +272,10 @@ IidManager::AllocateUid (std::string name)
   information.hash = hash;
   information.parent = 0;
   information.groupName = "";
+  information.size = 0;
   information.hasConstructor = false;
   information.mustHideFromDocumentation = false;
+  information.lookupGeneration = 0;
   m_information.push_back (information);
   uint32_t uid = m_information.size ();
   NS_ASSERT (uid <= 0xffff);
@@ -238,6 +301,7 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  m_generation++;
 }
 void 
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -247,6 +311,13 @@ IidManager::SetGroupName (uint16_t uid, std::string groupName)
   information->groupName = groupName;
 }
 void
+IidManager::SetSize (uint16_t uid, std::size_t size)
+{
+  NS_LOG_FUNCTION (this << uid << size);
+  struct IidInformation *information = LookupInformation (uid);
+  information->size = size;
+}
+void
 IidManager::HideFromDocumentation (uint16_t uid)
 {
   NS_LOG_FUNCTION (this << uid);
@@ -322,6 +393,13 @@ IidManager::GetGroupName (uint16_t uid) const
   struct IidInformation *information = LookupInformation (uid);
   return information->groupName;
 }
+std::size_t
+IidManager::GetSize (uint16_t uid) const
+{
+  NS_LOG_FUNCTION (this << uid);
+  struct IidInformation *information = LookupInformation (uid);
+  return information->size;
+}
 
 Callback<ObjectBase *> 
 IidManager::GetConstructor (uint16_t uid) const
@@ -356,21 +434,129 @@ IidManager::GetRegistered (uint32_t i) const
   return i + 1;
 }
 
+template <typename T>
 bool
-IidManager::HasAttribute (uint16_t uid,
-                          std::string name)
+IidManager::FindIndex (const indexmap_t &index, const std::vector<T> &items,
+                       std::string name, TypeId::hash_t hash, uint32_t *i)
+{
+  std::pair<indexmap_t::const_iterator, indexmap_t::const_iterator> range = index.equal_range (hash);
+  for (indexmap_t::const_iterator it = range.first; it != range.second; ++it)
+    {
+      if (items[it->second].name == name)
+        {
+          *i = it->second;
+          return true;
+        }
+    }
+  return false;
+}
+
+template <typename T>
+void
+IidManager::MergeLookup (lookupmap_t &lookup, uint16_t uid, const indexmap_t &index,
+                         std::vector<T> IidInformation::*items) const
+{
+  const std::vector<T> &added = LookupInformation (uid)->*items;
+  for (indexmap_t::const_iterator it = index.begin (); it != index.end (); ++it)
+    {
+      bool hidden = false;
+      std::pair<lookupmap_t::iterator, lookupmap_t::iterator> range = lookup.equal_range (it->first);
+      for (lookupmap_t::iterator j = range.first; j != range.second && !hidden; ++j)
+        {
+          const std::vector<T> &existing = LookupInformation (j->second.first)->*items;
+          hidden = existing[j->second.second].name == added[it->second].name;
+        }
+      if (!hidden)
+        {
+          lookup.insert (std::make_pair (it->first, std::make_pair (uid, it->second)));
+        }
+    }
+}
+
+void
+IidManager::MaterializeLookup (uint16_t uid) const
+{
+  NS_LOG_FUNCTION (this << uid);
+  struct IidInformation *information = LookupInformation (uid);
+  if (information->lookupGeneration == m_generation)
+    {
+      return;
+    }
+  information->attributeLookup.clear ();
+  information->traceSourceLookup.clear ();
+  uint16_t current = uid;
+  while (true)
+    {
+      // walk up from the type itself, so that its names hide the
+      // same names in its parents
+      struct IidInformation *other = LookupInformation (current);
+      MergeLookup (information->attributeLookup, current, other->attributeIndex,
+                   &IidInformation::attributes);
+      MergeLookup (information->traceSourceLookup, current, other->traceSourceIndex,
+                   &IidInformation::traceSources);
+      if (other->parent == current || other->parent == 0)
+        {
+          // top of inheritance tree, or a type without parent
+          break;
+        }
+      current = other->parent;
+    }
+  information->lookupGeneration = m_generation;
+}
+
+bool
+IidManager::LookupAttribute (uint16_t uid, std::string name,
+                             struct TypeId::AttributeInformation *info) const
+{
+  NS_LOG_FUNCTION (this << uid << name << info);
+  MaterializeLookup (uid);
+  struct IidInformation *information = LookupInformation (uid);
+  std::pair<lookupmap_t::const_iterator, lookupmap_t::const_iterator> range =
+    information->attributeLookup.equal_range (Hasher (name));
+  for (lookupmap_t::const_iterator it = range.first; it != range.second; ++it)
+    {
+      struct IidInformation *owner = LookupInformation (it->second.first);
+      if (owner->attributes[it->second.second].name == name)
+        {
+          *info = owner->attributes[it->second.second];
+          return true;
+        }
+    }
+  return false;
+}
+
+Ptr<const TraceSourceAccessor>
+IidManager::LookupTraceSource (uint16_t uid, std::string name) const
 {
   NS_LOG_FUNCTION (this << uid << name);
+  MaterializeLookup (uid);
+  struct IidInformation *information = LookupInformation (uid);
+  std::pair<lookupmap_t::const_iterator, lookupmap_t::const_iterator> range =
+    information->traceSourceLookup.equal_range (Hasher (name));
+  for (lookupmap_t::const_iterator it = range.first; it != range.second; ++it)
+    {
+      struct IidInformation *owner = LookupInformation (it->second.first);
+      if (owner->traceSources[it->second.second].name == name)
+        {
+          return owner->traceSources[it->second.second].accessor;
+        }
+    }
+  return 0;
+}
+
+bool
+IidManager::HasAttribute (uint16_t uid,
+                          std::string name,
+                          TypeId::hash_t hash)
+{
+  NS_LOG_FUNCTION (this << uid << name << hash);
   struct IidInformation *information  = LookupInformation (uid);
   while (true)
     {
-      for (std::vector<struct TypeId::AttributeInformation>::const_iterator i = information->attributes.begin ();
-           i != information->attributes.end (); ++i)
+      uint32_t i;
+      if (FindIndex (information->attributeIndex, information->attributes, name, hash, &i))
         {
-          if (i->name == name)
-            {
-              return true;
-            }
+          return true;
         }
       struct IidInformation *parent = LookupInformation (information->parent);
       if (parent == information)
@@ -395,7 +581,8 @@ IidManager::AddAttribute (uint16_t uid,
 {
   NS_LOG_FUNCTION (this << uid << name << help << flags << initialValue << accessor << checker);
   struct IidInformation *information = LookupInformation (uid);
-  if (HasAttribute (uid, name))
+  TypeId::hash_t hash = Hasher (name);
+  if (HasAttribute (uid, name, hash))
     {
       NS_FATAL_ERROR ("Attribute \"" << name << "\" already registered on tid=\"" << 
                       information->name << "\"");
@@ -409,6 +596,8 @@ IidManager::AddAttribute (uint16_t uid,
   info.accessor = accessor;
   info.checker = checker;
   information->attributes.push_back (info);
+  information->attributeIndex.insert (std::make_pair (hash, information->attributes.size () - 1));
+  m_generation++;
 }
 void 
 IidManager::SetAttributeInitialValue(uint16_t uid,
@@ -441,19 +630,17 @@ IidManager::GetAttribute(uint16_t uid, uint32_t i) const
 
 bool
 IidManager::HasTraceSource (uint16_t uid,
-                            std::string name)
+                            std::string name,
+                            TypeId::hash_t hash)
 {
-  NS_LOG_FUNCTION (this << uid << name);
+  NS_LOG_FUNCTION (this << uid << name << hash);
   struct IidInformation *information  = LookupInformation (uid);
   while (true)
     {
-      for (std::vector<struct TypeId::TraceSourceInformation>::const_iterator i = information->traceSources.begin ();
-           i != information->traceSources.end (); ++i)
+      uint32_t i;
+      if (FindIndex (information->traceSourceIndex, information->traceSources, name, hash, &i))
         {
-          if (i->name == name)
-            {
-              return true;
-            }
+          return true;
         }
       struct IidInformation *parent = LookupInformation (information->parent);
       if (parent == information)
@@ -475,7 +662,8 @@ IidManager::AddTraceSource (uint16_t uid,
 {
   NS_LOG_FUNCTION (this << uid << name << help << accessor);
   struct IidInformation *information  = LookupInformation (uid);
-  if (HasTraceSource (uid, name))
+  TypeId::hash_t hash = Hasher (name);
+  if (HasTraceSource (uid, name, hash))
     {
       NS_FATAL_ERROR ("Trace source \"" << name << "\" already registered on tid=\"" << 
                       information->name << "\"");
@@ -485,6 +673,8 @@ IidManager::AddTraceSource (uint16_t uid,
   source.help = help;
   source.accessor = accessor;
   information->traceSources.push_back (source);
+  information->traceSourceIndex.insert (std::make_pair (hash, information->traceSources.size () - 1));
+  m_generation++;
 }
 uint32_t 
 IidManager::GetTraceSourceN (uint16_t uid) const
@@ -588,22 +778,7 @@ bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
 {
   NS_LOG_FUNCTION (this << name << info);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do {
-      tid = nextTid;
-      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
-        {
-          struct TypeId::AttributeInformation tmp = tid.GetAttribute(i);
-          if (tmp.name == name)
-            {
-              *info = tmp;
-              return true;
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return false;
+  return Singleton<IidManager>::Get ()->LookupAttribute (m_tid, name, info);
 }
 
 TypeId 
@@ -620,6 +795,13 @@ TypeId::SetGroupName (std::string groupName)
   Singleton<IidManager>::Get ()->SetGroupName (m_tid, groupName);
   return *this;
 }
+TypeId
+TypeId::SetSize (std::size_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  Singleton<IidManager>::Get ()->SetSize (m_tid, size);
+  return *this;
+}
 TypeId 
 TypeId::GetParent (void) const
 {
@@ -652,6 +834,13 @@ TypeId::GetGroupName (void) const
   std::string groupName = Singleton<IidManager>::Get ()->GetGroupName (m_tid);
   return groupName;
 }
+std::size_t
+TypeId::GetSize (void) const
+{
+  NS_LOG_FUNCTION (this);
+  std::size_t size = Singleton<IidManager>::Get ()->GetSize (m_tid);
+  return size;
+}
 
 std::string 
 TypeId::GetName (void) const
@@ -791,21 +980,7 @@ Ptr<const TraceSourceAccessor>
 TypeId::LookupTraceSourceByName (std::string name) const
 {
   NS_LOG_FUNCTION (this << name);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do {
-      tid = nextTid;
-      for (uint32_t i = 0; i < tid.GetTraceSourceN (); i++)
-        {
-          struct TypeId::TraceSourceInformation info = tid.GetTraceSource (i);
-          if (info.name == name)
-            {
-              return info.accessor;
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return 0;
+  return Singleton<IidManager>::Get ()->LookupTraceSource (m_tid, name);
 }
 
 uint16_t 
@@ -157,6 +157,12 @@ public:
    */
   std::string GetGroupName (void) const;
 
+  /**
+   * \returns the size of the instances of this type, in bytes, or
+   *          zero if it was not recorded.
+   */
+  std::size_t GetSize (void) const;
+
   /**
    * \returns the name of this interface.
    */
@@ -239,11 +245,20 @@ public:
    */
   TypeId SetGroupName (std::string groupName);
 
+  /**
+   * \param size the size of the instances of this type, in bytes
+   * \returns this TypeId instance.
+   *
+   * The size is recorded by AddConstructor, and used to account
+   * the objects created by an ObjectFactory in the MemoryMonitor.
+   */
+  TypeId SetSize (std::size_t size);
+
   /**
    * \returns this TypeId instance
    *
    * Record in this TypeId the fact that the default constructor
-   * is accessible.
+   * is accessible, and the size of the instances it creates.
    */
   template <typename T>
   TypeId AddConstructor (void);
@@ -425,6 +440,7 @@ TypeId::AddConstructor (void)
   };
   Callback<ObjectBase *> cb = MakeCallback (&Maker::Create);
   DoAddConstructor (cb);
+  SetSize (sizeof (T));
   return *this;
 }
 
@@ -0,0 +1,215 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/checkpoint.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace ns3;
+
+/**
+ * \ingroup core-tests
+ *
+ * \brief Check that the variants resume from the state of the checkpoint.
+ *
+ * An event is run every second, and adds an increment to a counter and
+ * draws a random value. Each variant changes the increment at the
+ * checkpoint, and writes the counter and the last random value to a file
+ * at the end of its simulation. The random values must be those of a run
+ * without checkpoint.
+ */
+class CheckpointTestCase : public TestCase
+{
+public:
+  /**
+   * \param parallel the maximum number of variants running at the same time
+   */
+  CheckpointTestCase (uint32_t parallel);
+
+private:
+  virtual void DoRun (void);
+  /// Count and draw, and reschedule
+  void Tick (void);
+  /// Set the increment of a variant
+  void SetVariant (uint32_t variant);
+  /// \return the name of the result file of a variant
+  std::string GetFilename (uint32_t variant);
+
+  uint32_t m_parallel;                      //!< Variants running at the same time
+  uint32_t m_count;                         //!< Counter
+  uint32_t m_increment;                     //!< Increment of the counter
+  double m_last;                            //!< Last random value
+  Ptr<UniformRandomVariable> m_random;      //!< Random variable
+};
+
+CheckpointTestCase::CheckpointTestCase (uint32_t parallel)
+  : TestCase ("Check that variants resume from the checkpoint"),
+    m_parallel (parallel)
+{
+}
+
+void
+CheckpointTestCase::Tick (void)
+{
+  m_count += m_increment;
+  m_last = m_random->GetValue ();
+  Simulator::Schedule (Seconds (1), &CheckpointTestCase::Tick, this);
+}
+
+void
+CheckpointTestCase::SetVariant (uint32_t variant)
+{
+  m_increment = variant + 1;
+}
+
+std::string
+CheckpointTestCase::GetFilename (uint32_t variant)
+{
+  std::ostringstream oss;
+  oss << "checkpoint-" << m_parallel << "-" << variant << ".txt";
+  return CreateTempDirFilename (oss.str ());
+}
+
+void
+CheckpointTestCase::DoRun (void)
+{
+  // the reference run, without checkpoint
+  m_count = 0;
+  m_increment = 1;
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (42);
+  Simulator::Schedule (Seconds (0), &CheckpointTestCase::Tick, this);
+  Simulator::Stop (Seconds (9.5));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_ASSERT_MSG_EQ (m_count, 10, "The reference run must count 10 ticks");
+  double reference = m_last;
+
+  m_count = 0;
+  m_increment = 1;
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (42);
+  Simulator::Schedule (Seconds (0), &CheckpointTestCase::Tick, this);
+  Checkpoint::Schedule (Seconds (5), 3, MakeCallback (&CheckpointTestCase::SetVariant, this), m_parallel);
+  Simulator::Stop (Seconds (9.5));
+  Simulator::Run ();
+  if (Checkpoint::IsVariant ())
+    {
+      std::ofstream os (GetFilename (Checkpoint::GetVariant ()).c_str ());
+      os.precision (17);
+      os << m_count << " " << m_last << std::endl;
+      os.close ();
+      // leave the test runner to the parent process
+      _exit (os.fail () ? 1 : 0);
+    }
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (Checkpoint::GetNFailed (), 0, "All the variants must succeed");
+  NS_TEST_EXPECT_MSG_EQ (m_count, 5, "The parent process must stop at the checkpoint");
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      std::ifstream is (GetFilename (i).c_str ());
+      uint32_t count = 0;
+      double last = 0;
+      is >> count >> last;
+      NS_TEST_EXPECT_MSG_EQ (is.fail (), false, "The result of variant " << i << " cannot be read");
+      NS_TEST_EXPECT_MSG_EQ (count, 5 + 5 * (i + 1), "Variant " << i << " did not resume from the checkpoint");
+      NS_TEST_EXPECT_MSG_EQ (last, reference, "Variant " << i << " did not resume the random stream");
+      is.close ();
+      std::remove (GetFilename (i).c_str ());
+    }
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * \brief Check that a checkpoint only waits for its own variants.
+ *
+ * A child process which is not a variant, as a tap device creator would
+ * be, exits before the checkpoint: it must still be waitable once the
+ * variants have exited.
+ */
+class CheckpointOtherChildTestCase : public TestCase
+{
+public:
+  CheckpointOtherChildTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /// Do nothing in the variants
+  void SetVariant (uint32_t variant);
+};
+
+CheckpointOtherChildTestCase::CheckpointOtherChildTestCase ()
+  : TestCase ("Check that a checkpoint leaves the other children alone")
+{
+}
+
+void
+CheckpointOtherChildTestCase::SetVariant (uint32_t variant)
+{
+}
+
+void
+CheckpointOtherChildTestCase::DoRun (void)
+{
+  pid_t other = fork ();
+  NS_TEST_ASSERT_MSG_NE (other, -1, "fork() failed");
+  if (other == 0)
+    {
+      _exit (0);
+    }
+
+  Checkpoint::Schedule (Seconds (1), 2, MakeCallback (&CheckpointOtherChildTestCase::SetVariant, this), 2);
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+  if (Checkpoint::IsVariant ())
+    {
+      _exit (0);
+    }
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (Checkpoint::GetNFailed (), 0, "All the variants must succeed");
+  int status;
+  NS_TEST_EXPECT_MSG_EQ (waitpid (other, &status, 0), other, "The other child was reaped by the checkpoint");
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * \brief Checkpoint TestSuite
+ */
+class CheckpointTestSuite : public TestSuite
+{
+public:
+  CheckpointTestSuite ();
+};
+
+CheckpointTestSuite::CheckpointTestSuite ()
+  : TestSuite ("checkpoint", UNIT)
+{
+  AddTestCase (new CheckpointTestCase (1), TestCase::QUICK);
+  AddTestCase (new CheckpointTestCase (3), TestCase::QUICK);
+  AddTestCase (new CheckpointOtherChildTestCase (), TestCase::QUICK);
+}
+
+static CheckpointTestSuite g_checkpointTestSuite;
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/memory-monitor.h"
+#include "ns3/object-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \returns the usage of the TypeId or counter of the given name, or an
+ *          empty usage if it has no live instance nor block.
+ */
+static MemoryMonitor::Usage
+FindUsage (std::string name)
+{
+  MemoryMonitor::UsageList usages = MemoryMonitor::GetUsage ();
+  for (MemoryMonitor::UsageList::const_iterator i = usages.begin (); i != usages.end (); ++i)
+    {
+      if (i->name == name)
+        {
+          return *i;
+        }
+    }
+  MemoryMonitor::Usage empty = { name, 0, 0, 0 };
+  return empty;
+}
+
+class MemoryMonitorAccountingTestCase : public TestCase
+{
+public:
+  MemoryMonitorAccountingTestCase ();
+  virtual void DoRun (void);
+};
+
+MemoryMonitorAccountingTestCase::MemoryMonitorAccountingTestCase ()
+  : TestCase ("Check the accounting of objects and counters")
+{
+}
+
+void
+MemoryMonitorAccountingTestCase::DoRun (void)
+{
+  uint32_t counter = MemoryMonitor::RegisterCounter ("MemoryMonitorTestCounter");
+  MemoryMonitor::NotifyAllocate (counter, 1000);
+  NS_TEST_ASSERT_MSG_EQ (FindUsage ("MemoryMonitorTestCounter").count, 0, "Block accounted while disabled");
+
+  MemoryMonitor::Enable ();
+  MemoryMonitor::NotifyAllocate (counter, 100);
+  MemoryMonitor::NotifyAllocate (counter, 50);
+  MemoryMonitor::Usage usage = FindUsage ("MemoryMonitorTestCounter");
+  NS_TEST_ASSERT_MSG_EQ (usage.count, 2, "Unexpected number of blocks");
+  NS_TEST_ASSERT_MSG_EQ (usage.bytes, 150, "Unexpected number of bytes");
+  MemoryMonitor::NotifyDeallocate (counter, 100);
+  usage = FindUsage ("MemoryMonitorTestCounter");
+  NS_TEST_ASSERT_MSG_EQ (usage.count, 1, "Unexpected number of blocks");
+  NS_TEST_ASSERT_MSG_EQ (usage.bytes, 50, "Unexpected number of bytes");
+  NS_TEST_ASSERT_MSG_EQ (usage.peakBytes, 150, "Unexpected peak number of bytes");
+  // The release of the block allocated before the monitor was enabled
+  // is ignored.
+  MemoryMonitor::NotifyDeallocate (counter, 1000);
+  NS_TEST_ASSERT_MSG_EQ (FindUsage ("MemoryMonitorTestCounter").bytes, 50, "Unexpected number of bytes");
+  MemoryMonitor::NotifyAllocate (counter, 20);
+
+  // The counters are reset when the monitor is disabled, since the
+  // blocks they account are no longer released.
+  MemoryMonitor::Disable ();
+  NS_TEST_ASSERT_MSG_EQ (FindUsage ("MemoryMonitorTestCounter").count, 0, "Counter not reset");
+  MemoryMonitor::NotifyDeallocate (counter, 50);
+  MemoryMonitor::Enable ();
+  MemoryMonitor::NotifyAllocate (counter, 10);
+  usage = FindUsage ("MemoryMonitorTestCounter");
+  NS_TEST_ASSERT_MSG_EQ (usage.count, 1, "Unexpected number of blocks after the reset");
+  NS_TEST_ASSERT_MSG_EQ (usage.bytes, 10, "Unexpected number of bytes after the reset");
+  NS_TEST_ASSERT_MSG_EQ (usage.peakBytes, 10, "Unexpected peak number of bytes after the reset");
+  MemoryMonitor::NotifyDeallocate (counter, 10);
+
+  uint64_t before = FindUsage ("ns3::MemoryMonitor").count;
+  Ptr<MemoryMonitor> a = CreateObject<MemoryMonitor> ();
+  ObjectFactory factory;
+  factory.SetTypeId (MemoryMonitor::GetTypeId ());
+  Ptr<Object> b = factory.Create ();
+  usage = FindUsage ("ns3::MemoryMonitor");
+  NS_TEST_ASSERT_MSG_EQ (usage.count, before + 2, "Objects not accounted");
+  NS_TEST_ASSERT_MSG_EQ (MemoryMonitor::GetTypeId ().GetSize (), sizeof (MemoryMonitor), "Unexpected TypeId size");
+
+  // Objects accounted while enabled are released from the accounting
+  // after the monitor is disabled.
+  MemoryMonitor::Disable ();
+  a = 0;
+  b = 0;
+  NS_TEST_ASSERT_MSG_EQ (FindUsage ("ns3::MemoryMonitor").count, before, "Objects not released");
+}
+
+class MemoryMonitorSampleTestCase : public TestCase
+{
+public:
+  MemoryMonitorSampleTestCase ();
+  virtual void DoRun (void);
+  void Sample (const MemoryMonitor::UsageList &usages, uint32_t pending);
+private:
+  uint32_t m_samples;
+  uint32_t m_pending;
+};
+
+MemoryMonitorSampleTestCase::MemoryMonitorSampleTestCase ()
+  : TestCase ("Check the periodic sampling of the memory usage")
+{
+}
+
+void
+MemoryMonitorSampleTestCase::Sample (const MemoryMonitor::UsageList &usages, uint32_t pending)
+{
+  m_samples++;
+  m_pending = pending;
+}
+
+void
+MemoryMonitorSampleTestCase::DoRun (void)
+{
+  m_samples = 0;
+  m_pending = 0;
+  Ptr<MemoryMonitor> monitor = CreateObject<MemoryMonitor> ();
+  monitor->SetAttribute ("Interval", TimeValue (Seconds (1.0)));
+  monitor->TraceConnectWithoutContext ("Sample", MakeCallback (&MemoryMonitorSampleTestCase::Sample, this));
+  monitor->Start ();
+  Simulator::Schedule (Seconds (10.0), &MemoryMonitor::Stop, monitor);
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (m_samples, 9, "Unexpected number of samples");
+  // The sample at 9 s is reported before the next sample is scheduled,
+  // and sees only the event which stops the monitor.
+  NS_TEST_ASSERT_MSG_EQ (m_pending, 1, "Unexpected number of pending events");
+  NS_TEST_ASSERT_MSG_EQ (Simulator::GetPendingEventCount (), 0, "Events left in the simulator");
+  Simulator::Destroy ();
+}
+
+static class MemoryMonitorTestSuite : public TestSuite
+{
+public:
+  MemoryMonitorTestSuite ()
+    : TestSuite ("memory-monitor", UNIT)
+  {
+    AddTestCase (new MemoryMonitorAccountingTestCase (), TestCase::QUICK);
+    AddTestCase (new MemoryMonitorSampleTestCase (), TestCase::QUICK);
+  }
+} g_memoryMonitorTestSuite;
@@ -35,6 +35,8 @@
 #include "ns3/integer.h"
 #include "ns3/test.h"
 #include "ns3/rng-seed-manager.h"
+#include "ns3/rng-stream.h"
+#include "ns3/object-factory.h"
 #include "ns3/random-variable-stream.h"
 
 using namespace ns3;
@@ -2782,6 +2784,165 @@ RandomVariableStreamEmpiricalAntitheticTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (valueMean, expectedMean, TOLERANCE, "Wrong mean value."); 
 }
 
+// ===========================================================================
+// Test case for the counter-based Philox generator
+// ===========================================================================
+class RandomVariableStreamPhiloxTestCase : public TestCase
+{
+public:
+  static const uint32_t N_BINS = 50;
+  static const uint32_t N_MEASUREMENTS = 1000000;
+
+  RandomVariableStreamPhiloxTestCase ();
+  virtual ~RandomVariableStreamPhiloxTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+RandomVariableStreamPhiloxTestCase::RandomVariableStreamPhiloxTestCase ()
+  : TestCase ("Philox Random Variable Stream Generator")
+{
+}
+
+RandomVariableStreamPhiloxTestCase::~RandomVariableStreamPhiloxTestCase ()
+{
+}
+
+void
+RandomVariableStreamPhiloxTestCase::DoRun (void)
+{
+  // Known answers of Philox4x32-10, from the Random123 distribution
+  uint32_t counter[4] = { 0, 0, 0, 0 };
+  uint32_t key[2] = { 0, 0 };
+  RngStream::Philox (counter, key);
+  NS_TEST_ASSERT_MSG_EQ (counter[0], 0x6627e8d5, "Wrong Philox output");
+  NS_TEST_ASSERT_MSG_EQ (counter[1], 0xe169c58d, "Wrong Philox output");
+  NS_TEST_ASSERT_MSG_EQ (counter[2], 0xbc57ac4c, "Wrong Philox output");
+  NS_TEST_ASSERT_MSG_EQ (counter[3], 0x9b00dbd8, "Wrong Philox output");
+
+  uint32_t counter2[4] = { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 };
+  uint32_t key2[2] = { 0xa4093822, 0x299f31d0 };
+  RngStream::Philox (counter2, key2);
+  NS_TEST_ASSERT_MSG_EQ (counter2[0], 0xd16cfe09, "Wrong Philox output");
+  NS_TEST_ASSERT_MSG_EQ (counter2[1], 0x94fdcceb, "Wrong Philox output");
+  NS_TEST_ASSERT_MSG_EQ (counter2[2], 0x5001e420, "Wrong Philox output");
+  NS_TEST_ASSERT_MSG_EQ (counter2[3], 0x24126ea1, "Wrong Philox output");
+
+  RngSeedManager::SetGenerator (RngSeedManager::PHILOX);
+  SeedManager::SetSeed (time (0));
+
+  gsl_histogram * h = gsl_histogram_alloc (N_BINS);
+  gsl_histogram_set_ranges_uniform (h, 0., 1.);
+  Ptr<UniformRandomVariable> u = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < N_MEASUREMENTS; ++i)
+    {
+      double value = u->GetValue ();
+      NS_TEST_ASSERT_MSG_EQ ((value > 0 && value < 1), true, "Value out of (0,1).");
+      gsl_histogram_increment (h, value);
+    }
+  double expected = ((double)N_MEASUREMENTS / (double)N_BINS);
+  double chiSquared = 0;
+  for (uint32_t i = 0; i < N_BINS; ++i)
+    {
+      double tmp = gsl_histogram_get (h, i) - expected;
+      chiSquared += tmp * tmp / expected;
+    }
+  gsl_histogram_free (h);
+  NS_TEST_ASSERT_MSG_LT (chiSquared, gsl_cdf_chisq_Qinv (0.05, N_BINS), "Chi-squared statistic out of range");
+
+  // The values of a stream do not depend on the use of the other streams
+  Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable> ();
+  x->SetStream (5);
+  Ptr<UniformRandomVariable> y = CreateObject<UniformRandomVariable> ();
+  y->SetStream (6);
+  double first = y->GetValue ();
+  double xValues[10];
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      xValues[i] = x->GetValue ();
+    }
+  Ptr<UniformRandomVariable> z = CreateObject<UniformRandomVariable> ();
+  z->SetStream (6);
+  NS_TEST_ASSERT_MSG_EQ (z->GetValue (), first, "Stream is not reproducible.");
+  x->SetStream (5);
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (x->GetValue (), xValues[i], "Stream is not reproducible.");
+    }
+  NS_TEST_ASSERT_MSG_NE (xValues[0], first, "Streams are not distinct.");
+
+  RngSeedManager::SetGenerator (RngSeedManager::MRG32K3A);
+}
+
+// ===========================================================================
+// Test case for the bulk generation of random values
+// ===========================================================================
+class RandomVariableStreamBulkTestCase : public TestCase
+{
+public:
+  RandomVariableStreamBulkTestCase ();
+  virtual ~RandomVariableStreamBulkTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Compare (std::string typeId, std::string name1, double value1,
+                std::string name2, double value2, bool antithetic);
+};
+
+RandomVariableStreamBulkTestCase::RandomVariableStreamBulkTestCase ()
+  : TestCase ("Bulk generation of random variable streams")
+{
+}
+
+RandomVariableStreamBulkTestCase::~RandomVariableStreamBulkTestCase ()
+{
+}
+
+void
+RandomVariableStreamBulkTestCase::Compare (std::string typeId, std::string name1, double value1,
+                                           std::string name2, double value2, bool antithetic)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (typeId);
+  factory.Set (name1, DoubleValue (value1));
+  factory.Set (name2, DoubleValue (value2));
+  factory.Set ("Antithetic", BooleanValue (antithetic));
+  factory.Set ("Stream", IntegerValue (3));
+  Ptr<RandomVariableStream> scalar = factory.Create<RandomVariableStream> ();
+  Ptr<RandomVariableStream> bulk = factory.Create<RandomVariableStream> ();
+
+  // Odd sizes, so that buffered values are carried over between calls
+  const uint32_t sizes[] = { 1, 7, 128, 3, 1000 };
+  double values[1000];
+  for (uint32_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); ++s)
+    {
+      bulk->GetValues (values, sizes[s]);
+      for (uint32_t i = 0; i < sizes[s]; ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (values[i], scalar->GetValue (), typeId << ": bulk and scalar values differ.");
+        }
+    }
+}
+
+void
+RandomVariableStreamBulkTestCase::DoRun (void)
+{
+  SeedManager::SetSeed (time (0));
+  RngSeedManager::Generator generators[] = { RngSeedManager::MRG32K3A, RngSeedManager::PHILOX };
+  for (uint32_t g = 0; g < 2; ++g)
+    {
+      RngSeedManager::SetGenerator (generators[g]);
+      for (uint32_t a = 0; a < 2; ++a)
+        {
+          Compare ("ns3::UniformRandomVariable", "Min", 2, "Max", 5, a);
+          Compare ("ns3::ExponentialRandomVariable", "Mean", 2, "Bound", 3, a);
+          Compare ("ns3::NormalRandomVariable", "Mean", 1, "Variance", 4, a);
+        }
+    }
+  RngSeedManager::SetGenerator (RngSeedManager::MRG32K3A);
+}
+
 class RandomVariableStreamTestSuite : public TestSuite
 {
 public:
@@ -2826,6 +2987,8 @@ RandomVariableStreamTestSuite::RandomVariableStreamTestSuite ()
   AddTestCase (new RandomVariableStreamDeterministicTestCase, TestCase::QUICK);
   AddTestCase (new RandomVariableStreamEmpiricalTestCase, TestCase::QUICK);
   AddTestCase (new RandomVariableStreamEmpiricalAntitheticTestCase, TestCase::QUICK);
+  AddTestCase (new RandomVariableStreamPhiloxTestCase, TestCase::QUICK);
+  AddTestCase (new RandomVariableStreamBulkTestCase, TestCase::QUICK);
 }
 
 static RandomVariableStreamTestSuite randomVariableStreamTestSuite;
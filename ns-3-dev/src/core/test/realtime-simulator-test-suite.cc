@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/system-thread.h"
+
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Check that the events scheduled by threads other than the simulation
+ * thread are all executed, in the order in which each thread scheduled
+ * them, with their context, and without moving the time backward.
+ *
+ * The first event of each thread is scheduled before the simulator
+ * runs, the others while it runs.
+ */
+class RealtimeInjectionTestCase : public TestCase
+{
+public:
+  RealtimeInjectionTestCase ();
+
+private:
+  virtual void DoRun (void);
+  static void InjectFirst (std::pair<RealtimeInjectionTestCase *, uint32_t> context);
+  static void Inject (std::pair<RealtimeInjectionTestCase *, uint32_t> context);
+  void Start (void);
+  void Event (uint32_t thread, uint32_t seq);
+
+  std::vector<Ptr<SystemThread> > m_threads;
+  std::vector<uint32_t> m_next;
+  uint32_t m_count;
+  Time m_last;
+  bool m_ordered;
+  bool m_contexts;
+};
+
+/// Number of threads scheduling events
+static const uint32_t N_THREADS = 4;
+/// Number of events scheduled by each thread
+static const uint32_t N_EVENTS = 1000;
+
+RealtimeInjectionTestCase::RealtimeInjectionTestCase ()
+  : TestCase ("Check the events scheduled by other threads in the realtime simulator")
+{
+}
+
+void
+RealtimeInjectionTestCase::InjectFirst (std::pair<RealtimeInjectionTestCase *, uint32_t> context)
+{
+  Simulator::ScheduleWithContext (context.second, Seconds (0),
+                                  &RealtimeInjectionTestCase::Event, context.first, context.second, 0);
+}
+
+void
+RealtimeInjectionTestCase::Inject (std::pair<RealtimeInjectionTestCase *, uint32_t> context)
+{
+  RealtimeInjectionTestCase *me = context.first;
+  for (uint32_t i = 1; i < N_EVENTS; i++)
+    {
+      Simulator::ScheduleWithContext (context.second, Seconds (0),
+                                      &RealtimeInjectionTestCase::Event, me, context.second, i);
+    }
+}
+
+void
+RealtimeInjectionTestCase::Start (void)
+{
+  for (uint32_t i = 0; i < N_THREADS; i++)
+    {
+      m_threads[i]->Start ();
+    }
+}
+
+void
+RealtimeInjectionTestCase::Event (uint32_t thread, uint32_t seq)
+{
+  if (Simulator::GetContext () != thread)
+    {
+      m_contexts = false;
+    }
+  if (seq != m_next[thread] || Simulator::Now () < m_last)
+    {
+      m_ordered = false;
+    }
+  m_next[thread] = seq + 1;
+  m_last = Simulator::Now ();
+  if (++m_count == N_THREADS * N_EVENTS)
+    {
+      Simulator::Stop ();
+    }
+}
+
+void
+RealtimeInjectionTestCase::DoRun (void)
+{
+  StringValue impl;
+  GlobalValue::GetValueByName ("SimulatorImplementationType", impl);
+  GlobalValue::Bind ("SimulatorImplementationType",
+                     StringValue ("ns3::RealtimeSimulatorImpl"));
+
+  m_next.assign (N_THREADS, 0);
+  m_count = 0;
+  m_last = Seconds (0);
+  m_ordered = true;
+  m_contexts = true;
+
+  // The simulator is created by this thread, its simulation thread
+  Simulator::Schedule (Seconds (0), &RealtimeInjectionTestCase::Start, this);
+  // In case some events are lost
+  Simulator::Schedule (Seconds (10), &Simulator::Stop);
+
+  for (uint32_t i = 0; i < N_THREADS; i++)
+    {
+      // The first event of each thread, before the simulator runs
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeBoundCallback (&RealtimeInjectionTestCase::InjectFirst,
+                                                                          std::make_pair (this, i)));
+      thread->Start ();
+      thread->Join ();
+      m_threads.push_back (Create<SystemThread> (MakeBoundCallback (&RealtimeInjectionTestCase::Inject,
+                                                                    std::make_pair (this, i))));
+    }
+
+  Simulator::Run ();
+  for (uint32_t i = 0; i < N_THREADS; i++)
+    {
+      m_threads[i]->Join ();
+    }
+  m_threads.clear ();
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType", impl);
+
+  NS_TEST_EXPECT_MSG_EQ (m_count, N_THREADS * N_EVENTS, "events lost");
+  NS_TEST_EXPECT_MSG_EQ (m_ordered, true, "events out of order");
+  NS_TEST_EXPECT_MSG_EQ (m_contexts, true, "events with a wrong context");
+}
+
+class RealtimeSimulatorTestSuite : public TestSuite
+{
+public:
+  RealtimeSimulatorTestSuite ();
+};
+
+RealtimeSimulatorTestSuite::RealtimeSimulatorTestSuite ()
+  : TestSuite ("realtime-simulator", UNIT)
+{
+  AddTestCase (new RealtimeInjectionTestCase, TestCase::QUICK);
+}
+
+static RealtimeSimulatorTestSuite g_realtimeSimulatorTestSuite;
@@ -230,6 +230,38 @@ TimeIntputOutputTestCase::DoRun (void)
   std::cout << std::endl;
 }
     
+class TimeConversionTestCase : public TestCase
+{
+public:
+  TimeConversionTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+TimeConversionTestCase::TimeConversionTestCase ()
+  : TestCase ("Check the fast paths of the double conversions against int64x64_t")
+{
+}
+
+void
+TimeConversionTestCase::DoRun (void)
+{
+  const Time::Unit units[] = { Time::MIN, Time::S, Time::MS, Time::US, Time::NS, Time::PS };
+  const double values[] = { 0, 1, 2.5, 0.1, 0.3, -0.3, 1.1, 1e-3, 1e-5, 1e-9, 123.456789,
+                            -42.000000001, 0.000244140625, 0.00024414, 1e6, 7.0 / 3 };
+  for (uint32_t u = 0; u < sizeof (units) / sizeof (units[0]); ++u)
+    {
+      for (uint32_t v = 0; v < sizeof (values) / sizeof (values[0]); ++v)
+        {
+          Time fast = Time::FromDouble (values[v], units[u]);
+          Time slow = Time::From (int64x64_t (values[v]), units[u]);
+          NS_TEST_ASSERT_MSG_EQ (fast, slow, "FromDouble differs from From for " << values[v]);
+          NS_TEST_ASSERT_MSG_EQ (fast.ToDouble (units[u]), fast.To (units[u]).GetDouble (),
+                                 "ToDouble differs from To for " << values[v]);
+        }
+    }
+}
+
 static class TimeTestSuite : public TestSuite
 {
 public:
@@ -238,6 +270,7 @@ public:
   {
     AddTestCase (new TimesWithSignsTestCase (), TestCase::QUICK);
     AddTestCase (new TimeIntputOutputTestCase (), TestCase::QUICK);
+    AddTestCase (new TimeConversionTestCase (), TestCase::QUICK);
     // This should be last, since it changes the resolution
     AddTestCase (new TimeSimpleTestCase (), TestCase::QUICK);
   }
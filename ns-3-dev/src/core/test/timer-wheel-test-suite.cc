@@ -0,0 +1,260 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/timer-wheel.h"
+#include "ns3/timer.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/config.h"
+#include <vector>
+
+using namespace ns3;
+
+class TimerWheelExpireTestCase : public TestCase
+{
+public:
+  TimerWheelExpireTestCase ();
+  virtual void DoRun (void);
+  void Expire (Time expected);
+private:
+  Ptr<TimerWheel> m_wheel;
+  uint32_t m_nExpired;
+};
+
+TimerWheelExpireTestCase::TimerWheelExpireTestCase ()
+  : TestCase ("Check expiration times and cancellation of timer wheel events")
+{
+}
+
+void
+TimerWheelExpireTestCase::Expire (Time expected)
+{
+  Time granularity = m_wheel->GetGranularity ();
+  NS_TEST_EXPECT_MSG_EQ ((Simulator::Now () >= expected), true, "Event expired early");
+  NS_TEST_EXPECT_MSG_EQ ((Simulator::Now () < expected + granularity), true, "Event expired more than one tick late");
+  m_nExpired++;
+}
+
+void
+TimerWheelExpireTestCase::DoRun (void)
+{
+  m_wheel = Create<TimerWheel> (MilliSeconds (1));
+  m_nExpired = 0;
+
+  // Delays covering every level of the wheel, including beyond its range
+  std::vector<Time> delays;
+  delays.push_back (Seconds (0));
+  delays.push_back (MicroSeconds (1500));
+  delays.push_back (MilliSeconds (255));
+  delays.push_back (MilliSeconds (256));
+  delays.push_back (MilliSeconds (700));
+  delays.push_back (Seconds (70));
+  delays.push_back (Seconds (20000));
+  delays.push_back (Seconds (5000000));
+  for (std::vector<Time>::const_iterator i = delays.begin (); i != delays.end (); ++i)
+    {
+      m_wheel->Schedule (*i, &TimerWheelExpireTestCase::Expire, this, *i);
+    }
+
+  TimerWheel::Handle cancelled = m_wheel->Schedule (Seconds (2), &TimerWheelExpireTestCase::Expire, this, Seconds (2));
+  NS_TEST_ASSERT_MSG_EQ (m_wheel->IsRunning (cancelled), true, "Event is not pending");
+  NS_TEST_ASSERT_MSG_EQ (m_wheel->GetDelayLeft (cancelled), Seconds (2), "Wrong delay left");
+  m_wheel->Cancel (cancelled);
+  NS_TEST_ASSERT_MSG_EQ (m_wheel->IsRunning (cancelled), false, "Cancelled event is still pending");
+
+  // The pooled entry of the cancelled event is reused; the old handle stays stale
+  TimerWheel::Handle reused = m_wheel->Schedule (Seconds (1), &TimerWheelExpireTestCase::Expire, this, Seconds (1));
+  NS_TEST_ASSERT_MSG_EQ (m_wheel->IsRunning (cancelled), false, "Stale handle refers to a new event");
+  NS_TEST_ASSERT_MSG_EQ (m_wheel->IsRunning (reused), true, "Event is not pending");
+  NS_TEST_ASSERT_MSG_EQ (m_wheel->GetNPending (), delays.size () + 1, "Wrong number of pending events");
+
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_nExpired, delays.size () + 1, "Some events did not expire");
+  NS_TEST_EXPECT_MSG_EQ (m_wheel->GetNPending (), 0, "Some events are still pending");
+  NS_TEST_EXPECT_MSG_EQ (m_wheel->IsRunning (reused), false, "Expired event is still pending");
+  Simulator::Destroy ();
+  m_wheel = 0;
+}
+
+class TimerWheelTimerTestCase : public TestCase
+{
+public:
+  TimerWheelTimerTestCase ();
+  virtual void DoRun (void);
+  void Expire (void);
+private:
+  Time m_expired;
+};
+
+TimerWheelTimerTestCase::TimerWheelTimerTestCase ()
+  : TestCase ("Check Timer state transitions when using a timer wheel")
+{
+}
+
+void
+TimerWheelTimerTestCase::Expire (void)
+{
+  m_expired = Simulator::Now ();
+}
+
+void
+TimerWheelTimerTestCase::DoRun (void)
+{
+  Timer timer = Timer (Timer::CANCEL_ON_DESTROY);
+  timer.SetTimerWheel (Create<TimerWheel> (MilliSeconds (10)));
+  timer.SetFunction (&TimerWheelTimerTestCase::Expire, this);
+  timer.SetDelay (Seconds (10.0));
+  NS_TEST_ASSERT_MSG_EQ (timer.GetState (), Timer::EXPIRED, "");
+  timer.Schedule ();
+  NS_TEST_ASSERT_MSG_EQ (timer.GetState (), Timer::RUNNING, "");
+  NS_TEST_ASSERT_MSG_EQ (timer.GetDelayLeft (), Seconds (10.0), "");
+  timer.Suspend ();
+  NS_TEST_ASSERT_MSG_EQ (timer.GetState (), Timer::SUSPENDED, "");
+  NS_TEST_ASSERT_MSG_EQ (timer.GetDelayLeft (), Seconds (10.0), "");
+  timer.Resume ();
+  NS_TEST_ASSERT_MSG_EQ (timer.GetState (), Timer::RUNNING, "");
+  timer.Cancel ();
+  NS_TEST_ASSERT_MSG_EQ (timer.GetState (), Timer::EXPIRED, "");
+
+  timer.Schedule (MilliSeconds (25));
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (timer.GetState (), Timer::EXPIRED, "");
+  NS_TEST_ASSERT_MSG_EQ (m_expired, MilliSeconds (30), "Timer did not expire at the end of its tick");
+  Simulator::Destroy ();
+}
+
+class TimerWheelContextTestCase : public TestCase
+{
+public:
+  TimerWheelContextTestCase ();
+  virtual void DoRun (void);
+  void Arm (Time delay);
+  void Expire (uint32_t context);
+private:
+  Ptr<TimerWheel> m_wheel;
+  TimerWheel::Handle m_cancelled;
+  uint32_t m_nExpired;
+};
+
+TimerWheelContextTestCase::TimerWheelContextTestCase ()
+  : TestCase ("Check that timer wheel events expire in the context which scheduled them")
+{
+}
+
+void
+TimerWheelContextTestCase::Arm (Time delay)
+{
+  uint32_t context = Simulator::GetContext ();
+  TimerWheel::Handle handle = m_wheel->Schedule (delay, &TimerWheelContextTestCase::Expire, this, context);
+  if (context == 3)
+    {
+      m_cancelled = handle;
+    }
+}
+
+void
+TimerWheelContextTestCase::Expire (uint32_t context)
+{
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetContext (), context, "Event expired in the wrong context");
+  NS_TEST_EXPECT_MSG_NE (context, 3, "Cancelled event expired");
+  m_nExpired++;
+  if (context == 1)
+    {
+      // the event of context 3 expires at the same tick, in the wheel
+      // event run by context 1, and stays pending until it runs in its
+      // own context
+      NS_TEST_EXPECT_MSG_EQ (m_wheel->IsRunning (m_cancelled), true, "Event of another context is not pending");
+      m_wheel->Cancel (m_cancelled);
+    }
+}
+
+void
+TimerWheelContextTestCase::DoRun (void)
+{
+  m_wheel = Create<TimerWheel> (MilliSeconds (10));
+  m_nExpired = 0;
+  // the wheel event is armed by context 1, at the tick of all the events
+  Simulator::ScheduleWithContext (1, Seconds (0), &TimerWheelContextTestCase::Arm, this, MilliSeconds (100));
+  Simulator::ScheduleWithContext (2, Seconds (0), &TimerWheelContextTestCase::Arm, this, MilliSeconds (95));
+  Simulator::ScheduleWithContext (3, Seconds (0), &TimerWheelContextTestCase::Arm, this, MilliSeconds (95));
+  Simulator::ScheduleWithContext (4, Seconds (0.05), &TimerWheelContextTestCase::Arm, this, MilliSeconds (50));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_nExpired, 3, "Some events did not expire");
+  NS_TEST_EXPECT_MSG_EQ (m_wheel->GetNPending (), 0, "Some events are still pending");
+  Simulator::Destroy ();
+  m_wheel = 0;
+}
+
+class TimerWheelDefaultTestCase : public TestCase
+{
+public:
+  TimerWheelDefaultTestCase ();
+  virtual void DoRun (void);
+  void Expire (void);
+private:
+  uint32_t m_nExpired;
+};
+
+TimerWheelDefaultTestCase::TimerWheelDefaultTestCase ()
+  : TestCase ("Check that timers use the current default timer wheel")
+{
+}
+
+void
+TimerWheelDefaultTestCase::Expire (void)
+{
+  m_nExpired++;
+}
+
+void
+TimerWheelDefaultTestCase::DoRun (void)
+{
+  m_nExpired = 0;
+  Config::SetGlobal ("TimerWheelGranularity", TimeValue (MilliSeconds (10)));
+  Timer timer = Timer (Timer::CANCEL_ON_DESTROY);
+  timer.SetFunction (&TimerWheelDefaultTestCase::Expire, this);
+  timer.Schedule (MilliSeconds (25));
+  Ptr<TimerWheel> first = TimerWheel::GetDefault ();
+  NS_TEST_ASSERT_MSG_EQ (first->GetNPending (), 1, "Timer does not use the default wheel");
+  // the default wheel and its events are destroyed with the simulator
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (timer.IsRunning (), false, "Timer still running after Simulator::Destroy");
+  NS_TEST_EXPECT_MSG_EQ (timer.GetDelayLeft (), Seconds (0), "Destroyed timer has a delay left");
+  timer.Cancel ();
+
+  timer.Schedule (MilliSeconds (25));
+  Ptr<TimerWheel> second = TimerWheel::GetDefault ();
+  NS_TEST_EXPECT_MSG_EQ ((second != first), true, "The default wheel was not replaced");
+  NS_TEST_EXPECT_MSG_EQ (second->GetNPending (), 1, "Timer does not use the new default wheel");
+  NS_TEST_EXPECT_MSG_EQ (first->GetNPending (), 0, "Timer uses the destroyed default wheel");
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_nExpired, 1, "Timer did not expire");
+  Simulator::Destroy ();
+  Config::SetGlobal ("TimerWheelGranularity", TimeValue (Seconds (0)));
+}
+
+static class TimerWheelTestSuite : public TestSuite
+{
+public:
+  TimerWheelTestSuite ()
+    : TestSuite ("timer-wheel", UNIT)
+  {
+    AddTestCase (new TimerWheelExpireTestCase (), TestCase::QUICK);
+    AddTestCase (new TimerWheelTimerTestCase (), TestCase::QUICK);
+    AddTestCase (new TimerWheelContextTestCase (), TestCase::QUICK);
+    AddTestCase (new TimerWheelDefaultTestCase (), TestCase::QUICK);
+  }
+} g_timerWheelTestSuite;
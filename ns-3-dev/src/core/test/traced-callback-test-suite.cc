@@ -18,6 +18,7 @@
 
 #include "ns3/test.h"
 #include "ns3/traced-callback.h"
+#include "ns3/object.h"
 
 using namespace ns3;
 
@@ -108,6 +109,80 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class ChainTracedCallbackTestCase : public TestCase
+{
+public:
+  ChainTracedCallbackTestCase ();
+  virtual ~ChainTracedCallbackTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+  void CbCount (Ptr<const Object> a, const uint32_t &b);
+  void CbConnect (Ptr<const Object> a, const uint32_t &b);
+
+  TracedCallback<Ptr<const Object>, const uint32_t &> m_trace;
+  uint32_t m_count;
+  uint32_t m_last;
+};
+
+ChainTracedCallbackTestCase::ChainTracedCallbackTestCase ()
+  : TestCase ("Check TracedCallback with reference arguments and sinks connected during an invocation")
+{
+}
+
+void
+ChainTracedCallbackTestCase::CbCount (Ptr<const Object> a, const uint32_t &b)
+{
+  m_count++;
+  m_last = b;
+}
+
+void
+ChainTracedCallbackTestCase::CbConnect (Ptr<const Object> a, const uint32_t &b)
+{
+  //
+  // Connect enough sinks to force the chain to be reallocated while it
+  // is being walked.
+  //
+  for (uint32_t i = 0; i < 16; i++)
+    {
+      m_trace.ConnectWithoutContext (MakeCallback (&ChainTracedCallbackTestCase::CbCount, this));
+    }
+}
+
+void
+ChainTracedCallbackTestCase::DoRun (void)
+{
+  Ptr<const Object> object = CreateObject<Object> ();
+  m_count = 0;
+  m_last = 0;
+
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "A new TracedCallback has sinks");
+  m_trace (object, 1);
+  NS_TEST_ASSERT_MSG_EQ (m_count, 0, "A TracedCallback with no sinks called a sink");
+
+  //
+  // The sinks connected by CbConnect are called by the invocation which
+  // connected them, as they are appended to the chain.
+  //
+  m_trace.ConnectWithoutContext (MakeCallback (&ChainTracedCallbackTestCase::CbConnect, this));
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), false, "A TracedCallback with a sink is empty");
+  m_trace (object, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_count, 16, "Sinks connected during the invocation not called");
+  NS_TEST_ASSERT_MSG_EQ (m_last, 2, "Unexpected argument");
+
+  m_trace.DisconnectWithoutContext (MakeCallback (&ChainTracedCallbackTestCase::CbConnect, this));
+  m_count = 0;
+  uint32_t value = 3;
+  m_trace (object, value);
+  NS_TEST_ASSERT_MSG_EQ (m_count, 16, "Unexpected number of sinks called");
+  NS_TEST_ASSERT_MSG_EQ (m_last, 3, "Unexpected argument");
+
+  m_trace.DisconnectWithoutContext (MakeCallback (&ChainTracedCallbackTestCase::CbCount, this));
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "Sinks left after disconnection");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -118,6 +193,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new ChainTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
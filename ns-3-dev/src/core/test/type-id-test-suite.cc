@@ -25,6 +25,8 @@
 #include "ns3/type-id.h"
 #include "ns3/test.h"
 #include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/trace-source-accessor.h"
 
 using namespace std;
 
@@ -188,6 +190,98 @@ CollisionTestCase::DoRun (void)
 }
   
   
+//----------------------------
+//
+// Attribute and trace source lookup test
+
+class LookupAttributeTestCase : public TestCase
+{
+public:
+  LookupAttributeTestCase ();
+  virtual ~LookupAttributeTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+LookupAttributeTestCase::LookupAttributeTestCase ()
+  : TestCase ("Check lookups of attributes and trace sources by name")
+{
+}
+
+LookupAttributeTestCase::~LookupAttributeTestCase ()
+{
+}
+
+void
+LookupAttributeTestCase::DoRun (void)
+{
+  // Every name of the inheritance chain of every type must be found,
+  // in the nearest type which has it
+  uint32_t nids = TypeId::GetRegisteredN ();
+  for (uint32_t i = 0; i < nids; ++i)
+    {
+      const TypeId tid = TypeId::GetRegistered (i);
+      TypeId owner = tid;
+      while (true)
+        {
+          for (uint32_t j = 0; j < owner.GetAttributeN (); ++j)
+            {
+              struct TypeId::AttributeInformation expected = owner.GetAttribute (j);
+              struct TypeId::AttributeInformation info;
+              NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName (expected.name, &info), true,
+                                     "Attribute " << expected.name << " not found in " << tid.GetName ());
+              if (owner == tid)
+                {
+                  NS_TEST_ASSERT_MSG_EQ (info.help, expected.help,
+                                         "Wrong attribute " << expected.name << " in " << tid.GetName ());
+                }
+            }
+          for (uint32_t j = 0; j < owner.GetTraceSourceN (); ++j)
+            {
+              struct TypeId::TraceSourceInformation expected = owner.GetTraceSource (j);
+              NS_TEST_ASSERT_MSG_EQ ((tid.LookupTraceSourceByName (expected.name) != 0), (expected.accessor != 0),
+                                     "Trace source " << expected.name << " not found in " << tid.GetName ());
+            }
+          // the types of the collision test have no parent
+          if (owner.GetParent () == owner || owner.GetParent ().GetUid () == 0)
+            {
+              break;
+            }
+          owner = owner.GetParent ();
+        }
+      struct TypeId::AttributeInformation info;
+      NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("NoSuchAttribute", &info), false,
+                             "Unknown attribute found in " << tid.GetName ());
+      NS_TEST_ASSERT_MSG_EQ ((tid.LookupTraceSourceByName ("NoSuchTraceSource") == 0), true,
+                             "Unknown trace source found in " << tid.GetName ());
+    }
+
+  // The index of a child must see the attributes added to its parent
+  // after the first lookup
+  TypeId parent = TypeId ("ns3::LookupAttributeTestParent")
+    .SetParent (TypeId::LookupByName ("ns3::ObjectBase"))
+    .AddAttribute ("First", "First attribute of the parent",
+                   UintegerValue (1),
+                   Ptr<const AttributeAccessor> (),
+                   MakeUintegerChecker<uint32_t> ());
+  TypeId child = TypeId ("ns3::LookupAttributeTestChild")
+    .SetParent (parent);
+  struct TypeId::AttributeInformation info;
+  NS_TEST_ASSERT_MSG_EQ (child.LookupAttributeByName ("First", &info), true,
+                         "Attribute of the parent not found");
+  NS_TEST_ASSERT_MSG_EQ (child.LookupAttributeByName ("Second", &info), false,
+                         "Attribute found before its registration");
+  parent.AddAttribute ("Second", "Second attribute of the parent",
+                       UintegerValue (2),
+                       Ptr<const AttributeAccessor> (),
+                       MakeUintegerChecker<uint32_t> ());
+  NS_TEST_ASSERT_MSG_EQ (child.LookupAttributeByName ("Second", &info), true,
+                         "Attribute added to the parent after a lookup not found");
+  NS_TEST_ASSERT_MSG_EQ (info.help, "Second attribute of the parent",
+                         "Wrong attribute added to the parent");
+}
+
+
 //----------------------------
 //
 // Performance test
@@ -298,6 +392,7 @@ TypeIdTestSuite::TypeIdTestSuite ()
   // as chained.
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
+  AddTestCase (new LookupAttributeTestCase, QUICK);
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;  
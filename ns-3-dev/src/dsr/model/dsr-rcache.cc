@@ -39,6 +39,8 @@
 #include <vector>
 #include <functional>
 #include <iomanip>
+#include <queue>
+#include <utility>
 
 #include "ns3/simulator.h"
 #include "ns3/ipv4-route.h"
@@ -133,6 +135,8 @@ RouteCacheEntry::Print (std::ostream & os) const
 
 NS_OBJECT_ENSURE_REGISTERED (RouteCache);
 
+const uint32_t RouteCache::NO_NODE;
+
 TypeId RouteCache::GetTypeId ()
 {
   static TypeId tid = TypeId ("ns3::dsr::RouteCache")
@@ -144,8 +148,12 @@ TypeId RouteCache::GetTypeId ()
 
 RouteCache::RouteCache ()
   : m_vector (0),
+    m_nextExpire (Time::Max ()),
     m_maxEntriesEachDst (3),
     m_isLinkCache (false),
+    m_bestRoutesSourceIndex (NO_NODE),
+    m_bestRoutesStale (false),
+    m_nextLinkNodeExpire (Time::Max ()),
     m_ntimer (Timer::CANCEL_ON_DESTROY),
     m_delay (MilliSeconds (100))
 {
@@ -176,8 +184,7 @@ bool
 RouteCache::UpdateRouteEntry (Ipv4Address dst)
 {
   NS_LOG_FUNCTION (this << dst);
-  std::map<Ipv4Address, std::list<RouteCacheEntry> >::const_iterator i =
-    m_sortedRoutes.find (dst);
+  SortedRoutes::iterator i = m_sortedRoutes.find (dst);
   if (i == m_sortedRoutes.end ())
     {
       NS_LOG_LOGIC ("Failed to find the route entry for the destination " << dst);
@@ -185,19 +192,16 @@ RouteCache::UpdateRouteEntry (Ipv4Address dst)
     }
   else
     {
-      std::list<RouteCacheEntry> rtVector = i->second;
-      RouteCacheEntry successEntry = rtVector.front ();
-      successEntry.SetExpireTime (RouteCacheTimeout);
-      rtVector.pop_front ();
-      rtVector.push_back (successEntry);
+      std::list<RouteCacheEntry> & rtVector = i->second;
+      // Move the successful entry at the end of the list before extending its lifetime
+      rtVector.splice (rtVector.end (), rtVector, rtVector.begin ());
+      rtVector.back ().SetExpireTime (RouteCacheTimeout);
       rtVector.sort (CompareRoutesExpire);      // sort the route vector first
-      m_sortedRoutes.erase (dst);               // erase the entry first
-      /*
-       * Save the new route cache along with the destination address in map
-       */
-      std::pair<std::map<Ipv4Address, std::list<RouteCacheEntry> >::iterator, bool> result =
-        m_sortedRoutes.insert (std::make_pair (dst, rtVector));
-      return result.second;
+      if (RouteCacheTimeout + Simulator::Now () < m_nextExpire)
+        {
+          m_nextExpire = RouteCacheTimeout + Simulator::Now ();
+        }
+      return true;
     }
   return false;
 }
@@ -218,69 +222,66 @@ RouteCache::LookupRoute (Ipv4Address id, RouteCacheEntry & rt)
           NS_LOG_LOGIC ("Route to " << id << " not found; m_sortedRoutes is empty");
           return false;
         }
-      std::map<Ipv4Address, std::list<RouteCacheEntry> >::const_iterator i = m_sortedRoutes.find (id);
+      SortedRoutes::const_iterator i = m_sortedRoutes.find (id);
       if (i == m_sortedRoutes.end ())
         {
           NS_LOG_LOGIC ("No Direct Route to " << id << " found");
-          for (std::map<Ipv4Address, std::list<RouteCacheEntry> >::const_iterator j =
-                 m_sortedRoutes.begin (); j != m_sortedRoutes.end (); ++j)
+          /*
+           * Look for a sub route to id in the routes to the other destinations.  The sub route
+           * kept is the last one found when visiting the destinations by increasing address.
+           */
+          SortedRoutes::const_iterator best = m_sortedRoutes.end ();
+          std::list<RouteCacheEntry>::const_iterator bestEntry;
+          RouteCacheEntry::IP_VECTOR bestVector;
+          uint32_t bestSize = 0;
+          for (SortedRoutes::const_iterator j = m_sortedRoutes.begin (); j != m_sortedRoutes.end (); ++j)
             {
-              std::list<RouteCacheEntry> rtVector = j->second; // The route cache vector linked with destination address
+              if (best != m_sortedRoutes.end () && j->first < best->first)
+                {
+                  continue;
+                }
               /*
                * Loop through the possibly multiple routes within the route vector
                */
-              for (std::list<RouteCacheEntry>::const_iterator k = rtVector.begin (); k != rtVector.end (); ++k)
+              for (std::list<RouteCacheEntry>::const_iterator k = j->second.begin (); k != j->second.end (); ++k)
                 {
-                  // return the first route in the route vector
                   RouteCacheEntry::IP_VECTOR routeVector = k->GetVector ();
-                  RouteCacheEntry::IP_VECTOR changeVector;
-
-                  for (RouteCacheEntry::IP_VECTOR::iterator l = routeVector.begin (); l != routeVector.end (); ++l)
-                    {
-                      if (*l != id)
-                        {
-                          changeVector.push_back (*l);
-                        }
-                      else
-                        {
-                          changeVector.push_back (*l);
-                          break;
-                        }
-                    }
+                  uint32_t changeSize = std::find (routeVector.begin (), routeVector.end (), id) - routeVector.begin () + 1;
                   /*
                    * When the changed vector is smaller in size and larger than 1, which means we have found a route with the destination
                    * address we are looking for
                    */
-                  if ((changeVector.size () < routeVector.size ())  && (changeVector.size () > 1))
+                  if ((changeSize < routeVector.size ()) && (changeSize > 1))
                     {
-                      RouteCacheEntry changeEntry; // Create the route entry
-                      changeEntry.SetVector (changeVector);
-                      changeEntry.SetDestination (id);
-                      // Use the expire time from original route entry
-                      changeEntry.SetExpireTime (k->GetExpireTime ());
-                      // We need to add new route entry here
-                      std::list<RouteCacheEntry> newVector;
-                      newVector.push_back (changeEntry);
-                      newVector.sort (CompareRoutesExpire);  // sort the route vector first
-                      m_sortedRoutes[id] = newVector;   // Only get the first sub route and add it in route cache
-                      NS_LOG_INFO ("We have a sub-route to " << id << " add it in route cache");
+                      best = j;
+                      bestEntry = k;
+                      bestVector.swap (routeVector);
+                      bestSize = changeSize;
                     }
                 }
             }
-        }
-      NS_LOG_INFO ("Here we check the route cache again after updated the sub routes");
-      std::map<Ipv4Address, std::list<RouteCacheEntry> >::const_iterator m = m_sortedRoutes.find (id);
-      if (m == m_sortedRoutes.end ())
-        {
-          NS_LOG_LOGIC ("No updated route till last time");
-          return false;
+          if (best == m_sortedRoutes.end ())
+            {
+              NS_LOG_LOGIC ("No updated route till last time");
+              return false;
+            }
+          RouteCacheEntry changeEntry; // Create the route entry
+          bestVector.resize (bestSize);
+          changeEntry.SetVector (bestVector);
+          changeEntry.SetDestination (id);
+          // Use the expire time from original route entry
+          changeEntry.SetExpireTime (bestEntry->GetExpireTime ());
+          // Only get the first sub route and add it in route cache
+          m_sortedRoutes[id].push_back (changeEntry);
+          NS_LOG_INFO ("We have a sub-route to " << id << " add it in route cache");
+          rt = changeEntry;
+          return true;
         }
       /*
        * We have a direct route to the destination address
        */
-      std::list<RouteCacheEntry> rtVector = m->second;
-      rt = rtVector.front ();  // use the first entry in the route vector
-      NS_LOG_LOGIC ("Route to " << id << " with route size " << rtVector.size ());
+      rt = i->second.front ();  // use the first entry in the route vector
+      NS_LOG_LOGIC ("Route to " << id << " with route size " << i->second.size ());
       return true;
     }
 }
@@ -311,118 +312,89 @@ RouteCache::IsLinkCache ()
   return m_isLinkCache;
 }
 
+uint32_t
+RouteCache::FindGraphNode (Ipv4Address node) const
+{
+  std::vector<Ipv4Address>::const_iterator i = std::lower_bound (m_graphNodes.begin (), m_graphNodes.end (), node);
+  if (i == m_graphNodes.end () || *i != node)
+    {
+      return NO_NODE;
+    }
+  return i - m_graphNodes.begin ();
+}
+
 void
 RouteCache::RebuildBestRouteTable (Ipv4Address source)
 {
   NS_LOG_FUNCTION (this << source);
+  m_bestRoutesSource = source;
+  m_bestRoutesStale = true;
+}
+
+void
+RouteCache::ComputeBestRoutes ()
+{
+  NS_LOG_FUNCTION (this << m_bestRoutesSource);
+  m_bestRoutesStale = false;
+  uint32_t size = m_graphNodes.size ();
   /**
    * \brief The followings are initialize-single-source
    */
-  // @d shortest-path estimate
-  std::map<Ipv4Address, uint32_t> d;
   // @pre preceeding node
-  std::map<Ipv4Address, Ipv4Address> pre;
-  for (std::map<Ipv4Address, std::map<Ipv4Address, uint32_t> >::iterator i = m_netGraph.begin (); i != m_netGraph.end (); ++i)
+  m_bestRoutesPre.assign (size, NO_NODE);
+  m_bestRoutesSourceIndex = FindGraphNode (m_bestRoutesSource);
+  if (m_bestRoutesSourceIndex == NO_NODE)
     {
-      if (i->second.find (source) != i->second.end ())
-        {
-          d[i->first] = i->second[source];
-          pre[i->first] = source;
-        }
-      else
-        {
-          d[i->first] = MAXWEIGHT;
-          pre[i->first] = Ipv4Address ("255.255.255.255");
-        }
+      NS_LOG_LOGIC ("No link to the source " << m_bestRoutesSource << " in the link cache");
+      return;
     }
-  d[source] = 0;
+  // @d shortest-path estimate
+  std::vector<uint32_t> d (size, NO_NODE);
+  // The expire time of the link to the preceeding node
+  std::vector<Time> preExpire (size);
+  // the node set which shortest distance has been calculated
+  std::vector<bool> s (size, false);
   /**
    * \brief The followings are core of dijskra algorithm
+   *
+   * Among the nodes at the same distance, the one with the highest address is visited first.
    */
-  // the node set which shortest distance has been calculated, if true calculated
-  std::map<Ipv4Address, bool> s;
-  double temp = MAXWEIGHT;
-  Ipv4Address tempip = Ipv4Address ("255.255.255.255");
-  for (uint32_t i = 0; i < m_netGraph.size (); i++)
+  typedef std::pair<uint32_t, uint32_t> Candidate;    // distance, NO_NODE - index
+  std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate> > candidates;
+  d[m_bestRoutesSourceIndex] = 0;
+  candidates.push (std::make_pair (0, NO_NODE - m_bestRoutesSourceIndex));
+  while (!candidates.empty ())
     {
-      temp = MAXWEIGHT;
-      for (std::map<Ipv4Address,uint32_t>::const_iterator j = d.begin (); j != d.end (); ++j)
+      uint32_t dist = candidates.top ().first;
+      uint32_t index = NO_NODE - candidates.top ().second;
+      candidates.pop ();
+      if (s[index] || dist != d[index])
         {
-          Ipv4Address ip = j->first;
-          if (s.find (ip) == s.end ())
-            {
-              /*
-               * \brief The followings are for comparison
-               */
-              if (j->second <= temp)
-                {
-                  temp = j->second;
-                  tempip = ip;
-                }
-            }
+          continue;
         }
-      if (!tempip.IsBroadcast ())
+      s[index] = true;
+      for (uint32_t j = m_graphOffsets[index]; j < m_graphOffsets[index + 1]; ++j)
         {
-          s[tempip] = true;
-          for (std::map<Ipv4Address, uint32_t>::const_iterator k = m_netGraph[tempip].begin (); k != m_netGraph[tempip].end (); ++k)
+          uint32_t k = m_graphNeighbors[j];
+          if (!s[k] && d[k] > dist + 1)
             {
-              if (s.find (k->first) == s.end () && d[k->first] > d[tempip] + k->second)
-                {
-                  d[k->first] = d[tempip] + k->second;
-                  pre[k->first] = tempip;
-                }
-              /*
-               *  Selects the shortest-length route that has the longest expected lifetime
-               *  (highest minimum timeout of any link in the route)
-               *  For the computation overhead and complexity
-               *  Here I just implement kind of greedy strategy to select link with the longest expected lifetime when there is two options
-               */
-              else if (d[k->first] == d[tempip] + k->second)
-                {
-                  std::map<Link, LinkStab>::iterator oldlink = m_linkCache.find (Link (k->first, pre[k->first]));
-                  std::map<Link, LinkStab>::iterator newlink = m_linkCache.find (Link (k->first, tempip));
-                  if (oldlink != m_linkCache.end () && newlink != m_linkCache.end ())
-                    {
-                      if (oldlink->second.GetLinkStability () < newlink->second.GetLinkStability ())
-                        {
-                          NS_LOG_INFO ("Select the link with longest expected lifetime");
-                          d[k->first] = d[tempip] + k->second;
-                          pre[k->first] = tempip;
-                        }
-                    }
-                  else
-                    {
-                      NS_LOG_INFO ("Link Stability Info Corrupt");
-                    }
-                }
+              d[k] = dist + 1;
+              m_bestRoutesPre[k] = index;
+              preExpire[k] = m_graphLinkExpire[j];
+              candidates.push (std::make_pair (d[k], NO_NODE - k));
             }
-        }
-    }
-  // clean the best route table
-  m_bestRoutesTable_link.clear ();
-  for (std::map<Ipv4Address, Ipv4Address>::iterator i = pre.begin (); i != pre.end (); ++i)
-    {
-      // loop for all vertexes
-      RouteCacheEntry::IP_VECTOR route;
-      Ipv4Address iptemp = i->first;
-
-      if (!i->second.IsBroadcast () && iptemp != source)
-        {
-          while (iptemp != source)
-            {
-              route.push_back (iptemp);
-              iptemp = pre[iptemp];
-            }
-          route.push_back (source);
-          // Reverse the route
-          RouteCacheEntry::IP_VECTOR reverseroute;
-          for (RouteCacheEntry::IP_VECTOR::reverse_iterator j = route.rbegin (); j != route.rend (); ++j)
+          /*
+           *  Selects the shortest-length route that has the longest expected lifetime
+           *  (highest minimum timeout of any link in the route)
+           *  For the computation overhead and complexity
+           *  Here I just implement kind of greedy strategy to select link with the longest expected lifetime when there is two options
+           */
+          else if (d[k] == dist + 1 && preExpire[k] < m_graphLinkExpire[j])
             {
-              reverseroute.push_back (*j);
+              NS_LOG_INFO ("Select the link with longest expected lifetime");
+              m_bestRoutesPre[k] = index;
+              preExpire[k] = m_graphLinkExpire[j];
             }
-          NS_LOG_LOGIC ("Add newly calculated best routes");
-          PrintVector (reverseroute);
-          m_bestRoutesTable_link[i->first] = reverseroute;
         }
     }
 }
@@ -433,36 +405,59 @@ RouteCache::LookupRoute_Link (Ipv4Address id, RouteCacheEntry & rt)
   NS_LOG_FUNCTION (this << id);
   /// We need to purge the link node cache
   PurgeLinkNode ();
-  std::map<Ipv4Address, RouteCacheEntry::IP_VECTOR>::const_iterator i = m_bestRoutesTable_link.find (id);
-  if (i == m_bestRoutesTable_link.end ())
+  if (m_bestRoutesStale)
+    {
+      ComputeBestRoutes ();
+    }
+  uint32_t index = FindGraphNode (id);
+  if (index == NO_NODE || m_bestRoutesPre[index] == NO_NODE)
     {
       NS_LOG_INFO ("No route find to " << id);
       return false;
     }
   else
     {
-      if (i->second.size () < 2)
+      RouteCacheEntry::IP_VECTOR route;
+      while (index != m_bestRoutesSourceIndex)
         {
-          NS_LOG_LOGIC ("Route to " << id << " error");
-          return false;
+          route.push_back (m_graphNodes[index]);
+          index = m_bestRoutesPre[index];
         }
+      route.push_back (m_bestRoutesSource);
+      // Reverse the route
+      std::reverse (route.begin (), route.end ());
 
       RouteCacheEntry newEntry; // Create the route entry
-      newEntry.SetVector (i->second);
+      newEntry.SetVector (route);
       newEntry.SetDestination (id);
       newEntry.SetExpireTime (RouteCacheTimeout);
-      NS_LOG_INFO ("Route to " << id << " found with the length " << i->second.size ());
+      NS_LOG_INFO ("Route to " << id << " found with the length " << route.size ());
       rt = newEntry;
-      std::vector<Ipv4Address> path = rt.GetVector ();
-      PrintVector (path);
+      PrintVector (route);
       return true;
     }
 }
 
+void
+RouteCache::UpdateNextLinkNodeExpire (Time stability)
+{
+  Time expire = stability + Simulator::Now ();
+  if (expire < m_nextLinkNodeExpire)
+    {
+      m_nextLinkNodeExpire = expire;
+    }
+}
+
 void
 RouteCache::PurgeLinkNode ()
 {
   NS_LOG_FUNCTION (this);
+  if (m_nextLinkNodeExpire > Simulator::Now ())
+    {
+      NS_LOG_DEBUG ("No link nor node has expired yet");
+      return;
+    }
+  m_nextLinkNodeExpire = Time::Max ();
   for (std::map<Link, LinkStab>::iterator i = m_linkCache.begin (); i != m_linkCache.end (); )
     {
       NS_LOG_DEBUG ("The link stability " << i->second.GetLinkStability ().GetSeconds ());
@@ -474,6 +469,7 @@ RouteCache::PurgeLinkNode ()
         }
       else
         {
+          UpdateNextLinkNodeExpire (i->second.GetLinkStability ());
           ++i;
         }
     }
@@ -489,6 +485,7 @@ RouteCache::PurgeLinkNode ()
         }
       else
         {
+          UpdateNextLinkNodeExpire (i->second.GetNodeStability ());
           ++i;
         }
     }
@@ -498,15 +495,49 @@ void
 RouteCache::UpdateNetGraph ()
 {
   NS_LOG_FUNCTION (this);
-  m_netGraph.clear ();
-  for (std::map<Link, LinkStab>::iterator i = m_linkCache.begin (); i != m_linkCache.end (); ++i)
+  m_graphNodes.clear ();
+  for (std::map<Link, LinkStab>::const_iterator i = m_linkCache.begin (); i != m_linkCache.end (); ++i)
+    {
+      m_graphNodes.push_back (i->first.m_low);
+      m_graphNodes.push_back (i->first.m_high);
+    }
+  std::sort (m_graphNodes.begin (), m_graphNodes.end ());
+  m_graphNodes.erase (std::unique (m_graphNodes.begin (), m_graphNodes.end ()), m_graphNodes.end ());
+  /*
+   * Count the neighbors of every node, then fill the adjacency arrays
+   */
+  std::vector<std::pair<uint32_t, uint32_t> > links;
+  links.reserve (m_linkCache.size ());
+  m_graphOffsets.assign (m_graphNodes.size () + 1, 0);
+  for (std::map<Link, LinkStab>::const_iterator i = m_linkCache.begin (); i != m_linkCache.end (); ++i)
+    {
+      uint32_t low = FindGraphNode (i->first.m_low);
+      uint32_t high = FindGraphNode (i->first.m_high);
+      links.push_back (std::make_pair (low, high));
+      m_graphOffsets[low + 1]++;
+      m_graphOffsets[high + 1]++;
+    }
+  for (uint32_t i = 1; i < m_graphOffsets.size (); ++i)
+    {
+      m_graphOffsets[i] += m_graphOffsets[i - 1];
+    }
+  std::vector<uint32_t> next (m_graphOffsets.begin (), m_graphOffsets.end () - 1);
+  m_graphNeighbors.resize (2 * links.size ());
+  m_graphLinkExpire.resize (2 * links.size ());
+  uint32_t j = 0;
+  for (std::map<Link, LinkStab>::const_iterator i = m_linkCache.begin (); i != m_linkCache.end (); ++i, ++j)
     {
       // Here the weight is set as 1
       /// \todo May need to set different weight for different link here later
-      uint32_t weight = 1;
-      m_netGraph[i->first.m_low][i->first.m_high] = weight;
-      m_netGraph[i->first.m_high][i->first.m_low] = weight;
+      Time expire = i->second.GetLinkStability () + Simulator::Now ();
+      uint32_t low = links[j].first;
+      uint32_t high = links[j].second;
+      m_graphNeighbors[next[low]] = high;
+      m_graphLinkExpire[next[low]++] = expire;
+      m_graphNeighbors[next[high]] = low;
+      m_graphLinkExpire[next[high]++] = expire;
     }
+  m_bestRoutesStale = true;
 }
 
 bool
@@ -519,6 +550,7 @@ RouteCache::IncStability (Ipv4Address node)
       NS_LOG_INFO ("The initial stability " << m_initStability.GetSeconds ());
       NodeStab ns (m_initStability);
       m_nodeCache[node] = ns;
+      UpdateNextLinkNodeExpire (m_initStability);
       return false;
     }
   else
@@ -542,6 +574,7 @@ RouteCache::DecStability (Ipv4Address node)
     {
       NodeStab ns (m_initStability);
       m_nodeCache[node] = ns;
+      UpdateNextLinkNodeExpire (m_initStability);
       return false;
     }
   else
@@ -551,6 +584,7 @@ RouteCache::DecStability (Ipv4Address node)
       NS_LOG_INFO ("The stability here " << Time (i->second.GetNodeStability () / m_stabilityDecrFactor).GetSeconds ());
       NodeStab ns (Time (i->second.GetNodeStability () / m_stabilityDecrFactor));
       m_nodeCache[node] = ns;
+      UpdateNextLinkNodeExpire (ns.GetNodeStability ());
       return true;
     }
   return false;
@@ -567,6 +601,7 @@ RouteCache::AddRoute_Link (RouteCacheEntry::IP_VECTOR nodelist, Ipv4Address sour
     {
       NodeStab ns;                /// This is the node stability
       ns.SetNodeStability (m_initStability);
+      UpdateNextLinkNodeExpire (m_initStability);
 
       if (m_nodeCache.find (nodelist[i]) == m_nodeCache.end ())
         {
@@ -595,6 +630,7 @@ RouteCache::AddRoute_Link (RouteCacheEntry::IP_VECTOR nodelist, Ipv4Address sour
           stab.SetLinkStability (m_minLifeTime);
         }
       m_linkCache[link] = stab;
+      UpdateNextLinkNodeExpire (stab.GetLinkStability ());
       NS_LOG_DEBUG ("Add a new link");
       link.Print ();
       NS_LOG_DEBUG ("Link Info");
@@ -656,35 +692,36 @@ RouteCache::AddRoute (RouteCacheEntry & rt)
 {
   NS_LOG_FUNCTION (this);
   Purge ();
-  std::list<RouteCacheEntry> rtVector;   // Declare the route cache entry vector
   Ipv4Address dst = rt.GetDestination ();
-  std::vector<Ipv4Address> route = rt.GetVector ();
 
   NS_LOG_DEBUG ("The route destination we have " << dst);
-  std::map<Ipv4Address, std::list<RouteCacheEntry> >::const_iterator i =
-    m_sortedRoutes.find (dst);
+  SortedRoutes::iterator i = m_sortedRoutes.find (dst);
 
   if (i == m_sortedRoutes.end ())
     {
-      rtVector.push_back (rt);
-      m_sortedRoutes.erase (dst);   // Erase the route entries for dst first
       /**
        * Save the new route cache along with the destination address in map
        */
-      std::pair<std::map<Ipv4Address, std::list<RouteCacheEntry> >::iterator, bool> result =
-        m_sortedRoutes.insert (std::make_pair (dst, rtVector));
-      return result.second;
+      m_sortedRoutes[dst].push_back (rt);
+      if (rt.GetExpireTime () + Simulator::Now () < m_nextExpire)
+        {
+          m_nextExpire = rt.GetExpireTime () + Simulator::Now ();
+        }
+      return true;
     }
   else
     {
-      rtVector = i->second;
+      std::list<RouteCacheEntry> & rtVector = i->second;
       NS_LOG_DEBUG ("The existing route size " << rtVector.size () << " for destination address " << dst);
       /**
        * \brief Drop the most aged packet when buffer reaches to max
+       *
+       * The last entry of the sorted route cache is only put back if the new route is not added
        */
+      std::list<RouteCacheEntry> lastEntry;
       if (rtVector.size () >= m_maxEntriesEachDst)
         {
-          RemoveLastEntry (rtVector);         // Drop the last entry for the sorted route cache, the route has already been sorted
+          lastEntry.splice (lastEntry.end (), rtVector, --rtVector.end ());
         }
 
       if (FindSameRoute (rt, rtVector))
@@ -705,17 +742,16 @@ RouteCache::AddRoute (RouteCacheEntry & rt)
                                              << rtVector.back ().GetExpireTime ().GetSeconds ());
               NS_LOG_DEBUG ("The first hop" << rtVector.front ().GetVector ().size () << " The second hop "
                                             << rtVector.back ().GetVector ().size ());
-              m_sortedRoutes.erase (dst);               // erase the route entries for dst first
-              /**
-               * Save the new route cache along with the destination address in map
-               */
-              std::pair<std::map<Ipv4Address, std::list<RouteCacheEntry> >::iterator, bool> result =
-                m_sortedRoutes.insert (std::make_pair (dst, rtVector));
-              return result.second;
+              if (rt.GetExpireTime () + Simulator::Now () < m_nextExpire)
+                {
+                  m_nextExpire = rt.GetExpireTime () + Simulator::Now ();
+                }
+              return true;
             }
           else
             {
               NS_LOG_INFO ("The newly found route is already expired");
+              rtVector.splice (rtVector.end (), lastEntry);
             }
         }
     }
@@ -725,13 +761,11 @@ RouteCache::AddRoute (RouteCacheEntry & rt)
 bool RouteCache::FindSameRoute (RouteCacheEntry & rt, std::list<RouteCacheEntry> & rtVector)
 {
   NS_LOG_FUNCTION (this);
+  RouteCacheEntry::IP_VECTOR newVector = rt.GetVector ();
   for (std::list<RouteCacheEntry>::iterator i = rtVector.begin (); i != rtVector.end (); ++i)
     {
       // return the first route in the route vector
-      RouteCacheEntry::IP_VECTOR routeVector = i->GetVector ();
-      RouteCacheEntry::IP_VECTOR newVector = rt.GetVector ();
-
-      if (routeVector == newVector)
+      if (i->GetVector () == newVector)
         {
           NS_LOG_DEBUG ("Found same routes in the route cache with the vector size "
                         << rt.GetDestination () << " " << rtVector.size ());
@@ -741,14 +775,8 @@ bool RouteCache::FindSameRoute (RouteCacheEntry & rt, std::list<RouteCacheEntry>
             {
               i->SetExpireTime (rt.GetExpireTime ());
             }
-          m_sortedRoutes.erase (rt.GetDestination ()); // erase the entry first
           rtVector.sort (CompareRoutesExpire);  // sort the route vector first
-          /*
-           * Save the new route cache along with the destination address in map
-           */
-          std::pair<std::map<Ipv4Address, std::list<RouteCacheEntry> >::iterator, bool> result =
-            m_sortedRoutes.insert (std::make_pair (rt.GetDestination (), rtVector));
-          return result.second;
+          return true;
         }
     }
   return false;
@@ -825,12 +853,11 @@ RouteCache::DeleteAllRoutesIncludeLink (Ipv4Address errorSrc, Ipv4Address unreac
       /*
        * Loop all the routes saved in the route cache
        */
-      for (std::map<Ipv4Address, std::list<RouteCacheEntry> >::iterator j =
-             m_sortedRoutes.begin (); j != m_sortedRoutes.end (); )
+      for (SortedRoutes::iterator j = m_sortedRoutes.begin (); j != m_sortedRoutes.end (); )
         {
-          std::map<Ipv4Address, std::list<RouteCacheEntry> >::iterator jtmp = j;
+          SortedRoutes::iterator jtmp = j;
           Ipv4Address address = j->first;
-          std::list<RouteCacheEntry> rtVector = j->second;
+          std::list<RouteCacheEntry> & rtVector = j->second;
           /*
            * Loop all the routes for a single destination
            */
@@ -906,21 +933,14 @@ RouteCache::DeleteAllRoutesIncludeLink (Ipv4Address errorSrc, Ipv4Address unreac
                 }
             }
           ++j;
-          if (!IsLinkCache ())
-            {
-              m_sortedRoutes.erase (jtmp);
-            }
           if (rtVector.size ())
             {
-              /*
-               * Save the new route cache along with the destination address in map
-               */
               rtVector.sort (CompareRoutesExpire);
-              m_sortedRoutes[address] = rtVector;
             }
           else
             {
               NS_LOG_DEBUG ("There is no route left for that destination " << address);
+              m_sortedRoutes.erase (jtmp);
             }
         }
     }
@@ -969,57 +989,49 @@ RouteCache::Purge ()
       NS_LOG_DEBUG ("The route cache is empty");
       return;
     }
-  for (std::map<Ipv4Address, std::list<RouteCacheEntry> >::iterator i =
-         m_sortedRoutes.begin (); i != m_sortedRoutes.end (); )
+  if (m_nextExpire > Simulator::Now ())
+    {
+      NS_LOG_DEBUG ("No route has expired yet");
+      return;
+    }
+  m_nextExpire = Time::Max ();
+  for (SortedRoutes::iterator i = m_sortedRoutes.begin (); i != m_sortedRoutes.end (); )
     {
       // Loop of route cache entry with the route size
-      std::map<Ipv4Address, std::list<RouteCacheEntry> >::iterator itmp = i;
+      SortedRoutes::iterator itmp = i;
+      ++i;
       /*
        * The route cache entry vector
        */
-      Ipv4Address dst = i->first;
-      std::list<RouteCacheEntry> rtVector = i->second;
+      Ipv4Address dst = itmp->first;
+      std::list<RouteCacheEntry> & rtVector = itmp->second;
       NS_LOG_DEBUG ("The route vector size of 1 " << dst << " " << rtVector.size ());
-      if (rtVector.size ())
+      for (std::list<RouteCacheEntry>::iterator j = rtVector.begin (); j != rtVector.end (); )
         {
-          for (std::list<RouteCacheEntry>::iterator j = rtVector.begin (); j != rtVector.end (); )
-            {
-              NS_LOG_DEBUG ("The expire time of every entry with expire time " << j->GetExpireTime ());
-              /*
-               * First verify if the route has expired or not
-               */
-              if (j->GetExpireTime () <= Seconds (0))
-                {
-                  /*
-                   * When the expire time has passed, erase the certain route
-                   */
-                  NS_LOG_DEBUG ("Erase the expired route for " << dst << " with expire time " << j->GetExpireTime ());
-                  j = rtVector.erase (j);
-                }
-              else
-                {
-                  ++j;
-                }
-            }
-          NS_LOG_DEBUG ("The route vector size of 2 " << dst << " " << rtVector.size ());
-          if (rtVector.size ())
+          NS_LOG_DEBUG ("The expire time of every entry with expire time " << j->GetExpireTime ());
+          /*
+           * First verify if the route has expired or not
+           */
+          if (j->GetExpireTime () <= Seconds (0))
             {
-              ++i;
-              m_sortedRoutes.erase (itmp); // erase the entry first
               /*
-               * Save the new route cache along with the destination address in map
+               * When the expire time has passed, erase the certain route
                */
-              m_sortedRoutes.insert (std::make_pair (dst, rtVector));
+              NS_LOG_DEBUG ("Erase the expired route for " << dst << " with expire time " << j->GetExpireTime ());
+              j = rtVector.erase (j);
             }
           else
             {
-              ++i;
-              m_sortedRoutes.erase (itmp);
+              if (j->GetExpireTime () + Simulator::Now () < m_nextExpire)
+                {
+                  m_nextExpire = j->GetExpireTime () + Simulator::Now ();
+                }
+              ++j;
             }
         }
-      else
+      NS_LOG_DEBUG ("The route vector size of 2 " << dst << " " << rtVector.size ());
+      if (rtVector.empty ())
         {
-          ++i;
           m_sortedRoutes.erase (itmp);
         }
     }
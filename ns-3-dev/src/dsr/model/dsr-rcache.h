@@ -54,6 +54,7 @@
 #include "ns3/callback.h"
 #include "ns3/wifi-mac-header.h"
 #include "ns3/arp-cache.h"
+#include "ns3/sgi-hashmap.h"
 #include "dsr-option-header.h"
 
 namespace ns3 {
@@ -413,8 +414,13 @@ public:
   void PrintRouteVector (std::list<RouteCacheEntry> route);
   /**
    * \brief Find the same route in the route cache
+   *
+   * When found, the expire time of the route is extended to the one of rt
+   * and rtVector is sorted again.
+   *
    * \param rt entry with destination address dst, if exists
    * \param rtVector the route vector
+   * \return true if rtVector holds the same route as rt
    */
   bool FindSameRoute (RouteCacheEntry & rt, std::list<RouteCacheEntry> & rtVector);
   /**
@@ -550,8 +556,12 @@ private:
    * Define the route cache data structure
    */
   typedef std::list<RouteCacheEntry> routeEntryVector;
+  /// Hash table of the route entry vectors, indexed by destination address
+  typedef sgi::hash_map<Ipv4Address, routeEntryVector, Ipv4AddressHash> SortedRoutes;
+
+  SortedRoutes m_sortedRoutes;                                  ///< Map the ipv4Address to route entry vector
 
-  std::map<Ipv4Address, routeEntryVector> m_sortedRoutes;       ///< Map the ipv4Address to route entry vector
+  Time m_nextExpire;                                            ///< Lower bound of the expire times of the routes in m_sortedRoutes
 
   routeEntryVector m_routeEntryVector;                          ///< Define the route vector
 
@@ -568,15 +578,44 @@ private:
    */
   #define MAXWEIGHT 0xFFFF;
   /**
-   * Current network graph state for this node, double is weight, which is calculated by the node information
-   * and link information, any time some changes of link cache and node cache
-   * change the weight and then recompute the best choice for each node
+   * Current network graph state for this node, built from the link cache any time it changes.
+   * The graph is kept as adjacency arrays: the neighbors of the node m_graphNodes[i] are the nodes
+   * whose indexes are stored in m_graphNeighbors from m_graphOffsets[i] to m_graphOffsets[i + 1],
+   * and m_graphLinkExpire holds the expire time of the link to each of them.  Every link has a weight of 1.
    */
-  std::map<Ipv4Address, std::map<Ipv4Address, uint32_t> > m_netGraph;
-
-  std::map<Ipv4Address, RouteCacheEntry::IP_VECTOR> m_bestRoutesTable_link;     ///< for link route cache
+  std::vector<Ipv4Address> m_graphNodes;                                        ///< The nodes of the graph, sorted by address
+  std::vector<uint32_t> m_graphOffsets;                                         ///< The first neighbor of each node
+  std::vector<uint32_t> m_graphNeighbors;                                       ///< The neighbors of all the nodes
+  std::vector<Time> m_graphLinkExpire;                                          ///< The expire time of the link to each neighbor
+  /**
+   * The best routes of the link cache, as the shortest path tree rooted at m_bestRoutesSource: the
+   * preceding node of each node of the graph on its best route, or NO_NODE when it has none.
+   * The tree is only computed when a route is looked up after the graph or the source changed.
+   */
+  std::vector<uint32_t> m_bestRoutesPre;
+  Ipv4Address m_bestRoutesSource;                                               ///< The source of the best routes
+  uint32_t m_bestRoutesSourceIndex;                                             ///< The index of the source in the graph, or NO_NODE
+  bool m_bestRoutesStale;                                                       ///< Whether the best routes must be computed again
   std::map<Link, LinkStab> m_linkCache;                                         ///< The data structure to store link info
   std::map<Ipv4Address, NodeStab> m_nodeCache;                                  ///< The data structure to store node info
+  Time m_nextLinkNodeExpire;                                                    ///< Lower bound of the expire times of the links and nodes
+  /// Index used for a node which is not in the graph
+  static const uint32_t NO_NODE = 0xffffffff;
+  /**
+   * \brief find a node in the network graph
+   * \param node the ip address of the node
+   * \return the index of the node in m_graphNodes, or NO_NODE
+   */
+  uint32_t FindGraphNode (Ipv4Address node) const;
+  /**
+   * \brief Dijkstra algorithm over the network graph to compute the best routes from m_bestRoutesSource
+   */
+  void ComputeBestRoutes ();
+  /**
+   * \brief lower the bound of the expire times of the links and nodes if needed
+   * \param stability the stability of a link or node which has just been set
+   */
+  void UpdateNextLinkNodeExpire (Time stability);
   /**
    * \brief used by LookupRoute when LinkCache
    * \param id the ip address we are looking for
@@ -596,7 +635,7 @@ private:
 
 public:
   /**
-   * \brief Dijsktra algorithm to get the best route from m_netGraph and update the m_bestRoutesTable_link
+   * \brief Dijsktra algorithm to get the best route from the network graph and update the best routes
    * when current graph information has changed
    * \param type The type of the cache
    */
@@ -604,7 +643,7 @@ public:
   bool IsLinkCache ();
   bool AddRoute_Link (RouteCacheEntry::IP_VECTOR nodelist, Ipv4Address node);
   /**
-   *  \brief USE MAXWEIGHT TO REPRESENT MAX; USE BROADCAST ADDRESS TO REPRESENT NULL PRECEEDING ADDRESS
+   *  \brief Invalidate the best routes, which are computed again from source at the next lookup
    *  \param source The source address the routes based on
    */
   void RebuildBestRouteTable (Ipv4Address source);
@@ -384,6 +384,87 @@ DsrCacheEntryTest::DoRun ()
   NS_TEST_EXPECT_MSG_EQ (rcache->DeleteRoute (Ipv4Address ("1.1.1.1")), false, "trivial");
 }
 // -----------------------------------------------------------------------------
+// / Unit test for the route lookups of the link cache and path cache
+class DsrRouteCacheLookupTest : public TestCase
+{
+public:
+  DsrRouteCacheLookupTest ();
+  ~DsrRouteCacheLookupTest ();
+  virtual void
+  DoRun (void);
+};
+DsrRouteCacheLookupTest::DsrRouteCacheLookupTest ()
+  : TestCase ("DSR route cache lookups")
+{
+}
+DsrRouteCacheLookupTest::~DsrRouteCacheLookupTest ()
+{
+}
+void
+DsrRouteCacheLookupTest::DoRun ()
+{
+  Ipv4Address a ("10.0.0.1");
+  Ipv4Address b ("10.0.0.2");
+  Ipv4Address c ("10.0.0.3");
+  Ipv4Address d ("10.0.0.4");
+  Ipv4Address e ("10.0.0.5");
+
+  Ptr<dsr::RouteCache> rcache = CreateObject<dsr::RouteCache> ();
+  rcache->SetCacheType ("LinkCache");
+  rcache->SetInitStability (Seconds (25));
+  rcache->SetMinLifeTime (Seconds (1));
+  rcache->SetStabilityDecrFactor (2);
+  rcache->SetStabilityIncrFactor (4);
+  rcache->SetCacheTimeout (Seconds (300));
+
+  std::vector<Ipv4Address> ip;
+  ip.push_back (a);
+  ip.push_back (b);
+  ip.push_back (c);
+  ip.push_back (d);
+  NS_TEST_EXPECT_MSG_EQ (rcache->AddRoute_Link (ip, a), true, "trivial");
+  std::vector<Ipv4Address> ip2;
+  ip2.push_back (a);
+  ip2.push_back (e);
+  ip2.push_back (d);
+  NS_TEST_EXPECT_MSG_EQ (rcache->AddRoute_Link (ip2, a), true, "trivial");
+
+  dsr::RouteCacheEntry entry;
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (d, entry), true, "No route to d");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ().size (), 3, "Not the shortest route to d");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ()[1], e, "Not the shortest route to d");
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (c, entry), true, "No route to c");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ().size (), 3, "Wrong route to c");
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (Ipv4Address ("10.0.0.6"), entry), false, "Route to an unknown node");
+
+  // Break the link a-e, the route to d now goes through b and c
+  rcache->DeleteAllRoutesIncludeLink (a, e, a);
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (d, entry), true, "No route to d");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ().size (), 4, "Wrong route to d after the link break");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ()[1], b, "Wrong route to d after the link break");
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (e, entry), true, "No route to e");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ().size (), 5, "Wrong route to e after the link break");
+
+  Ptr<dsr::RouteCache> pcache = CreateObject<dsr::RouteCache> ();
+  pcache->SetCacheType ("PathCache");
+  pcache->SetMaxEntriesEachDst (2);
+  dsr::RouteCacheEntry route (ip, d, Seconds (10));
+  NS_TEST_EXPECT_MSG_EQ (pcache->AddRoute (route), true, "trivial");
+  // Sub route of the route to d
+  NS_TEST_EXPECT_MSG_EQ (pcache->LookupRoute (c, entry), true, "No sub route to c");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ().size (), 3, "Wrong sub route to c");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetDestination (), c, "Wrong sub route to c");
+  NS_TEST_EXPECT_MSG_EQ (pcache->LookupRoute (e, entry), false, "Route to an unknown node");
+  // Adding the same route again keeps a single entry, an expired route is not added
+  NS_TEST_EXPECT_MSG_EQ (pcache->AddRoute (route), true, "trivial");
+  dsr::RouteCacheEntry expired (ip2, d, Seconds (0));
+  NS_TEST_EXPECT_MSG_EQ (pcache->AddRoute (expired), false, "Expired route added");
+  NS_TEST_EXPECT_MSG_EQ (pcache->LookupRoute (d, entry), true, "No route to d");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ().size (), 4, "Wrong route to d");
+  NS_TEST_EXPECT_MSG_EQ (pcache->DeleteRoute (d), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (pcache->LookupRoute (d, entry), false, "Deleted route to d");
+}
+// -----------------------------------------------------------------------------
 // / Unit test for Send Buffer
 class DsrSendBuffTest : public TestCase
 {
@@ -516,6 +597,7 @@ public:
     AddTestCase (new DsrAckReqHeaderTest, TestCase::QUICK);
     AddTestCase (new DsrAckHeaderTest, TestCase::QUICK);
     AddTestCase (new DsrCacheEntryTest, TestCase::QUICK);
+    AddTestCase (new DsrRouteCacheLookupTest, TestCase::QUICK);
     AddTestCase (new DsrSendBuffTest, TestCase::QUICK);
   }
 } g_dsrTestSuite;
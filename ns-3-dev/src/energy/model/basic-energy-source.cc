@@ -50,7 +50,9 @@ BasicEnergySource::GetTypeId (void)
                                        &BasicEnergySource::GetSupplyVoltage),
                    MakeDoubleChecker<double> ())
     .AddAttribute ("PeriodicEnergyUpdateInterval",
-                   "Time between two consecutive periodic energy updates.",
+                   "Time between two consecutive periodic energy updates. When zero, "
+                   "the remaining energy is only updated on demand and when the load "
+                   "changes, and a single event is scheduled at the predicted depletion.",
                    TimeValue (Seconds (1.0)),
                    MakeTimeAccessor (&BasicEnergySource::SetEnergyUpdateInterval,
                                      &BasicEnergySource::GetEnergyUpdateInterval),
@@ -66,6 +68,7 @@ BasicEnergySource::BasicEnergySource ()
 {
   NS_LOG_FUNCTION (this);
   m_lastUpdateTime = Seconds (0.0);
+  m_depletionPowerW = 0;
 }
 
 BasicEnergySource::~BasicEnergySource ()
@@ -147,6 +150,20 @@ BasicEnergySource::UpdateEnergySource (void)
       return;
     }
 
+  if (m_energyUpdateInterval.IsZero ())
+    {
+      CalculateRemainingEnergy ();
+      m_lastUpdateTime = Simulator::Now ();
+      if (m_remainingEnergyJ <= 0)
+        {
+          m_energyUpdateEvent.Cancel ();
+          HandleEnergyDrainedEvent ();
+          return;
+        }
+      ScheduleDepletionEvent ();
+      return;
+    }
+
   m_energyUpdateEvent.Cancel ();
 
   CalculateRemainingEnergy ();
@@ -164,6 +181,19 @@ BasicEnergySource::UpdateEnergySource (void)
                                              this);
 }
 
+void
+BasicEnergySource::NotifyLoadChanged (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_energyUpdateInterval.IsZero () || Simulator::IsFinished ()
+      || m_remainingEnergyJ <= 0)
+    {
+      return;
+    }
+  // the remaining energy was updated just before the change of load
+  ScheduleDepletionEvent ();
+}
+
 /*
  * Private functions start here.
  */
@@ -204,4 +234,41 @@ BasicEnergySource::CalculateRemainingEnergy (void)
   NS_LOG_DEBUG ("BasicEnergySource:Remaining energy = " << m_remainingEnergyJ);
 }
 
+void
+BasicEnergySource::ScheduleDepletionEvent (void)
+{
+  NS_LOG_FUNCTION (this);
+  double powerW = CalculateTotalCurrent () * m_supplyVoltageV;
+  // the energy decreases linearly, the prediction holds until the load changes
+  if (m_energyUpdateEvent.IsRunning () && powerW == m_depletionPowerW)
+    {
+      return;
+    }
+  m_energyUpdateEvent.Cancel ();
+  m_depletionPowerW = powerW;
+  if (powerW <= 0)
+    {
+      return;
+    }
+  double delayS = m_remainingEnergyJ / powerW;
+  if (delayS >= (Simulator::GetMaximumSimulationTime () - Simulator::Now ()).GetSeconds ())
+    {
+      return; // never depleted
+    }
+  NS_LOG_DEBUG ("BasicEnergySource:Energy depleted in " << delayS << "s");
+  m_energyUpdateEvent = Simulator::Schedule (Seconds (delayS),
+                                             &BasicEnergySource::HandleDepletionEvent,
+                                             this);
+}
+
+void
+BasicEnergySource::HandleDepletionEvent (void)
+{
+  NS_LOG_FUNCTION (this);
+  CalculateRemainingEnergy ();
+  m_lastUpdateTime = Simulator::Now ();
+  // ignore the rounding of the depletion time to the time resolution
+  HandleEnergyDrainedEvent ();
+}
+
 } // namespace ns3
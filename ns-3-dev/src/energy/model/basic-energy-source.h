@@ -33,6 +33,12 @@ namespace ns3 {
  * BasicEnergySource decreases/increases remaining energy stored in itself in
  * linearly.
  *
+ * By default, the remaining energy is updated every
+ * PeriodicEnergyUpdateInterval. When this interval is zero, the source does
+ * not update itself periodically: since the current drawn is constant
+ * between two state changes of the device energy models, the remaining
+ * energy is integrated when it is requested or when the load changes, and a
+ * single event is scheduled at the predicted depletion time.
  */
 class BasicEnergySource : public EnergySource
 {
@@ -74,6 +80,12 @@ public:
    */
   virtual void UpdateEnergySource (void);
 
+  /**
+   * Implements NotifyLoadChanged. Reschedules the depletion event when the
+   * periodic updates are disabled.
+   */
+  virtual void NotifyLoadChanged (void);
+
   /**
    * \param initialEnergyJ Initial energy, in Joules
    *
@@ -127,13 +139,27 @@ private:
    */
   void CalculateRemainingEnergy (void);
 
+  /**
+   * Schedules the depletion of the energy at the current total load, if it
+   * changed since the last prediction. Used when the periodic updates are
+   * disabled.
+   */
+  void ScheduleDepletionEvent (void);
+
+  /**
+   * Handles the predicted depletion of the energy. The load has not changed
+   * since the event was scheduled.
+   */
+  void HandleDepletionEvent (void);
+
 private:
   double m_initialEnergyJ;                // initial energy, in Joules
   double m_supplyVoltageV;                // supply voltage, in Volts
   TracedValue<double> m_remainingEnergyJ; // remaining energy, in Joules
-  EventId m_energyUpdateEvent;            // energy update event
+  EventId m_energyUpdateEvent;            // energy update or depletion event
   Time m_lastUpdateTime;                  // last update time
   Time m_energyUpdateInterval;            // energy update interval
+  double m_depletionPowerW;               // load of the predicted depletion, in Watts
 
 };
 
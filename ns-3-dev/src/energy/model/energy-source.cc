@@ -101,6 +101,12 @@ EnergySource::FindDeviceEnergyModels (std::string name)
   return container;
 }
 
+void
+EnergySource::NotifyLoadChanged (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
 void
 EnergySource::InitializeDeviceModels (void)
 {
@@ -110,6 +110,15 @@ public:
    */
   virtual void UpdateEnergySource (void) = 0;
 
+  /**
+   * Called by DeviceEnergyModels right after they change the current they
+   * draw, UpdateEnergySource having been called before the change. Energy
+   * sources which do not update their remaining energy periodically use it
+   * to predict their depletion time with the new total current. The default
+   * implementation does nothing.
+   */
+  virtual void NotifyLoadChanged (void);
+
   /**
    * \brief Sets pointer to node containing this EnergySource.
    *
@@ -20,6 +20,7 @@
 
 #include "ns3/basic-energy-source.h"
 #include "ns3/wifi-radio-energy-model.h"
+#include "ns3/simple-device-energy-model.h"
 #include "ns3/basic-energy-source-helper.h"
 #include "ns3/wifi-radio-energy-model-helper.h"
 #include "ns3/energy-source-container.h"
@@ -366,6 +367,100 @@ BasicEnergyDepletionTest::DepletionTestCase (double simTimeS,
 
 // -------------------------------------------------------------------------- //
 
+/**
+ * Test case of the BasicEnergySource without periodic updates: the remaining
+ * energy is integrated when the load changes and a single event is scheduled
+ * at the predicted depletion time.
+ */
+class BasicEnergyLazyUpdateTest : public TestCase
+{
+public:
+  BasicEnergyLazyUpdateTest ();
+  virtual ~BasicEnergyLazyUpdateTest ();
+
+private:
+  void DoRun (void);
+
+  /**
+   * \param oldValue Previous remaining energy, in Joules.
+   * \param newValue New remaining energy, in Joules.
+   *
+   * Records the time of the last change of the remaining energy.
+   */
+  void RemainingEnergy (double oldValue, double newValue);
+
+  /**
+   * Checks the remaining energy while the source is draining.
+   */
+  void CheckRemainingEnergy (Ptr<BasicEnergySource> source, double expectedJ);
+
+private:
+  double m_lastChangeS;     // time of the last change of remaining energy
+  double m_lastValueJ;      // last remaining energy traced
+  double m_tolerance;       // tolerance for energy and time estimation
+};
+
+BasicEnergyLazyUpdateTest::BasicEnergyLazyUpdateTest ()
+  : TestCase ("Basic energy source without periodic updates test case")
+{
+  m_tolerance = 1.0e-9;
+}
+
+BasicEnergyLazyUpdateTest::~BasicEnergyLazyUpdateTest ()
+{
+}
+
+void
+BasicEnergyLazyUpdateTest::RemainingEnergy (double oldValue, double newValue)
+{
+  m_lastChangeS = Simulator::Now ().GetSeconds ();
+  m_lastValueJ = newValue;
+}
+
+void
+BasicEnergyLazyUpdateTest::CheckRemainingEnergy (Ptr<BasicEnergySource> source,
+                                                 double expectedJ)
+{
+  NS_TEST_ASSERT_MSG_EQ_TOL (source->GetRemainingEnergy (), expectedJ, m_tolerance,
+                             "Incorrect remaining energy!");
+}
+
+void
+BasicEnergyLazyUpdateTest::DoRun (void)
+{
+  m_lastChangeS = 0;
+  m_lastValueJ = -1;
+
+  Ptr<BasicEnergySource> source = CreateObject<BasicEnergySource> ();
+  source->SetInitialEnergy (10.0);
+  source->SetSupplyVoltage (3.0);
+  source->SetEnergyUpdateInterval (Seconds (0));
+  source->TraceConnectWithoutContext ("RemainingEnergy",
+                                      MakeCallback (&BasicEnergyLazyUpdateTest::RemainingEnergy, this));
+  Ptr<SimpleDeviceEnergyModel> model = CreateObject<SimpleDeviceEnergyModel> ();
+  model->SetEnergySource (source);
+  source->AppendDeviceEnergyModel (model);
+  source->Initialize ();
+
+  // 0.3 W from 1 s: 7.3 J left at 10 s, then 1.5 W until depletion
+  Simulator::Schedule (Seconds (1.0), &SimpleDeviceEnergyModel::SetCurrentA, model, 0.1);
+  Simulator::Schedule (Seconds (10.0), &SimpleDeviceEnergyModel::SetCurrentA, model, 0.5);
+  Simulator::Schedule (Seconds (12.0), &BasicEnergyLazyUpdateTest::CheckRemainingEnergy,
+                       this, source, 4.3);
+  Simulator::Run ();
+
+  double depletionS = 10.0 + 7.3 / 1.5;
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_lastChangeS, depletionS, m_tolerance, "Incorrect depletion time!");
+  NS_TEST_ASSERT_MSG_EQ (m_lastValueJ, 0, "Energy not depleted!");
+  // the three scheduled events, the depletion event predicted at 1 s and
+  // cancelled at 10 s, which the simulator still counts, and the actual
+  // depletion event; no periodic update
+  NS_TEST_ASSERT_MSG_EQ (Simulator::GetEventCount (), 5, "Unexpected number of events!");
+  Simulator::Destroy ();
+}
+
+// -------------------------------------------------------------------------- //
+
 /**
  * Unit test suite for energy model. Although the test suite involves 2 modules
  * it is still considered a unit test. Because a DeviceEnergyModel cannot live
@@ -382,6 +477,7 @@ BasicEnergyModelTestSuite::BasicEnergyModelTestSuite ()
 {
   AddTestCase (new BasicEnergyUpdateTest, TestCase::QUICK);
   AddTestCase (new BasicEnergyDepletionTest, TestCase::QUICK);
+  AddTestCase (new BasicEnergyLazyUpdateTest, TestCase::QUICK);
 }
 
 // create an instance of the test suite
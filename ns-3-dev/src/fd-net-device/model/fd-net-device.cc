@@ -36,42 +36,226 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <poll.h>
 #include <unistd.h>
 #include <arpa/inet.h>
 #include <net/ethernet.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
 
 NS_LOG_COMPONENT_DEFINE ("FdNetDevice");
 
 namespace ns3 {
 
+/**
+ * Layout of the buffers filled by FdNetDeviceFdReader: the size of the
+ * frame slots, the number of slots, the size of the frame in each slot,
+ * then the slots themselves.
+ */
+enum
+{
+  BATCH_SLOT_SIZE = 0,
+  BATCH_SLOTS = 1,
+  BATCH_LENGTHS = 2
+};
+
+/// Maximum number of buffers kept for reuse by a reader.
+static const uint32_t MAX_FREE_BUFFERS = 16;
+
+static bool
+IsSocket (int fd)
+{
+  struct stat st;
+  return fstat (fd, &st) == 0 && S_ISSOCK (st.st_mode);
+}
+
 FdNetDeviceFdReader::FdNetDeviceFdReader ()
-  : m_bufferSize (65536) // Defaults to maximum TCP window size
+  : m_bufferSize (65536), // Defaults to maximum TCP window size
+    m_batchSize (1),
+    m_isSocket (-1)
+{
+}
+
+FdNetDeviceFdReader::~FdNetDeviceFdReader ()
 {
+  for (std::vector<uint8_t *>::iterator i = m_freeBuffers.begin (); i != m_freeBuffers.end (); ++i)
+    {
+      free (*i);
+    }
 }
 
 void
 FdNetDeviceFdReader::SetBufferSize (uint32_t bufferSize)
 {
+  NS_ASSERT (m_freeBuffers.empty ());
   m_bufferSize = bufferSize;
 }
 
+void
+FdNetDeviceFdReader::SetBatchSize (uint32_t batchSize)
+{
+  NS_ASSERT (m_freeBuffers.empty ());
+  m_batchSize = std::max (batchSize, (uint32_t)1);
+}
+
+uint8_t *
+FdNetDeviceFdReader::AllocateBuffer (void)
+{
+  {
+    CriticalSection cs (m_freeBuffersMutex);
+    if (!m_freeBuffers.empty ())
+      {
+        uint8_t *batch = m_freeBuffers.back ();
+        m_freeBuffers.pop_back ();
+        return batch;
+      }
+  }
+  uint32_t header = (BATCH_LENGTHS + m_batchSize) * sizeof (uint32_t);
+  uint8_t *batch = (uint8_t *)malloc (header + m_batchSize * m_bufferSize);
+  NS_ABORT_MSG_IF (batch == 0, "malloc() failed");
+  uint32_t *words = reinterpret_cast<uint32_t *> (batch);
+  words[BATCH_SLOT_SIZE] = m_bufferSize;
+  words[BATCH_SLOTS] = m_batchSize;
+  return batch;
+}
+
+void
+FdNetDeviceFdReader::ReleaseBuffer (uint8_t *batch)
+{
+  uint32_t *words = reinterpret_cast<uint32_t *> (batch);
+  if (words[BATCH_SLOT_SIZE] == m_bufferSize && words[BATCH_SLOTS] == m_batchSize)
+    {
+      CriticalSection cs (m_freeBuffersMutex);
+      if (m_freeBuffers.size () < MAX_FREE_BUFFERS)
+        {
+          m_freeBuffers.push_back (batch);
+          return;
+        }
+    }
+  free (batch);
+}
+
+uint8_t *
+FdNetDeviceFdReader::GetFrame (uint8_t *batch, uint32_t index, ssize_t &len)
+{
+  uint32_t *words = reinterpret_cast<uint32_t *> (batch);
+  NS_ASSERT (index < words[BATCH_SLOTS]);
+  len = words[BATCH_LENGTHS + index];
+  uint32_t header = (BATCH_LENGTHS + words[BATCH_SLOTS]) * sizeof (uint32_t);
+  return batch + header + index * words[BATCH_SLOT_SIZE];
+}
+
+/**
+ * \returns true if a failed read or receive can be tried again later
+ */
+static bool
+IsTransientError (void)
+{
+  return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+ssize_t
+FdNetDeviceFdReader::ReadFrames (uint8_t *batch)
+{
+  uint32_t *lengths = reinterpret_cast<uint32_t *> (batch) + BATCH_LENGTHS;
+  ssize_t len;
+
+  if (m_isSocket < 0)
+    {
+      m_isSocket = IsSocket (m_fd);
+    }
+
+#ifdef HAVE_RECVMMSG
+  if (m_isSocket)
+    {
+      // Block until the first frame is received, then take all the
+      // frames already queued in the socket.
+      std::vector<struct mmsghdr> msgs (m_batchSize);
+      std::vector<struct iovec> iovecs (m_batchSize);
+      for (uint32_t i = 0; i < m_batchSize; i++)
+        {
+          iovecs[i].iov_base = GetFrame (batch, i, len);
+          iovecs[i].iov_len = m_bufferSize;
+          memset (&msgs[i].msg_hdr, 0, sizeof (msgs[i].msg_hdr));
+          msgs[i].msg_hdr.msg_iov = &iovecs[i];
+          msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+      NS_LOG_LOGIC ("Calling recvmmsg on fd " << m_fd);
+      int n;
+      do
+        {
+          n = recvmmsg (m_fd, &msgs[0], m_batchSize, MSG_WAITFORONE, 0);
+        }
+      while (n < 0 && errno == EINTR);
+      if (n < 0 && IsTransientError ())
+        {
+          // Nothing to read after all, wait for the next frame.
+          return -1;
+        }
+      if (n <= 0)
+        {
+          return 0;
+        }
+      for (int i = 0; i < n; i++)
+        {
+          lengths[i] = msgs[i].msg_len;
+        }
+      return n;
+    }
+#endif
+
+  // Read the first frame, then the next ones as long as the file
+  // descriptor has some to read without blocking.
+  uint32_t n = 0;
+  while (n < m_batchSize)
+    {
+      if (n > 0)
+        {
+          struct pollfd pfd;
+          pfd.fd = m_fd;
+          pfd.events = POLLIN;
+          if (poll (&pfd, 1, 0) <= 0 || !(pfd.revents & POLLIN))
+            {
+              break;
+            }
+        }
+      NS_LOG_LOGIC ("Calling read on fd " << m_fd);
+      do
+        {
+          len = read (m_fd, GetFrame (batch, n, len), m_bufferSize);
+        }
+      while (len < 0 && errno == EINTR);
+      if (len < 0 && n == 0 && IsTransientError ())
+        {
+          return -1;
+        }
+      if (len <= 0)
+        {
+          break;
+        }
+      lengths[n++] = len;
+    }
+  return n;
+}
+
 FdReader::Data FdNetDeviceFdReader::DoRead (void)
 {
   NS_LOG_FUNCTION (this);
 
-  uint8_t *buf = (uint8_t *)malloc (m_bufferSize);
-  NS_ABORT_MSG_IF (buf == 0, "malloc() failed");
-
-  NS_LOG_LOGIC ("Calling read on fd " << m_fd);
-  ssize_t len = read (m_fd, buf, m_bufferSize);
-  if (len <= 0)
+  uint8_t *batch = AllocateBuffer ();
+  ssize_t n = ReadFrames (batch);
+  if (n <= 0)
     {
-      free (buf);
-      buf = 0;
-      len = 0;
+      // A negative length is ignored by FdReader, a zero one stops it.
+      ReleaseBuffer (batch);
+      return FdReader::Data (0, n);
     }
 
-  return FdReader::Data (buf, len);
+  NS_LOG_LOGIC ("Read " << n << " frames from fd " << m_fd);
+  return FdReader::Data (batch, n);
 }
 
 NS_OBJECT_ENSURE_REGISTERED (FdNetDevice);
@@ -111,6 +295,21 @@ FdNetDevice::GetTypeId (void)
                    UintegerValue (1000),
                    MakeUintegerAccessor (&FdNetDevice::m_maxPendingReads),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("RxBatchSize", "Maximum number of frames read from the "
+                   "file descriptor at once.  All the frames of a read are "
+                   "received by the device in a single simulation event.",
+                   UintegerValue (32),
+                   MakeUintegerAccessor (&FdNetDevice::m_rxBatchSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("TxBatchSize", "Maximum number of frames written to the "
+                   "file descriptor at once.  If greater than one, the frames "
+                   "sent at the same simulation time are queued and written "
+                   "together after the current event, or as soon as the "
+                   "queue is full; the MacTxDrop trace reports the frames "
+                   "which could not be written.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&FdNetDevice::m_txBatchSize),
+                   MakeUintegerChecker<uint32_t> (1))
     //
     // Trace sources at the "top" of the net device, where packets transition
     // to/from higher layers.  These points do not really correspond to the
@@ -156,6 +355,7 @@ FdNetDevice::FdNetDevice ()
     m_isBroadcast (true),
     m_isMulticast (false),
     m_pendingReadCount (0),
+    m_txIsSocket (-1),
     m_startEvent (),
     m_stopEvent ()
 {
@@ -231,7 +431,11 @@ FdNetDevice::StartDevice (void)
 
   m_fdReader = Create<FdNetDeviceFdReader> ();
   m_fdReader->SetBufferSize(m_mtu);
-  m_fdReader->Start (m_fd, MakeCallback (&FdNetDevice::ReceiveCallback, this));
+  m_fdReader->SetBatchSize (m_rxBatchSize);
+  // The read thread releases the buffers it cannot queue through the
+  // reader it runs for, never through m_fdReader.
+  m_fdReader->Start (m_fd, MakeCallback (&FdNetDevice::ReceiveCallback, this)
+                     .Bind (PeekPointer (m_fdReader)));
 
   NotifyLinkUp ();
 }
@@ -241,6 +445,12 @@ FdNetDevice::StopDevice (void)
 {
   NS_LOG_FUNCTION (this);
 
+  if (!m_txPackets.empty ())
+    {
+      Simulator::Cancel (m_txFlushEvent);
+      FlushTx ();
+    }
+
   if (m_fdReader != 0)
     {
       m_fdReader->Stop ();
@@ -255,11 +465,12 @@ FdNetDevice::StopDevice (void)
 }
 
 void
-FdNetDevice::ReceiveCallback (uint8_t *buf, ssize_t len)
+FdNetDevice::ReceiveCallback (FdNetDeviceFdReader *reader, uint8_t *buf, ssize_t len)
 {
-  NS_LOG_FUNCTION (this << buf << len);
+  NS_LOG_FUNCTION (this << reader << buf << len);
   bool skip = false;
 
+  // buf holds a batch of len frames
   {
     CriticalSection cs (m_pendingReadMutex);
     if (m_pendingReadCount >= m_maxPendingReads)
@@ -269,69 +480,81 @@ FdNetDevice::ReceiveCallback (uint8_t *buf, ssize_t len)
       }
     else
       {
-        ++m_pendingReadCount;
+        m_pendingReadCount += len;
       }
   }
 
   if (skip)
     {
+      reader->ReleaseBuffer (buf);
       struct timespec time = { 0, 100000000L }; // 100 ms
       nanosleep (&time, NULL);
     }
   else
     {
-      Simulator::ScheduleWithContext (m_nodeId, Time (0), MakeEvent (&FdNetDevice::ForwardUp, this, buf, len));
+      Simulator::ScheduleWithContext (m_nodeId, Time (0), MakeEvent (&FdNetDevice::ForwardUpBatch, this, buf, len));
    }
 }
 
-/// \todo Consider having a instance member m_packetBuffer and using memmove
-///  instead of memcpy to add the PI header.
-///  It might be faster in this case to use memmove and avoid the extra mallocs.
+/**
+ * Write the PI header of a frame for our friend the kernel.
+ *
+ * \param buf the buffer holding the frame after 4 free bytes
+ * \param len the size of the frame
+ */
 static void
-AddPIHeader (uint8_t *&buf, ssize_t &len)
+AddPIHeader (uint8_t *buf, ssize_t len)
 {
-  // Synthesize PI header for our friend the kernel
-  uint8_t *buf2 = (uint8_t*)malloc (len + 4);
-  memcpy (buf2 + 4, buf, len);
-  len += 4;
-
   // PI = 16 bits flags (0) + 16 bits proto
   // NOTE: be careful to interpret buffer data explicitly as
   //  little-endian to be insensible to native byte ordering.
+  uint8_t *frame = buf + 4;
   uint16_t flags = 0;
   uint16_t proto = 0x0008; // default to IPv4
   if (len > 14)
     {
-      if (buf[12] == 0x81 && buf[13] == 0x00 && len > 18)
+      if (frame[12] == 0x81 && frame[13] == 0x00 && len > 18)
         {
           // tagged ethernet packet
-          proto = buf[16] | (buf[17] << 8);
+          proto = frame[16] | (frame[17] << 8);
         }
       else
         {
           // untagged ethernet packet
-          proto = buf[12] | (buf[13] << 8);
+          proto = frame[12] | (frame[13] << 8);
         }
     }
-  buf2[0] = (uint8_t)flags;
-  buf2[1] = (uint8_t)(flags >> 8);
-  buf2[2] = (uint8_t)proto;
-  buf2[3] = (uint8_t)(proto >> 8);
-
-  // swap buffer
-  free (buf);
-  buf = buf2;
+  buf[0] = (uint8_t)flags;
+  buf[1] = (uint8_t)(flags >> 8);
+  buf[2] = (uint8_t)proto;
+  buf[3] = (uint8_t)(proto >> 8);
 }
 
-static void
-RemovePIHeader (uint8_t *&buf, ssize_t &len)
+void
+FdNetDevice::ForwardUpBatch (uint8_t *batch, ssize_t count)
 {
-  // strip PI header if present, shrink buffer
-  if (len >= 4)
+  NS_LOG_FUNCTION (this << batch << count);
+
+  {
+    CriticalSection cs (m_pendingReadMutex);
+    m_pendingReadCount -= std::min (m_pendingReadCount, (uint32_t)count);
+  }
+
+  for (ssize_t i = 0; i < count; i++)
     {
-      len -= 4;
-      memmove (buf, buf + 4, len);
-      buf = (uint8_t*)realloc (buf, len);
+      ssize_t len;
+      uint8_t *buf = FdNetDeviceFdReader::GetFrame (batch, i, len);
+      ForwardUp (buf, len);
+    }
+
+  // The reader is gone if the device was stopped meanwhile.
+  if (m_fdReader != 0)
+    {
+      m_fdReader->ReleaseBuffer (batch);
+    }
+  else
+    {
+      free (batch);
     }
 }
 
@@ -340,26 +563,18 @@ FdNetDevice::ForwardUp (uint8_t *buf, ssize_t len)
 {
   NS_LOG_FUNCTION (this << buf << len);
 
-  if (m_pendingReadCount > 0)
+  // We need to skip the PI header and ignore it
+  if (m_encapMode == DIXPI && len >= 4)
     {
-      {
-        CriticalSection cs (m_pendingReadMutex);
-        --m_pendingReadCount;
-      }
-    }
-
-  // We need to remove the PI header and ignore it
-  if (m_encapMode == DIXPI)
-    {
-      RemovePIHeader (buf, len);
+      buf += 4;
+      len -= 4;
     }
 
   //
-  // Create a packet out of the buffer we received and free that buffer.
+  // Create a packet out of the buffer we received.  The buffer belongs
+  // to the batch being forwarded up.
   //
   Ptr<Packet> packet = Create<Packet> (reinterpret_cast<const uint8_t *> (buf), len);
-  free (buf);
-  buf = 0;
 
   //
   // Trace sinks will expect complete packets, not packets without some of the
@@ -527,27 +742,122 @@ FdNetDevice::SendFrom (Ptr<Packet> packet, const Address& src, const Address& de
   NS_ASSERT_MSG (packet->GetSize () <= m_mtu, "FdNetDevice::SendFrom(): Packet too big " << packet->GetSize ());
 
   ssize_t len =  (ssize_t) packet->GetSize ();
-  uint8_t *buffer = (uint8_t*)malloc (len);
-  packet->CopyData (buffer, len);
+
+  // Each frame is built in its slot of the transmission buffer, after
+  // room for the PI header.
+  uint32_t slotSize = m_mtu + 4;
+  uint32_t slots = std::max (m_txBatchSize, (uint32_t)1);
+  if (m_txBuffer.size () != slots * slotSize)
+    {
+      NS_ASSERT (m_txPackets.empty ());
+      m_txBuffer.resize (slots * slotSize);
+    }
+  uint8_t *buffer = &m_txBuffer[m_txPackets.size () * slotSize];
+  packet->CopyData (buffer + 4, len);
 
   // We need to add the PI header
   if (m_encapMode == DIXPI)
     {
       AddPIHeader (buffer, len);
+      len += 4;
+    }
+  else
+    {
+      buffer += 4;
     }
 
-  ssize_t written = write (m_fd, buffer, len);
-  free (buffer);
+  if (slots == 1)
+    {
+      ssize_t written = write (m_fd, buffer, len);
+      if (written == -1 || written != len)
+        {
+          m_macTxDropTrace (packet);
+          return false;
+        }
+      return true;
+    }
 
-  if (written == -1 || written != len)
+  m_txLengths.push_back (len);
+  m_txPackets.push_back (packet);
+  if (m_txPackets.size () == slots)
     {
-      m_macTxDropTrace (packet);
-      return false;
+      Simulator::Cancel (m_txFlushEvent);
+      FlushTx ();
+    }
+  else if (!m_txFlushEvent.IsRunning ())
+    {
+      m_txFlushEvent = Simulator::ScheduleNow (&FdNetDevice::FlushTx, this);
     }
 
   return true;
 }
 
+void
+FdNetDevice::FlushTx (void)
+{
+  NS_LOG_FUNCTION (this << m_txPackets.size ());
+
+  uint32_t count = m_txPackets.size ();
+  uint32_t slotSize = m_mtu + 4;
+  uint32_t offset = (m_encapMode == DIXPI) ? 0 : 4;
+  std::vector<bool> sent (count, false);
+
+  if (m_txIsSocket < 0)
+    {
+      m_txIsSocket = IsSocket (m_fd);
+    }
+
+#ifdef HAVE_RECVMMSG
+  if (m_txIsSocket)
+    {
+      std::vector<struct mmsghdr> msgs (count);
+      std::vector<struct iovec> iovecs (count);
+      for (uint32_t i = 0; i < count; i++)
+        {
+          iovecs[i].iov_base = &m_txBuffer[i * slotSize + offset];
+          iovecs[i].iov_len = m_txLengths[i];
+          memset (&msgs[i].msg_hdr, 0, sizeof (msgs[i].msg_hdr));
+          msgs[i].msg_hdr.msg_iov = &iovecs[i];
+          msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+      // sendmmsg stops at the first frame which cannot be sent; try
+      // the next ones, as consecutive writes would.
+      uint32_t next = 0;
+      while (next < count)
+        {
+          int n = sendmmsg (m_fd, &msgs[next], count - next, 0);
+          if (n <= 0)
+            {
+              next++;
+              continue;
+            }
+          for (int i = 0; i < n; i++, next++)
+            {
+              sent[next] = (msgs[next].msg_len == m_txLengths[next]);
+            }
+        }
+    }
+  else
+#endif
+    {
+      for (uint32_t i = 0; i < count; i++)
+        {
+          ssize_t written = write (m_fd, &m_txBuffer[i * slotSize + offset], m_txLengths[i]);
+          sent[i] = (written == (ssize_t)m_txLengths[i]);
+        }
+    }
+
+  for (uint32_t i = 0; i < count; i++)
+    {
+      if (!sent[i])
+        {
+          m_macTxDropTrace (m_txPackets[i]);
+        }
+    }
+  m_txLengths.clear ();
+  m_txPackets.clear ();
+}
+
 void
 FdNetDevice::SetFileDescriptor (int fd)
 {
@@ -37,9 +37,22 @@
 #include "ns3/system-mutex.h"
 
 #include <string.h>
+#include <vector>
 
 namespace ns3 {
 
+/**
+ * \ingroup fd-net-device
+ *
+ * \brief reader of batches of frames from the file descriptor of a FdNetDevice
+ *
+ * Each read returns all the frames available on the file descriptor, up
+ * to the batch size, using a single recvmmsg() call on sockets. The frames
+ * are stored in a single buffer, and the read callback is given that
+ * buffer and the number of frames it holds. GetFrame gives access to each
+ * frame of the batch. Buffers given back with ReleaseBuffer are reused by
+ * later reads instead of being allocated again.
+ */
 class FdNetDeviceFdReader : public FdReader
 {
 public:
@@ -47,6 +60,7 @@ public:
    * Constructor for the FdNetDevice.
    */
   FdNetDeviceFdReader ();
+  ~FdNetDeviceFdReader ();
 
   /**
    * Set size of the read buffer.
@@ -54,10 +68,44 @@ public:
    */
   void SetBufferSize (uint32_t bufferSize);
 
+  /**
+   * Set the maximum number of frames read at once.
+   *
+   */
+  void SetBatchSize (uint32_t batchSize);
+
+  /**
+   * Give back a buffer passed to the read callback, so that it can be
+   * reused by a later read. This method can be called from any thread.
+   *
+   * \param batch the buffer to release
+   */
+  void ReleaseBuffer (uint8_t *batch);
+
+  /**
+   * \param batch a buffer passed to the read callback
+   * \param index the index of a frame in the batch
+   * \param len the size of the frame
+   * \returns the start of the frame
+   */
+  static uint8_t *GetFrame (uint8_t *batch, uint32_t index, ssize_t &len);
+
 private:
   FdReader::Data DoRead (void);
-  
+  uint8_t *AllocateBuffer (void);
+  /**
+   * \param batch the buffer to fill
+   * \returns the number of frames read, zero on end of file or error,
+   * or a negative value if no frame could be read yet
+   */
+  ssize_t ReadFrames (uint8_t *batch);
+
   uint32_t m_bufferSize;
+  uint32_t m_batchSize;
+  /// Zero if the file descriptor is not a socket, negative if unknown yet.
+  int m_isSocket;
+  std::vector<uint8_t *> m_freeBuffers;
+  SystemMutex m_freeBuffersMutex;
 };
 
 class Node;
@@ -198,9 +246,10 @@ private:
   /**
    * \internal
    *
-   * Callback to invoke when a new frame is received
+   * Callback to invoke, in the read thread, when a batch of frames is
+   * received by a reader
    */
-  void ReceiveCallback (uint8_t *buf, ssize_t len);
+  void ReceiveCallback (FdNetDeviceFdReader *reader, uint8_t *buf, ssize_t len);
 
   /**
    * \internal
@@ -209,6 +258,21 @@ private:
    */
   void ForwardUp (uint8_t *buf, ssize_t len);
 
+  /**
+   * \internal
+   *
+   * Forward up all the frames of a batch read from the file descriptor
+   * and release the batch.
+   */
+  void ForwardUpBatch (uint8_t *batch, ssize_t count);
+
+  /**
+   * \internal
+   *
+   * Write all the frames queued for transmission.
+   */
+  void FlushTx (void);
+
   /**
    * Start Sending a Packet Down the Wire.
    * @param p packet to send
@@ -329,6 +393,57 @@ private:
    */
   SystemMutex m_pendingReadMutex;
 
+  /**
+   * \internal
+   *
+   * Maximum number of frames read from the file descriptor at once.
+   */
+  uint32_t m_rxBatchSize;
+
+  /**
+   * \internal
+   *
+   * Maximum number of frames queued before being written to the file
+   * descriptor at once.
+   */
+  uint32_t m_txBatchSize;
+
+  /**
+   * \internal
+   *
+   * Frames queued for transmission, each in a slot of m_mtu + 4 bytes.
+   * The buffer is kept from one transmission to the next.
+   */
+  std::vector<uint8_t> m_txBuffer;
+
+  /**
+   * \internal
+   *
+   * Size of each frame queued for transmission.
+   */
+  std::vector<uint32_t> m_txLengths;
+
+  /**
+   * \internal
+   *
+   * Packets queued for transmission, for the MacTxDrop trace.
+   */
+  std::vector<Ptr<Packet> > m_txPackets;
+
+  /**
+   * \internal
+   *
+   * Zero if the file descriptor is not a socket, negative if unknown yet.
+   */
+  int m_txIsSocket;
+
+  /**
+   * \internal
+   *
+   * Event writing the queued frames.
+   */
+  EventId m_txFlushEvent;
+
   /**
    * \internal
    *
@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/fd-net-device.h"
+#include "ns3/ethernet-header.h"
+#include "ns3/global-value.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-condition.h"
+#include "ns3/system-mutex.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace ns3;
+
+/// Number of frames written to the socket by the tests.
+static const uint32_t N_FRAMES = 5;
+
+/**
+ * Write N_FRAMES datagrams of increasing sizes to a socket.
+ */
+static void
+WriteFrames (int fd, uint32_t size)
+{
+  std::vector<uint8_t> frame (size + N_FRAMES);
+  for (uint32_t i = 0; i < N_FRAMES; i++)
+    {
+      std::fill (frame.begin (), frame.end (), i);
+      ssize_t len = write (fd, &frame[0], size + i);
+      NS_ASSERT (len == (ssize_t)(size + i));
+    }
+}
+
+/**
+ * Check that the frames queued in a datagram socket are read by
+ * batches of at most the batch size of the reader.
+ */
+class FdNetDeviceReaderBatchTestCase : public TestCase
+{
+public:
+  FdNetDeviceReaderBatchTestCase (uint32_t batchSize);
+  virtual void DoRun (void);
+
+private:
+  void Read (uint8_t *batch, ssize_t count);
+
+  uint32_t m_batchSize;
+  Ptr<FdNetDeviceFdReader> m_reader;
+  SystemMutex m_mutex;
+  SystemCondition m_done;
+  std::vector<ssize_t> m_batches;
+  std::vector<ssize_t> m_lengths;
+  std::vector<uint8_t> m_contents;
+};
+
+FdNetDeviceReaderBatchTestCase::FdNetDeviceReaderBatchTestCase (uint32_t batchSize)
+  : TestCase ("Check the batched reads of FdNetDeviceFdReader"),
+    m_batchSize (batchSize)
+{
+}
+
+void
+FdNetDeviceReaderBatchTestCase::Read (uint8_t *batch, ssize_t count)
+{
+  CriticalSection cs (m_mutex);
+  m_batches.push_back (count);
+  for (ssize_t i = 0; i < count; i++)
+    {
+      ssize_t len;
+      uint8_t *frame = FdNetDeviceFdReader::GetFrame (batch, i, len);
+      m_lengths.push_back (len);
+      m_contents.push_back (frame[len - 1]);
+    }
+  m_reader->ReleaseBuffer (batch);
+  if (m_lengths.size () == N_FRAMES)
+    {
+      m_done.SetCondition (true);
+      m_done.Signal ();
+    }
+}
+
+void
+FdNetDeviceReaderBatchTestCase::DoRun (void)
+{
+  int sv[2];
+  NS_TEST_ASSERT_MSG_EQ (socketpair (AF_UNIX, SOCK_DGRAM, 0, sv), 0, "socketpair() failed");
+
+  // Queue all the frames before the reader starts, so that they are
+  // available to the first read.
+  WriteFrames (sv[0], 100);
+
+  m_reader = Create<FdNetDeviceFdReader> ();
+  m_reader->SetBufferSize (1500);
+  m_reader->SetBatchSize (m_batchSize);
+  m_reader->Start (sv[1], MakeCallback (&FdNetDeviceReaderBatchTestCase::Read, this));
+  bool timedOut = m_done.TimedWait (5000000000ULL);
+  m_reader->Stop ();
+  close (sv[0]);
+  close (sv[1]);
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (timedOut, false, "not all the frames were read");
+  uint32_t batches = (N_FRAMES + m_batchSize - 1) / m_batchSize;
+  NS_TEST_ASSERT_MSG_EQ (m_batches.size (), batches, "wrong number of batches");
+  for (uint32_t i = 0; i < batches; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_batches[i], std::min (m_batchSize, N_FRAMES - i * m_batchSize),
+                             "wrong size of batch " << i);
+    }
+  for (uint32_t i = 0; i < N_FRAMES; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_lengths[i], 100 + i, "wrong length of frame " << i);
+      NS_TEST_EXPECT_MSG_EQ ((uint32_t)m_contents[i], i, "wrong contents of frame " << i);
+    }
+}
+
+/**
+ * Check that a FdNetDevice forwards up all the frames of the batches
+ * read from a datagram socket.
+ */
+class FdNetDeviceReceiveTestCase : public TestCase
+{
+public:
+  FdNetDeviceReceiveTestCase ();
+  virtual void DoRun (void);
+
+private:
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                uint16_t protocol, const Address &from);
+
+  std::vector<uint32_t> m_sizes;
+};
+
+FdNetDeviceReceiveTestCase::FdNetDeviceReceiveTestCase ()
+  : TestCase ("Check that FdNetDevice receives batches of frames")
+{
+}
+
+bool
+FdNetDeviceReceiveTestCase::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                     uint16_t protocol, const Address &from)
+{
+  m_sizes.push_back (packet->GetSize ());
+  return true;
+}
+
+void
+FdNetDeviceReceiveTestCase::DoRun (void)
+{
+  // The frames are forwarded up from the read thread, which needs a
+  // simulator implementation that accepts events from other threads.
+  StringValue impl;
+  GlobalValue::GetValueByName ("SimulatorImplementationType", impl);
+  GlobalValue::Bind ("SimulatorImplementationType",
+                     StringValue ("ns3::RealtimeSimulatorImpl"));
+
+  int sv[2];
+  NS_TEST_ASSERT_MSG_EQ (socketpair (AF_UNIX, SOCK_DGRAM, 0, sv), 0, "socketpair() failed");
+
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<FdNetDevice> device = CreateObject<FdNetDevice> ();
+  device->SetAttribute ("RxBatchSize", UintegerValue (2));
+  device->SetAddress (Mac48Address ("00:00:00:00:00:01"));
+  node->AddDevice (device);
+  device->SetFileDescriptor (sv[1]);
+  device->SetReceiveCallback (MakeCallback (&FdNetDeviceReceiveTestCase::Receive, this));
+
+  for (uint32_t i = 0; i < N_FRAMES; i++)
+    {
+      Ptr<Packet> packet = Create<Packet> (100 + i);
+      EthernetHeader header (false);
+      header.SetSource (Mac48Address ("00:00:00:00:00:02"));
+      header.SetDestination (Mac48Address ("00:00:00:00:00:01"));
+      header.SetLengthType (0x0800);
+      packet->AddHeader (header);
+      std::vector<uint8_t> frame (packet->GetSize ());
+      packet->CopyData (&frame[0], frame.size ());
+      NS_TEST_ASSERT_MSG_EQ (write (sv[0], &frame[0], frame.size ()), (ssize_t)frame.size (),
+                             "write() failed");
+    }
+
+  Simulator::Stop (Seconds (0.2));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  close (sv[0]);
+  GlobalValue::Bind ("SimulatorImplementationType", impl);
+
+  NS_TEST_ASSERT_MSG_EQ (m_sizes.size (), N_FRAMES, "not all the frames were received");
+  for (uint32_t i = 0; i < N_FRAMES; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_sizes[i], 100 + i, "wrong size of packet " << i);
+    }
+}
+
+class FdNetDeviceTestSuite : public TestSuite
+{
+public:
+  FdNetDeviceTestSuite ();
+};
+
+FdNetDeviceTestSuite::FdNetDeviceTestSuite ()
+  : TestSuite ("fd-net-device", UNIT)
+{
+  AddTestCase (new FdNetDeviceReaderBatchTestCase (1), TestCase::QUICK);
+  AddTestCase (new FdNetDeviceReaderBatchTestCase (2), TestCase::QUICK);
+  AddTestCase (new FdNetDeviceReaderBatchTestCase (8), TestCase::QUICK);
+  AddTestCase (new FdNetDeviceReceiveTestCase, TestCase::QUICK);
+}
+
+static FdNetDeviceTestSuite g_fdNetDeviceTestSuite;
@@ -55,6 +55,12 @@ FlowMonitorHelper::SetMonitorAttribute (std::string n1, const AttributeValue &v1
   m_monitorFactory.Set (n1, v1);
 }
 
+void
+FlowMonitorHelper::SetTraceFilter (Ptr<TraceFilter> filter)
+{
+  m_filter = filter;
+}
+
 
 Ptr<FlowMonitor>
 FlowMonitorHelper::GetMonitor ()
@@ -104,6 +110,7 @@ FlowMonitorHelper::Install (Ptr<Node> node)
       Ptr<Ipv4FlowProbe> probe = Create<Ipv4FlowProbe> (monitor,
                                                         DynamicCast<Ipv4FlowClassifier> (classifier),
                                                         node);
+      probe->SetTraceFilter (m_filter);
     }
   Ptr<FlowClassifier> classifier6 = GetClassifier6 ();
   Ptr<Ipv6L3Protocol> ipv6 = node->GetObject<Ipv6L3Protocol> ();
@@ -112,6 +119,7 @@ FlowMonitorHelper::Install (Ptr<Node> node)
       Ptr<Ipv6FlowProbe> probe6 = Create<Ipv6FlowProbe> (monitor,
                                                          DynamicCast<Ipv6FlowClassifier> (classifier6),
                                                          node);
+      probe6->SetTraceFilter (m_filter);
     }
   return m_flowMonitor;
 }
@@ -24,6 +24,7 @@
 #include "ns3/object-factory.h"
 #include "ns3/flow-monitor.h"
 #include "ns3/flow-classifier.h"
+#include "ns3/trace-filter.h"
 #include <string>
 
 namespace ns3 {
@@ -50,6 +51,16 @@ public:
    */
   void SetMonitorAttribute (std::string n1, const AttributeValue &v1);
 
+  /**
+   * \brief Set the filter of the probes installed afterwards
+   *
+   * The probes only report the packets sent which the filter accepts,
+   * see FlowProbe::SetTraceFilter.
+   *
+   * \param filter the filter, or 0 to report all the packets
+   */
+  void SetTraceFilter (Ptr<TraceFilter> filter);
+
   /**
    * \brief Enable flow monitoring on a set of nodes
    * \param nodes A NodeContainer holding the set of nodes to work with.
@@ -131,6 +142,7 @@ private:
   Ptr<FlowMonitor> m_flowMonitor;        //!< the FlowMonitor object
   Ptr<FlowClassifier> m_flowClassifier4; //!< the FlowClassifier object for IPv4
   Ptr<FlowClassifier> m_flowClassifier6; //!< the FlowClassifier object for IPv6
+  Ptr<TraceFilter> m_filter;             //!< the filter of the probes
 };
 
 } // namespace ns3
@@ -39,9 +39,16 @@ void
 FlowProbe::DoDispose (void)
 {
   m_flowMonitor = 0;
+  m_filter = 0;
   Object::DoDispose ();
 }
 
+void
+FlowProbe::SetTraceFilter (Ptr<TraceFilter> filter)
+{
+  m_filter = filter;
+}
+
 void
 FlowProbe::AddPacketStats (FlowId flowId, uint32_t packetSize, Time delayFromFirstProbe)
 {
@@ -27,6 +27,7 @@
 #include "ns3/object.h"
 #include "ns3/flow-classifier.h"
 #include "ns3/nstime.h"
+#include "ns3/trace-filter.h"
 
 namespace ns3 {
 
@@ -98,9 +99,16 @@ public:
   /// \param index FlowProbe index
   void SerializeToXmlStream (std::ostream &os, int indent, uint32_t index) const;
 
+  /// Only report the packets accepted by a filter when they are sent.
+  /// The packets rejected are not classified, and are ignored by all
+  /// the probes.
+  /// \param filter the filter, or 0 to report all the packets
+  virtual void SetTraceFilter (Ptr<TraceFilter> filter);
+
 protected:
   Ptr<FlowMonitor> m_flowMonitor; //!< the FlowMonitor instance
   Stats m_stats; //!< The flow stats
+  Ptr<TraceFilter> m_filter; //!< the filter of the packets sent
 
 };
 
@@ -235,9 +235,17 @@ Ipv4FlowProbe::DoDispose ()
 {
   m_ipv4 = 0;
   m_classifier = 0;
+  m_ipv4Filter = 0;
   FlowProbe::DoDispose ();
 }
 
+void
+Ipv4FlowProbe::SetTraceFilter (Ptr<TraceFilter> filter)
+{
+  FlowProbe::SetTraceFilter (filter);
+  m_ipv4Filter = DynamicCast<Ipv4TraceFilter> (filter);
+}
+
 void
 Ipv4FlowProbe::SendOutgoingLogger (const Ipv4Header &ipHeader, Ptr<const Packet> ipPayload, uint32_t interface)
 {
@@ -250,6 +258,17 @@ Ipv4FlowProbe::SendOutgoingLogger (const Ipv4Header &ipHeader, Ptr<const Packet>
       return;
     }
 
+  if (m_filter != 0)
+    {
+      bool accepted = (m_ipv4Filter != 0) ? m_ipv4Filter->Accept (ipHeader, ipPayload)
+        : m_filter->Accept (ipPayload);
+      if (!accepted)
+        {
+          // without a tag, the packet is ignored by the other probes
+          return;
+        }
+    }
+
   if (m_classifier->Classify (ipHeader, ipPayload, &flowId, &packetId))
     {
       uint32_t size = (ipPayload->GetSize () + ipHeader.GetSerializedSize ());
@@ -24,6 +24,7 @@
 #include "ns3/flow-probe.h"
 #include "ns3/ipv4-flow-classifier.h"
 #include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-trace-filter.h"
 
 namespace ns3 {
 
@@ -73,6 +74,11 @@ public:
     DROP_INVALID_REASON, /**< Fallback reason (no known reason) */
   };
 
+  /// Only report the packets accepted by a filter when they are sent.
+  /// An Ipv4TraceFilter also selects the packets by their five-tuple.
+  /// \param filter the filter, or 0 to report all the packets
+  virtual void SetTraceFilter (Ptr<TraceFilter> filter);
+
 protected:
 
   virtual void DoDispose (void);
@@ -107,6 +113,7 @@ private:
 
   Ptr<Ipv4FlowClassifier> m_classifier; //!< the Ipv4FlowClassifier this probe is associated with
   Ptr<Ipv4L3Protocol> m_ipv4; //!< the Ipv4L3Protocol this probe is bound to
+  Ptr<Ipv4TraceFilter> m_ipv4Filter; //!< the filter of the packets sent, if it is an Ipv4TraceFilter
 };
 
 
@@ -244,6 +244,12 @@ Ipv6FlowProbe::SendOutgoingLogger (const Ipv6Header &ipHeader, Ptr<const Packet>
   FlowId flowId;
   FlowPacketId packetId;
 
+  if (m_filter != 0 && !m_filter->Accept (ipPayload))
+    {
+      // without a tag, the packet is ignored by the other probes
+      return;
+    }
+
   if (m_classifier->Classify (ipHeader, ipPayload, &flowId, &packetId))
     {
       uint32_t size = (ipPayload->GetSize () + ipHeader.GetSerializedSize ());
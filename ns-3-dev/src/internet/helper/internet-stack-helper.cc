@@ -717,8 +717,16 @@ Ipv4L3ProtocolDropSinkWithoutContext (
       return;
     }
 
+  if (!stream->MayAccept (packet))
+    {
+      return;
+    }
   Ptr<Packet> p = packet->Copy ();
   p->AddHeader (header);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -743,6 +751,11 @@ Ipv4L3ProtocolTxSinkWithoutContext (
       return;
     }
 
+  if (!stream->Accept (packet))
+    {
+      return;
+    }
+
   *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " " << *packet << std::endl;
 }
 
@@ -767,6 +780,11 @@ Ipv4L3ProtocolRxSinkWithoutContext (
       return;
     }
 
+  if (!stream->Accept (packet))
+    {
+      return;
+    }
+
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << *packet << std::endl;
 }
 
@@ -803,8 +821,16 @@ Ipv4L3ProtocolDropSinkWithContext (
       return;
     }
 
+  if (!stream->MayAccept (packet))
+    {
+      return;
+    }
   Ptr<Packet> p = packet->Copy ();
   p->AddHeader (header);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
 #ifdef INTERFACE_CONTEXT
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << context << "(" << interface << ") " 
                         << *p << std::endl;
@@ -836,6 +862,11 @@ Ipv4L3ProtocolTxSinkWithContext (
       return;
     }
 
+  if (!stream->Accept (packet))
+    {
+      return;
+    }
+
 #ifdef INTERFACE_CONTEXT
   *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " " << context << "(" << interface << ") " 
                         << *packet << std::endl;
@@ -867,6 +898,11 @@ Ipv4L3ProtocolRxSinkWithContext (
       return;
     }
 
+  if (!stream->Accept (packet))
+    {
+      return;
+    }
+
 #ifdef INTERFACE_CONTEXT
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << context << "(" << interface << ") " 
                         << *packet << std::endl;
@@ -1055,8 +1091,16 @@ Ipv6L3ProtocolDropSinkWithoutContext (
       return;
     }
 
+  if (!stream->MayAccept (packet))
+    {
+      return;
+    }
   Ptr<Packet> p = packet->Copy ();
   p->AddHeader (header);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -1081,6 +1125,11 @@ Ipv6L3ProtocolTxSinkWithoutContext (
       return;
     }
 
+  if (!stream->Accept (packet))
+    {
+      return;
+    }
+
   *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " " << *packet << std::endl;
 }
 
@@ -1105,6 +1154,11 @@ Ipv6L3ProtocolRxSinkWithoutContext (
       return;
     }
 
+  if (!stream->Accept (packet))
+    {
+      return;
+    }
+
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << *packet << std::endl;
 }
 
@@ -1141,8 +1195,16 @@ Ipv6L3ProtocolDropSinkWithContext (
       return;
     }
 
+  if (!stream->MayAccept (packet))
+    {
+      return;
+    }
   Ptr<Packet> p = packet->Copy ();
   p->AddHeader (header);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
 #ifdef INTERFACE_CONTEXT
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << context << "(" << interface << ") " 
                         << *p << std::endl;
@@ -1174,6 +1236,11 @@ Ipv6L3ProtocolTxSinkWithContext (
       return;
     }
 
+  if (!stream->Accept (packet))
+    {
+      return;
+    }
+
 #ifdef INTERFACE_CONTEXT
   *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " " << context << "(" << interface << ") " 
                         << *packet << std::endl;
@@ -1205,6 +1272,11 @@ Ipv6L3ProtocolRxSinkWithContext (
       return;
     }
 
+  if (!stream->Accept (packet))
+    {
+      return;
+    }
+
 #ifdef INTERFACE_CONTEXT
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << context << "(" << interface << ") " 
                         << *packet << std::endl;
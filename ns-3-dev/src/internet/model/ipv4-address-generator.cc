@@ -16,7 +16,7 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-#include <list>
+#include <map>
 #include "ns3/abort.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
@@ -179,7 +179,8 @@ public:
     uint32_t addrHigh; //!< /internal the highest allocated address
   };
 
-  std::list<Entry> m_entries; //!< /internal contained of allocated addresses
+  typedef std::map<uint32_t, Entry> EntryMap; //!< /internal blocks of allocated addresses, indexed by their lowest address
+  EntryMap m_entries; //!< /internal contained of allocated addresses
   bool m_test; //!< /internal test mode (if true)
 };
 
@@ -362,17 +363,26 @@ Ipv4AddressGeneratorImpl::AddAllocated (const Ipv4Address address)
 
   NS_ABORT_MSG_UNLESS (addr, "Ipv4AddressGeneratorImpl::Add(): Allocating the broadcast address is not a good idea"); 
  
-  std::list<Entry>::iterator i;
+//
+// The blocks are indexed by their lowest address, so the only blocks the new
+// address can collide with or extend are the last block starting at or below
+// it, and the first block starting above it.  Topologies with many point to
+// point links allocate a block for every network, and a linear walk of the
+// blocks would make the allocation of all of them quadratic.
+//
+  EntryMap::iterator next = m_entries.upper_bound (addr);
 
-  for (i = m_entries.begin (); i != m_entries.end (); ++i)
+  if (next != m_entries.begin ())
     {
-      NS_LOG_LOGIC ("examine entry: " << Ipv4Address ((*i).addrLow) << 
-                    " to " << Ipv4Address ((*i).addrHigh));
+      EntryMap::iterator i = next;
+      --i;
+      NS_LOG_LOGIC ("examine entry: " << Ipv4Address ((*i).second.addrLow) << 
+                    " to " << Ipv4Address ((*i).second.addrHigh));
 //
 // First things first.  Is there an address collision -- that is, does the
 // new address fall in a previously allocated block of addresses.
 //
-      if (addr >= (*i).addrLow && addr <= (*i).addrHigh)
+      if (addr <= (*i).second.addrHigh)
         {
           NS_LOG_LOGIC ("Ipv4AddressGeneratorImpl::Add(): Address Collision: " << Ipv4Address (addr)); 
           if (!m_test) 
@@ -382,62 +392,37 @@ Ipv4AddressGeneratorImpl::AddAllocated (const Ipv4Address address)
           return false;
         }
 //
-// If the new address is less than the lowest address in the current block,
-// and can't be merged into to the current block, then insert it as a new
-// block before the current block.
-//
-      if (addr < (*i).addrLow - 1)
-        {
-          break;
-        }
-//
-// If the new address fits at the end of the block, look ahead to the next 
-// block and make sure it's not a collision there.  If we won't overlap, then
-// just extend the current block by one address.  We expect that completely
-// filled network ranges will be a fairly rare occurrence, so we don't worry
-// about collapsing address range blocks.
+// If the new address fits at the end of the block, just extend the block by
+// one address.  The next block starts above the new address, so we can't
+// overlap it.  We expect that completely filled network ranges will be a
+// fairly rare occurrence, so we don't worry about collapsing address range
+// blocks.
 // 
-      if (addr == (*i).addrHigh + 1)
+      if (addr == (*i).second.addrHigh + 1)
         {
-          std::list<Entry>::iterator j = i;
-          ++j;
-
-          if (j != m_entries.end ())
-            {
-              if (addr == (*j).addrLow)
-                {
-                  NS_LOG_LOGIC ("Ipv4AddressGeneratorImpl::Add(): "
-                                "Address Collision: " << Ipv4Address (addr));
-                  if (!m_test)
-                    {
-                      NS_FATAL_ERROR ("Ipv4AddressGeneratorImpl::Add(): Address Collision: " << Ipv4Address (addr));
-                    }
-                  return false;
-                }
-            }
-
           NS_LOG_LOGIC ("New addrHigh = " << Ipv4Address (addr));
-          (*i).addrHigh = addr;
+          (*i).second.addrHigh = addr;
           return true;
         }
+    }
 //
-// If we get here, we know that the next lower block of addresses couldn't 
-// have been extended to include this new address since the code immediately 
-// above would have been executed and that next lower block extended upward.
-// So we know it's safe to extend the current block down to includ the new
-// address.
+// If we get here, the next lower block of addresses couldn't have been
+// extended to include this new address, so it's safe to extend the next
+// block down to include the new address.
 //
-      if (addr == (*i).addrLow - 1)
-        {
-          NS_LOG_LOGIC ("New addrLow = " << Ipv4Address (addr));
-          (*i).addrLow = addr;
-          return true;
-        }
+  if (next != m_entries.end () && addr == (*next).second.addrLow - 1)
+    {
+      NS_LOG_LOGIC ("New addrLow = " << Ipv4Address (addr));
+      Entry entry = (*next).second;
+      entry.addrLow = addr;
+      m_entries.erase (next);
+      m_entries.insert (std::make_pair (addr, entry));
+      return true;
     }
 
   Entry entry;
   entry.addrLow = entry.addrHigh = addr;
-  m_entries.insert (i, entry);
+  m_entries.insert (next, std::make_pair (addr, entry));
   return true;
 }
 
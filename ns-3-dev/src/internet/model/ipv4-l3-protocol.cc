@@ -468,7 +468,7 @@ Ipv4L3Protocol::Receive ( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t p
         {
           if (ipv4Interface->IsUp ())
             {
-              m_rxTrace (packet, m_node->GetObject<Ipv4> (), interface);
+              m_rxTrace (packet, this, interface);
               break;
             }
           else
@@ -636,7 +636,7 @@ Ipv4L3Protocol::Send (Ptr<Packet> packet,
 
           m_sendOutgoingTrace (ipHeader, packetCopy, ifaceIndex);
           packetCopy->AddHeader (ipHeader);
-          m_txTrace (packetCopy, m_node->GetObject<Ipv4> (), ifaceIndex);
+          m_txTrace (packetCopy, this, ifaceIndex);
           outInterface->Send (packetCopy, destination);
         }*/
       // Tan Luu edited
@@ -646,7 +646,7 @@ Ipv4L3Protocol::Send (Ptr<Packet> packet,
       NS_ASSERT (packetCopy->GetSize () <= outInterface->GetDevice ()->GetMtu ());
       m_sendOutgoingTrace (ipHeader, packetCopy, ifaceIndex);
       packetCopy->AddHeader (ipHeader);
-      m_txTrace (packetCopy, m_node->GetObject<Ipv4> (), ifaceIndex);
+      m_txTrace (packetCopy, this, ifaceIndex);
       outInterface->Send (packetCopy, destination);
       // finish
       return;
@@ -670,7 +670,7 @@ Ipv4L3Protocol::Send (Ptr<Packet> packet,
               Ptr<Packet> packetCopy = packet->Copy ();
               m_sendOutgoingTrace (ipHeader, packetCopy, ifaceIndex);
               packetCopy->AddHeader (ipHeader);
-              m_txTrace (packetCopy, m_node->GetObject<Ipv4> (), ifaceIndex);
+              m_txTrace (packetCopy, this, ifaceIndex);
               outInterface->Send (packetCopy, destination);
               return;
             }
@@ -798,13 +798,13 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
               DoFragmentation (packet, outInterface->GetDevice ()->GetMtu (), listFragments);
               for ( std::list<Ptr<Packet> >::iterator it = listFragments.begin (); it != listFragments.end (); it++ )
                 {
-                  m_txTrace (*it, m_node->GetObject<Ipv4> (), interface);
+                  m_txTrace (*it, this, interface);
                   outInterface->Send (*it, route->GetGateway ());
                 }
             }
           else
             {
-              m_txTrace (packet, m_node->GetObject<Ipv4> (), interface);
+              m_txTrace (packet, this, interface);
               outInterface->Send (packet, route->GetGateway ());
             }
         }
@@ -828,13 +828,13 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
               for ( std::list<Ptr<Packet> >::iterator it = listFragments.begin (); it != listFragments.end (); it++ )
                 {
                   NS_LOG_LOGIC ("Sending fragment " << **it );
-                  m_txTrace (*it, m_node->GetObject<Ipv4> (), interface);
+                  m_txTrace (*it, this, interface);
                   outInterface->Send (*it, ipHeader.GetDestination ());
                 }
             }
           else
             {
-              m_txTrace (packet, m_node->GetObject<Ipv4> (), interface);
+              m_txTrace (packet, this, interface);
               outInterface->Send (packet, ipHeader.GetDestination ());
             }
         }
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ipv4-trace-filter.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("Ipv4TraceFilter");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv4TraceFilter);
+
+/// Protocol number of TCP
+static const uint8_t TCP_PROT_NUMBER = 6;
+/// Protocol number of UDP
+static const uint8_t UDP_PROT_NUMBER = 17;
+
+TypeId
+Ipv4TraceFilter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::Ipv4TraceFilter")
+    .SetParent<TraceFilter> ()
+    .AddConstructor<Ipv4TraceFilter> ()
+  ;
+  return tid;
+}
+
+Ipv4TraceFilter::Ipv4TraceFilter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+Ipv4TraceFilter::~Ipv4TraceFilter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+Ipv4TraceFilter::AddFlow (Ipv4Address source, Ipv4Address destination, uint8_t protocol,
+                          uint16_t sourcePort, uint16_t destinationPort)
+{
+  NS_LOG_FUNCTION (this << source << destination << (uint32_t)protocol << sourcePort << destinationPort);
+  struct Flow flow;
+  flow.source = source;
+  flow.destination = destination;
+  flow.protocol = protocol;
+  flow.sourcePort = sourcePort;
+  flow.destinationPort = destinationPort;
+  m_flows.push_back (flow);
+}
+
+bool
+Ipv4TraceFilter::Accept (const Ipv4Header &header, Ptr<const Packet> payload) const
+{
+  NS_LOG_FUNCTION (this << &header << payload);
+  if (!AcceptTime () || !AcceptUid (payload->GetUid ()) || !AcceptPredicates (payload))
+    {
+      return false;
+    }
+  if (m_flows.empty ())
+    {
+      return true;
+    }
+  uint8_t protocol = header.GetProtocol ();
+  // the ports are the first 4 bytes of both TCP and UDP headers, and are
+  // only carried by the first fragment
+  bool hasPorts = (protocol == TCP_PROT_NUMBER || protocol == UDP_PROT_NUMBER)
+    && header.GetFragmentOffset () == 0 && payload->GetSize () >= 4;
+  uint32_t ports = 0;
+  if (hasPorts)
+    {
+      uint8_t data[4];
+      payload->CopyData (data, 4);
+      ports = (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+    }
+  return Match (header.GetSource (), header.GetDestination (), protocol, ports, hasPorts);
+}
+
+bool
+Ipv4TraceFilter::DoAccept (Ptr<const Packet> p) const
+{
+  if (m_flows.empty ())
+    {
+      return true;
+    }
+  // read the fields directly rather than deserializing the header
+  uint8_t data[64];
+  uint32_t size = p->CopyData (data, sizeof (data));
+  if (size < 20 || (data[0] >> 4) != 4)
+    {
+      return false;
+    }
+  uint32_t headerSize = (data[0] & 0x0f) * 4;
+  uint8_t protocol = data[9];
+  uint16_t fragmentOffset = ((data[6] & 0x1f) << 8) | data[7];
+  Ipv4Address source = Ipv4Address::Deserialize (&data[12]);
+  Ipv4Address destination = Ipv4Address::Deserialize (&data[16]);
+  bool hasPorts = (protocol == TCP_PROT_NUMBER || protocol == UDP_PROT_NUMBER)
+    && fragmentOffset == 0 && size >= headerSize + 4;
+  uint32_t ports = 0;
+  if (hasPorts)
+    {
+      uint8_t *l4 = &data[headerSize];
+      ports = (l4[0] << 24) | (l4[1] << 16) | (l4[2] << 8) | l4[3];
+    }
+  return Match (source, destination, protocol, ports, hasPorts);
+}
+
+bool
+Ipv4TraceFilter::Match (Ipv4Address source, Ipv4Address destination, uint8_t protocol,
+                        uint32_t ports, bool hasPorts) const
+{
+  Ipv4Address any = Ipv4Address::GetAny ();
+  uint16_t sourcePort = ports >> 16;
+  uint16_t destinationPort = ports & 0xffff;
+  for (std::vector<struct Flow>::const_iterator i = m_flows.begin (); i != m_flows.end (); ++i)
+    {
+      if ((i->source == any || i->source == source)
+          && (i->destination == any || i->destination == destination)
+          && (i->protocol == 0 || i->protocol == protocol)
+          && (i->sourcePort == 0 || (hasPorts && i->sourcePort == sourcePort))
+          && (i->destinationPort == 0 || (hasPorts && i->destinationPort == destinationPort)))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+} // namespace ns3
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef IPV4_TRACE_FILTER_H
+#define IPV4_TRACE_FILTER_H
+
+#include <vector>
+#include "ns3/trace-filter.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-header.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup ipv4
+ *
+ * \brief Select the traced packets by their IPv4 five-tuple
+ *
+ * In addition to the conditions of TraceFilter, the filter only accepts
+ * the packets of the flows added with AddFlow, if any. A packet belongs
+ * to a flow if its source and destination addresses, its protocol and,
+ * for UDP and TCP, its source and destination ports match the fields of
+ * the flow which are not wildcards.
+ *
+ * The five-tuple of a packet is read from the IPv4 header at the start of
+ * the packet, as in the IPv4 traces of InternetStackHelper, or given
+ * separately, as in the FlowMonitor probes. The packets which do not start
+ * with an IPv4 header, such as the packets of most device traces, never
+ * belong to a flow.
+ */
+class Ipv4TraceFilter : public TraceFilter
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  Ipv4TraceFilter ();
+  virtual ~Ipv4TraceFilter ();
+
+  /**
+   * \brief Accept the packets of a flow
+   *
+   * \param source source address, or Ipv4Address::GetAny () for any
+   * \param destination destination address, or Ipv4Address::GetAny () for any
+   * \param protocol protocol number, or 0 for any
+   * \param sourcePort source port, or 0 for any
+   * \param destinationPort destination port, or 0 for any
+   */
+  void AddFlow (Ipv4Address source, Ipv4Address destination, uint8_t protocol = 0,
+                uint16_t sourcePort = 0, uint16_t destinationPort = 0);
+
+  using TraceFilter::Accept;
+
+  /**
+   * The predicates of the filter are applied to the payload.
+   *
+   * \param header the IPv4 header of a packet about to be traced
+   * \param payload the payload of the packet
+   * \return true if the packet should be traced, false otherwise
+   */
+  bool Accept (const Ipv4Header &header, Ptr<const Packet> payload) const;
+
+private:
+  /**
+   * \brief The fields of a flow, zero for wildcards
+   */
+  struct Flow
+  {
+    Ipv4Address source;        //!< Source address
+    Ipv4Address destination;   //!< Destination address
+    uint8_t protocol;          //!< Protocol
+    uint16_t sourcePort;       //!< Source port
+    uint16_t destinationPort;  //!< Destination port
+  };
+
+  virtual bool DoAccept (Ptr<const Packet> p) const;
+
+  /**
+   * \param source source address of a packet
+   * \param destination destination address of the packet
+   * \param protocol protocol of the packet
+   * \param ports the source port in the upper 16 bits and the destination
+   *        port in the lower ones
+   * \param hasPorts whether the packet carries ports
+   * \return true if the packet belongs to a flow of the filter
+   */
+  bool Match (Ipv4Address source, Ipv4Address destination, uint8_t protocol,
+              uint32_t ports, bool hasPorts) const;
+
+  std::vector<struct Flow> m_flows; //!< Flows accepted
+};
+
+} // namespace ns3
+
+#endif /* IPV4_TRACE_FILTER_H */
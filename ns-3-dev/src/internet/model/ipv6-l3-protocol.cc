@@ -861,7 +861,7 @@ void Ipv6L3Protocol::Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16
         {
           if (ipv6Interface->IsUp ())
             {
-              m_rxTrace (packet, m_node->GetObject<Ipv6> (), interface);
+              m_rxTrace (packet, this, interface);
               break;
             }
           else
@@ -1008,14 +1008,14 @@ void Ipv6L3Protocol::SendRealOut (Ptr<Ipv6Route> route, Ptr<Packet> packet, Ipv6
               /* IPv6 header is already added in fragments */
               for (std::list<Ptr<Packet> >::const_iterator it = fragments.begin (); it != fragments.end (); it++)
                 {
-                  m_txTrace (*it, m_node->GetObject<Ipv6> (), interface);
+                  m_txTrace (*it, this, interface);
                   outInterface->Send (*it, route->GetGateway ());
                 }
             }
           else
             {
               packet->AddHeader (ipHeader);
-              m_txTrace (packet, m_node->GetObject<Ipv6> (), interface);
+              m_txTrace (packet, this, interface);
               outInterface->Send (packet, route->GetGateway ());
             }
         }
@@ -1038,14 +1038,14 @@ void Ipv6L3Protocol::SendRealOut (Ptr<Ipv6Route> route, Ptr<Packet> packet, Ipv6
               /* IPv6 header is already added in fragments */
               for (std::list<Ptr<Packet> >::const_iterator it = fragments.begin (); it != fragments.end (); it++)
                 {
-                  m_txTrace (*it, m_node->GetObject<Ipv6> (), interface);
+                  m_txTrace (*it, this, interface);
                   outInterface->Send (*it, ipHeader.GetDestinationAddress ());
                 }
             }
           else
             {
               packet->AddHeader (ipHeader);
-              m_txTrace (packet, m_node->GetObject<Ipv6> (), interface);
+              m_txTrace (packet, this, interface);
               outInterface->Send (packet, ipHeader.GetDestinationAddress ());
             }
         }
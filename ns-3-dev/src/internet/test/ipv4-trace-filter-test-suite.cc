@@ -0,0 +1,328 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/ipv4-trace-filter.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/udp-header.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+#include "ns3/output-stream-wrapper.h"
+
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check the sampling, time windows and predicates of TraceFilter.
+ */
+class TraceFilterTestCase : public TestCase
+{
+public:
+  TraceFilterTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /// Check the time windows, at the time of the event
+  void CheckWindows (Ptr<TraceFilter> filter, Ptr<const Packet> p, bool expected);
+};
+
+TraceFilterTestCase::TraceFilterTestCase ()
+  : TestCase ("Check the sampling, time windows and predicates of TraceFilter")
+{
+}
+
+static bool
+IsLarge (Ptr<const Packet> p)
+{
+  return p->GetSize () >= 100;
+}
+
+void
+TraceFilterTestCase::CheckWindows (Ptr<TraceFilter> filter, Ptr<const Packet> p, bool expected)
+{
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (p), expected,
+                         "Wrong decision at " << Simulator::Now ().GetSeconds () << " s");
+}
+
+void
+TraceFilterTestCase::DoRun (void)
+{
+  Ptr<TraceFilter> filter = CreateObject<TraceFilter> ();
+  filter->SetSamplingRatio (0.1);
+
+  // the sample is about 10% of the packets, and the same for copies
+  uint32_t sampled = 0;
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (10);
+      bool accepted = filter->Accept (p);
+      NS_TEST_ASSERT_MSG_EQ (filter->Accept (p->Copy ()), accepted, "A copy must be sampled as the original");
+      sampled += accepted;
+    }
+  NS_TEST_EXPECT_MSG_EQ_TOL (sampled, 1000, 100, "The sample does not hold 10% of the packets");
+
+  filter->SetSamplingRatio (0);
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (Create<Packet> (10)), false, "No packet must be sampled");
+  filter->SetSamplingRatio (1);
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (Create<Packet> (10)), true, "All the packets must be sampled");
+
+  filter->AddPredicate (MakeCallback (&IsLarge));
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (Create<Packet> (10)), false, "The predicate must reject small packets");
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (Create<Packet> (100)), true, "The predicate must accept large packets");
+
+  Ptr<const Packet> p = Create<Packet> (100);
+  filter->AddTimeWindow (Seconds (1), Seconds (2));
+  filter->AddTimeWindow (Seconds (3), Seconds (4));
+  Simulator::Schedule (Seconds (0.5), &TraceFilterTestCase::CheckWindows, this, filter, p, false);
+  Simulator::Schedule (Seconds (1), &TraceFilterTestCase::CheckWindows, this, filter, p, true);
+  Simulator::Schedule (Seconds (2), &TraceFilterTestCase::CheckWindows, this, filter, p, false);
+  Simulator::Schedule (Seconds (3.5), &TraceFilterTestCase::CheckWindows, this, filter, p, true);
+  Simulator::Schedule (Seconds (5), &TraceFilterTestCase::CheckWindows, this, filter, p, false);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check the five-tuple selection of Ipv4TraceFilter.
+ */
+class Ipv4TraceFilterTestCase : public TestCase
+{
+public:
+  Ipv4TraceFilterTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param source source address
+   * \param destination destination address
+   * \param sourcePort source port
+   * \param destinationPort destination port
+   * \param header [out] the IPv4 header of the packet
+   * \return an UDP packet without its IPv4 header
+   */
+  Ptr<Packet> CreateUdpPacket (Ipv4Address source, Ipv4Address destination,
+                               uint16_t sourcePort, uint16_t destinationPort, Ipv4Header &header);
+};
+
+Ipv4TraceFilterTestCase::Ipv4TraceFilterTestCase ()
+  : TestCase ("Check the five-tuple selection of Ipv4TraceFilter")
+{
+}
+
+Ptr<Packet>
+Ipv4TraceFilterTestCase::CreateUdpPacket (Ipv4Address source, Ipv4Address destination,
+                                          uint16_t sourcePort, uint16_t destinationPort, Ipv4Header &header)
+{
+  Ptr<Packet> p = Create<Packet> (20);
+  UdpHeader udp;
+  udp.SetSourcePort (sourcePort);
+  udp.SetDestinationPort (destinationPort);
+  p->AddHeader (udp);
+  header.SetSource (source);
+  header.SetDestination (destination);
+  header.SetProtocol (17);
+  header.SetPayloadSize (p->GetSize ());
+  return p;
+}
+
+void
+Ipv4TraceFilterTestCase::DoRun (void)
+{
+  Ipv4Address a ("10.0.0.1");
+  Ipv4Address b ("10.0.0.2");
+  Ipv4Address c ("10.0.0.3");
+  Ptr<Ipv4TraceFilter> filter = CreateObject<Ipv4TraceFilter> ();
+
+  Ipv4Header header;
+  Ptr<Packet> p = CreateUdpPacket (a, b, 1000, 9, header);
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (header, p), true, "A filter without flows must accept all the packets");
+
+  filter->AddFlow (a, Ipv4Address::GetAny (), 17, 0, 9);
+  filter->AddFlow (c, b, 6);
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (header, p), true, "The packet must match the first flow");
+  Ptr<Packet> withHeader = p->Copy ();
+  withHeader->AddHeader (header);
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (withHeader), true, "The packet with its header must match the first flow");
+
+  p = CreateUdpPacket (a, b, 1000, 10, header);
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (header, p), false, "The packet must not match the destination port");
+  withHeader = p->Copy ();
+  withHeader->AddHeader (header);
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (withHeader), false, "The packet with its header must not match the destination port");
+
+  p = CreateUdpPacket (c, b, 1000, 9, header);
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (header, p), false, "A UDP packet must not match the TCP flow");
+
+  // a later fragment does not carry the ports
+  p = CreateUdpPacket (a, b, 1000, 9, header);
+  header.SetFragmentOffset (8);
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (header, p), false, "A later fragment must not match a port");
+
+  NS_TEST_EXPECT_MSG_EQ (filter->Accept (Create<Packet> (100)), false, "A packet without IPv4 header must not match");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that the ascii traces of InternetStackHelper only write
+ * the packets accepted by the filter of their stream.
+ *
+ * A node sends a packet to another at 1, 2 and 3 s; the interface of the
+ * receiver is down from 2.5 s, so that the last packet is dropped.  The
+ * simulation runs twice, traced by a stream without filter, then by a
+ * stream filtered by a time window.
+ */
+class Ipv4AsciiTraceFilterTestCase : public TestCase
+{
+public:
+  Ipv4AsciiTraceFilterTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Run the simulation.
+   *
+   * \param filter the filter of the trace, or 0
+   * \return the ascii trace of all the nodes
+   */
+  std::string Run (Ptr<TraceFilter> filter);
+  /// Send a packet from the socket
+  void Send (Ptr<Socket> socket, Ipv4Address to);
+};
+
+Ipv4AsciiTraceFilterTestCase::Ipv4AsciiTraceFilterTestCase ()
+  : TestCase ("Check that the filtered ascii traces of InternetStackHelper drop lines")
+{
+}
+
+void
+Ipv4AsciiTraceFilterTestCase::Send (Ptr<Socket> socket, Ipv4Address to)
+{
+  socket->SendTo (Create<Packet> (100), 0, InetSocketAddress (to, 9));
+}
+
+std::string
+Ipv4AsciiTraceFilterTestCase::Run (Ptr<TraceFilter> filter)
+{
+  NodeContainer n;
+  n.Create (2);
+  InternetStackHelper internet;
+  internet.Install (n);
+
+  Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice> ();
+  Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice> ();
+  txDev->SetAddress (Mac48Address::Allocate ());
+  rxDev->SetAddress (Mac48Address::Allocate ());
+  n.Get (0)->AddDevice (txDev);
+  n.Get (1)->AddDevice (rxDev);
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  txDev->SetChannel (channel);
+  rxDev->SetChannel (channel);
+  NetDeviceContainer d;
+  d.Add (txDev);
+  d.Add (rxDev);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer i = ipv4.Assign (d);
+
+  // the helper traces each interface to a single stream
+  std::ostringstream trace;
+  Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper> (&trace);
+  stream->SetTraceFilter (filter);
+  internet.EnableAsciiIpv4All (stream);
+
+  Ptr<Socket> sink = Socket::CreateSocket (n.Get (1), UdpSocketFactory::GetTypeId ());
+  sink->Bind (InetSocketAddress (Ipv4Address::GetAny (), 9));
+  Ptr<Socket> socket = Socket::CreateSocket (n.Get (0), UdpSocketFactory::GetTypeId ());
+  for (uint32_t t = 1; t <= 3; t++)
+    {
+      Simulator::Schedule (Seconds (t), &Ipv4AsciiTraceFilterTestCase::Send, this, socket, i.GetAddress (1));
+    }
+  Ptr<Ipv4> rxIpv4 = n.Get (1)->GetObject<Ipv4> ();
+  Simulator::Schedule (Seconds (2.5), &Ipv4::SetDown, rxIpv4, i.Get (1).second);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return trace.str ();
+}
+
+void
+Ipv4AsciiTraceFilterTestCase::DoRun (void)
+{
+  std::string all = Run (0);
+  Ptr<TraceFilter> filter = CreateObject<TraceFilter> ();
+  filter->AddTimeWindow (Seconds (1.5), Seconds (3.5));
+  std::string filtered = Run (filter);
+
+  // the lines of the unfiltered trace within the window, and the drops
+  std::istringstream allLines (all);
+  std::string line;
+  std::string expected;
+  uint32_t nAll = 0;
+  uint32_t nDrops = 0;
+  while (std::getline (allLines, line))
+    {
+      nAll++;
+      std::istringstream fields (line);
+      std::string event;
+      double time;
+      fields >> event >> time;
+      if (time >= 1.5 && time < 3.5)
+        {
+          expected += line + "\n";
+          nDrops += (event == "d");
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (nAll, 6, "The unfiltered trace must hold a transmission and a reception or drop per packet");
+  NS_TEST_EXPECT_MSG_EQ (nDrops, 1, "The unfiltered trace must hold the drop of the last packet");
+  NS_TEST_EXPECT_MSG_EQ (filtered, expected, "The filtered trace must only hold the lines within the window");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Trace filter TestSuite
+ */
+class Ipv4TraceFilterTestSuite : public TestSuite
+{
+public:
+  Ipv4TraceFilterTestSuite ();
+};
+
+Ipv4TraceFilterTestSuite::Ipv4TraceFilterTestSuite ()
+  : TestSuite ("ipv4-trace-filter", UNIT)
+{
+  AddTestCase (new TraceFilterTestCase, TestCase::QUICK);
+  AddTestCase (new Ipv4TraceFilterTestCase, TestCase::QUICK);
+  AddTestCase (new Ipv4AsciiTraceFilterTestCase, TestCase::QUICK);
+}
+
+static Ipv4TraceFilterTestSuite g_ipv4TraceFilterTestSuite;
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Benchmark of a dense IEEE 802.15.4 deployment.
+ *
+ * --nodes motes are placed on a square grid, --step meters apart, on a
+ * single SingleModelSpectrumChannel. Each mote sends a data frame to its
+ * right neighbor every --interval seconds, starting at a random time, so
+ * that each PHY accumulates the interference of many overlapping frames
+ * and evaluates the error model for every chunk of the frames it receives.
+ *
+ * The program reports the number of frames sent and received, the
+ * wall-clock time of the simulation and the part of it spent per frame
+ * received, and the number of events processed as counted by
+ * Simulator::GetEventCount, cancelled events included.
+ */
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/lr-wpan-module.h>
+
+#include <iostream>
+#include <cmath>
+
+using namespace ns3;
+
+static uint32_t g_received = 0;
+
+static void
+DataIndication (McpsDataIndicationParams params, Ptr<Packet> p)
+{
+  g_received++;
+}
+
+static void
+SendFrame (Ptr<LrWpanNetDevice> device, Mac16Address destination, uint32_t size, Time interval)
+{
+  McpsDataRequestParams params;
+  params.m_srcAddrMode = SHORT_ADDR;
+  params.m_dstAddrMode = SHORT_ADDR;
+  params.m_dstPanId = 0;
+  params.m_dstAddr = destination;
+  params.m_msduHandle = 0;
+  params.m_txOptions = TX_OPTION_NONE;
+  device->GetMac ()->McpsDataRequest (params, Create<Packet> (size));
+  Simulator::Schedule (interval, &SendFrame, device, destination, size, interval);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nNodes = 1000;
+  double step = 5;
+  double interval = 1;
+  uint32_t size = 50;
+  double duration = 20;
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "number of motes", nNodes);
+  cmd.AddValue ("step", "distance between two neighbor motes, in meters", step);
+  cmd.AddValue ("interval", "interval between two frames of a mote, in seconds", interval);
+  cmd.AddValue ("size", "size of the frames, in bytes", size);
+  cmd.AddValue ("duration", "duration of the simulation, in seconds", duration);
+  cmd.Parse (argc, argv);
+
+  uint32_t width = std::max<uint32_t> (1, (uint32_t)std::ceil (std::sqrt ((double)nNodes)));
+
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "MinX", DoubleValue (0.0),
+                                 "MinY", DoubleValue (0.0),
+                                 "DeltaX", DoubleValue (step),
+                                 "DeltaY", DoubleValue (step),
+                                 "GridWidth", UintegerValue (width),
+                                 "LayoutType", StringValue ("RowFirst"));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  LrWpanHelper lrWpanHelper;
+  NetDeviceContainer devices = lrWpanHelper.Install (nodes);
+  lrWpanHelper.AssociateToPan (devices, 0);
+
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Ptr<LrWpanNetDevice> device = DynamicCast<LrWpanNetDevice> (devices.Get (i));
+      device->GetPhy ()->SetMobility (nodes.Get (i)->GetObject<MobilityModel> ());
+      device->GetMac ()->SetMcpsDataIndicationCallback (MakeCallback (&DataIndication));
+
+      // AssociateToPan numbers the motes from 1
+      uint32_t neighbor = (i + 1) % nNodes;
+      uint8_t buffer[2] = { (uint8_t)(((neighbor + 1) >> 8) & 0xff), (uint8_t)((neighbor + 1) & 0xff) };
+      Mac16Address destination;
+      destination.CopyFrom (buffer);
+      Simulator::Schedule (Seconds (start->GetValue (0, interval)), &SendFrame,
+                           device, destination, size, Seconds (interval));
+    }
+
+  Simulator::Stop (Seconds (duration));
+
+  std::cout << "Simulating " << nNodes << " motes for " << duration << " s ..." << std::endl;
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  double wallTime = clock.End () / 1000.0;
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  std::cout << "Frames sent: about " << (uint64_t)(nNodes * duration / interval) << std::endl
+            << "Frames received: " << g_received << std::endl
+            << "Wall-clock time: " << wallTime << " s, "
+            << (g_received > 0 ? wallTime * 1e6 / g_received : 0) << " us per frame received" << std::endl
+            << "Events processed (cancelled included): " << events << std::endl;
+  return 0;
+}
@@ -28,6 +28,9 @@ namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (LrWpanErrorModel);
 
+const double LrWpanErrorModel::m_tableStep = 0.002;
+const double LrWpanErrorModel::m_tableMax = 16.0;
+
 TypeId
 LrWpanErrorModel::GetTypeId (void)
 {
@@ -60,7 +63,7 @@ LrWpanErrorModel::LrWpanErrorModel (void)
 }
 
 double
-LrWpanErrorModel::GetChunkSuccessRate (double snr, uint32_t nbits) const
+LrWpanErrorModel::ComputeBer (double snr) const
 {
   double ber = 0.0;
 
@@ -71,7 +74,48 @@ LrWpanErrorModel::GetChunkSuccessRate (double snr, uint32_t nbits) const
 
   ber = ber * 8.0 / 15.0 / 16.0;
 
-  ber = std::min (ber, 1.0);
+  return std::min (ber, 1.0);
+}
+
+const std::vector<double> &
+LrWpanErrorModel::GetBerTable (void) const
+{
+  static std::vector<double> table;
+  if (table.empty ())
+    {
+      uint32_t n = (uint32_t)(m_tableMax / m_tableStep + 0.5) + 1;
+      table.reserve (n);
+      for (uint32_t i = 0; i < n; i++)
+        {
+          table.push_back (ComputeBer (i * m_tableStep));
+        }
+    }
+  return table;
+}
+
+double
+LrWpanErrorModel::GetChunkSuccessRate (double snr, uint32_t nbits) const
+{
+  if (snr >= m_tableMax)
+    {
+      // The bit error rate is below 1e-68, so 1 - ber rounds to 1.
+      return 1.0;
+    }
+
+  double ber;
+  if (snr > 0)
+    {
+      const std::vector<double> &table = GetBerTable ();
+      double position = snr / m_tableStep;
+      uint32_t i = (uint32_t)position;
+      double fraction = position - i;
+      ber = table[i] + fraction * (table[i + 1] - table[i]);
+    }
+  else
+    {
+      ber = ComputeBer (snr);
+    }
+
   double retval = pow (1.0 - ber, nbits);
   return retval;
 }
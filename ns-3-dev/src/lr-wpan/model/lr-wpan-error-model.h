@@ -21,6 +21,7 @@
 #define LR_WPAN_ERROR_MODEL_H
 
 #include <ns3/object.h>
+#include <vector>
 
 namespace ns3 {
 
@@ -30,6 +31,10 @@ namespace ns3 {
  * Model the error rate for IEEE 802.15.4 2.4 GHz AWGN channel for OQPSK
  * the model description can be found in IEEE Std 802.15.4-2006, section
  * E.4.1.7
+ *
+ * The bit error rate is precomputed once for all the instances on a
+ * regular grid of SNR values, and linearly interpolated between them.
+ * The relative interpolation error is at most 5e-5 of the bit error rate.
  */
 class LrWpanErrorModel : public Object
 {
@@ -53,11 +58,34 @@ public:
   double GetChunkSuccessRate (double snr, uint32_t nbits) const;
 
 private:
+  /**
+   * Compute the bit error rate with the formula of the standard.
+   *
+   * \return the bit error rate
+   * \param snr SNR expressed as a power ratio (i.e. not in dB)
+   */
+  double ComputeBer (double snr) const;
+  /**
+   * Get the bit error rates precomputed at every m_tableStep of SNR, from 0.
+   *
+   * \return the table of bit error rates
+   */
+  const std::vector<double> & GetBerTable (void) const;
+
   /**
    * Array of precalculated binomial coefficients.
    */
   double m_binomialCoefficients[17];
 
+  /**
+   * The step of SNR, as a power ratio, between two entries of the table.
+   */
+  static const double m_tableStep;
+  /**
+   * The largest SNR of the table, as a power ratio. Above it, the bit error
+   * rate is negligible in double precision.
+   */
+  static const double m_tableMax;
 };
 
 
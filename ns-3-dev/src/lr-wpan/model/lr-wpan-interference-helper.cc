@@ -27,9 +27,16 @@ NS_LOG_COMPONENT_DEFINE ("LrWpanInterferenceHelper");
 
 namespace ns3 {
 
+/**
+ * The number of removals after which the running sum of the signals is
+ * recomputed, if the set of signals did not become empty meanwhile.
+ */
+static const uint32_t LR_WPAN_INTERFERENCE_RESUM_INTERVAL = 256;
+
 LrWpanInterferenceHelper::LrWpanInterferenceHelper (Ptr<const SpectrumModel> spectrumModel)
   : m_spectrumModel (spectrumModel),
-    m_dirty (false)
+    m_dirty (false),
+    m_removed (0)
 {
   m_signal = Create<SpectrumValue> (m_spectrumModel);
 }
@@ -69,9 +76,21 @@ LrWpanInterferenceHelper::RemoveSignal (Ptr<const SpectrumValue> signal)
   if (signal->GetSpectrumModel () == m_spectrumModel)
     {
       result = (m_signals.erase (signal) == 1);
-      if (result)
+      if (result && !m_dirty)
         {
-          m_dirty = true;
+          if (m_signals.empty ())
+            {
+              m_signal = Create<SpectrumValue> (m_spectrumModel);
+              m_removed = 0;
+            }
+          else if (++m_removed >= LR_WPAN_INTERFERENCE_RESUM_INTERVAL)
+            {
+              m_dirty = true;
+            }
+          else
+            {
+              *m_signal -= *signal;
+            }
         }
     }
   return result;
@@ -83,7 +102,9 @@ LrWpanInterferenceHelper::ClearSignals (void)
   NS_LOG_FUNCTION (this);
 
   m_signals.clear ();
-  m_dirty = true;
+  m_signal = Create<SpectrumValue> (m_spectrumModel);
+  m_dirty = false;
+  m_removed = 0;
 }
 
 Ptr<SpectrumValue>
@@ -101,6 +122,7 @@ LrWpanInterferenceHelper::GetSignalPsd (void) const
           *m_signal += *(*it);
         }
       m_dirty = false;
+      m_removed = 0;
     }
 
   return m_signal->Copy ();
@@ -24,6 +24,7 @@
 #include <ns3/simple-ref-count.h>
 #include <ns3/ptr.h>
 #include <set>
+#include <stdint.h>
 
 namespace ns3 {
 
@@ -34,6 +35,11 @@ class SpectrumModel;
  * \ingroup lr-wpan
  *
  * \brief This class provides helper functions for LrWpan interference handling.
+ *
+ * The sum of the accumulated signals is kept up to date as signals are
+ * added and removed. To bound the rounding errors of the subtractions, it
+ * is recomputed from the signals when the set becomes empty, and after a
+ * number of removals.
  */
 class LrWpanInterferenceHelper : public SimpleRefCount<LrWpanInterferenceHelper>
 {
@@ -105,10 +111,16 @@ private:
   mutable Ptr<SpectrumValue> m_signal;
 
   /**
-   * Mark m_signal as dirty, whenever a signal is added or removed. m_signal has
-   * to be recomputed before next use.
+   * Mark m_signal as dirty, whenever the running sum may have drifted from
+   * the sum of the signals. m_signal has to be recomputed before next use.
    */
   mutable bool m_dirty;
+
+  /**
+   * The number of signals subtracted from m_signal since it was last
+   * recomputed.
+   */
+  mutable uint32_t m_removed;
 };
 
 }
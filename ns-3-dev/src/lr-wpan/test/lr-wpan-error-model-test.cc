@@ -23,6 +23,8 @@
 #include <ns3/packet.h>
 #include <ns3/simulator.h>
 #include <ns3/lr-wpan-error-model.h>
+#include <ns3/lr-wpan-interference-helper.h>
+#include <ns3/spectrum-value.h>
 #include <ns3/propagation-loss-model.h>
 #include <ns3/lr-wpan-net-device.h>
 #include <ns3/lr-wpan-mac.h>
@@ -32,6 +34,9 @@
 #include <ns3/mac16-address.h>
 #include <ns3/constant-position-mobility-model.h>
 #include "ns3/rng-seed-manager.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE ("lr-wpan-error-model-test");
 
@@ -175,6 +180,151 @@ LrWpanErrorModelTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (ber, 0.175, 0.001, "Model fails for SNR = " << snr);
 }
 
+// ==============================================================================
+class LrWpanErrorTableTestCase : public TestCase
+{
+public:
+  LrWpanErrorTableTestCase ();
+  virtual ~LrWpanErrorTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LrWpanErrorTableTestCase::LrWpanErrorTableTestCase ()
+  : TestCase ("Test the interpolation of the 802.15.4 error model")
+{
+}
+
+LrWpanErrorTableTestCase::~LrWpanErrorTableTestCase ()
+{
+}
+
+void
+LrWpanErrorTableTestCase::DoRun (void)
+{
+  static const double coefficients[17] = { 1, -16, 120, -560, 1820, -4368, 8008, -11440, 12870,
+                                           -11440, 8008, -4368, 1820, -560, 120, -16, 1 };
+  Ptr<LrWpanErrorModel> model = CreateObject<LrWpanErrorModel> ();
+
+  // Compare to the formula of IEEE Std 802.15.4-2006, section E.4.1.7,
+  // between and on the points of the table, and beyond it.
+  for (double snrDb = -15; snrDb <= 15; snrDb += 0.0173)
+    {
+      double snr = pow (10.0, snrDb / 10.0);
+      double ber = 0.0;
+      for (uint32_t k = 2; k <= 16; k++)
+        {
+          ber += coefficients[k] * exp (20.0 * snr * (1.0 / k - 1.0));
+        }
+      ber = std::min (ber * 8.0 / 15.0 / 16.0, 1.0);
+      double interpolated = 1.0 - model->GetChunkSuccessRate (snr, 1);
+      NS_TEST_ASSERT_MSG_EQ_TOL (interpolated, ber, std::max (ber * 5.1e-5, 1e-15), "Model fails for SNR = " << snrDb);
+      double psr = model->GetChunkSuccessRate (snr, 1024);
+      NS_TEST_ASSERT_MSG_EQ_TOL (psr, pow (1.0 - ber, 1024), 1e-4, "Model fails for SNR = " << snrDb);
+    }
+}
+
+// ==============================================================================
+class LrWpanInterferenceSumTestCase : public TestCase
+{
+public:
+  LrWpanInterferenceSumTestCase ();
+  virtual ~LrWpanInterferenceSumTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Compare the running sum of the helper with a full re-sum of the signals.
+   *
+   * \param helper the interference helper
+   * \param signals the signals added to the helper and not removed
+   * \param removed the number of signals removed so far
+   */
+  void CheckSum (Ptr<LrWpanInterferenceHelper> helper,
+                 const std::vector<Ptr<SpectrumValue> > &signals, uint32_t removed);
+};
+
+LrWpanInterferenceSumTestCase::LrWpanInterferenceSumTestCase ()
+  : TestCase ("Test the running sum of the 802.15.4 interference helper")
+{
+}
+
+LrWpanInterferenceSumTestCase::~LrWpanInterferenceSumTestCase ()
+{
+}
+
+void
+LrWpanInterferenceSumTestCase::CheckSum (Ptr<LrWpanInterferenceHelper> helper,
+                                         const std::vector<Ptr<SpectrumValue> > &signals, uint32_t removed)
+{
+  Ptr<SpectrumValue> sum = helper->GetSignalPsd ();
+  for (uint32_t band = 0; band < sum->GetSpectrumModel ()->GetNumBands (); band++)
+    {
+      double expected = 0;
+      for (std::vector<Ptr<SpectrumValue> >::const_iterator i = signals.begin (); i != signals.end (); ++i)
+        {
+          expected += *((*i)->ConstValuesBegin () + band);
+        }
+      NS_TEST_ASSERT_MSG_EQ_TOL ((*sum)[band], expected, expected * 1e-9,
+                                 "Wrong sum in band " << band << " after " << removed << " removals");
+    }
+}
+
+void
+LrWpanInterferenceSumTestCase::DoRun (void)
+{
+  std::vector<double> frequencies;
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      frequencies.push_back (2405e6 + i * 1e6);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (frequencies);
+  Ptr<LrWpanInterferenceHelper> helper = Create<LrWpanInterferenceHelper> (model);
+
+  // Signals spread over two orders of magnitude, so that the subtractions
+  // round.
+  std::vector<Ptr<SpectrumValue> > signals;
+  for (uint32_t i = 0; i < 400; i++)
+    {
+      Ptr<SpectrumValue> signal = Create<SpectrumValue> (model);
+      for (uint32_t band = 0; band < frequencies.size (); band++)
+        {
+          (*signal)[band] = 1e-12 * (1 + (i * 37 + band * 11) % 100);
+        }
+      NS_TEST_ASSERT_MSG_EQ (helper->AddSignal (signal), true, "Signal " << i << " not added");
+      signals.push_back (signal);
+    }
+  CheckSum (helper, signals, 0);
+
+  // Remove more signals than the re-sum interval, in another order than
+  // they were added, checking the sum on the way. The sum is read after
+  // 255 subtractions, at the first re-sum, and after it.
+  uint32_t removed = 0;
+  while (signals.size () > 20)
+    {
+      uint32_t index = (removed * 7) % signals.size ();
+      NS_TEST_ASSERT_MSG_EQ (helper->RemoveSignal (signals[index]), true, "Signal not removed");
+      signals.erase (signals.begin () + index);
+      removed++;
+      if (removed == 255 || removed == 256 || removed % 50 == 0)
+        {
+          CheckSum (helper, signals, removed);
+        }
+    }
+  CheckSum (helper, signals, removed);
+
+  // Signals added after a re-sum are counted
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Ptr<SpectrumValue> signal = Create<SpectrumValue> (model);
+      *signal += 1e-10;
+      helper->AddSignal (signal);
+      signals.push_back (signal);
+    }
+  CheckSum (helper, signals, removed);
+}
+
 // ==============================================================================
 class LrWpanErrorModelTestSuite : public TestSuite
 {
@@ -186,6 +336,8 @@ LrWpanErrorModelTestSuite::LrWpanErrorModelTestSuite ()
   : TestSuite ("lr-wpan-error-model", UNIT)
 {
   AddTestCase (new LrWpanErrorModelTestCase, TestCase::QUICK);
+  AddTestCase (new LrWpanErrorTableTestCase, TestCase::QUICK);
+  AddTestCase (new LrWpanInterferenceSumTestCase, TestCase::QUICK);
   AddTestCase (new LrWpanErrorDistanceTestCase, TestCase::QUICK);
 }
 
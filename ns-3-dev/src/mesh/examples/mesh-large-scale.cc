@@ -0,0 +1,239 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mesh-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/mesh-helper.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * \brief Benchmark of HWMP in a large 802.11s mesh.
+ *
+ * This script scales the grid of the mesh example to a large number of
+ * mesh points (40 * 25 = 1000 by default). The first mesh point is the
+ * root of the proactive HWMP tree, so that every mesh point handles the
+ * periodic root announcements, and UDP echo flows between random pairs of
+ * mesh points exercise the reactive path discovery and the path errors.
+ *
+ * At the end, the script reports the wall-clock time of the simulation
+ * and the number of events processed per second, as counted by
+ * Simulator::GetEventCount (cancelled events included).
+ *
+ * Usage: ./waf --run "mesh-large-scale --x-size=40 --y-size=25 --flows=20 --time=10"
+ */
+class MeshLargeScale
+{
+public:
+  MeshLargeScale ();
+  /// Configure script parameters, \return true on successful configuration
+  bool Configure (int argc, char **argv);
+  /// Run simulation
+  void Run ();
+  /// Report results
+  void Report (std::ostream & os);
+
+private:
+  ///\name parameters
+  //\{
+  /// Number of mesh points in a row of the grid
+  uint32_t xSize;
+  /// Number of rows of the grid
+  uint32_t ySize;
+  /// Distance between neighbor mesh points, meters
+  double step;
+  /// Number of UDP echo flows
+  uint32_t flows;
+  /// Interval between two packets of a flow, seconds
+  double packetInterval;
+  /// Simulation time, seconds
+  double totalTime;
+  /// Mac address of the root mesh point, or broadcast for no root
+  std::string root;
+  //\}
+
+  ///\name results
+  //\{
+  /// Wall-clock duration of the simulation, seconds
+  double wallTime;
+  /// Number of events processed, cancelled events included
+  uint64_t events;
+  //\}
+
+  ///\name network
+  //\{
+  NodeContainer nodes;
+  NetDeviceContainer meshDevices;
+  Ipv4InterfaceContainer interfaces;
+  MeshHelper mesh;
+  //\}
+
+private:
+  void CreateNodes ();
+  void InstallInternetStack ();
+  void InstallApplications ();
+};
+
+int main (int argc, char **argv)
+{
+  MeshLargeScale test;
+  if (!test.Configure (argc, argv))
+    NS_FATAL_ERROR ("Configuration failed. Aborted.");
+
+  test.Run ();
+  test.Report (std::cout);
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+MeshLargeScale::MeshLargeScale () :
+  xSize (40),
+  ySize (25),
+  step (100),
+  flows (20),
+  packetInterval (1),
+  totalTime (10),
+  // the address of the first mesh point created
+  root ("00:00:00:00:00:01"),
+  wallTime (0),
+  events (0)
+{
+}
+
+bool
+MeshLargeScale::Configure (int argc, char **argv)
+{
+  SeedManager::SetSeed (12345);
+  CommandLine cmd;
+
+  cmd.AddValue ("x-size", "Number of mesh points in a row of the grid.", xSize);
+  cmd.AddValue ("y-size", "Number of rows of the grid.", ySize);
+  cmd.AddValue ("step", "Distance between neighbor mesh points, m.", step);
+  cmd.AddValue ("flows", "Number of UDP echo flows.", flows);
+  cmd.AddValue ("packet-interval", "Interval between two packets of a flow, s.", packetInterval);
+  cmd.AddValue ("time", "Simulation time, s.", totalTime);
+  cmd.AddValue ("root", "Mac address of the root mesh point, ff:ff:ff:ff:ff:ff for none.", root);
+
+  cmd.Parse (argc, argv);
+  return (xSize * ySize > 1);
+}
+
+void
+MeshLargeScale::Run ()
+{
+  CreateNodes ();
+  InstallInternetStack ();
+  InstallApplications ();
+
+  std::cout << "Starting simulation for " << totalTime << " s ...\n";
+
+  Simulator::Stop (Seconds (totalTime));
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  wallTime = clock.End () / 1000.0;
+  events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+}
+
+void
+MeshLargeScale::Report (std::ostream & os)
+{
+  os << "Mesh points: " << xSize * ySize << ", flows: " << flows << "\n"
+     << "Events processed (cancelled included): " << events << "\n"
+     << "Wall-clock time: " << wallTime << " s\n"
+     << "Events processed per second: " << (wallTime > 0 ? events / wallTime : 0) << "\n";
+}
+
+void
+MeshLargeScale::CreateNodes ()
+{
+  std::cout << "Creating " << xSize * ySize << " mesh points.\n";
+  nodes.Create (xSize * ySize);
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+
+  mesh = MeshHelper::Default ();
+  if (!Mac48Address (root.c_str ()).IsBroadcast ())
+    {
+      mesh.SetStackInstaller ("ns3::Dot11sStack", "Root", Mac48AddressValue (Mac48Address (root.c_str ())));
+    }
+  else
+    {
+      mesh.SetStackInstaller ("ns3::Dot11sStack");
+    }
+  mesh.SetMacType ("RandomStart", TimeValue (Seconds (0.1)));
+  meshDevices = mesh.Install (wifiPhy, nodes);
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "MinX", DoubleValue (0.0),
+                                 "MinY", DoubleValue (0.0),
+                                 "DeltaX", DoubleValue (step),
+                                 "DeltaY", DoubleValue (step),
+                                 "GridWidth", UintegerValue (xSize),
+                                 "LayoutType", StringValue ("RowFirst"));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+}
+
+void
+MeshLargeScale::InstallInternetStack ()
+{
+  InternetStackHelper internetStack;
+  internetStack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.0.0.0");
+  interfaces = address.Assign (meshDevices);
+}
+
+void
+MeshLargeScale::InstallApplications ()
+{
+  uint16_t port = 9;
+  uint32_t size = xSize * ySize;
+  UdpEchoServerHelper echoServer (port);
+  ApplicationContainer serverApps = echoServer.Install (nodes);
+  serverApps.Start (Seconds (0.0));
+  serverApps.Stop (Seconds (totalTime));
+
+  Ptr<UniformRandomVariable> node = CreateObject<UniformRandomVariable> ();
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < flows; ++i)
+    {
+      uint32_t src = node->GetInteger (0, size - 1);
+      uint32_t dst = node->GetInteger (0, size - 2);
+      if (dst >= src)
+        {
+          dst++;
+        }
+      UdpEchoClientHelper echoClient (interfaces.GetAddress (dst), port);
+      echoClient.SetAttribute ("MaxPackets", UintegerValue ((uint32_t)(totalTime / packetInterval)));
+      echoClient.SetAttribute ("Interval", TimeValue (Seconds (packetInterval)));
+      echoClient.SetAttribute ("PacketSize", UintegerValue (64));
+      ApplicationContainer clientApps = echoClient.Install (nodes.Get (src));
+      clientApps.Start (Seconds (start->GetValue (1, 1 + totalTime / 4)));
+      clientApps.Stop (Seconds (totalTime));
+    }
+}
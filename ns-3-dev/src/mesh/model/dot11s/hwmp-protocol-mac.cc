@@ -374,21 +374,13 @@ HwmpProtocolMac::InitiatePerr (std::vector<HwmpProtocol::FailedDestination> fail
                                  Mac48Address> receivers)
 {
   //All duplicates in PERR are checked here, and there is no reason to
-  //check it at any athoer place
+  //check it at any athoer place. The stored receivers and destinations
+  //are indexed so that batching many failures stays linear.
   {
     std::vector<Mac48Address>::const_iterator end = receivers.end ();
     for (std::vector<Mac48Address>::const_iterator i = receivers.begin (); i != end; i++)
       {
-        bool should_add = true;
-        for (std::vector<Mac48Address>::const_iterator j = m_myPerr.receivers.begin (); j
-             != m_myPerr.receivers.end (); j++)
-          {
-            if ((*i) == (*j))
-              {
-                should_add = false;
-              }
-          }
-        if (should_add)
+        if (m_myPerr.receiverSet.insert (std::make_pair (*i, true)).second)
           {
             m_myPerr.receivers.push_back (*i);
           }
@@ -398,19 +390,18 @@ HwmpProtocolMac::InitiatePerr (std::vector<HwmpProtocol::FailedDestination> fail
     std::vector<HwmpProtocol::FailedDestination>::const_iterator end = failedDestinations.end ();
     for (std::vector<HwmpProtocol::FailedDestination>::const_iterator i = failedDestinations.begin (); i != end; i++)
       {
-        bool should_add = true;
-        for (std::vector<HwmpProtocol::FailedDestination>::const_iterator j = m_myPerr.destinations.begin (); j
-             != m_myPerr.destinations.end (); j++)
+        // Skip a destination already stored with a newer sequence number
+        std::pair<sgi::hash_map<Mac48Address, uint32_t, Mac48AddressHash>::iterator, bool> stored =
+          m_myPerr.seqnums.insert (std::make_pair ((*i).destination, (*i).seqnum));
+        if (!stored.second)
           {
-            if (((*i).destination == (*j).destination) && ((*j).seqnum > (*i).seqnum))
+            if (stored.first->second > (*i).seqnum)
               {
-                should_add = false;
+                continue;
               }
+            stored.first->second = (*i).seqnum;
           }
-        if (should_add)
-          {
-            m_myPerr.destinations.push_back (*i);
-          }
+        m_myPerr.destinations.push_back (*i);
       }
   }
   SendMyPerr ();
@@ -427,6 +418,8 @@ HwmpProtocolMac::SendMyPerr ()
   ForwardPerr (m_myPerr.destinations, m_myPerr.receivers);
   m_myPerr.destinations.clear ();
   m_myPerr.receivers.clear ();
+  m_myPerr.seqnums.clear ();
+  m_myPerr.receiverSet.clear ();
 }
 uint32_t
 HwmpProtocolMac::GetLinkMetric (Mac48Address peerAddress) const
@@ -23,6 +23,7 @@
 
 #include "ns3/mesh-wifi-interface-mac-plugin.h"
 #include "ns3/hwmp-protocol.h"
+#include "ns3/sgi-hashmap.h"
 
 namespace ns3 {
 
@@ -105,6 +106,10 @@ private:
   struct MyPerr {
     std::vector<HwmpProtocol::FailedDestination> destinations;
     std::vector<Mac48Address> receivers;
+    /// highest sequence number of each stored destination
+    sgi::hash_map<Mac48Address, uint32_t, Mac48AddressHash> seqnums;
+    /// stored receivers
+    sgi::hash_map<Mac48Address, bool, Mac48AddressHash> receiverSet;
   };
   MyPerr m_myPerr;
   ///\name Statistics:
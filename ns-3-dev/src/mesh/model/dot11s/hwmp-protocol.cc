@@ -35,6 +35,7 @@
 #include "ie-dot11s-prep.h"
 #include "ns3/trace-source-accessor.h"
 #include "ie-dot11s-perr.h"
+#include <set>
 
 NS_LOG_COMPONENT_DEFINE ("HwmpProtocol");
 
@@ -215,7 +216,7 @@ void
 HwmpProtocol::DoDispose ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  for (std::map<Mac48Address, PreqEvent>::iterator i = m_preqTimeouts.begin (); i != m_preqTimeouts.end (); i++)
+  for (sgi::hash_map<Mac48Address, PreqEvent, Mac48AddressHash>::iterator i = m_preqTimeouts.begin (); i != m_preqTimeouts.end (); i++)
     {
       i->second.preqTimeout.Cancel ();
     }
@@ -406,7 +407,7 @@ HwmpProtocol::ReceivePreq (IePreq preq, Mac48Address from, uint32_t interface, M
 {
   preq.IncrementMetric (metric);
   //acceptance cretirea:
-  std::map<Mac48Address, std::pair<uint32_t, uint32_t> >::const_iterator i = m_hwmpSeqnoMetricDatabase.find (
+  sgi::hash_map<Mac48Address, std::pair<uint32_t, uint32_t>, Mac48AddressHash>::const_iterator i = m_hwmpSeqnoMetricDatabase.find (
       preq.GetOriginatorAddress ());
   bool freshInfo (true);
   if (i != m_hwmpSeqnoMetricDatabase.end ())
@@ -569,7 +570,7 @@ HwmpProtocol::ReceivePrep (IePrep prep, Mac48Address from, uint32_t interface, M
 {
   prep.IncrementMetric (metric);
   //acceptance cretirea:
-  std::map<Mac48Address, std::pair<uint32_t, uint32_t> >::const_iterator i = m_hwmpSeqnoMetricDatabase.find (
+  sgi::hash_map<Mac48Address, std::pair<uint32_t, uint32_t>, Mac48AddressHash>::const_iterator i = m_hwmpSeqnoMetricDatabase.find (
       prep.GetOriginatorAddress ());
   bool freshInfo (true);
   uint32_t sequence = prep.GetDestinationSeqNumber ();
@@ -747,7 +748,7 @@ HwmpProtocol::DropDataFrame (uint32_t seqno, Mac48Address source)
     {
       return true;
     }
-  std::map<Mac48Address, uint32_t,std::less<Mac48Address> >::const_iterator i = m_lastDataSeqno.find (source);
+  sgi::hash_map<Mac48Address, uint32_t, Mac48AddressHash>::const_iterator i = m_lastDataSeqno.find (source);
   if (i == m_lastDataSeqno.end ())
     {
       m_lastDataSeqno[source] = seqno;
@@ -827,17 +828,17 @@ HwmpProtocol::GetPerrReceivers (std::vector<FailedDestination> failedDest)
           retval.push_back (precursors[j]);
         }
     }
-  //Check if we have dublicates in retval and precursors:
-  for (unsigned int i = 0; i < retval.size (); i++)
+  //Remove the duplicates in retval, keeping the first occurrence:
+  std::set<Mac48Address> seen;
+  HwmpRtable::PrecursorList::iterator last = retval.begin ();
+  for (HwmpRtable::PrecursorList::const_iterator i = retval.begin (); i != retval.end (); i++)
     {
-      for (unsigned int j = i+1; j < retval.size (); j++)
+      if (seen.insert (i->second).second)
         {
-          if (retval[i].second == retval[j].second)
-            {
-              retval.erase (retval.begin () + j);
-            }
+          *last++ = *i;
         }
     }
+  retval.erase (last, retval.end ());
   return retval;
 }
 std::vector<Mac48Address>
@@ -915,7 +916,7 @@ HwmpProtocol::DequeueFirstPacket ()
 void
 HwmpProtocol::ReactivePathResolved (Mac48Address dst)
 {
-  std::map<Mac48Address, PreqEvent>::iterator i = m_preqTimeouts.find (dst);
+  sgi::hash_map<Mac48Address, PreqEvent, Mac48AddressHash>::iterator i = m_preqTimeouts.find (dst);
   if (i != m_preqTimeouts.end ())
     {
       m_routeDiscoveryTimeCallback (Simulator::Now () - i->second.whenScheduled);
@@ -967,7 +968,7 @@ HwmpProtocol::ProactivePathResolved ()
 bool
 HwmpProtocol::ShouldSendPreq (Mac48Address dst)
 {
-  std::map<Mac48Address, PreqEvent>::const_iterator i = m_preqTimeouts.find (dst);
+  sgi::hash_map<Mac48Address, PreqEvent, Mac48AddressHash>::const_iterator i = m_preqTimeouts.find (dst);
   if (i == m_preqTimeouts.end ())
     {
       m_preqTimeouts[dst].preqTimeout = Simulator::Schedule (
@@ -988,7 +989,7 @@ HwmpProtocol::RetryPathDiscovery (Mac48Address dst, uint8_t numOfRetry)
     }
   if (result.retransmitter != Mac48Address::GetBroadcast ())
     {
-      std::map<Mac48Address, PreqEvent>::iterator i = m_preqTimeouts.find (dst);
+      sgi::hash_map<Mac48Address, PreqEvent, Mac48AddressHash>::iterator i = m_preqTimeouts.find (dst);
       NS_ASSERT (i != m_preqTimeouts.end ());
       m_preqTimeouts.erase (i);
       return;
@@ -1003,7 +1004,7 @@ HwmpProtocol::RetryPathDiscovery (Mac48Address dst, uint8_t numOfRetry)
           packet.reply (false, packet.pkt, packet.src, packet.dst, packet.protocol, HwmpRtable::MAX_METRIC);
           packet = DequeueFirstPacketByDst (dst);
         }
-      std::map<Mac48Address, PreqEvent>::iterator i = m_preqTimeouts.find (dst);
+      sgi::hash_map<Mac48Address, PreqEvent, Mac48AddressHash>::iterator i = m_preqTimeouts.find (dst);
       NS_ASSERT (i != m_preqTimeouts.end ());
       m_routeDiscoveryTimeCallback (Simulator::Now () - i->second.whenScheduled);
       m_preqTimeouts.erase (i);
@@ -25,6 +25,8 @@
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 #include "ns3/traced-value.h"
+#include "ns3/mac48-address.h"
+#include "ns3/sgi-hashmap.h"
 #include <vector>
 #include <map>
 
@@ -240,9 +242,9 @@ private:
   ///\name Sequence number filters
   ///\{
   /// Data sequence number database
-  std::map<Mac48Address, uint32_t> m_lastDataSeqno;
+  sgi::hash_map<Mac48Address, uint32_t, Mac48AddressHash> m_lastDataSeqno;
   /// keeps HWMP seqno (first in pair) and HWMP metric (second in pair) for each address
-  std::map<Mac48Address, std::pair<uint32_t, uint32_t> > m_hwmpSeqnoMetricDatabase;
+  sgi::hash_map<Mac48Address, std::pair<uint32_t, uint32_t>, Mac48AddressHash> m_hwmpSeqnoMetricDatabase;
   ///\}
 
   /// Routing table
@@ -254,7 +256,7 @@ private:
     EventId preqTimeout;
     Time whenScheduled;
   };
-  std::map<Mac48Address, PreqEvent> m_preqTimeouts;
+  sgi::hash_map<Mac48Address, PreqEvent, Mac48AddressHash> m_preqTimeouts;
   EventId m_proactivePreqTimer;
   /// Random start in Proactive PREQ propagation
   Time m_randomStart;
@@ -52,19 +52,22 @@ void
 HwmpRtable::DoDispose ()
 {
   m_routes.clear ();
+  m_destinations.clear ();
 }
 void
 HwmpRtable::AddReactivePath (Mac48Address destination, Mac48Address retransmitter, uint32_t interface,
                              uint32_t metric, Time lifetime, uint32_t seqnum)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  RouteMap::iterator i = m_routes.find (destination);
   if (i == m_routes.end ())
     {
-      ReactiveRoute newroute;
-      m_routes[destination] = newroute;
+      i = m_routes.insert (std::make_pair (destination, ReactiveRoute ())).first;
     }
-  i = m_routes.find (destination);
-  NS_ASSERT (i != m_routes.end ());
+  else if (i->second.retransmitter != retransmitter)
+    {
+      UnfileDestination (i->second.retransmitter, destination);
+    }
+  m_destinations[retransmitter].insert (destination);
   i->second.retransmitter = retransmitter;
   i->second.interface = interface;
   i->second.metric = metric;
@@ -90,7 +93,7 @@ HwmpRtable::AddPrecursor (Mac48Address destination, uint32_t precursorInterface,
   precursor.interface = precursorInterface;
   precursor.address = precursorAddress;
   precursor.whenExpire = Simulator::Now () + lifetime;
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  RouteMap::iterator i = m_routes.find (destination);
   if (i != m_routes.end ())
     {
       bool should_add = true;
@@ -132,16 +135,30 @@ HwmpRtable::DeleteProactivePath (Mac48Address root)
 void
 HwmpRtable::DeleteReactivePath (Mac48Address destination)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  RouteMap::iterator i = m_routes.find (destination);
   if (i != m_routes.end ())
     {
+      UnfileDestination (i->second.retransmitter, destination);
       m_routes.erase (i);
     }
 }
+void
+HwmpRtable::UnfileDestination (Mac48Address retransmitter, Mac48Address destination)
+{
+  RetransmitterMap::iterator i = m_destinations.find (retransmitter);
+  if (i != m_destinations.end ())
+    {
+      i->second.erase (destination);
+      if (i->second.empty ())
+        {
+          m_destinations.erase (i);
+        }
+    }
+}
 HwmpRtable::LookupResult
 HwmpRtable::LookupReactive (Mac48Address destination)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  RouteMap::iterator i = m_routes.find (destination);
   if (i == m_routes.end ())
     {
       return LookupResult ();
@@ -156,7 +173,7 @@ HwmpRtable::LookupReactive (Mac48Address destination)
 HwmpRtable::LookupResult
 HwmpRtable::LookupReactiveExpired (Mac48Address destination)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  RouteMap::iterator i = m_routes.find (destination);
   if (i == m_routes.end ())
     {
       return LookupResult ();
@@ -185,13 +202,17 @@ HwmpRtable::GetUnreachableDestinations (Mac48Address peerAddress)
 {
   HwmpProtocol::FailedDestination dst;
   std::vector<HwmpProtocol::FailedDestination> retval;
-  for (std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.begin (); i != m_routes.end (); i++)
+  RetransmitterMap::const_iterator destinations = m_destinations.find (peerAddress);
+  if (destinations != m_destinations.end ())
     {
-      if (i->second.retransmitter == peerAddress)
+      for (std::set<Mac48Address>::const_iterator i = destinations->second.begin ();
+           i != destinations->second.end (); i++)
         {
-          dst.destination = i->first;
-          i->second.seqnum++;
-          dst.seqnum = i->second.seqnum;
+          RouteMap::iterator route = m_routes.find (*i);
+          NS_ASSERT (route != m_routes.end ());
+          dst.destination = *i;
+          route->second.seqnum++;
+          dst.seqnum = route->second.seqnum;
           retval.push_back (dst);
         }
     }
@@ -209,7 +230,7 @@ HwmpRtable::GetPrecursors (Mac48Address destination)
 {
   //We suppose that no duplicates here can be
   PrecursorList retval;
-  std::map<Mac48Address, ReactiveRoute>::iterator route = m_routes.find (destination);
+  RouteMap::iterator route = m_routes.find (destination);
   if (route != m_routes.end ())
     {
       for (std::vector<Precursor>::const_iterator i = route->second.precursors.begin ();
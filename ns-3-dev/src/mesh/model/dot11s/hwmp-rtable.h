@@ -22,8 +22,10 @@
 #define HWMP_RTABLE_H
 
 #include <map>
+#include <set>
 #include "ns3/nstime.h"
 #include "ns3/mac48-address.h"
+#include "ns3/sgi-hashmap.h"
 #include "ns3/hwmp-protocol.h"
 namespace ns3 {
 namespace dot11s {
@@ -31,6 +33,11 @@ namespace dot11s {
  * \ingroup dot11s
  *
  * \brief Routing table for HWMP -- 802.11s routing protocol
+ *
+ * Reactive routes are kept in a hash table. The destinations are also
+ * filed by retransmitter, in address order, so that the destinations
+ * made unreachable by a link failure are found without scanning the
+ * whole table.
  */
 class HwmpRtable : public Object
 {
@@ -136,8 +143,16 @@ private:
     std::vector<Precursor> precursors;
   };
 
+  /// Reactive routes, by destination
+  typedef sgi::hash_map<Mac48Address, ReactiveRoute, Mac48AddressHash> RouteMap;
+  /// Destinations of the reactive routes, by retransmitter
+  typedef std::map<Mac48Address, std::set<Mac48Address> > RetransmitterMap;
+  /// Remove a destination from the destinations of a retransmitter
+  void UnfileDestination (Mac48Address retransmitter, Mac48Address destination);
   /// List of routes
-  std::map<Mac48Address, ReactiveRoute>  m_routes;
+  RouteMap m_routes;
+  /// Destinations reached through each retransmitter
+  RetransmitterMap m_destinations;
   /// Path to proactive tree root MP
   ProactiveRoute  m_root;
 };
@@ -107,6 +107,8 @@ private:
   void TestPrecursorAdd ();
   void TestPrecursorFind ();
   ///\}
+  /// Test the destinations made unreachable by a link failure
+  void TestUnreachable ();
 private:
   Mac48Address dst;
   Mac48Address hop;
@@ -192,9 +194,35 @@ HwmpRtableTest::TestPrecursorFind ()
     }
 }
 
+void
+HwmpRtableTest::TestUnreachable ()
+{
+  Ptr<HwmpRtable> rtable = CreateObject<HwmpRtable> ();
+  Mac48Address other ("01:00:00:01:00:04");
+  rtable->AddReactivePath (Mac48Address ("01:00:00:01:00:20"), hop, iface, metric, expire, seqnum);
+  rtable->AddReactivePath (Mac48Address ("01:00:00:01:00:10"), hop, iface, metric, expire, seqnum);
+  rtable->AddReactivePath (Mac48Address ("01:00:00:01:00:30"), other, iface, metric, expire, seqnum);
+  // a route moved to another retransmitter, and a deleted route
+  rtable->AddReactivePath (Mac48Address ("01:00:00:01:00:30"), hop, iface, metric, expire, seqnum);
+  rtable->AddReactivePath (Mac48Address ("01:00:00:01:00:40"), hop, iface, metric, expire, seqnum);
+  rtable->DeleteReactivePath (Mac48Address ("01:00:00:01:00:40"));
+
+  std::vector<HwmpProtocol::FailedDestination> unreachable = rtable->GetUnreachableDestinations (hop);
+  NS_TEST_ASSERT_MSG_EQ (unreachable.size (), 3, "Unreachable destinations works");
+  // in address order, with incremented sequence numbers
+  NS_TEST_EXPECT_MSG_EQ (unreachable[0].destination, Mac48Address ("01:00:00:01:00:10"), "Unreachable destinations works");
+  NS_TEST_EXPECT_MSG_EQ (unreachable[1].destination, Mac48Address ("01:00:00:01:00:20"), "Unreachable destinations works");
+  NS_TEST_EXPECT_MSG_EQ (unreachable[2].destination, Mac48Address ("01:00:00:01:00:30"), "Unreachable destinations works");
+  NS_TEST_EXPECT_MSG_EQ (unreachable[0].seqnum, seqnum + 1, "Unreachable destinations works");
+  NS_TEST_EXPECT_MSG_EQ (rtable->GetUnreachableDestinations (other).size (), 0, "Unreachable destinations works");
+  rtable->Dispose ();
+}
+
 void
 HwmpRtableTest::DoRun ()
 {
+  TestUnreachable ();
+
   table = CreateObject<HwmpRtable> ();
 
   Simulator::Schedule (Seconds (0), &HwmpRtableTest::TestLookup, this);
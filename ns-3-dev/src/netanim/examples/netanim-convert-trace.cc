@@ -0,0 +1,51 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/netanim-module.h"
+
+// Convert a trace file written with AnimationInterface::EnableBinaryTrace
+// to the XML trace file loaded by NetAnim.
+//
+// Usage: ./waf --run "netanim-convert-trace --input=anim.bin --output=anim.xml"
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Binary animation trace file to convert", input);
+  cmd.AddValue ("output", "XML animation trace file to write", output);
+  cmd.Parse (argc, argv);
+
+  if (input.empty () || output.empty ())
+    {
+      std::cerr << "Both --input and --output must be given" << std::endl;
+      return 1;
+    }
+  if (!AnimationInterface::ConvertBinaryTrace (input, output))
+    {
+      std::cerr << "Could not convert " << input << std::endl;
+      return 1;
+    }
+  return 0;
+}
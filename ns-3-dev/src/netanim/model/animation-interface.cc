@@ -44,6 +44,7 @@
 #include "ns3/energy-source-container.h"
 
 #include <cstdio>
+#include <cstring>
 #include <unistd.h>
 #include <sstream>
 #include <fstream>
@@ -57,6 +58,92 @@ namespace ns3 {
 
 #define PURGE_INTERVAL 5
 
+// Binary trace format: a magic header, followed by records starting
+// with a one-byte record type. Integers are LEB128 varints, doubles
+// are IEEE 754 little-endian.
+static const char BINARY_TRACE_MAGIC[] = "NS3ANIM\001";
+#define BINARY_TRACE_MAGIC_SIZE 8
+#define MAX_INTERNED_STRINGS 65536
+#define MAX_BINARY_STRING_SIZE (1 << 28)
+enum BinaryRecordType
+{
+  BINARY_TEXT = 'T',   // varint length, bytes: XML text written verbatim
+  BINARY_STRING = 'S', // varint id, varint length, bytes: defines an interned string
+  BINARY_PACKET = 'P'  // kind, fId, tId, fbTx, lbTx, fbRx, lbRx, interned meta-info id
+};
+
+static void
+AppendVarint (std::string &buf, uint64_t v)
+{
+  while (v >= 0x80)
+    {
+      buf.push_back (static_cast<char> ((v & 0x7f) | 0x80));
+      v >>= 7;
+    }
+  buf.push_back (static_cast<char> (v));
+}
+
+static void
+AppendDouble (std::string &buf, double d)
+{
+  uint64_t v;
+  std::memcpy (&v, &d, sizeof (v));
+  for (uint32_t i = 0; i < 8; ++i)
+    {
+      buf.push_back (static_cast<char> (v & 0xff));
+      v >>= 8;
+    }
+}
+
+static bool
+ReadVarint (FILE *f, uint64_t &v)
+{
+  v = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      int c = std::fgetc (f);
+      if (c == EOF)
+        {
+          return false;
+        }
+      v |= static_cast<uint64_t> (c & 0x7f) << shift;
+      if (!(c & 0x80))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+static bool
+ReadDouble (FILE *f, double &d)
+{
+  uint8_t b[8];
+  if (std::fread (b, 1, 8, f) != 8)
+    {
+      return false;
+    }
+  uint64_t v = 0;
+  for (int i = 7; i >= 0; --i)
+    {
+      v = (v << 8) | b[i];
+    }
+  std::memcpy (&d, &v, sizeof (d));
+  return true;
+}
+
+static bool
+ReadString (FILE *f, std::string &st)
+{
+  uint64_t len;
+  if (!ReadVarint (f, len) || len > MAX_BINARY_STRING_SIZE)
+    {
+      return false;
+    }
+  st.resize (len);
+  return (len == 0) || (std::fread (&st[0], 1, len, f) == len);
+}
+
 static bool initialized = false;
 std::map <uint32_t, std::string> AnimationInterface::nodeDescriptions;
 std::map <uint32_t, Rgb> AnimationInterface::nodeColors;
@@ -72,7 +159,8 @@ AnimationInterface::AnimationInterface (const std::string fn, bool enable3105, u
     m_maxPktsPerFile (maxPktsPerFile), m_originalFileName (fn),
     m_routingStopTime (Seconds (0)), m_routingFileName (""),
     m_routingPollInterval (Seconds (5)), m_enable3105 (enable3105),
-    m_trackPackets (true)
+    m_trackPackets (true), m_binaryTrace (false),
+    m_samplingInterval (1), m_maxPendingPackets (MAX_PENDING_PKTS)
 {
   m_uniformRandomVariable = CreateObject<UniformRandomVariable> ();
   initialized = true;
@@ -89,6 +177,33 @@ void AnimationInterface::SkipPacketTracing ()
   m_trackPackets = false;
 }
 
+void AnimationInterface::EnableBinaryTrace (bool enable)
+{
+  if (m_binaryTrace == enable)
+    {
+      return;
+    }
+  // Rewrite the trace file from the start in the new format
+  StopAnimation (true);
+  m_binaryTrace = enable;
+  StartAnimation (true);
+}
+
+void AnimationInterface::SetPacketSampling (uint32_t interval)
+{
+  m_samplingInterval = interval;
+}
+
+void AnimationInterface::SetMaxPendingPackets (uint32_t maxPending)
+{
+  m_maxPendingPackets = maxPending;
+}
+
+bool AnimationInterface::IsPacketSampled (uint64_t uid) const
+{
+  return (m_samplingInterval <= 1) || (uid % m_samplingInterval == 0);
+}
+
 AnimationInterface & AnimationInterface::EnableIpv4RouteTracking (std::string fileName, Time startTime, Time stopTime, Time pollInterval)
 {
   m_routingFileName = fileName;
@@ -352,12 +467,18 @@ bool AnimationInterface::SetOutputFile (const std::string& fn)
       return true;
     }
   NS_LOG_INFO ("Creating new trace file:" << fn.c_str ());
-  m_f = std::fopen (fn.c_str (), "w");
+  m_f = std::fopen (fn.c_str (), m_binaryTrace ? "wb" : "w");
   if (!m_f)
     {
       NS_FATAL_ERROR ("Unable to open Animation output file");
       return false; // Can't open
     }
+  if (m_binaryTrace)
+    {
+      // Interned strings are defined anew in each file
+      m_internedStrings.clear ();
+      WriteN (BINARY_TRACE_MAGIC, BINARY_TRACE_MAGIC_SIZE, m_f);
+    }
   m_outputFileName = fn;
   m_outputFileSet = true;
   return true;
@@ -493,112 +614,21 @@ Vector AnimationInterface::GetPosition (Ptr <Node> n)
   return m_nodeLocation[n->GetId ()];
 }
 
-void AnimationInterface::PurgePendingWifi ()
+void AnimationInterface::PurgePendingPackets (AnimUidPacketInfoMap& pendingPackets)
 {
-  if (m_pendingWifiPackets.empty ())
-    return;
-  std::vector <uint64_t> purgeList;
-  for (std::map<uint64_t, AnimPacketInfo>::iterator i = m_pendingWifiPackets.begin ();
-       i != m_pendingWifiPackets.end ();
-       ++i)
+  double now = Simulator::Now ().GetSeconds ();
+  for (AnimUidPacketInfoMap::iterator i = pendingPackets.begin ();
+       i != pendingPackets.end (); )
     {
-     
-      AnimPacketInfo pktInfo = i->second; 
-      double delta = (Simulator::Now ().GetSeconds () - pktInfo.m_fbTx);
-      if (delta > PURGE_INTERVAL)
+      if (now - i->second.m_fbTx > PURGE_INTERVAL)
         {
-          purgeList.push_back (i->first);
+          pendingPackets.erase (i++);
         }
-    }
-
-  for (std::vector <uint64_t>::iterator i = purgeList.begin ();
-       i != purgeList.end ();
-       ++i)
-    {
-      m_pendingWifiPackets.erase (*i);
-    }
-
-}
-
-void AnimationInterface::PurgePendingWimax ()
-{
-  if (m_pendingWimaxPackets.empty ())
-    return;
-  std::vector <uint64_t> purgeList;
-  for (std::map<uint64_t, AnimPacketInfo>::iterator i = m_pendingWimaxPackets.begin ();
-       i != m_pendingWimaxPackets.end ();
-       ++i)
-    {
-
-      AnimPacketInfo pktInfo = i->second;
-      double delta = (Simulator::Now ().GetSeconds () - pktInfo.m_fbTx);
-      if (delta > PURGE_INTERVAL)
-        {
-          purgeList.push_back (i->first);
-        }
-    }
-
-  for (std::vector <uint64_t>::iterator i = purgeList.begin ();
-       i != purgeList.end ();
-       ++i)
-    {
-      m_pendingWimaxPackets.erase (*i);
-    }
-
-}
-
-
-void AnimationInterface::PurgePendingLte ()
-{
-  if (m_pendingLtePackets.empty ())
-    return;
-  std::vector <uint64_t> purgeList;
-  for (std::map<uint64_t, AnimPacketInfo>::iterator i = m_pendingLtePackets.begin ();
-       i != m_pendingLtePackets.end ();
-       ++i)
-    {
-
-      AnimPacketInfo pktInfo = i->second;
-      double delta = (Simulator::Now ().GetSeconds () - pktInfo.m_fbTx);
-      if (delta > PURGE_INTERVAL)
+      else
         {
-          purgeList.push_back (i->first);
-        }
-    }
-
-  for (std::vector <uint64_t>::iterator i = purgeList.begin ();
-       i != purgeList.end ();
-       ++i)
-    {
-      m_pendingLtePackets.erase (*i);
-    }
-}
-
-void AnimationInterface::PurgePendingCsma ()
-{
-  if (m_pendingCsmaPackets.empty ())
-    return;
-  std::vector <uint64_t> purgeList;
-  for (std::map<uint64_t, AnimPacketInfo>::iterator i = m_pendingCsmaPackets.begin ();
-       i != m_pendingCsmaPackets.end ();
-       ++i)
-    {
-    
-      AnimPacketInfo pktInfo = i->second;
-      double delta = (Simulator::Now ().GetSeconds () - pktInfo.m_fbTx);
-      if (delta > PURGE_INTERVAL)
-        { 
-          purgeList.push_back (i->first);
+          ++i;
         }
     }
-
-  for (std::vector <uint64_t>::iterator i = purgeList.begin ();
-       i != purgeList.end ();
-       ++i)
-    {
-      m_pendingCsmaPackets.erase (*i);
-    }
-
 }
 
 std::string AnimationInterface::GetMacAddress (Ptr <NetDevice> nd)
@@ -886,7 +916,11 @@ void AnimationInterface::StopAnimation (bool onlyAnimation)
 {
   m_started = false;
   NS_LOG_INFO ("Stopping Animation");
-  ResetAnimWriteCallback ();
+  // When the trace only goes on in a new file, keep the user's callback
+  if (!onlyAnimation)
+    {
+      ResetAnimWriteCallback ();
+    }
   if (m_f) 
     {
       // Terminate the anim element
@@ -911,6 +945,13 @@ int AnimationInterface::WriteN (const std::string& st, FILE * f)
     {
       m_writeCallback (st.c_str ());
     }
+  if (m_binaryTrace && f == m_f)
+    {
+      std::string record (1, static_cast<char> (BINARY_TEXT));
+      AppendVarint (record, st.length ());
+      record.append (st);
+      return WriteN (record.c_str (), record.length (), f);
+    }
   return WriteN (st.c_str (), st.length (), f);
 }
 
@@ -1017,19 +1058,18 @@ void AnimationInterface::DevTxTrace (std::string context, Ptr<const Packet> p,
 {
   if (!m_started || !IsInTimeWindow () || !m_trackPackets)
     return;
+  if (!IsPacketSampled (p->GetUid ()))
+    return;
   NS_ASSERT (tx);
   NS_ASSERT (rx);
   Time now = Simulator::Now ();
-  std::ostringstream oss;
   double fbTx = now.GetSeconds ();
   double lbTx = (now + txTime).GetSeconds ();
   double fbRx = (now + rxTime - txTime).GetSeconds ();
   double lbRx = (now + rxTime).GetSeconds ();
-  oss << GetXMLOpenClose_p ("p", tx->GetNode ()->GetId (), fbTx, lbTx, rx->GetNode ()->GetId (), 
-         fbRx, lbRx, m_enablePacketMetadata? GetPacketMetadata (p):"");
   StartNewTraceFile ();
   ++m_currentPktCount;
-  WriteN (oss.str (), m_f);
+  WritePacket ("p", tx->GetNode ()->GetId (), fbTx, lbTx, rx->GetNode ()->GetId (), fbRx, lbRx, p);
 }
 
 
@@ -1061,31 +1101,46 @@ AnimationInterface::GetNetDeviceFromContext (std::string context)
 
 void AnimationInterface::AddPendingUanPacket (uint64_t AnimUid, AnimPacketInfo &pktinfo)
 {
-  m_pendingUanPackets[AnimUid] = pktinfo;
+  AddPendingPacket (m_pendingUanPackets, AnimUid, pktinfo);
 }
 
                                   
 void AnimationInterface::AddPendingWifiPacket (uint64_t AnimUid, AnimPacketInfo &pktinfo)
 {
-  m_pendingWifiPackets[AnimUid] = pktinfo;
+  AddPendingPacket (m_pendingWifiPackets, AnimUid, pktinfo);
 }
 
 void AnimationInterface::AddPendingWimaxPacket (uint64_t AnimUid, AnimPacketInfo &pktinfo)
 {
   NS_ASSERT (pktinfo.m_txnd);
-  m_pendingWimaxPackets[AnimUid] = pktinfo;
+  AddPendingPacket (m_pendingWimaxPackets, AnimUid, pktinfo);
 }
 
 void AnimationInterface::AddPendingLtePacket (uint64_t AnimUid, AnimPacketInfo &pktinfo)
 {
   NS_ASSERT (pktinfo.m_txnd);
-  m_pendingLtePackets[AnimUid] = pktinfo;
+  AddPendingPacket (m_pendingLtePackets, AnimUid, pktinfo);
 }
 
 void AnimationInterface::AddPendingCsmaPacket (uint64_t AnimUid, AnimPacketInfo &pktinfo)
 {
   NS_ASSERT (pktinfo.m_txnd);
-  m_pendingCsmaPackets[AnimUid] = pktinfo;
+  AddPendingPacket (m_pendingCsmaPackets, AnimUid, pktinfo);
+}
+
+void AnimationInterface::AddPendingPacket (AnimUidPacketInfoMap& pendingPackets, uint64_t AnimUid, AnimPacketInfo &pktinfo)
+{
+  pendingPackets[AnimUid] = pktinfo;
+  // Animation uids grow with time: forget the oldest packets first
+  while (m_maxPendingPackets && pendingPackets.size () > m_maxPendingPackets)
+    {
+      AnimUidPacketInfoMap::iterator oldest = pendingPackets.begin ();
+      if (oldest->first == AnimUid)
+        {
+          ++oldest;
+        }
+      pendingPackets.erase (oldest);
+    }
 }
 
 uint64_t AnimationInterface::GetAnimUidFromPacket (Ptr <const Packet> p)
@@ -1127,7 +1182,10 @@ void AnimationInterface::UanPhyGenTxTrace (std::string context, Ptr<const Packet
   tag.Set (gAnimUid);
   p->AddByteTag (tag);
   AnimPacketInfo pktinfo (ndev, Simulator::Now (), Simulator::Now (), UpdatePosition (n));
-  AddPendingUanPacket (gAnimUid, pktinfo);
+  if (IsPacketSampled (gAnimUid))
+    {
+      AddPendingUanPacket (gAnimUid, pktinfo);
+    }
 
 
 }
@@ -1141,6 +1199,8 @@ void AnimationInterface::UanPhyGenRxTrace (std::string context, Ptr<const Packet
   Ptr <Node> n = ndev->GetNode ();
   NS_ASSERT (n);
   uint64_t AnimUid = GetAnimUidFromPacket (p);
+  if (!IsPacketSampled (AnimUid))
+    return;
   NS_LOG_INFO ("UanPhyGenRxTrace for packet:" << AnimUid);
   if (!UanPacketIsPending (AnimUid))
     {
@@ -1198,7 +1258,10 @@ void AnimationInterface::WifiPhyTxBeginTrace (std::string context,
   tag.Set (gAnimUid);
   p->AddByteTag (tag);
   AnimPacketInfo pktinfo (ndev, Simulator::Now (), Simulator::Now (), UpdatePosition (n));
-  AddPendingWifiPacket (gAnimUid, pktinfo);
+  if (IsPacketSampled (gAnimUid))
+    {
+      AddPendingWifiPacket (gAnimUid, pktinfo);
+    }
   Ptr<WifiNetDevice> netDevice = DynamicCast<WifiNetDevice> (ndev);
   Mac48Address nodeAddr = netDevice->GetMac ()->GetAddress ();
   std::ostringstream oss; 
@@ -1221,8 +1284,14 @@ void AnimationInterface::WifiPhyTxDropTrace (std::string context,
   NS_ASSERT (ndev);
   // Erase pending wifi
   uint64_t AnimUid = GetAnimUidFromPacket (p);
+  if (!IsPacketSampled (AnimUid))
+    return;
   NS_LOG_INFO ("TxDropTrace for packet:" << AnimUid);
-  NS_ASSERT (WifiPacketIsPending (AnimUid) == true);
+  if (!WifiPacketIsPending (AnimUid))
+    {
+      NS_LOG_WARN ("WifiPhyTxDropTrace: unknown Uid");
+      return;
+    }
   m_pendingWifiPackets.erase (m_pendingWifiPackets.find (AnimUid));
 }
 
@@ -1237,6 +1306,8 @@ void AnimationInterface::WifiPhyRxBeginTrace (std::string context,
   Ptr <Node> n = ndev->GetNode ();
   NS_ASSERT (n);
   uint64_t AnimUid = GetAnimUidFromPacket (p);
+  if (!IsPacketSampled (AnimUid))
+    return;
   NS_LOG_INFO ("Wifi RxBeginTrace for packet:" << AnimUid);
   if (!WifiPacketIsPending (AnimUid))
     {
@@ -1276,6 +1347,8 @@ void AnimationInterface::WifiPhyRxEndTrace (std::string context,
   Ptr <Node> n = ndev->GetNode ();
   NS_ASSERT (n);
   uint64_t AnimUid = GetAnimUidFromPacket (p);
+  if (!IsPacketSampled (AnimUid))
+    return;
   if (!WifiPacketIsPending (AnimUid))
     {
       NS_LOG_WARN ("WifiPhyRxEndTrace: unknown Uid");
@@ -1303,6 +1376,8 @@ void AnimationInterface::WifiMacRxTrace (std::string context,
   Ptr <Node> n = ndev->GetNode ();
   NS_ASSERT (n);
   uint64_t AnimUid = GetAnimUidFromPacket (p);
+  if (!IsPacketSampled (AnimUid))
+    return;
   if (!WifiPacketIsPending (AnimUid))
     {
       NS_LOG_WARN ("WifiMacRxTrace: unknown Uid");
@@ -1338,7 +1413,10 @@ void AnimationInterface::WimaxTxTrace (std::string context, Ptr<const Packet> p,
   AnimByteTag tag;
   tag.Set (gAnimUid);
   p->AddByteTag (tag);
-  AddPendingWimaxPacket (gAnimUid, pktinfo);
+  if (IsPacketSampled (gAnimUid))
+    {
+      AddPendingWimaxPacket (gAnimUid, pktinfo);
+    }
 }
 
 
@@ -1351,8 +1429,14 @@ void AnimationInterface::WimaxRxTrace (std::string context, Ptr<const Packet> p,
   Ptr <Node> n = ndev->GetNode ();
   NS_ASSERT (n);
   uint64_t AnimUid = GetAnimUidFromPacket (p);
+  if (!IsPacketSampled (AnimUid))
+    return;
   NS_LOG_INFO ("WimaxRxTrace for packet:" << AnimUid);
-  NS_ASSERT (WimaxPacketIsPending (AnimUid) == true);
+  if (!WimaxPacketIsPending (AnimUid))
+    {
+      NS_LOG_WARN ("WimaxRxTrace: unknown Uid");
+      return;
+    }
   AnimPacketInfo& pktInfo = m_pendingWimaxPackets[AnimUid];
   pktInfo.ProcessRxBegin (ndev, Simulator::Now ());
   pktInfo.ProcessRxEnd (ndev, Simulator::Now () + Seconds (0.001), UpdatePosition (n));
@@ -1376,7 +1460,10 @@ void AnimationInterface::LteTxTrace (std::string context, Ptr<const Packet> p, c
   AnimByteTag tag;
   tag.Set (gAnimUid);
   p->AddByteTag (tag);
-  AddPendingLtePacket (gAnimUid, pktinfo);
+  if (IsPacketSampled (gAnimUid))
+    {
+      AddPendingLtePacket (gAnimUid, pktinfo);
+    }
 }
 
 
@@ -1389,6 +1476,8 @@ void AnimationInterface::LteRxTrace (std::string context, Ptr<const Packet> p, c
   Ptr <Node> n = ndev->GetNode ();
   NS_ASSERT (n);
   uint64_t AnimUid = GetAnimUidFromPacket (p);
+  if (!IsPacketSampled (AnimUid))
+    return;
   NS_LOG_INFO ("LteRxTrace for packet:" << gAnimUid);
   if (!LtePacketIsPending (AnimUid))
     {
@@ -1431,7 +1520,10 @@ void AnimationInterface::LteSpectrumPhyTxStart (std::string context, Ptr<const P
     AnimByteTag tag;
     tag.Set (gAnimUid);
     p->AddByteTag (tag);
-    AddPendingLtePacket (gAnimUid, pktinfo);
+    if (IsPacketSampled (gAnimUid))
+      {
+        AddPendingLtePacket (gAnimUid, pktinfo);
+      }
   }
 }
 
@@ -1457,6 +1549,8 @@ void AnimationInterface::LteSpectrumPhyRxStart (std::string context, Ptr<const P
   {
     Ptr <Packet> p = *i;
     uint64_t AnimUid = GetAnimUidFromPacket (p);
+    if (!IsPacketSampled (AnimUid))
+      continue;
     NS_LOG_INFO ("LteSpectrumPhyRxTrace for packet:" << gAnimUid);
     if (!LtePacketIsPending (AnimUid))
       {
@@ -1486,7 +1580,10 @@ void AnimationInterface::CsmaPhyTxBeginTrace (std::string context, Ptr<const Pac
   tag.Set (gAnimUid);
   p->AddByteTag (tag);
   AnimPacketInfo pktinfo (ndev, Simulator::Now (), Simulator::Now (), UpdatePosition (n));
-  AddPendingCsmaPacket (gAnimUid, pktinfo);
+  if (IsPacketSampled (gAnimUid))
+    {
+      AddPendingCsmaPacket (gAnimUid, pktinfo);
+    }
 
 }
 
@@ -1499,6 +1596,8 @@ void AnimationInterface::CsmaPhyTxEndTrace (std::string context, Ptr<const Packe
   Ptr <Node> n = ndev->GetNode ();
   NS_ASSERT (n);
   uint64_t AnimUid = GetAnimUidFromPacket (p);
+  if (!IsPacketSampled (AnimUid))
+    return;
   NS_LOG_INFO ("CsmaPhyTxEndTrace for packet:" << AnimUid);
   if (!CsmaPacketIsPending (AnimUid))
     {
@@ -1521,6 +1620,8 @@ void AnimationInterface::CsmaPhyRxEndTrace (std::string context, Ptr<const Packe
   Ptr <Node> n = ndev->GetNode ();
   NS_ASSERT (n);
   uint64_t AnimUid = GetAnimUidFromPacket (p);
+  if (!IsPacketSampled (AnimUid))
+    return;
   if (!CsmaPacketIsPending (AnimUid))
     {
       NS_LOG_WARN ("CsmaPhyRxEndTrace: unknown Uid"); 
@@ -1551,6 +1652,8 @@ void AnimationInterface::CsmaMacRxTrace (std::string context,
   Ptr <Node> n = ndev->GetNode ();
   NS_ASSERT (n);
   uint64_t AnimUid = GetAnimUidFromPacket (p);
+  if (!IsPacketSampled (AnimUid))
+    return;
   if (!CsmaPacketIsPending (AnimUid))
     {
       NS_LOG_WARN ("CsmaMacRxTrace: unknown Uid"); 
@@ -1643,10 +1746,11 @@ void AnimationInterface::MobilityAutoCheck ()
     }
   if (!Simulator::IsFinished ())
     {
-      PurgePendingWifi ();
-      PurgePendingWimax ();
-      PurgePendingLte ();
-      PurgePendingCsma ();
+      PurgePendingPackets (m_pendingWifiPackets);
+      PurgePendingPackets (m_pendingWimaxPackets);
+      PurgePendingPackets (m_pendingLtePackets);
+      PurgePendingPackets (m_pendingCsmaPackets);
+      PurgePendingPackets (m_pendingUanPackets);
       Simulator::Schedule (m_mobilityPollInterval, &AnimationInterface::MobilityAutoCheck, this);
     }
 }
@@ -1775,7 +1879,6 @@ return s;
 void AnimationInterface::OutputWirelessPacket (Ptr<const Packet> p, AnimPacketInfo &pktInfo, AnimRxInfo pktrxInfo)
 {
   StartNewTraceFile ();
-  std::ostringstream oss;
   uint32_t nodeId =  0;
   if (pktInfo.m_txnd)
     nodeId = pktInfo.m_txnd->GetNode ()->GetId ();
@@ -1785,22 +1888,151 @@ void AnimationInterface::OutputWirelessPacket (Ptr<const Packet> p, AnimPacketIn
   double lbTx = pktInfo.firstlastbitDelta + pktInfo.m_fbTx;
   uint32_t rxId = pktrxInfo.m_rxnd->GetNode ()->GetId ();
 
-  oss << GetXMLOpenClose_p ("wp", nodeId, pktInfo.m_fbTx, lbTx, rxId,
-                            pktrxInfo.m_fbRx, pktrxInfo.m_lbRx, m_enablePacketMetadata? GetPacketMetadata (p):"");
-  WriteN (oss.str (), m_f);
+  WritePacket ("wp", nodeId, pktInfo.m_fbTx, lbTx, rxId, pktrxInfo.m_fbRx, pktrxInfo.m_lbRx, p);
 }
 
 void AnimationInterface::OutputCsmaPacket (Ptr<const Packet> p, AnimPacketInfo &pktInfo, AnimRxInfo pktrxInfo)
 {
   StartNewTraceFile ();
-  std::ostringstream oss;
   NS_ASSERT (pktInfo.m_txnd);
   uint32_t nodeId = pktInfo.m_txnd->GetNode ()->GetId ();
   uint32_t rxId = pktrxInfo.m_rxnd->GetNode ()->GetId ();
 
-  oss << GetXMLOpenClose_p ("p", nodeId, pktInfo.m_fbTx, pktInfo.m_lbTx, rxId,
-                            pktrxInfo.m_fbRx, pktrxInfo.m_lbRx, m_enablePacketMetadata? GetPacketMetadata (p):"");
-  WriteN (oss.str (), m_f);
+  WritePacket ("p", nodeId, pktInfo.m_fbTx, pktInfo.m_lbTx, rxId, pktrxInfo.m_fbRx, pktrxInfo.m_lbRx, p);
+}
+
+void AnimationInterface::WritePacket (std::string pktType, uint32_t fId, double fbTx, double lbTx, uint32_t tId,
+                                      double fbRx, double lbRx, Ptr<const Packet> p)
+{
+  std::string metaInfo = m_enablePacketMetadata ? GetPacketMetadata (p) : "";
+  if (!m_binaryTrace || m_writeCallback)
+    {
+      std::string st = GetXMLOpenClose_p (pktType, fId, fbTx, lbTx, tId, fbRx, lbRx, metaInfo);
+      if (!m_binaryTrace)
+        {
+          WriteN (st, m_f);
+          return;
+        }
+      m_writeCallback (st.c_str ());
+    }
+  uint32_t metaId = metaInfo.empty () ? 0 : GetInternedStringId (metaInfo);
+  std::string record;
+  record.reserve (64);
+  record.push_back (static_cast<char> (BINARY_PACKET));
+  record.push_back (pktType == "wp" ? 1 : 0);
+  AppendVarint (record, fId);
+  AppendVarint (record, tId);
+  AppendDouble (record, fbTx);
+  AppendDouble (record, lbTx);
+  AppendDouble (record, fbRx);
+  AppendDouble (record, lbRx);
+  AppendVarint (record, metaId);
+  WriteN (record.c_str (), record.length (), m_f);
+}
+
+uint32_t AnimationInterface::GetInternedStringId (const std::string& st)
+{
+  std::map<std::string, uint32_t>::const_iterator i = m_internedStrings.find (st);
+  if (i != m_internedStrings.end ())
+    {
+      return i->second;
+    }
+  if (m_internedStrings.size () >= MAX_INTERNED_STRINGS)
+    {
+      // Bound the table: start over, ids are defined again when reused
+      m_internedStrings.clear ();
+    }
+  uint32_t id = m_internedStrings.size () + 1;
+  m_internedStrings[st] = id;
+  std::string record (1, static_cast<char> (BINARY_STRING));
+  AppendVarint (record, id);
+  AppendVarint (record, st.length ());
+  record.append (st);
+  WriteN (record.c_str (), record.length (), m_f);
+  return id;
+}
+
+bool AnimationInterface::ConvertBinaryTrace (const std::string& binaryFileName, const std::string& xmlFileName)
+{
+  FILE * in = std::fopen (binaryFileName.c_str (), "rb");
+  if (!in)
+    {
+      NS_LOG_WARN ("Unable to open binary trace file " << binaryFileName);
+      return false;
+    }
+  char magic[BINARY_TRACE_MAGIC_SIZE];
+  if ((std::fread (magic, 1, BINARY_TRACE_MAGIC_SIZE, in) != BINARY_TRACE_MAGIC_SIZE) ||
+      (std::memcmp (magic, BINARY_TRACE_MAGIC, BINARY_TRACE_MAGIC_SIZE) != 0))
+    {
+      NS_LOG_WARN (binaryFileName << " is not a binary animation trace file");
+      std::fclose (in);
+      return false;
+    }
+  FILE * out = std::fopen (xmlFileName.c_str (), "w");
+  if (!out)
+    {
+      NS_LOG_WARN ("Unable to open XML trace file " << xmlFileName);
+      std::fclose (in);
+      return false;
+    }
+
+  // Interned strings by id, 0 being the empty string
+  std::vector<std::string> strings (1);
+  bool ok = true;
+  int type;
+  while (ok && (type = std::fgetc (in)) != EOF)
+    {
+      std::string st;
+      switch (type)
+        {
+        case BINARY_TEXT:
+          ok = ReadString (in, st);
+          break;
+        case BINARY_STRING:
+          {
+            uint64_t id;
+            ok = ReadVarint (in, id) && (id > 0) && (id <= MAX_INTERNED_STRINGS) && ReadString (in, st);
+            if (ok)
+              {
+                if (strings.size () <= id)
+                  {
+                    strings.resize (id + 1);
+                  }
+                strings[id].swap (st);
+              }
+            break;
+          }
+        case BINARY_PACKET:
+          {
+            int kind = std::fgetc (in);
+            uint64_t fId, tId, metaId;
+            double fbTx, lbTx, fbRx, lbRx;
+            ok = (kind != EOF) && ReadVarint (in, fId) && ReadVarint (in, tId)
+              && ReadDouble (in, fbTx) && ReadDouble (in, lbTx)
+              && ReadDouble (in, fbRx) && ReadDouble (in, lbRx)
+              && ReadVarint (in, metaId) && (metaId < strings.size ());
+            if (ok)
+              {
+                st = GetXMLOpenClose_p (kind ? "wp" : "p", fId, fbTx, lbTx, tId, fbRx, lbRx, strings[metaId]);
+              }
+            break;
+          }
+        default:
+          ok = false;
+          break;
+        }
+      if (ok && (std::fwrite (st.data (), 1, st.length (), out) != st.length ()))
+        {
+          ok = false;
+        }
+    }
+  if (!ok)
+    {
+      NS_LOG_WARN ("Truncated or corrupted binary trace file " << binaryFileName);
+    }
+  std::fclose (in);
+  std::fclose (out);
+  return ok;
 }
 
 void AnimationInterface::SetConstantPosition (Ptr <Node> n, double x, double y, double z)
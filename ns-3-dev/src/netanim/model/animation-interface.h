@@ -44,6 +44,7 @@
 namespace ns3 {
 
 #define MAX_PKTS_PER_TRACE_FILE 100000
+#define MAX_PENDING_PKTS 100000
 struct Rgb;
 struct NodeSize;
 typedef struct 
@@ -455,6 +456,52 @@ public:
    */
   uint64_t GetTracePktCount ();
 
+  /**
+   *
+   * \brief Write the trace file in the compact binary format
+   * \param enable if true, the trace file is reopened and written in binary,
+   *        if false, it is reopened and written in XML
+   *
+   * Packet records are written as fixed binary fields instead of XML
+   * elements, and packet metadata strings are interned: each distinct
+   * string is written once and then referred to by a number. All the
+   * other elements are written unchanged. The trace file is rewritten
+   * from the beginning, so this should be called right after the
+   * AnimationInterface is created. Use ConvertBinaryTrace to obtain the
+   * XML trace file NetAnim reads.
+   */
+  void EnableBinaryTrace (bool enable = true);
+
+  /**
+   *
+   * \brief Convert a binary trace file to the XML format
+   * \param binaryFileName The binary trace file written with EnableBinaryTrace
+   * \param xmlFileName The XML trace file to write
+   *
+   * returns true if the whole binary trace file could be converted
+   *
+   */
+  static bool ConvertBinaryTrace (const std::string& binaryFileName, const std::string& xmlFileName);
+
+  /**
+   *
+   * \brief Trace only a sample of the packets
+   * \param interval One packet out of every interval packets is traced.
+   *        0 or 1 traces every packet
+   *
+   */
+  void SetPacketSampling (uint32_t interval);
+
+  /**
+   *
+   * \brief Bound the number of wireless and CSMA packets waiting for their reception
+   * \param maxPending The maximum number of packets tracked for each kind
+   *        of device, 0 for no limit. When the limit is reached, the
+   *        oldest packet is forgotten. The default is MAX_PENDING_PKTS
+   *
+   */
+  void SetMaxPendingPackets (uint32_t maxPending);
+
   /**
    *
    * \brief Setup a node counter
@@ -624,6 +671,12 @@ private:
 
   void OutputWirelessPacket (Ptr<const Packet> p, AnimPacketInfo& pktInfo, AnimRxInfo pktrxInfo);
   void OutputCsmaPacket (Ptr<const Packet> p, AnimPacketInfo& pktInfo, AnimRxInfo pktrxInfo);
+  // Write a packet record as XML or binary
+  void WritePacket (std::string pktType, uint32_t fId, double fbTx, double lbTx, uint32_t tId,
+                    double fbRx, double lbRx, Ptr<const Packet> p);
+  // Id of an interned string in the binary trace, written on first use
+  uint32_t GetInternedStringId (const std::string& st);
+  bool IsPacketSampled (uint64_t uid) const;
   void MobilityAutoCheck ();
   
 
@@ -647,6 +700,10 @@ private:
   void AddPendingUanPacket (uint64_t AnimUid, AnimPacketInfo&);
   bool UanPacketIsPending (uint64_t AnimUid);
 
+  typedef std::map<uint64_t, AnimPacketInfo> AnimUidPacketInfoMap;
+  void AddPendingPacket (AnimUidPacketInfoMap& pendingPackets, uint64_t AnimUid, AnimPacketInfo&);
+  void PurgePendingPackets (AnimUidPacketInfoMap& pendingPackets);
+
   uint64_t GetAnimUidFromPacket (Ptr <const Packet>);
 
   std::map<uint32_t, Vector> m_nodeLocation;
@@ -656,11 +713,6 @@ private:
   void WriteDummyPacket ();
   bool NodeHasMoved (Ptr <Node> n, Vector newLocation);
 
-  void PurgePendingWifi ();
-  void PurgePendingWimax ();
-  void PurgePendingLte ();
-  void PurgePendingCsma ();
-
   // Recalculate topology bounds
   void RecalcTopoBounds (Vector v);
   std::vector < Ptr <Node> > RecalcTopoBounds ();
@@ -717,6 +769,10 @@ private:
 
   bool m_enable3105;
   bool m_trackPackets;
+  bool m_binaryTrace;
+  uint32_t m_samplingInterval;
+  uint32_t m_maxPendingPackets;
+  std::map <std::string, uint32_t> m_internedStrings;
   uint32_t m_remainingEnergyCounterId;
   std::string GetPacketMetadata (Ptr<const Packet> p);
 
@@ -736,7 +792,7 @@ private:
   std::string GetXMLOpenClose_link (uint32_t fromLp, uint32_t fromId, uint32_t toLp, uint32_t toId);
   std::string GetXMLOpenClose_linkupdate (uint32_t fromId, uint32_t toId, std::string);
   std::string GetXMLOpen_packet (uint32_t fromLp, uint32_t fromId, double fbTx, double lbTx, std::string auxInfo = "");
-  std::string GetXMLOpenClose_p (std::string pktType, uint32_t fId, double fbTx, double lbTx, uint32_t tId, double fbRx, double lbRx,
+  static std::string GetXMLOpenClose_p (std::string pktType, uint32_t fId, double fbTx, double lbTx, uint32_t tId, double fbRx, double lbRx,
                                  std::string metaInfo = "", std::string auxInfo = "");
   std::string GetXMLOpenClose_rx (uint32_t toLp, uint32_t toId, double fbRx, double lbRx);
   std::string GetXMLOpen_wpacket (uint32_t fromLp, uint32_t fromId, double fbTx, double lbTx, double range);
@@ -18,6 +18,8 @@
  */
 
 #include <iostream>
+#include <fstream>
+#include <vector>
 #include "unistd.h"
 
 #include "ns3/core-module.h"
@@ -27,6 +29,7 @@
 #include "ns3/netanim-module.h"
 #include "ns3/applications-module.h"
 #include "ns3/point-to-point-layout-module.h"
+#include "ns3/wifi-module.h"
 #include "ns3/basic-energy-source.h"
 #include "ns3/simple-device-energy-model.h"
 
@@ -228,6 +231,214 @@ AnimationRemainingEnergyTestCase::CheckLogic (void)
                             "Wrong remaining energy value was traced");
 }
 
+class AnimationBinaryTraceTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  AnimationBinaryTraceTestCase ();
+
+private:
+
+  virtual void
+  DoRun (void);
+
+  void
+  RunSimulation (const char* traceFileName, bool binary);
+
+  std::vector<std::string>
+  ReadPacketElements (const char* traceFileName);
+
+  static void
+  CountPacketElements (const char* str);
+
+  static uint32_t m_written;
+};
+
+uint32_t AnimationBinaryTraceTestCase::m_written = 0;
+
+AnimationBinaryTraceTestCase::AnimationBinaryTraceTestCase () :
+  TestCase ("Verify the conversion of binary traces to XML")
+{
+}
+
+void
+AnimationBinaryTraceTestCase::RunSimulation (const char* traceFileName, bool binary)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  AnimationInterface::SetConstantPosition (nodes.Get (0), 0 , 10);
+  AnimationInterface::SetConstantPosition (nodes.Get (1), 1 , 10);
+
+  PointToPointHelper pointToPoint;
+  pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
+  pointToPoint.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  NetDeviceContainer devices = pointToPoint.Install (nodes);
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  UdpEchoServerHelper echoServer (9);
+  ApplicationContainer serverApps = echoServer.Install (nodes.Get (1));
+  serverApps.Start (Seconds (1.0));
+  serverApps.Stop (Seconds (10.0));
+
+  UdpEchoClientHelper echoClient (interfaces.GetAddress (1), 9);
+  echoClient.SetAttribute ("MaxPackets", UintegerValue (5));
+  echoClient.SetAttribute ("Interval", TimeValue (Seconds (1.0)));
+  echoClient.SetAttribute ("PacketSize", UintegerValue (1024));
+  ApplicationContainer clientApps = echoClient.Install (nodes.Get (0));
+  clientApps.Start (Seconds (2.0));
+  clientApps.Stop (Seconds (10.0));
+
+  AnimationInterface anim (traceFileName);
+  anim.EnablePacketMetadata (true);
+  anim.SetAnimWriteCallback (&AnimationBinaryTraceTestCase::CountPacketElements);
+  anim.EnableBinaryTrace (binary);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+std::vector<std::string>
+AnimationBinaryTraceTestCase::ReadPacketElements (const char* traceFileName)
+{
+  std::vector<std::string> elements;
+  std::ifstream in (traceFileName);
+  std::string line;
+  while (std::getline (in, line))
+    {
+      if (line.compare (0, 3, "<p ") == 0)
+        {
+          elements.push_back (line);
+        }
+    }
+  return elements;
+}
+
+void
+AnimationBinaryTraceTestCase::CountPacketElements (const char* str)
+{
+  if (std::string (str).compare (0, 3, "<p ") == 0)
+    {
+      m_written++;
+    }
+}
+
+void
+AnimationBinaryTraceTestCase::DoRun (void)
+{
+  const char* xmlFileName = "netanim-test-xml.xml";
+  const char* binaryFileName = "netanim-test-binary.bin";
+  const char* convertedFileName = "netanim-test-converted.xml";
+
+  RunSimulation (xmlFileName, false);
+  NS_TEST_EXPECT_MSG_EQ (m_written, 10, "Expected 10 packets given to the write callback");
+  m_written = 0;
+  RunSimulation (binaryFileName, true);
+  NS_TEST_EXPECT_MSG_EQ (m_written, 10, "Write callback lost when switching to a binary trace");
+  bool converted = AnimationInterface::ConvertBinaryTrace (binaryFileName, convertedFileName);
+  NS_TEST_ASSERT_MSG_EQ (converted, true, "Binary trace could not be converted");
+
+  std::vector<std::string> expected = ReadPacketElements (xmlFileName);
+  std::vector<std::string> actual = ReadPacketElements (convertedFileName);
+  NS_TEST_EXPECT_MSG_EQ (expected.size (), 10, "Expected 10 packets traced");
+  NS_TEST_EXPECT_MSG_EQ ((actual == expected), true, "Converted packets differ from the XML trace");
+
+  bool badFile = AnimationInterface::ConvertBinaryTrace (xmlFileName, convertedFileName);
+  NS_TEST_EXPECT_MSG_EQ (badFile, false, "XML trace was accepted as a binary trace");
+
+  unlink (xmlFileName);
+  unlink (binaryFileName);
+  unlink (convertedFileName);
+}
+
+class AnimationPendingPacketsTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  AnimationPendingPacketsTestCase ();
+
+private:
+
+  virtual void
+  DoRun (void);
+
+  uint32_t
+  RunSimulation (uint32_t maxPending);
+};
+
+AnimationPendingPacketsTestCase::AnimationPendingPacketsTestCase () :
+  TestCase ("Verify the eviction of pending wireless packets")
+{
+}
+
+uint32_t
+AnimationPendingPacketsTestCase::RunSimulation (uint32_t maxPending)
+{
+  NodeContainer nodes;
+  nodes.Create (3);
+  AnimationInterface::SetConstantPosition (nodes.Get (0), 0, 0);
+  AnimationInterface::SetConstantPosition (nodes.Get (1), 10, 0);
+  AnimationInterface::SetConstantPosition (nodes.Get (2), 0, 10);
+
+  WifiHelper wifi = WifiHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  NqosWifiMacHelper mac = NqosWifiMacHelper::Default ();
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  UdpEchoServerHelper echoServer (9);
+  ApplicationContainer serverApps = echoServer.Install (nodes.Get (2));
+  serverApps.Start (Seconds (1.0));
+  serverApps.Stop (Seconds (5.0));
+
+  // Both clients send at once, so that many packets are pending together
+  UdpEchoClientHelper echoClient (interfaces.GetAddress (2), 9);
+  echoClient.SetAttribute ("MaxPackets", UintegerValue (10));
+  echoClient.SetAttribute ("Interval", TimeValue (MilliSeconds (100)));
+  echoClient.SetAttribute ("PacketSize", UintegerValue (512));
+  ApplicationContainer clientApps = echoClient.Install (NodeContainer (nodes.Get (0), nodes.Get (1)));
+  clientApps.Start (Seconds (2.0));
+  clientApps.Stop (Seconds (5.0));
+
+  const char* traceFileName = "netanim-test-pending.xml";
+  uint32_t traced;
+  {
+    AnimationInterface anim (traceFileName);
+    anim.SetMaxPendingPackets (maxPending);
+    Simulator::Stop (Seconds (5.0));
+    Simulator::Run ();
+    traced = anim.GetTracePktCount ();
+    Simulator::Destroy ();
+  }
+  unlink (traceFileName);
+  return traced;
+}
+
+void
+AnimationPendingPacketsTestCase::DoRun (void)
+{
+  uint32_t unbounded = RunSimulation (0);
+  uint32_t bounded = RunSimulation (1);
+  NS_TEST_EXPECT_MSG_GT (unbounded, 0, "No wireless packet traced");
+  NS_TEST_EXPECT_MSG_GT (bounded, 0, "No wireless packet traced with one pending packet");
+  NS_TEST_EXPECT_MSG_EQ ((bounded <= unbounded), true, "Evicted packets were traced");
+}
+
 static class AnimationInterfaceTestSuite : public TestSuite
 {
 public:
@@ -236,5 +447,7 @@ public:
   {
     AddTestCase (new AnimationInterfaceTestCase (), TestCase::QUICK);
     AddTestCase (new AnimationRemainingEnergyTestCase (), TestCase::QUICK);
+    AddTestCase (new AnimationBinaryTraceTestCase (), TestCase::QUICK);
+    AddTestCase (new AnimationPendingPacketsTestCase (), TestCase::QUICK);
   }
 } g_animationInterfaceTestSuite;
@@ -19,6 +19,7 @@
 #include <stdint.h>
 #include <string>
 #include <fstream>
+#include <algorithm>
 
 #include "ns3/abort.h"
 #include "ns3/assert.h"
@@ -35,6 +36,15 @@ NS_LOG_COMPONENT_DEFINE ("TraceHelper");
 
 namespace ns3 {
 
+/// The pcapng file shared by the traces, if merged output is enabled
+static Ptr<PcapNgFile> g_mergedFile = 0;
+/// The maximum length of packet data stored in the shared pcapng file
+static uint32_t g_mergedSnapLen = 65535;
+/// The filter of the pcap files created
+static Ptr<TraceFilter> g_pcapFilter = 0;
+/// The filter of the ascii streams created
+static Ptr<TraceFilter> g_asciiFilter = 0;
+
 PcapHelper::PcapHelper ()
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -56,6 +66,19 @@ PcapHelper::CreateFile (
   NS_LOG_FUNCTION (filename << filemode << dataLinkType << snapLen << tzCorrection);
 
   Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper> ();
+  file->SetTraceFilter (g_pcapFilter);
+  if (g_mergedFile != 0)
+    {
+      std::string name = filename;
+      std::string::size_type dot = name.rfind (".pcap");
+      if (dot != std::string::npos && dot + 5 == name.size ())
+        {
+          name = name.substr (0, dot);
+        }
+      file->OpenInterface (g_mergedFile, name, dataLinkType, std::min (snapLen, g_mergedSnapLen));
+      NS_ABORT_MSG_IF (file->Fail (), "Unable to add " << name << " to the merged pcapng file");
+      return file;
+    }
   file->Open (filename, filemode);
   NS_ABORT_MSG_IF (file->Fail (), "Unable to Open " << filename << " for mode " << filemode);
 
@@ -76,6 +99,32 @@ PcapHelper::CreateFile (
   return file;
 }
 
+void
+PcapHelper::EnableMergedOutput (std::string filename, uint32_t snapLen)
+{
+  NS_LOG_FUNCTION (filename << snapLen);
+  g_mergedFile = Create<PcapNgFile> ();
+  g_mergedFile->Open (filename, std::ios::out);
+  NS_ABORT_MSG_IF (g_mergedFile->Fail (), "Unable to Open " << filename << " for mode " << std::ios::out);
+  g_mergedSnapLen = snapLen;
+  // the traces keep the file open as long as they exist
+  Simulator::ScheduleDestroy (&PcapHelper::DisableMergedOutput);
+}
+
+void
+PcapHelper::DisableMergedOutput (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  g_mergedFile = 0;
+}
+
+void
+PcapHelper::SetTraceFilter (Ptr<TraceFilter> filter)
+{
+  NS_LOG_FUNCTION (filter);
+  g_pcapFilter = filter;
+}
+
 std::string
 PcapHelper::GetFilenameFromDevice (std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -186,6 +235,7 @@ AsciiTraceHelper::CreateFileStream (std::string filename, std::ios::openmode fil
   NS_LOG_FUNCTION (filename << filemode);
 
   Ptr<OutputStreamWrapper> StreamWrapper = Create<OutputStreamWrapper> (filename, filemode);
+  StreamWrapper->SetTraceFilter (g_asciiFilter);
 
   //
   // Note that the ascii trace helper promptly forgets all about the trace file.
@@ -201,6 +251,13 @@ AsciiTraceHelper::CreateFileStream (std::string filename, std::ios::openmode fil
   return StreamWrapper;
 }
 
+void
+AsciiTraceHelper::SetTraceFilter (Ptr<TraceFilter> filter)
+{
+  NS_LOG_FUNCTION (filter);
+  g_asciiFilter = filter;
+}
+
 std::string
 AsciiTraceHelper::GetFilenameFromDevice (std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -303,6 +360,10 @@ void
 AsciiTraceHelper::DefaultEnqueueSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
   *stream->GetStream () << "+ " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -310,6 +371,10 @@ void
 AsciiTraceHelper::DefaultEnqueueSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
   *stream->GetStream () << "+ " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -329,6 +394,10 @@ void
 AsciiTraceHelper::DefaultDropSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -336,6 +405,10 @@ void
 AsciiTraceHelper::DefaultDropSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -356,6 +429,10 @@ void
 AsciiTraceHelper::DefaultDequeueSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
   *stream->GetStream () << "- " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -363,6 +440,10 @@ void
 AsciiTraceHelper::DefaultDequeueSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
   *stream->GetStream () << "- " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -380,6 +461,10 @@ void
 AsciiTraceHelper::DefaultReceiveSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -387,6 +472,10 @@ void
 AsciiTraceHelper::DefaultReceiveSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  if (!stream->Accept (p))
+    {
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
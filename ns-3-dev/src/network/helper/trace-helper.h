@@ -101,6 +101,38 @@ public:
    */
   Ptr<PcapFileWrapper> CreateFile (std::string filename, std::ios::openmode filemode,
                                    uint32_t dataLinkType,  uint32_t snapLen = 65535, int32_t tzCorrection = 0);
+
+  /**
+   * @brief Gather the pcap traces created afterwards into a single pcapng file.
+   *
+   * Once enabled, CreateFile no longer creates a pcap file, but describes a
+   * new interface, named after the pcap file without its ".pcap" extension,
+   * in the shared pcapng file, so that the EnablePcap methods of all the
+   * device helpers write to a single file through one buffered stream,
+   * with nanosecond timestamps. The file mode and time zone correction
+   * passed to CreateFile are then ignored. The trace of a single device
+   * can be extracted with PcapNgFile::Extract.
+   *
+   * The file is closed once merged output is disabled and the traces
+   * are destroyed, at the latest when the simulation is destroyed.
+   *
+   * @param filename name of the pcapng file
+   * @param snapLen maximum length of packet data stored in records, for
+   *        all the interfaces of the file
+   */
+  static void EnableMergedOutput (std::string filename, uint32_t snapLen = 65535);
+
+  /**
+   * @brief Create a separate pcap file again for each subsequent trace.
+   */
+  static void DisableMergedOutput (void);
+
+  /**
+   * @brief Filter the packets written to the pcap files created afterwards.
+   *
+   * @param filter the filter, or 0 to write all the packets
+   */
+  static void SetTraceFilter (Ptr<TraceFilter> filter);
   /**
    * @brief Hook a trace source to the default trace sink
    * 
@@ -202,6 +234,16 @@ public:
   Ptr<OutputStreamWrapper> CreateFileStream (std::string filename, 
                                              std::ios::openmode filemode = std::ios::out);
 
+  /**
+   * @brief Filter the packets written to the streams created afterwards.
+   *
+   * The default trace sinks, and the sinks of the device and internet
+   * helpers, skip the packets rejected by the filter of their stream.
+   *
+   * @param filter the filter, or 0 to write all the packets
+   */
+  static void SetTraceFilter (Ptr<TraceFilter> filter);
+
   /**
    * @brief Hook a trace source to the default enqueue operation trace sink that
    * does not accept nor log a trace context.
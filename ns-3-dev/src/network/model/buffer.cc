@@ -20,6 +20,7 @@
 #include "buffer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/memory-monitor.h"
 
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
@@ -45,6 +46,9 @@ static struct Zeroes
   const uint32_t size;  //!< buffer size
 } g_zeroes; //!< Zero-filled buffer
 
+/// Counter of the Buffer::Data blocks in the MemoryMonitor
+static uint32_t g_memoryCounter = ns3::MemoryMonitor::RegisterCounter ("ns3::Buffer");
+
 }
 
 namespace ns3 {
@@ -170,6 +174,7 @@ Buffer::Allocate (uint32_t reqSize)
   NS_ASSERT (reqSize >= 1);
   uint32_t size = reqSize - 1 + sizeof (struct Buffer::Data);
   uint8_t *b = new uint8_t [size];
+  MemoryMonitor::NotifyAllocate (g_memoryCounter, size);
   struct Buffer::Data *data = reinterpret_cast<struct Buffer::Data*>(b);
   data->m_size = reqSize;
   data->m_count = 1;
@@ -181,6 +186,7 @@ Buffer::Deallocate (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
+  MemoryMonitor::NotifyDeallocate (g_memoryCounter, data->m_size - 1 + sizeof (struct Buffer::Data));
   uint8_t *buf = reinterpret_cast<uint8_t *> (data);
   delete [] buf;
 }
@@ -19,6 +19,7 @@
  */
 #include "byte-tag-list.h"
 #include "ns3/log.h"
+#include "ns3/memory-monitor.h"
 #include <vector>
 #include <cstring>
 
@@ -30,6 +31,9 @@ NS_LOG_COMPONENT_DEFINE ("ByteTagList");
 
 namespace ns3 {
 
+/// Counter of the ByteTagListData blocks in the MemoryMonitor
+static uint32_t g_memoryCounter = MemoryMonitor::RegisterCounter ("ns3::ByteTagList");
+
 /**
  * \ingroup packet
  *
@@ -65,6 +69,7 @@ ByteTagListDataFreeList::~ByteTagListDataFreeList ()
   for (ByteTagListDataFreeList::iterator i = begin ();
        i != end (); i++)
     {
+      MemoryMonitor::NotifyDeallocate (g_memoryCounter, (*i)->size + sizeof (struct ByteTagListData) - 4);
       uint8_t *buffer = (uint8_t *)(*i);
       delete [] buffer;
     }
@@ -369,13 +374,18 @@ ByteTagList::Allocate (uint32_t size)
           data->dirty = 0;
           return data;
         }
+      MemoryMonitor::NotifyDeallocate (g_memoryCounter, data->size + sizeof (struct ByteTagListData) - 4);
       uint8_t *buffer = (uint8_t *)data;
       delete [] buffer;
     }
-  uint8_t *buffer = new uint8_t [std::max (size, g_maxSize) + sizeof (struct ByteTagListData) - 4];
+  // Record the actual capacity of the block, which is needed to
+  // account it when it is released.
+  uint32_t capacity = std::max (size, g_maxSize);
+  uint8_t *buffer = new uint8_t [capacity + sizeof (struct ByteTagListData) - 4];
+  MemoryMonitor::NotifyAllocate (g_memoryCounter, capacity + sizeof (struct ByteTagListData) - 4);
   struct ByteTagListData *data = (struct ByteTagListData *)buffer;
   data->count = 1;
-  data->size = size;
+  data->size = capacity;
   data->dirty = 0;
   return data;
 }
@@ -395,6 +405,7 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
       if (g_freeList.size () > FREE_LIST_SIZE ||
           data->size < g_maxSize)
         {
+          MemoryMonitor::NotifyDeallocate (g_memoryCounter, data->size + sizeof (struct ByteTagListData) - 4);
           uint8_t *buffer = (uint8_t *)data;
           delete [] buffer;
         }
@@ -412,6 +423,7 @@ ByteTagList::Allocate (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
   uint8_t *buffer = new uint8_t [size + sizeof (struct ByteTagListData) - 4];
+  MemoryMonitor::NotifyAllocate (g_memoryCounter, size + sizeof (struct ByteTagListData) - 4);
   struct ByteTagListData *data = (struct ByteTagListData *)buffer;
   data->count = 1;
   data->size = size;
@@ -430,6 +442,7 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
   data->count--;
   if (data->count == 0)
     {
+      MemoryMonitor::NotifyDeallocate (g_memoryCounter, data->size + sizeof (struct ByteTagListData) - 4);
       uint8_t *buffer = (uint8_t *)data;
       delete [] buffer;
     }
@@ -22,6 +22,7 @@
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/memory-monitor.h"
 #include "packet-metadata.h"
 #include "buffer.h"
 #include "header.h"
@@ -31,6 +32,9 @@ NS_LOG_COMPONENT_DEFINE ("PacketMetadata");
 
 namespace ns3 {
 
+/// Counter of the PacketMetadata::Data blocks in the MemoryMonitor
+static uint32_t g_memoryCounter = MemoryMonitor::RegisterCounter ("ns3::PacketMetadata");
+
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
@@ -626,6 +630,7 @@ PacketMetadata::Allocate (uint32_t n)
     }
   size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
   uint8_t *buf = new uint8_t [size];
+  MemoryMonitor::NotifyAllocate (g_memoryCounter, size);
   struct PacketMetadata::Data *data = (struct PacketMetadata::Data *)buf;
   data->m_size = n;
   data->m_count = 1;
@@ -636,6 +641,8 @@ void
 PacketMetadata::Deallocate (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
+  MemoryMonitor::NotifyDeallocate (g_memoryCounter,
+                                   sizeof (struct Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE);
   uint8_t *buf = (uint8_t *)data;
   delete [] buf;
 }
@@ -34,6 +34,8 @@ NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
 namespace ns3 {
 
+uint32_t PacketTagList::m_memoryCounter = MemoryMonitor::RegisterCounter ("ns3::PacketTagList");
+
 bool
 PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
 {
@@ -134,6 +136,7 @@ PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
       NS_ASSERT (cur->count > 1);
       cur->count--;                       // unmerge cur
       struct TagData * copy = new struct TagData ();
+      MemoryMonitor::NotifyAllocate (m_memoryCounter, sizeof (struct TagData));
       copy->tid = cur->tid;
       copy->count = 1;
       memcpy (copy->data, cur->data, TagData::MAX_SIZE);
@@ -177,6 +180,7 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
   if (preMerge)
     {
       // found tid before first merge, so delete cur
+      MemoryMonitor::NotifyDeallocate (m_memoryCounter, sizeof (struct TagData));
       delete cur;
     }
   else
@@ -226,6 +230,7 @@ PacketTagList::ReplaceWriter (Tag & tag, bool preMerge,
       // need to copy, replace, and link past cur
       cur->count--;                     // unmerge cur
       struct TagData * copy = new struct TagData ();
+      MemoryMonitor::NotifyAllocate (m_memoryCounter, sizeof (struct TagData));
       copy->tid = tag.GetInstanceTypeId ();
       copy->count = 1;
       tag.Serialize (TagBuffer (copy->data,
@@ -250,6 +255,7 @@ PacketTagList::Add (const Tag &tag) const
       NS_ASSERT (cur->tid != tag.GetInstanceTypeId ());
     }
   struct TagData * head = new struct TagData ();
+  MemoryMonitor::NotifyAllocate (m_memoryCounter, sizeof (struct TagData));
   head->count = 1;
   head->next = 0;
   head->tid = tag.GetInstanceTypeId ();
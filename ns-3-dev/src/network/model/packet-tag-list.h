@@ -28,6 +28,7 @@
 #include <stdint.h>
 #include <ostream>
 #include "ns3/type-id.h"
+#include "ns3/memory-monitor.h"
 
 namespace ns3 {
 
@@ -291,6 +292,11 @@ private:
    * Pointer to first \ref TagData on the list
    */
   struct TagData *m_next;
+
+  /**
+   * Counter of the \ref TagData structures in the MemoryMonitor
+   */
+  static uint32_t m_memoryCounter;
 };
 
 } // namespace ns3
@@ -350,12 +356,14 @@ PacketTagList::RemoveAll (void)
         }
       if (prev != 0) 
         {
+          MemoryMonitor::NotifyDeallocate (m_memoryCounter, sizeof (struct TagData));
 	  delete prev;
         }
       prev = cur;
     }
   if (prev != 0) 
     {
+      MemoryMonitor::NotifyDeallocate (m_memoryCounter, sizeof (struct TagData));
       delete prev;
     }
   m_next = 0;
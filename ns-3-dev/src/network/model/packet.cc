@@ -21,6 +21,7 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/memory-monitor.h"
 #include <string>
 #include <cstdarg>
 
@@ -30,6 +31,9 @@ namespace ns3 {
 
 uint32_t Packet::m_globalUid = 0;
 
+/// Counter of the Packet instances in the MemoryMonitor
+static uint32_t g_memoryCounter = MemoryMonitor::RegisterCounter ("ns3::Packet");
+
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
 {
@@ -140,6 +144,7 @@ Packet::Packet ()
     m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, 0),
     m_nixVector (0)
 {
+  MemoryMonitor::NotifyAllocate (g_memoryCounter, sizeof (Packet));
   m_globalUid++;
 }
 
@@ -149,10 +154,16 @@ Packet::Packet (const Packet &o)
     m_packetTagList (o.m_packetTagList),
     m_metadata (o.m_metadata)
 {
+  MemoryMonitor::NotifyAllocate (g_memoryCounter, sizeof (Packet));
   o.m_nixVector ? m_nixVector = o.m_nixVector->Copy ()
     : m_nixVector = 0;
 }
 
+Packet::~Packet ()
+{
+  MemoryMonitor::NotifyDeallocate (g_memoryCounter, sizeof (Packet));
+}
+
 Packet &
 Packet::operator = (const Packet &o)
 {
@@ -182,6 +193,7 @@ Packet::Packet (uint32_t size)
     m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
     m_nixVector (0)
 {
+  MemoryMonitor::NotifyAllocate (g_memoryCounter, sizeof (Packet));
   m_globalUid++;
 }
 Packet::Packet (uint8_t const *buffer, uint32_t size, bool magic)
@@ -191,6 +203,7 @@ Packet::Packet (uint8_t const *buffer, uint32_t size, bool magic)
     m_metadata (0,0),
     m_nixVector (0)
 {
+  MemoryMonitor::NotifyAllocate (g_memoryCounter, sizeof (Packet));
   NS_ASSERT (magic);
   Deserialize (buffer, size);
 }
@@ -208,6 +221,7 @@ Packet::Packet (uint8_t const*buffer, uint32_t size)
     m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
     m_nixVector (0)
 {
+  MemoryMonitor::NotifyAllocate (g_memoryCounter, sizeof (Packet));
   m_globalUid++;
   m_buffer.AddAtStart (size);
   Buffer::Iterator i = m_buffer.Begin ();
@@ -222,6 +236,7 @@ Packet::Packet (const Buffer &buffer,  const ByteTagList &byteTagList,
     m_metadata (metadata),
     m_nixVector (0)
 {
+  MemoryMonitor::NotifyAllocate (g_memoryCounter, sizeof (Packet));
 }
 
 Ptr<Packet>
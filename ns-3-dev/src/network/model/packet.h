@@ -234,6 +234,7 @@ public:
    * \param o object to copy
    */
   Packet (const Packet &o);
+  ~Packet ();
   /**
    * \brief Basic assignment
    * \param o object to copy
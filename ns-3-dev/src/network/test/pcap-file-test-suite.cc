@@ -25,6 +25,11 @@
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/pcap-file.h"
+#include "ns3/pcapng-file.h"
+#include "ns3/pcap-file-wrapper.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-helper.h"
 
 using namespace ns3;
 
@@ -1120,6 +1125,204 @@ DiffTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+// ===========================================================================
+// Test case to make sure that a pcapng file holds the packets of several
+// interfaces, truncated to their snap length, and that the packets of one
+// interface can be extracted into a pcap file.
+// ===========================================================================
+class PcapNgTestCase : public TestCase
+{
+public:
+  PcapNgTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PcapNgTestCase::PcapNgTestCase ()
+  : TestCase ("Check that PcapNgFile merges interfaces and PcapNgFile::Extract splits them")
+{
+}
+
+void
+PcapNgTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("merged.pcapng");
+  std::string extracted = CreateTempDirFilename ("extracted.pcap");
+  uint8_t buffer[128];
+  for (uint32_t i = 0; i < sizeof (buffer); ++i)
+    {
+      buffer[i] = i;
+    }
+
+  //
+  // Interleave the packets of two interfaces, with a small buffer so that
+  // some blocks are written before the file is closed.
+  //
+  Ptr<PcapNgFile> f = Create<PcapNgFile> ();
+  f->Open (filename, std::ios::out);
+  NS_TEST_ASSERT_MSG_EQ (f->Fail (), false, "Open (" << filename << ", \"std::ios::out\") returns error");
+  f->SetBufferSize (100);
+  uint32_t a = f->AddInterface (1, 65535, "a");
+  uint32_t b = f->AddInterface (9, 64, "b");
+  NS_TEST_ASSERT_MSG_EQ (a, 0, "The first interface must have index 0");
+  NS_TEST_ASSERT_MSG_EQ (b, 1, "The second interface must have index 1");
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      f->Write (i % 2 == 0 ? a : b, i * 1000001000ULL, buffer, 100 + i);
+      NS_TEST_EXPECT_MSG_EQ (f->Fail (), false, "Write must not fail");
+    }
+  f->Close ();
+
+  //
+  // Read the packets back in order.
+  //
+  f = Create<PcapNgFile> ();
+  f->Open (filename, std::ios::in);
+  NS_TEST_ASSERT_MSG_EQ (f->Fail (), false, "Open (" << filename << ", \"std::ios::in\") returns error");
+  uint8_t data[128];
+  uint32_t interface, inclLen, origLen, readLen;
+  uint64_t timestamp;
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      bool read = f->Read (data, sizeof (data), interface, timestamp, inclLen, origLen, readLen);
+      NS_TEST_ASSERT_MSG_EQ (read, true, "Read of packet " << i << " fails");
+      NS_TEST_EXPECT_MSG_EQ (interface, i % 2, "Packet " << i << " has the wrong interface");
+      NS_TEST_EXPECT_MSG_EQ (timestamp, i * 1000001000ULL, "Packet " << i << " has the wrong timestamp");
+      NS_TEST_EXPECT_MSG_EQ (origLen, 100 + i, "Packet " << i << " has the wrong original length");
+      NS_TEST_EXPECT_MSG_EQ (inclLen, (i % 2 == 0 ? 100 + i : 64), "Packet " << i << " is not truncated to the snap length");
+      NS_TEST_EXPECT_MSG_EQ (readLen, inclLen, "Packet " << i << " has the wrong length of data");
+      NS_TEST_EXPECT_MSG_EQ (memcmp (data, buffer, readLen), 0, "Packet " << i << " has the wrong data");
+    }
+  NS_TEST_EXPECT_MSG_EQ (f->Read (data, sizeof (data), interface, timestamp, inclLen, origLen, readLen), false,
+                         "The file must only contain 10 packets");
+  NS_TEST_ASSERT_MSG_EQ (f->GetNInterfaces (), 2, "The file must describe 2 interfaces");
+  NS_TEST_EXPECT_MSG_EQ (f->GetInterface (1).name, "b", "The second interface has the wrong name");
+  NS_TEST_EXPECT_MSG_EQ (f->GetInterface (1).dataLinkType, 9, "The second interface has the wrong data link type");
+  NS_TEST_EXPECT_MSG_EQ (f->GetInterface (1).snapLen, 64, "The second interface has the wrong snap length");
+  f->Close ();
+
+  //
+  // Extract the packets of the second interface.
+  //
+  NS_TEST_EXPECT_MSG_EQ (PcapNgFile::Extract (filename, "c", extracted), -1, "There is no interface c");
+  NS_TEST_ASSERT_MSG_EQ (PcapNgFile::Extract (filename, "b", extracted), 5, "Interface b has 5 packets");
+  PcapFile pcap;
+  pcap.Open (extracted, std::ios::in);
+  NS_TEST_ASSERT_MSG_EQ (pcap.Fail (), false, "Open (" << extracted << ", \"std::ios::in\") returns error");
+  NS_TEST_EXPECT_MSG_EQ (pcap.GetDataLinkType (), 9, "The pcap file has the wrong data link type");
+  NS_TEST_EXPECT_MSG_EQ (pcap.GetSnapLen (), 64, "The pcap file has the wrong snap length");
+  for (uint32_t i = 1; i < 10; i += 2)
+    {
+      uint32_t tsSec, tsUsec;
+      pcap.Read (data, sizeof (data), tsSec, tsUsec, inclLen, origLen, readLen);
+      NS_TEST_ASSERT_MSG_EQ (pcap.Fail (), false, "Read of extracted packet " << i << " fails");
+      NS_TEST_EXPECT_MSG_EQ (tsSec, i, "Extracted packet " << i << " has the wrong seconds");
+      NS_TEST_EXPECT_MSG_EQ (tsUsec, i, "Extracted packet " << i << " has the wrong microseconds");
+      // the truncated packets keep their original length
+      NS_TEST_EXPECT_MSG_EQ (origLen, 100 + i, "Extracted packet " << i << " has the wrong original length");
+      NS_TEST_EXPECT_MSG_EQ (inclLen, 64, "Extracted packet " << i << " has the wrong included length");
+    }
+  pcap.Close ();
+
+  remove (filename.c_str ());
+  remove (extracted.c_str ());
+}
+
+// ===========================================================================
+// Test case to make sure that the pcap traces created by PcapHelper once
+// merged output is enabled are gathered into a single pcapng file.
+// ===========================================================================
+class PcapHelperMergedOutputTestCase : public TestCase
+{
+public:
+  PcapHelperMergedOutputTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PcapHelperMergedOutputTestCase::PcapHelperMergedOutputTestCase ()
+  : TestCase ("Check that PcapHelper::CreateFile adds interfaces to the merged pcapng file")
+{
+}
+
+void
+PcapHelperMergedOutputTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("helper.pcapng");
+  std::string extracted = CreateTempDirFilename ("helper-extracted.pcap");
+  std::string traceA = CreateTempDirFilename ("trace-0-1.pcap");
+  std::string traceB = CreateTempDirFilename ("trace-1-1.pcap");
+
+  PcapHelper::EnableMergedOutput (filename, 64);
+  PcapHelper helper;
+  Ptr<PcapFileWrapper> a = helper.CreateFile (traceA, std::ios::out, PcapHelper::DLT_EN10MB);
+  Ptr<PcapFileWrapper> b = helper.CreateFile (traceB, std::ios::out, PcapHelper::DLT_PPP, 32);
+  a->Write (Seconds (1), Create<Packet> (100));
+  b->Write (Seconds (2), Create<Packet> (200));
+  a->Write (Seconds (3), Create<Packet> (50));
+
+  // The file is closed once the merged output is disabled and the traces
+  // are gone.
+  a = 0;
+  b = 0;
+  Simulator::Destroy ();
+
+  FILE *p = std::fopen (traceA.c_str (), "r");
+  NS_TEST_EXPECT_MSG_EQ ((p == 0), true, "CreateFile must not create " << traceA);
+  if (p != 0)
+    {
+      std::fclose (p);
+    }
+
+  Ptr<PcapNgFile> f = Create<PcapNgFile> ();
+  f->Open (filename, std::ios::in);
+  NS_TEST_ASSERT_MSG_EQ (f->Fail (), false, "Open (" << filename << ", \"std::ios::in\") returns error");
+  uint8_t data[256];
+  uint32_t interface, inclLen, origLen, readLen;
+  uint64_t timestamp;
+  uint32_t interfaces[] = { 0, 1, 0 };
+  uint32_t origLens[] = { 100, 200, 50 };
+  uint32_t inclLens[] = { 64, 32, 50 };
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      bool read = f->Read (data, sizeof (data), interface, timestamp, inclLen, origLen, readLen);
+      NS_TEST_ASSERT_MSG_EQ (read, true, "Read of packet " << i << " fails");
+      NS_TEST_EXPECT_MSG_EQ (interface, interfaces[i], "Packet " << i << " has the wrong interface");
+      NS_TEST_EXPECT_MSG_EQ (timestamp, (i + 1) * 1000000000ULL, "Packet " << i << " has the wrong timestamp");
+      NS_TEST_EXPECT_MSG_EQ (origLen, origLens[i], "Packet " << i << " has the wrong original length");
+      NS_TEST_EXPECT_MSG_EQ (inclLen, inclLens[i], "Packet " << i << " is not truncated to the snap length");
+    }
+  NS_TEST_EXPECT_MSG_EQ (f->Read (data, sizeof (data), interface, timestamp, inclLen, origLen, readLen), false,
+                         "The file must only contain 3 packets");
+  NS_TEST_ASSERT_MSG_EQ (f->GetNInterfaces (), 2, "The file must describe 2 interfaces");
+  NS_TEST_EXPECT_MSG_EQ (f->GetInterface (0).name, traceA.substr (0, traceA.size () - 5),
+                         "The first interface must be named after its pcap file");
+  NS_TEST_EXPECT_MSG_EQ (f->GetInterface (0).dataLinkType, PcapHelper::DLT_EN10MB,
+                         "The first interface has the wrong data link type");
+  NS_TEST_EXPECT_MSG_EQ (f->GetInterface (1).dataLinkType, PcapHelper::DLT_PPP,
+                         "The second interface has the wrong data link type");
+  NS_TEST_EXPECT_MSG_EQ (f->GetInterface (1).snapLen, 32, "The second interface has the wrong snap length");
+  f->Close ();
+
+  std::string nameB = traceB.substr (0, traceB.size () - 5);
+  NS_TEST_ASSERT_MSG_EQ (PcapNgFile::Extract (filename, nameB, extracted), 1, "Trace " << nameB << " has 1 packet");
+  PcapFile pcap;
+  pcap.Open (extracted, std::ios::in);
+  NS_TEST_ASSERT_MSG_EQ (pcap.Fail (), false, "Open (" << extracted << ", \"std::ios::in\") returns error");
+  uint32_t tsSec, tsUsec;
+  pcap.Read (data, sizeof (data), tsSec, tsUsec, inclLen, origLen, readLen);
+  NS_TEST_ASSERT_MSG_EQ (pcap.Fail (), false, "Read of the extracted packet fails");
+  NS_TEST_EXPECT_MSG_EQ (tsSec, 2, "The extracted packet has the wrong seconds");
+  NS_TEST_EXPECT_MSG_EQ (origLen, 200, "The extracted packet has the wrong original length");
+  NS_TEST_EXPECT_MSG_EQ (inclLen, 32, "The extracted packet has the wrong included length");
+  pcap.Close ();
+
+  remove (filename.c_str ());
+  remove (extracted.c_str ());
+}
+
 class PcapFileTestSuite : public TestSuite
 {
 public:
@@ -1137,6 +1340,8 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new PcapNgTestCase, TestCase::QUICK);
+  AddTestCase (new PcapHelperMergedOutputTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite;
@@ -195,6 +195,21 @@ private:
 
 ATTRIBUTE_HELPER_HEADER (Mac48Address); //!< Macro to make help make class an ns-3 attribute
 
+/**
+ * \ingroup address
+ *
+ * \brief Class providing an hash for MAC-48 addresses
+ */
+class Mac48AddressHash : public std::unary_function<Mac48Address, size_t> {
+public:
+  /**
+   * Returns the hash of the address
+   * \param x the address
+   * \return the hash
+   */
+  size_t operator() (Mac48Address const &x) const;
+};
+
 inline bool operator == (const Mac48Address &a, const Mac48Address &b)
 {
   return memcmp (a.m_address, b.m_address, 6) == 0;
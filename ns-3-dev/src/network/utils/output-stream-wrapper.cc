@@ -61,4 +61,17 @@ OutputStreamWrapper::GetStream (void)
   return m_ostream;
 }
 
+void
+OutputStreamWrapper::SetTraceFilter (Ptr<TraceFilter> filter)
+{
+  NS_LOG_FUNCTION (this << filter);
+  m_filter = filter;
+}
+
+Ptr<TraceFilter>
+OutputStreamWrapper::GetTraceFilter (void) const
+{
+  return m_filter;
+}
+
 } // namespace ns3
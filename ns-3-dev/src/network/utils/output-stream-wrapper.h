@@ -23,6 +23,7 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
+#include "trace-filter.h"
 
 namespace ns3 {
 
@@ -92,9 +93,46 @@ public:
    */
   std::ostream *GetStream (void);
 
+  /**
+   * \param filter the filter of the packets written to the stream, or 0
+   *        to write all of them
+   */
+  void SetTraceFilter (Ptr<TraceFilter> filter);
+
+  /**
+   * \return the filter of the packets written to the stream, or 0
+   */
+  Ptr<TraceFilter> GetTraceFilter (void) const;
+
+  /**
+   * Trace sinks which write packets call this method first, and drop the
+   * packets rejected.
+   *
+   * \param p a packet about to be written to the stream
+   * \return true if the stream has no filter or its filter accepts the packet
+   */
+  bool Accept (Ptr<const Packet> p) const
+  {
+    return m_filter == 0 || m_filter->Accept (p);
+  }
+
+  /**
+   * Trace sinks which must build the packet they write call this method
+   * before building it, then Accept on the packet built.
+   *
+   * \param p the packet the written packet is built from
+   * \return false if the filter of the stream rejects the packet whatever
+   *         its contents, see TraceFilter::MayAccept
+   */
+  bool MayAccept (Ptr<const Packet> p) const
+  {
+    return m_filter == 0 || m_filter->MayAccept (p);
+  }
+
 private:
   std::ostream *m_ostream; //!< The output stream
   bool m_destroyable; //!< Can be destroyed
+  Ptr<TraceFilter> m_filter; //!< Filter of the packets written
 };
 
 } // namespace ns3
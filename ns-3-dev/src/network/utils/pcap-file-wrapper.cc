@@ -45,6 +45,7 @@ PcapFileWrapper::GetTypeId (void)
 
 
 PcapFileWrapper::PcapFileWrapper ()
+  : m_ngInterface (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -60,12 +61,20 @@ bool
 PcapFileWrapper::Fail (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile != 0)
+    {
+      return m_ngFile->Fail ();
+    }
   return m_file.Fail ();
 }
 bool 
 PcapFileWrapper::Eof (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile != 0)
+    {
+      return m_ngFile->Eof ();
+    }
   return m_file.Eof ();
 }
 void 
@@ -79,9 +88,36 @@ void
 PcapFileWrapper::Close (void)
 {
   NS_LOG_FUNCTION (this);
+  // the shared pcapng file is closed with its last reference
+  m_ngFile = 0;
   m_file.Close ();
 }
 
+void
+PcapFileWrapper::SetTraceFilter (Ptr<TraceFilter> filter)
+{
+  NS_LOG_FUNCTION (this << filter);
+  m_filter = filter;
+}
+
+Ptr<TraceFilter>
+PcapFileWrapper::GetTraceFilter (void) const
+{
+  return m_filter;
+}
+
+void
+PcapFileWrapper::OpenInterface (Ptr<PcapNgFile> file, std::string const &name, uint32_t dataLinkType, uint32_t snapLen)
+{
+  NS_LOG_FUNCTION (this << file << name << dataLinkType << snapLen);
+  if (snapLen == std::numeric_limits<uint32_t>::max ())
+    {
+      snapLen = m_snapLen;
+    }
+  m_ngFile = file;
+  m_ngInterface = file->AddInterface (dataLinkType, snapLen, name);
+}
+
 void
 PcapFileWrapper::Open (std::string const &filename, std::ios::openmode mode)
 {
@@ -112,6 +148,15 @@ void
 PcapFileWrapper::Write (Time t, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << p);
+  if (m_filter != 0 && !m_filter->Accept (p))
+    {
+      return;
+    }
+  if (m_ngFile != 0)
+    {
+      m_ngFile->Write (m_ngInterface, t.GetNanoSeconds (), p);
+      return;
+    }
   uint64_t current = t.GetMicroSeconds ();
   uint64_t s = current / 1000000;
   uint64_t us = current % 1000000;
@@ -123,6 +168,15 @@ void
 PcapFileWrapper::Write (Time t, Header &header, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << &header << p);
+  if (m_filter != 0 && !m_filter->Accept (p))
+    {
+      return;
+    }
+  if (m_ngFile != 0)
+    {
+      m_ngFile->Write (m_ngInterface, t.GetNanoSeconds (), header, p);
+      return;
+    }
   uint64_t current = t.GetMicroSeconds ();
   uint64_t s = current / 1000000;
   uint64_t us = current % 1000000;
@@ -134,6 +188,11 @@ void
 PcapFileWrapper::Write (Time t, uint8_t const *buffer, uint32_t length)
 {
   NS_LOG_FUNCTION (this << t << &buffer << length);
+  if (m_ngFile != 0)
+    {
+      m_ngFile->Write (m_ngInterface, t.GetNanoSeconds (), buffer, length);
+      return;
+    }
   uint64_t current = t.GetMicroSeconds ();
   uint64_t s = current / 1000000;
   uint64_t us = current % 1000000;
@@ -180,6 +239,10 @@ uint32_t
 PcapFileWrapper::GetSnapLen (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile != 0)
+    {
+      return m_ngFile->GetInterface (m_ngInterface).snapLen;
+    }
   return m_file.GetSnapLen ();
 }
 
@@ -187,6 +250,10 @@ uint32_t
 PcapFileWrapper::GetDataLinkType (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile != 0)
+    {
+      return m_ngFile->GetInterface (m_ngInterface).dataLinkType;
+    }
   return m_file.GetDataLinkType ();
 }
 
@@ -27,6 +27,8 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "pcap-file.h"
+#include "pcapng-file.h"
+#include "trace-filter.h"
 
 namespace ns3 {
 
@@ -35,6 +37,9 @@ namespace ns3 {
  * ns-3 interface to the low-level public methods of PcapFile.  Users are
  * encouraged to use this object instead of class ns3::PcapFile in ns-3
  * public APIs.
+ *
+ * Instead of a pcap file of its own, a wrapper may write to an interface
+ * of a pcapng file shared with other wrappers, see OpenInterface.
  */
 class PcapFileWrapper : public Object
 {
@@ -77,6 +82,31 @@ public:
    */
   void Open (std::string const &filename, std::ios::openmode mode);
 
+  /**
+   * Write the packets of this wrapper to a new interface of a pcapng file
+   * instead of a pcap file. The wrapper must not have been opened yet.
+   *
+   * \param file The pcapng file, opened for writing.
+   * \param name The name of the interface.
+   * \param dataLinkType A data link type as defined in the pcap library.
+   * \param snapLen An optional maximum size for the packets of the interface.
+   * Defaults to the "CaptureSize" attribute.
+   */
+  void OpenInterface (Ptr<PcapNgFile> file, std::string const &name, uint32_t dataLinkType,
+                      uint32_t snapLen = std::numeric_limits<uint32_t>::max ());
+
+  /**
+   * \param filter the filter of the packets written to the file, or 0 to
+   *        write all of them. Only the Write methods taking a packet are
+   *        filtered.
+   */
+  void SetTraceFilter (Ptr<TraceFilter> filter);
+
+  /**
+   * \return the filter of the packets written to the file, or 0
+   */
+  Ptr<TraceFilter> GetTraceFilter (void) const;
+
   /**
    * Close the underlying pcap file.
    */
@@ -215,6 +245,9 @@ public:
 private:
   PcapFile m_file; //!< Pcap file
   uint32_t m_snapLen; //!< max length of saved packets
+  Ptr<PcapNgFile> m_ngFile; //!< Shared pcapng file, if written to an interface
+  uint32_t m_ngInterface; //!< Interface of the pcapng file
+  Ptr<TraceFilter> m_filter; //!< Filter of the packets written
 };
 
 } // namespace ns3
@@ -371,9 +371,9 @@ PcapFile::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t timeZoneCorrect
 }
 
 uint32_t
-PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
+PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen, uint32_t origLen)
 {
-  NS_LOG_FUNCTION (this << tsSec << tsUsec << totalLen);
+  NS_LOG_FUNCTION (this << tsSec << tsUsec << totalLen << origLen);
   NS_ASSERT (m_file.good ());
 
   uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
@@ -382,7 +382,7 @@ PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
   header.m_tsSec = tsSec;
   header.m_tsUsec = tsUsec;
   header.m_inclLen = inclLen;
-  header.m_origLen = totalLen;
+  header.m_origLen = origLen;
 
   if (m_swapMode)
     {
@@ -404,7 +404,15 @@ void
 PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, uint32_t totalLen)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << &data << totalLen);
-  uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalLen);
+  uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalLen, totalLen);
+  m_file.write ((const char *)data, inclLen);
+}
+
+void
+PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, uint32_t dataLen, uint32_t origLen)
+{
+  NS_LOG_FUNCTION (this << tsSec << tsUsec << &data << dataLen << origLen);
+  uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, dataLen, origLen);
   m_file.write ((const char *)data, inclLen);
 }
 
@@ -412,7 +420,7 @@ void
 PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << p);
-  uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, p->GetSize ());
+  uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, p->GetSize (), p->GetSize ());
   p->CopyData (&m_file, inclLen);
 }
 
@@ -422,7 +430,7 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, Header &header, Ptr<const Pack
   NS_LOG_FUNCTION (this << tsSec << tsUsec << &header << p);
   uint32_t headerSize = header.GetSerializedSize ();
   uint32_t totalSize = headerSize + p->GetSize ();
-  uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalSize);
+  uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalSize, totalSize);
 
   Buffer headerBuffer;
   headerBuffer.AddAtStart (headerSize);
@@ -129,6 +129,19 @@ public:
    */
   void Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, uint32_t totalLen);
 
+  /**
+   * \brief Write next packet to file, keeping its original length when
+   * the data was already truncated
+   *
+   * \param tsSec       Packet timestamp, seconds
+   * \param tsUsec      Packet timestamp, microseconds
+   * \param data        Data buffer
+   * \param dataLen     Length of the data buffer
+   * \param origLen     Original packet length
+   *
+   */
+  void Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, uint32_t dataLen, uint32_t origLen);
+
   /**
    * \brief Write next packet to file
    * 
@@ -339,10 +352,11 @@ private:
    * \brief Write a Pcap packet header
    * \param tsSec Time stamp (seconds part)
    * \param tsUsec Time stamp (microseconds part)
-   * \param totalLen total packet length
+   * \param totalLen length of the packet data available
+   * \param origLen original packet length
    * \returns the length of the packet to write in the Pcap file
    */
-  uint32_t WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen);
+  uint32_t WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen, uint32_t origLen);
 
   /**
    * \brief Read and verify a Pcap file header
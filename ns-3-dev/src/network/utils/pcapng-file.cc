@@ -0,0 +1,483 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include <algorithm>
+#include "ns3/assert.h"
+#include "ns3/packet.h"
+#include "ns3/header.h"
+#include "ns3/buffer.h"
+#include "ns3/log.h"
+#include "pcapng-file.h"
+#include "pcap-file.h"
+
+NS_LOG_COMPONENT_DEFINE ("PcapNgFile");
+
+namespace ns3 {
+
+const uint32_t PCAPNG_SECTION_HEADER = 0x0a0d0d0a;     /**< Type of the section header block */
+const uint32_t PCAPNG_INTERFACE = 0x00000001;          /**< Type of the interface description block */
+const uint32_t PCAPNG_ENHANCED_PACKET = 0x00000006;    /**< Type of the enhanced packet block */
+const uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1a2b3c4d;   /**< Byte order magic of the section header */
+const uint32_t PCAPNG_SWAPPED_BYTE_ORDER_MAGIC = 0x4d3c2b1a; /**< Looks this way if byte swapping is required */
+const uint16_t PCAPNG_VERSION_MAJOR = 1;               /**< Major version of the pcapng format */
+const uint16_t PCAPNG_VERSION_MINOR = 0;               /**< Minor version of the pcapng format */
+const uint16_t PCAPNG_OPT_ENDOFOPT = 0;                /**< Option ending the options of a block */
+const uint16_t PCAPNG_OPT_IF_NAME = 2;                 /**< Interface name option */
+const uint16_t PCAPNG_OPT_IF_TSRESOL = 9;              /**< Interface timestamp resolution option */
+
+/**
+ * \param length a length in bytes
+ * \return the length padded to a multiple of 4 bytes
+ */
+static uint32_t
+Pad4 (uint32_t length)
+{
+  return (length + 3) & ~3U;
+}
+
+PcapNgFile::PcapNgFile ()
+  : m_writing (false),
+    m_swapMode (false),
+    m_bufferSize (BUFFER_SIZE_DEFAULT)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PcapNgFile::~PcapNgFile ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+bool
+PcapNgFile::Fail (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_file.fail ();
+}
+
+bool
+PcapNgFile::Eof (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_file.eof ();
+}
+
+void
+PcapNgFile::Open (std::string const &filename, std::ios::openmode mode)
+{
+  NS_LOG_FUNCTION (this << filename << mode);
+  NS_ASSERT ((mode & std::ios::app) == 0);
+  NS_ASSERT (!m_file.fail ());
+
+  m_filename = filename;
+  m_writing = (mode & std::ios::out) != 0;
+  m_interfaces.clear ();
+  m_buffer.clear ();
+  m_file.open (filename.c_str (), mode | std::ios::binary);
+  if (m_file.fail ())
+    {
+      return;
+    }
+  if (m_writing)
+    {
+      m_swapMode = false;
+      uint32_t offset = StartBlock (PCAPNG_SECTION_HEADER, 16);
+      Put32 (offset, PCAPNG_BYTE_ORDER_MAGIC);
+      uint16_t version[2] = { PCAPNG_VERSION_MAJOR, PCAPNG_VERSION_MINOR };
+      std::memcpy (&m_buffer[offset + 4], version, 4);
+      // the length of the section is not known
+      Put32 (offset + 8, 0xffffffff);
+      Put32 (offset + 12, 0xffffffff);
+      EndBlock (offset, 16);
+    }
+  else
+    {
+      ReadSectionHeader ();
+    }
+}
+
+void
+PcapNgFile::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_writing && m_file.is_open ())
+    {
+      Flush ();
+    }
+  m_file.close ();
+}
+
+void
+PcapNgFile::SetBufferSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  m_bufferSize = size;
+}
+
+void
+PcapNgFile::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_buffer.empty ())
+    {
+      m_file.write ((const char *)&m_buffer[0], m_buffer.size ());
+      m_buffer.clear ();
+    }
+  m_file.flush ();
+}
+
+void
+PcapNgFile::Put32 (uint32_t offset, uint32_t value)
+{
+  std::memcpy (&m_buffer[offset], &value, 4);
+}
+
+uint32_t
+PcapNgFile::StartBlock (uint32_t type, uint32_t bodyLen)
+{
+  uint32_t offset = m_buffer.size ();
+  m_buffer.resize (offset + 12 + bodyLen);
+  Put32 (offset, type);
+  Put32 (offset + 4, 12 + bodyLen);
+  return offset + 8;
+}
+
+void
+PcapNgFile::EndBlock (uint32_t offset, uint32_t bodyLen)
+{
+  Put32 (offset + bodyLen, 12 + bodyLen);
+  if (m_buffer.size () >= m_bufferSize)
+    {
+      Flush ();
+    }
+}
+
+uint32_t
+PcapNgFile::AddInterface (uint32_t dataLinkType, uint32_t snapLen, std::string const &name)
+{
+  NS_LOG_FUNCTION (this << dataLinkType << snapLen << name);
+  NS_ASSERT (m_writing);
+
+  uint32_t nameLen = name.size ();
+  uint32_t bodyLen = 8 + (nameLen > 0 ? 4 + Pad4 (nameLen) : 0) + 8 + 4;
+  uint32_t offset = StartBlock (PCAPNG_INTERFACE, bodyLen);
+  uint16_t type[2] = { (uint16_t)dataLinkType, 0 };
+  std::memcpy (&m_buffer[offset], type, 4);
+  Put32 (offset + 4, snapLen);
+  uint32_t option = offset + 8;
+  if (nameLen > 0)
+    {
+      uint16_t header[2] = { PCAPNG_OPT_IF_NAME, (uint16_t)nameLen };
+      std::memcpy (&m_buffer[option], header, 4);
+      std::memcpy (&m_buffer[option + 4], name.data (), nameLen);
+      option += 4 + Pad4 (nameLen);
+    }
+  // nanosecond timestamps
+  uint16_t header[2] = { PCAPNG_OPT_IF_TSRESOL, 1 };
+  std::memcpy (&m_buffer[option], header, 4);
+  m_buffer[option + 4] = 9;
+  option += 8;
+  header[0] = PCAPNG_OPT_ENDOFOPT;
+  header[1] = 0;
+  std::memcpy (&m_buffer[option], header, 4);
+  EndBlock (offset, bodyLen);
+
+  struct Interface interface;
+  interface.dataLinkType = dataLinkType;
+  interface.snapLen = snapLen;
+  interface.name = name;
+  interface.tsPerSecond = 1000000000;
+  m_interfaces.push_back (interface);
+  return m_interfaces.size () - 1;
+}
+
+uint32_t
+PcapNgFile::StartPacket (uint32_t interface, uint64_t timestamp, uint32_t totalLen, uint32_t &inclLen)
+{
+  NS_ASSERT (m_writing && interface < m_interfaces.size ());
+  inclLen = std::min (totalLen, m_interfaces[interface].snapLen);
+  uint32_t bodyLen = 20 + Pad4 (inclLen);
+  uint32_t offset = StartBlock (PCAPNG_ENHANCED_PACKET, bodyLen);
+  Put32 (offset, interface);
+  Put32 (offset + 4, timestamp >> 32);
+  Put32 (offset + 8, timestamp & 0xffffffff);
+  Put32 (offset + 12, inclLen);
+  Put32 (offset + 16, totalLen);
+  return offset + 20;
+}
+
+void
+PcapNgFile::Write (uint32_t interface, uint64_t timestamp, uint8_t const * const data, uint32_t totalLen)
+{
+  NS_LOG_FUNCTION (this << interface << timestamp << &data << totalLen);
+  uint32_t inclLen;
+  uint32_t offset = StartPacket (interface, timestamp, totalLen, inclLen);
+  std::memcpy (&m_buffer[offset], data, inclLen);
+  EndBlock (offset - 20, 20 + Pad4 (inclLen));
+}
+
+void
+PcapNgFile::Write (uint32_t interface, uint64_t timestamp, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << interface << timestamp << p);
+  uint32_t inclLen;
+  uint32_t offset = StartPacket (interface, timestamp, p->GetSize (), inclLen);
+  p->CopyData (&m_buffer[offset], inclLen);
+  EndBlock (offset - 20, 20 + Pad4 (inclLen));
+}
+
+void
+PcapNgFile::Write (uint32_t interface, uint64_t timestamp, Header &header, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << interface << timestamp << &header << p);
+  uint32_t headerSize = header.GetSerializedSize ();
+  uint32_t inclLen;
+  uint32_t offset = StartPacket (interface, timestamp, headerSize + p->GetSize (), inclLen);
+
+  Buffer headerBuffer;
+  headerBuffer.AddAtStart (headerSize);
+  header.Serialize (headerBuffer.Begin ());
+  uint32_t toCopy = std::min (headerSize, inclLen);
+  headerBuffer.CopyData (&m_buffer[offset], toCopy);
+  p->CopyData (&m_buffer[offset + toCopy], inclLen - toCopy);
+  EndBlock (offset - 20, 20 + Pad4 (inclLen));
+}
+
+uint16_t
+PcapNgFile::Get16 (uint8_t const *data) const
+{
+  uint16_t value;
+  std::memcpy (&value, data, 2);
+  if (m_swapMode)
+    {
+      value = ((value & 0x00ff) << 8) | ((value & 0xff00) >> 8);
+    }
+  return value;
+}
+
+uint32_t
+PcapNgFile::Get32 (uint8_t const *data) const
+{
+  uint32_t value;
+  std::memcpy (&value, data, 4);
+  if (m_swapMode)
+    {
+      value = ((value & 0x000000ff) << 24) | ((value & 0x0000ff00) << 8)
+        | ((value & 0x00ff0000) >> 8) | ((value & 0xff000000) >> 24);
+    }
+  return value;
+}
+
+void
+PcapNgFile::ReadSectionHeader (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint8_t header[12];
+  m_file.read ((char *)header, 12);
+  if (m_file.fail ())
+    {
+      return;
+    }
+  uint32_t magic;
+  std::memcpy (&magic, header + 8, 4);
+  m_swapMode = (magic == PCAPNG_SWAPPED_BYTE_ORDER_MAGIC);
+  if (Get32 (header) != PCAPNG_SECTION_HEADER
+      || (magic != PCAPNG_BYTE_ORDER_MAGIC && magic != PCAPNG_SWAPPED_BYTE_ORDER_MAGIC))
+    {
+      m_file.setstate (std::ios::failbit);
+      return;
+    }
+  uint32_t length = Get32 (header + 4);
+  if (length < 28 || length % 4 != 0)
+    {
+      m_file.setstate (std::ios::failbit);
+      return;
+    }
+  m_file.seekg (length - 12, std::ios::cur);
+}
+
+void
+PcapNgFile::ReadInterface (uint8_t const *body, uint32_t bodyLen)
+{
+  if (bodyLen < 8)
+    {
+      return;
+    }
+  struct Interface interface;
+  interface.dataLinkType = Get16 (body);
+  interface.snapLen = Get32 (body + 4);
+  interface.tsPerSecond = 1000000;
+  uint32_t option = 8;
+  while (option + 4 <= bodyLen)
+    {
+      uint16_t code = Get16 (body + option);
+      uint16_t length = Get16 (body + option + 2);
+      if (code == PCAPNG_OPT_ENDOFOPT || option + 4 + length > bodyLen)
+        {
+          break;
+        }
+      if (code == PCAPNG_OPT_IF_NAME)
+        {
+          interface.name = std::string ((const char *)body + option + 4, length);
+          interface.name = interface.name.substr (0, interface.name.find ('\0'));
+        }
+      else if (code == PCAPNG_OPT_IF_TSRESOL && length >= 1)
+        {
+          uint8_t resolution = body[option + 4];
+          interface.tsPerSecond = 1;
+          for (uint8_t i = 0; i < (resolution & 0x7f); i++)
+            {
+              interface.tsPerSecond *= (resolution & 0x80) ? 2 : 10;
+            }
+        }
+      option += 4 + Pad4 (length);
+    }
+  m_interfaces.push_back (interface);
+}
+
+bool
+PcapNgFile::Read (uint8_t * const data, uint32_t maxBytes,
+                  uint32_t &interface, uint64_t &timestamp,
+                  uint32_t &inclLen, uint32_t &origLen, uint32_t &readLen)
+{
+  NS_LOG_FUNCTION (this << &data << maxBytes);
+  NS_ASSERT (!m_writing);
+
+  while (true)
+    {
+      uint8_t header[8];
+      m_file.read ((char *)header, 8);
+      if (m_file.fail ())
+        {
+          return false;
+        }
+      uint32_t type = Get32 (header);
+      uint32_t length = Get32 (header + 4);
+      if (type == PCAPNG_SECTION_HEADER)
+        {
+          // a new section, possibly in the other byte order
+          m_file.seekg (-8, std::ios::cur);
+          m_interfaces.clear ();
+          ReadSectionHeader ();
+          if (m_file.fail ())
+            {
+              return false;
+            }
+          continue;
+        }
+      if (length < 12 || length % 4 != 0)
+        {
+          m_file.setstate (std::ios::failbit);
+          return false;
+        }
+      m_block.resize (length - 8);
+      m_file.read ((char *)&m_block[0], length - 8);
+      if (m_file.fail ())
+        {
+          return false;
+        }
+      uint32_t bodyLen = length - 12;
+      if (type == PCAPNG_INTERFACE)
+        {
+          ReadInterface (&m_block[0], bodyLen);
+        }
+      else if (type == PCAPNG_ENHANCED_PACKET && bodyLen >= 20)
+        {
+          interface = Get32 (&m_block[0]);
+          if (interface >= m_interfaces.size ())
+            {
+              m_file.setstate (std::ios::failbit);
+              return false;
+            }
+          uint64_t units = ((uint64_t)Get32 (&m_block[4]) << 32) | Get32 (&m_block[8]);
+          uint64_t perSecond = m_interfaces[interface].tsPerSecond;
+          timestamp = units / perSecond * 1000000000 + units % perSecond * 1000000000 / perSecond;
+          inclLen = std::min (Get32 (&m_block[12]), bodyLen - 20);
+          origLen = Get32 (&m_block[16]);
+          readLen = std::min (inclLen, maxBytes);
+          std::memcpy (data, &m_block[20], readLen);
+          return true;
+        }
+    }
+}
+
+uint32_t
+PcapNgFile::GetNInterfaces (void) const
+{
+  return m_interfaces.size ();
+}
+
+const struct PcapNgFile::Interface &
+PcapNgFile::GetInterface (uint32_t interface) const
+{
+  NS_ASSERT (interface < m_interfaces.size ());
+  return m_interfaces[interface];
+}
+
+int64_t
+PcapNgFile::Extract (std::string const &filename, std::string const &name,
+                     std::string const &pcapFilename)
+{
+  NS_LOG_FUNCTION (filename << name << pcapFilename);
+  PcapNgFile in;
+  in.Open (filename, std::ios::in);
+  if (in.Fail ())
+    {
+      return -1;
+    }
+
+  PcapFile out;
+  bool found = false;
+  int64_t packets = 0;
+  std::vector<uint8_t> data (1 << 18);
+  uint32_t interface, inclLen, origLen, readLen;
+  uint64_t timestamp;
+  uint32_t checked = 0;
+  while (true)
+    {
+      bool more = in.Read (&data[0], data.size (), interface, timestamp, inclLen, origLen, readLen);
+      // create the pcap file as soon as the interface is described, so
+      // that it exists even if the interface has no packet
+      for (; !found && checked < in.GetNInterfaces (); checked++)
+        {
+          const struct Interface &description = in.GetInterface (checked);
+          if (description.name == name)
+            {
+              out.Open (pcapFilename, std::ios::out);
+              out.Init (description.dataLinkType, description.snapLen);
+              if (out.Fail ())
+                {
+                  return -1;
+                }
+              found = true;
+            }
+        }
+      if (!more)
+        {
+          break;
+        }
+      if (in.GetInterface (interface).name == name)
+        {
+          out.Write (timestamp / 1000000000, timestamp % 1000000000 / 1000, &data[0], readLen, origLen);
+          packets++;
+        }
+    }
+  return found ? packets : -1;
+}
+
+} // namespace ns3
@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAPNG_FILE_H
+#define PCAPNG_FILE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+class Packet;
+class Header;
+
+/**
+ * \brief A pcapng file holding the packets of several interfaces
+ *
+ * A pcapng file (see http://www.tcpdump.org/pcap/pcap.html and the
+ * pcapng specification) starts with a section header, and describes each
+ * capture interface with an interface description block, which carries
+ * its data link type, snap length and name. The packets of all the
+ * interfaces are then stored in enhanced packet blocks, in the order in
+ * which they are written, with nanosecond timestamps.
+ *
+ * The blocks are written in the byte order of the host, and gathered in
+ * a buffer which is written to the file once it exceeds the buffer size,
+ * so that many interfaces can share a single file descriptor and few
+ * large writes.
+ *
+ * A file opened for reading is read sequentially with Read, which
+ * handles both byte orders. Extract copies the packets of one interface
+ * into a classic pcap file.
+ */
+class PcapNgFile : public SimpleRefCount<PcapNgFile>
+{
+public:
+  static const uint32_t BUFFER_SIZE_DEFAULT = 1 << 20; /**< Default size of the write buffer, in bytes */
+
+  /**
+   * \brief The description of an interface of the file
+   */
+  struct Interface
+  {
+    uint32_t dataLinkType;    //!< Data link type of the packets
+    uint32_t snapLen;         //!< Maximum length of packet data stored in the blocks
+    std::string name;         //!< Name of the interface
+    uint64_t tsPerSecond;     //!< Number of timestamp units per second
+  };
+
+  PcapNgFile ();
+  ~PcapNgFile ();
+
+  /**
+   * \return true if the 'fail' bit is set in the underlying iostream, false otherwise.
+   */
+  bool Fail (void) const;
+  /**
+   * \return true if the 'eof' bit is set in the underlying iostream, false otherwise.
+   */
+  bool Eof (void) const;
+
+  /**
+   * Create a new pcapng file, and write its section header, or open an
+   * existing pcapng file and read its section header.
+   *
+   * \param filename String containing the name of the file.
+   * \param mode std::ios::out to create the file, std::ios::in to read it.
+   */
+  void Open (std::string const &filename, std::ios::openmode mode);
+
+  /**
+   * Write the buffered blocks, and close the file.
+   */
+  void Close (void);
+
+  /**
+   * \param size the number of bytes buffered before they are written to
+   *        the file
+   */
+  void SetBufferSize (uint32_t size);
+
+  /**
+   * Write the buffered blocks to the file.
+   */
+  void Flush (void);
+
+  /**
+   * \brief Describe a new interface
+   *
+   * \param dataLinkType A data link type as defined in the pcap library.
+   * \param snapLen The maximum size of the packet data stored for this interface.
+   * \param name The name of the interface.
+   * \return the index of the interface, to be passed to Write.
+   */
+  uint32_t AddInterface (uint32_t dataLinkType, uint32_t snapLen, std::string const &name);
+
+  /**
+   * \brief Write the next packet of an interface
+   *
+   * \param interface Index of the interface returned by AddInterface.
+   * \param timestamp Packet timestamp, in nanoseconds.
+   * \param data Data buffer
+   * \param totalLen Total packet length
+   */
+  void Write (uint32_t interface, uint64_t timestamp, uint8_t const * const data, uint32_t totalLen);
+
+  /**
+   * \brief Write the next packet of an interface
+   *
+   * \param interface Index of the interface returned by AddInterface.
+   * \param timestamp Packet timestamp, in nanoseconds.
+   * \param p Packet to write
+   */
+  void Write (uint32_t interface, uint64_t timestamp, Ptr<const Packet> p);
+
+  /**
+   * \brief Write the next packet of an interface, preceded by a header
+   *
+   * \param interface Index of the interface returned by AddInterface.
+   * \param timestamp Packet timestamp, in nanoseconds.
+   * \param header Header to prepend to the packet
+   * \param p Packet to write
+   */
+  void Write (uint32_t interface, uint64_t timestamp, Header &header, Ptr<const Packet> p);
+
+  /**
+   * \brief Read the next packet
+   *
+   * The interface descriptions met on the way are recorded, and the blocks
+   * of other types are skipped.
+   *
+   * \param data Data buffer
+   * \param maxBytes Allocated data buffer size
+   * \param interface [out] Index of the interface of the packet
+   * \param timestamp [out] Packet timestamp, in nanoseconds
+   * \param inclLen [out] Included length
+   * \param origLen [out] Original length
+   * \param readLen [out] Number of bytes read
+   * \return false at the end of the file or on error, true otherwise.
+   */
+  bool Read (uint8_t * const data, uint32_t maxBytes,
+             uint32_t &interface, uint64_t &timestamp,
+             uint32_t &inclLen, uint32_t &origLen, uint32_t &readLen);
+
+  /**
+   * \return the number of interfaces described so far.
+   */
+  uint32_t GetNInterfaces (void) const;
+
+  /**
+   * \param interface Index of an interface
+   * \return the description of the interface
+   */
+  const struct Interface & GetInterface (uint32_t interface) const;
+
+  /**
+   * \brief Copy the packets of an interface into a pcap file
+   *
+   * The pcap file has the data link type and snap length of the interface,
+   * and microsecond timestamps. The packets truncated in the pcapng file
+   * are stored with their truncated length.
+   *
+   * \param filename Name of the pcapng file
+   * \param name Name of the interface
+   * \param pcapFilename Name of the pcap file to create
+   * \return the number of packets copied, or -1 if the pcapng file could
+   *         not be read or has no interface of this name.
+   */
+  static int64_t Extract (std::string const &filename, std::string const &name,
+                          std::string const &pcapFilename);
+
+private:
+  /**
+   * Start a block in the write buffer.
+   *
+   * \param type Type of the block
+   * \param bodyLen Length of the body of the block, a multiple of 4
+   * \return the offset of the body of the block in the buffer
+   */
+  uint32_t StartBlock (uint32_t type, uint32_t bodyLen);
+  /**
+   * End the block started at the given offset, flushing the buffer if full.
+   *
+   * \param offset Offset of the body of the block in the buffer
+   * \param bodyLen Length of the body of the block
+   */
+  void EndBlock (uint32_t offset, uint32_t bodyLen);
+  /**
+   * Start an enhanced packet block in the write buffer.
+   *
+   * \param interface Index of the interface
+   * \param timestamp Packet timestamp, in nanoseconds
+   * \param totalLen Total packet length
+   * \param inclLen [out] Length of the packet data to store
+   * \return the offset of the packet data in the buffer
+   */
+  uint32_t StartPacket (uint32_t interface, uint64_t timestamp, uint32_t totalLen, uint32_t &inclLen);
+  /**
+   * Store a 32-bit word in the write buffer.
+   *
+   * \param offset Offset of the word
+   * \param value Value of the word
+   */
+  void Put32 (uint32_t offset, uint32_t value);
+  /**
+   * \param data Buffer holding the value, in the byte order of the file
+   * \return the 16-bit value, in host order
+   */
+  uint16_t Get16 (uint8_t const *data) const;
+  /**
+   * \param data Buffer holding the value, in the byte order of the file
+   * \return the 32-bit value, in host order
+   */
+  uint32_t Get32 (uint8_t const *data) const;
+  /**
+   * Read the section header at the start of the file.
+   */
+  void ReadSectionHeader (void);
+  /**
+   * Record the interface described by a block.
+   *
+   * \param body The body of the interface description block
+   * \param bodyLen The length of the body
+   */
+  void ReadInterface (uint8_t const *body, uint32_t bodyLen);
+
+  std::string m_filename;                  //!< file name
+  std::fstream m_file;                     //!< file stream
+  bool m_writing;                          //!< file opened for writing
+  bool m_swapMode;                         //!< the file is in the other byte order
+  std::vector<uint8_t> m_buffer;           //!< blocks waiting to be written
+  uint32_t m_bufferSize;                   //!< size above which the buffer is written
+  std::vector<struct Interface> m_interfaces;  //!< interfaces described so far
+  std::vector<uint8_t> m_block;            //!< block being read
+};
+
+} // namespace ns3
+
+#endif /* PCAPNG_FILE_H */
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "trace-filter.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("TraceFilter");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (TraceFilter);
+
+/// Number of distinct hashed unique ids
+static const uint64_t HASH_RANGE = (uint64_t)1 << 32;
+
+TypeId
+TraceFilter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TraceFilter")
+    .SetParent<Object> ()
+    .AddConstructor<TraceFilter> ()
+    .AddAttribute ("SamplingRatio",
+                   "The fraction of the packets accepted, chosen by their unique id.",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&TraceFilter::SetSamplingRatio,
+                                       &TraceFilter::GetSamplingRatio),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+  ;
+  return tid;
+}
+
+TraceFilter::TraceFilter ()
+  : m_threshold (HASH_RANGE)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TraceFilter::~TraceFilter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TraceFilter::SetSamplingRatio (double ratio)
+{
+  NS_LOG_FUNCTION (this << ratio);
+  NS_ASSERT (ratio >= 0 && ratio <= 1);
+  m_threshold = (uint64_t)(ratio * HASH_RANGE);
+}
+
+double
+TraceFilter::GetSamplingRatio (void) const
+{
+  return (double)m_threshold / HASH_RANGE;
+}
+
+void
+TraceFilter::AddTimeWindow (Time start, Time stop)
+{
+  NS_LOG_FUNCTION (this << start << stop);
+  m_windows.push_back (std::make_pair (start, stop));
+}
+
+void
+TraceFilter::AddPredicate (Predicate predicate)
+{
+  NS_LOG_FUNCTION (this);
+  m_predicates.push_back (predicate);
+}
+
+bool
+TraceFilter::Accept (Ptr<const Packet> p) const
+{
+  NS_LOG_FUNCTION (this << p);
+  // cheapest checks first
+  if (!MayAccept (p))
+    {
+      return false;
+    }
+  return AcceptPredicates (p) && DoAccept (p);
+}
+
+bool
+TraceFilter::MayAccept (Ptr<const Packet> p) const
+{
+  return AcceptTime () && AcceptUid (p->GetUid ());
+}
+
+bool
+TraceFilter::AcceptTime (void) const
+{
+  if (m_windows.empty ())
+    {
+      return true;
+    }
+  Time now = Simulator::Now ();
+  for (std::vector<std::pair<Time, Time> >::const_iterator i = m_windows.begin (); i != m_windows.end (); ++i)
+    {
+      if (now >= i->first && now < i->second)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+bool
+TraceFilter::AcceptUid (uint64_t uid) const
+{
+  if (m_threshold >= HASH_RANGE)
+    {
+      return true;
+    }
+  // Fibonacci hashing spreads the consecutive unique ids of the packets
+  // over the whole range
+  uint64_t hash = (uid * 0x9e3779b97f4a7c15ULL) >> 32;
+  return hash < m_threshold;
+}
+
+bool
+TraceFilter::AcceptPredicates (Ptr<const Packet> p) const
+{
+  for (std::vector<Predicate>::const_iterator i = m_predicates.begin (); i != m_predicates.end (); ++i)
+    {
+      if (!(*i)(p))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+bool
+TraceFilter::DoAccept (Ptr<const Packet> p) const
+{
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TRACE_FILTER_H
+#define TRACE_FILTER_H
+
+#include <vector>
+#include <utility>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/callback.h"
+#include "ns3/packet.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup network
+ *
+ * \brief Select the packets recorded by trace sinks
+ *
+ * A trace filter accepts a packet if the current simulation time is in
+ * one of its time windows, if the packet is in the sample defined by the
+ * "SamplingRatio" attribute, and if all its predicates accept the packet.
+ *
+ * The sample is chosen by hashing the unique id of the packet, so that it
+ * is deterministic, and that a packet sampled at one layer or node is
+ * also sampled at all the others.
+ *
+ * The pcap and ascii trace helpers (see PcapHelper::SetTraceFilter and
+ * AsciiTraceHelper::SetTraceFilter) and the flow monitor probes (see
+ * FlowMonitorHelper::SetTraceFilter) only check the filter once a trace
+ * source fires, and record nothing for the packets rejected.
+ */
+class TraceFilter : public Object
+{
+public:
+  /**
+   * \brief A predicate on packets
+   */
+  typedef Callback<bool, Ptr<const Packet> > Predicate;
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  TraceFilter ();
+  virtual ~TraceFilter ();
+
+  /**
+   * \param ratio the fraction of the packets to accept, between 0 and 1
+   */
+  void SetSamplingRatio (double ratio);
+  /**
+   * \return the fraction of the packets accepted
+   */
+  double GetSamplingRatio (void) const;
+
+  /**
+   * \brief Accept the packets traced between two times
+   *
+   * Once a window is added, the packets traced out of all the windows
+   * are rejected.
+   *
+   * \param start the start of the window
+   * \param stop the end of the window, excluded
+   */
+  void AddTimeWindow (Time start, Time stop);
+
+  /**
+   * \brief Only accept the packets accepted by a predicate
+   *
+   * \param predicate the predicate
+   */
+  void AddPredicate (Predicate predicate);
+
+  /**
+   * \param p a packet about to be traced
+   * \return true if the packet should be traced, false otherwise
+   */
+  bool Accept (Ptr<const Packet> p) const;
+
+  /**
+   * \brief Check the conditions which do not depend on the contents of a packet
+   *
+   * The sinks which build the packet they trace, such as the drop sinks
+   * adding back the header, check these conditions first, so as to only
+   * build the packets which may be accepted.
+   *
+   * \param p a packet about to be traced, or a copy with the same unique id
+   * \return false if the packet is rejected whatever its contents
+   */
+  bool MayAccept (Ptr<const Packet> p) const;
+
+protected:
+  /**
+   * \return true if the current time is in a window of the filter
+   */
+  bool AcceptTime (void) const;
+  /**
+   * \param uid the unique id of a packet
+   * \return true if the packet is in the sample of the filter
+   */
+  bool AcceptUid (uint64_t uid) const;
+  /**
+   * \param p a packet about to be traced
+   * \return true if all the predicates of the filter accept the packet
+   */
+  bool AcceptPredicates (Ptr<const Packet> p) const;
+
+private:
+  /**
+   * Check the packet against the conditions of a subclass. The default
+   * implementation accepts all the packets.
+   *
+   * \param p a packet about to be traced
+   * \return true if the packet should be traced, false otherwise
+   */
+  virtual bool DoAccept (Ptr<const Packet> p) const;
+
+  uint64_t m_threshold; //!< Hashed unique ids below this value are sampled
+  std::vector<std::pair<Time, Time> > m_windows; //!< Time windows
+  std::vector<Predicate> m_predicates; //!< Predicates
+};
+
+} // namespace ns3
+
+#endif /* TRACE_FILTER_H */
@@ -65,4 +65,13 @@
  * current node extracts the appropriate neighbor-index from the 
  * nix-vector and transmits the packet through the corresponding 
  * net-device.  This continues until the packet reaches the destination.
+ *
+ * The BFS trees are kept in a global store shared by all the nodes: the
+ * tree of a source is computed once, the first time the source looks for
+ * a route, and the nix-vectors to all the destinations are built from it.
+ * The store also indexes the IP addresses of the nodes, and is flushed
+ * when the topology changes, i.e. when an interface goes up or down, an
+ * address is added or removed, or FlushGlobalNixRoutingCache is called.
+ * Ipv4NixVectorRouting::PrecomputeNixVectors computes the trees of all the
+ * nodes at once, using several threads.
  * */
@@ -47,6 +47,7 @@
 #include "ns3/ipv4-static-routing-helper.h"
 #include "ns3/ipv4-list-routing-helper.h"
 #include "ns3/ipv4-nix-vector-helper.h"
+#include "ns3/ipv4-nix-vector-routing.h"
 
 using namespace ns3;
 
@@ -130,11 +131,13 @@ main (int argc, char *argv[])
 
   int nCN = 2, nLANClients = 42;
   bool nix = true;
+  uint32_t nixThreads = 0;
 
   CommandLine cmd;
   cmd.AddValue ("CN", "Number of total CNs [2]", nCN);
   cmd.AddValue ("LAN", "Number of nodes per LAN [42]", nLANClients);
   cmd.AddValue ("NIX", "Toggle nix-vector routing", nix);
+  cmd.AddValue ("nixThreads", "Number of threads precomputing the nix-vectors, none if 0 [0]", nixThreads);
   cmd.Parse (argc,argv);
 
   if (nCN < 2) 
@@ -507,6 +510,10 @@ main (int argc, char *argv[])
     {
       // Calculate routing tables
       std::cout << "Using Nix-vectors..." << std::endl;
+      if (nixThreads)
+        {
+          Ipv4NixVectorRouting::PrecomputeNixVectors (nixThreads);
+        }
     }
   else
     {
@@ -24,7 +24,13 @@
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/sgi-hashmap.h"
 #include "ns3/ipv4-list-routing.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
 
 #include "ipv4-nix-vector-routing.h"
 
@@ -34,6 +40,125 @@ namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (Ipv4NixVectorRouting);
 
+/**
+ * \ingroup nix-vector-routing
+ * Hash function of the (source, destination) keys of the nix-vector store
+ */
+struct NixVectorKeyHash
+{
+  size_t operator() (uint64_t key) const
+  {
+    return static_cast<size_t> (key ^ (key >> 32) * 0x9e3779b9);
+  }
+};
+
+/**
+ * \ingroup nix-vector-routing
+ * Global nix-vector store, shared by the nix-vector routing
+ * protocols of all the nodes.
+ *
+ * It holds a view of the topology, the BFS tree of every source which
+ * looked for a route, and the nix-vectors built from these trees, indexed
+ * by source and destination node ids.  Everything is valid for a given
+ * version of the topology only, and rebuilt when the version changes.
+ */
+struct NixVectorStore
+{
+  NixVectorStore ()
+    : version (1),
+      builtVersion (0),
+      destroyScheduled (false)
+  {
+  }
+  /* current version of the topology */
+  uint32_t version;
+  /* version of the topology the store was built for */
+  uint32_t builtVersion;
+  bool destroyScheduled;
+  /* node id of each IP address */
+  sgi::hash_map<Ipv4Address, uint32_t, Ipv4AddressHash> addresses;
+  /* neighbors of each node through its up interfaces, in BFS order */
+  std::vector<std::vector<uint32_t> > bfsNeighbors;
+  /* neighbors of each node, in neighbor-index order */
+  std::vector<std::vector<uint32_t> > nixNeighbors;
+  /* parent of every node in the BFS tree of each source, empty if not computed yet */
+  std::vector<std::vector<uint32_t> > trees;
+  /* nix-vectors, indexed by source id << 32 | destination id */
+  sgi::hash_map<uint64_t, Ptr<NixVector>, NixVectorKeyHash> nixVectors;
+};
+
+/* parent of the nodes which are not in a BFS tree */
+static const uint32_t NIX_NO_PARENT = 0xffffffff;
+
+static NixVectorStore &
+GetNixVectorStore (void)
+{
+  static NixVectorStore store;
+  return store;
+}
+
+static void
+ResetNixVectorStore (void)
+{
+  NixVectorStore &store = GetNixVectorStore ();
+  store.version++;
+  store.destroyScheduled = false;
+  store.addresses.clear ();
+  store.bfsNeighbors.clear ();
+  store.nixNeighbors.clear ();
+  store.trees.clear ();
+  store.nixVectors.clear ();
+}
+
+/* breadth first search over the topology of the store, which only
+ * handles node ids so that it can run in any thread */
+static void
+ComputeBfsTree (const std::vector<std::vector<uint32_t> > & neighbors, uint32_t source, std::vector<uint32_t> & parents)
+{
+  parents.assign (neighbors.size (), NIX_NO_PARENT);
+  // discovered nodes with unexplored children
+  std::vector<uint32_t> greyNodeList;
+  greyNodeList.reserve (neighbors.size ());
+  greyNodeList.push_back (source);
+  parents[source] = source;
+  for (uint32_t i = 0; i < greyNodeList.size (); i++)
+    {
+      const std::vector<uint32_t> & adjacent = neighbors[greyNodeList[i]];
+      for (std::vector<uint32_t>::const_iterator j = adjacent.begin (); j != adjacent.end (); ++j)
+        {
+          if (parents[*j] == NIX_NO_PARENT)
+            {
+              parents[*j] = greyNodeList[i];
+              greyNodeList.push_back (*j);
+            }
+        }
+    }
+}
+
+/**
+ * \ingroup nix-vector-routing
+ * A share of the BFS trees computed by Ipv4NixVectorRouting::PrecomputeNixVectors
+ */
+struct NixTreeWork
+{
+  NixVectorStore *store;
+  uint32_t first;
+  uint32_t step;
+};
+
+static void
+ComputeBfsTrees (NixTreeWork *work)
+{
+  NixVectorStore *store = work->store;
+  for (uint32_t i = work->first; i < store->trees.size (); i += work->step)
+    {
+      if (store->trees[i].empty ())
+        {
+          ComputeBfsTree (store->bfsNeighbors, i, store->trees[i]);
+        }
+    }
+}
+
 TypeId 
 Ipv4NixVectorRouting::GetTypeId (void)
 {
@@ -45,7 +170,8 @@ Ipv4NixVectorRouting::GetTypeId (void)
 }
 
 Ipv4NixVectorRouting::Ipv4NixVectorRouting ()
-  : m_totalNeighbors (0)
+  : m_totalNeighbors (0),
+    m_topologyVersion (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -89,21 +215,195 @@ void
 Ipv4NixVectorRouting::FlushGlobalNixRoutingCache ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
+  // The store and the caches of every node are flushed on their next use
+  GetNixVectorStore ().version++;
+}
+
+void
+Ipv4NixVectorRouting::CheckTopologyVersion ()
+{
+  uint32_t version = GetNixVectorStore ().version;
+  if (m_topologyVersion != version)
+    {
+      NS_LOG_LOGIC ("Flushing Nix caches.");
+      FlushNixCache ();
+      FlushIpv4RouteCache ();
+      m_topologyVersion = version;
+    }
+}
+
+void
+Ipv4NixVectorRouting::UpdateNixVectorStore ()
+{
+  NixVectorStore &store = GetNixVectorStore ();
+  uint32_t nNodes = NodeList::GetNNodes ();
+  if (store.builtVersion == store.version && store.bfsNeighbors.size () == nNodes)
+    {
+      return;
+    }
+  NS_LOG_LOGIC ("Building the nix-vector store for " << nNodes << " nodes");
+  store.addresses.clear ();
+  store.trees.clear ();
+  store.nixVectors.clear ();
+  store.bfsNeighbors.assign (nNodes, std::vector<uint32_t> ());
+  store.nixNeighbors.assign (nNodes, std::vector<uint32_t> ());
+  store.trees.resize (nNodes);
+  store.builtVersion = store.version;
+  if (!store.destroyScheduled)
+    {
+      Simulator::ScheduleDestroy (&ResetNixVectorStore);
+      store.destroyScheduled = true;
+    }
+
+  for (uint32_t id = 0; id < nNodes; id++)
     {
-      Ptr<Node> node = *i;
-      Ptr<Ipv4NixVectorRouting> rp = node->GetObject<Ipv4NixVectorRouting> ();
-      if (!rp)
+      Ptr<Node> node = NodeList::GetNode (id);
+      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+      if (ipv4)
         {
-          continue;
+          // The first node holding an address is its destination
+          for (uint32_t i = 0; i < ipv4->GetNInterfaces (); i++)
+            {
+              for (uint32_t j = 0; j < ipv4->GetNAddresses (i); j++)
+                {
+                  store.addresses.insert (std::make_pair (ipv4->GetAddress (i, j).GetLocal (), id));
+                }
+            }
+        }
+
+      for (uint32_t i = 0; i < node->GetNDevices (); i++)
+        {
+          // Get a net device from the node
+          // as well as the channel, and figure
+          // out the adjacent net devices
+          Ptr<NetDevice> localNetDevice = node->GetDevice (i);
+          Ptr<Channel> channel = localNetDevice->GetChannel ();
+          if (channel == 0)
+            {
+              continue;
+            }
+
+          // this function takes in the local net dev, and channnel, and
+          // writes to the netDeviceContainer the adjacent net devs
+          NetDeviceContainer netDeviceContainer;
+          GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
+
+          // the neighbor index ignores the bridge devices
+          if (!localNetDevice->IsBridge ())
+            {
+              for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
+                {
+                  store.nixNeighbors[id].push_back ((*iter)->GetNode ()->GetId ());
+                }
+            }
+
+          // the BFS only goes through up interfaces
+          if (ipv4)
+            {
+              uint32_t interfaceIndex = (ipv4)->GetInterfaceForDevice (localNetDevice);
+              if (!(ipv4->IsUp (interfaceIndex)))
+                {
+                  NS_LOG_LOGIC ("Ipv4Interface is down");
+                  continue;
+                }
+            }
+          if (!(localNetDevice->IsLinkUp ()))
+            {
+              NS_LOG_LOGIC ("Link is down.");
+              continue;
+            }
+          for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
+            {
+              store.bfsNeighbors[id].push_back ((*iter)->GetNode ()->GetId ());
+            }
         }
-      NS_LOG_LOGIC ("Flushing Nix caches.");
-      rp->FlushNixCache ();
-      rp->FlushIpv4RouteCache ();
     }
 }
 
+void
+Ipv4NixVectorRouting::PrecomputeNixVectors (uint32_t nThreads)
+{
+  NS_LOG_FUNCTION (nThreads);
+  UpdateNixVectorStore ();
+  NixVectorStore &store = GetNixVectorStore ();
+  if (nThreads == 0)
+    {
+      nThreads = 1;
+    }
+  std::vector<NixTreeWork> work (nThreads);
+  for (uint32_t i = 0; i < nThreads; i++)
+    {
+      work[i].store = &store;
+      work[i].first = i;
+      work[i].step = nThreads;
+    }
+#ifdef HAVE_PTHREAD_H
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 1; i < nThreads; i++)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeBoundCallback (&ComputeBfsTrees, &work[i]));
+      threads.push_back (thread);
+      thread->Start ();
+    }
+  ComputeBfsTrees (&work[0]);
+  for (uint32_t i = 0; i < threads.size (); i++)
+    {
+      threads[i]->Join ();
+    }
+#else
+  for (uint32_t i = 0; i < nThreads; i++)
+    {
+      ComputeBfsTrees (&work[i]);
+    }
+#endif
+}
+
+Ptr<NixVector>
+Ipv4NixVectorRouting::GetSharedNixVector (uint32_t source, uint32_t dest)
+{
+  NS_LOG_FUNCTION (source << dest);
+  NixVectorStore &store = GetNixVectorStore ();
+  uint64_t key = (static_cast<uint64_t> (source) << 32) | dest;
+  sgi::hash_map<uint64_t, Ptr<NixVector>, NixVectorKeyHash>::const_iterator i = store.nixVectors.find (key);
+  if (i != store.nixVectors.end ())
+    {
+      NS_LOG_LOGIC ("Found Nix-vector in the global store.");
+      return i->second;
+    }
+
+  std::vector<uint32_t> & parents = store.trees[source];
+  if (parents.empty ())
+    {
+      NS_LOG_LOGIC ("Computing the BFS tree of Node " << source);
+      ComputeBfsTree (store.bfsNeighbors, source, parents);
+    }
+  if (parents[dest] == NIX_NO_PARENT)
+    {
+      return 0;
+    }
+
+  // walk up the BFS tree from the destination, adding the
+  // neighbor index of each node with respect to its parent
+  Ptr<NixVector> nixVector = Create<NixVector> ();
+  for (uint32_t node = dest; node != source; node = parents[node])
+    {
+      const std::vector<uint32_t> & neighbors = store.nixNeighbors[parents[node]];
+      uint32_t destId = 0;
+      for (uint32_t j = 0; j < neighbors.size (); j++)
+        {
+          if (neighbors[j] == node)
+            {
+              destId = j;
+            }
+        }
+      NS_LOG_LOGIC ("Adding Nix: " << destId << " with "
+                                   << nixVector->BitCount (neighbors.size ()) << " bits, for node " << parents[node]);
+      nixVector->AddNeighborIndex (destId, nixVector->BitCount (neighbors.size ()));
+    }
+  store.nixVectors.insert (std::make_pair (key, nixVector));
+  return nixVector;
+}
+
 void
 Ipv4NixVectorRouting::FlushNixCache ()
 {
@@ -145,6 +445,18 @@ Ipv4NixVectorRouting::GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetD
     }
   else
     {
+      // without a specific output interface, the nix vector
+      // comes from the BFS tree of the source in the global store
+      if (!oif)
+        {
+          nixVector = GetSharedNixVector (source->GetId (), destNode->GetId ());
+          if (!nixVector)
+            {
+              NS_LOG_ERROR ("No routing path exists");
+            }
+          return nixVector;
+        }
+
       // otherwise proceed as normal 
       // and build the nix vector
       std::vector< Ptr<Node> > parentVector;
@@ -340,27 +652,16 @@ Ipv4NixVectorRouting::GetNodeByIp (Ipv4Address dest)
 { 
   NS_LOG_FUNCTION_NOARGS ();
 
-  NodeContainer allNodes = NodeContainer::GetGlobal ();
-  Ptr<Node> destNode;
-
-  for (NodeContainer::Iterator i = allNodes.Begin (); i != allNodes.End (); ++i)
-    {
-      Ptr<Node> node = *i;
-      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-      if (ipv4->GetInterfaceForAddress (dest) != -1)
-        {
-          destNode = node;
-          break;
-        }
-    }
-
-  if (!destNode)
+  UpdateNixVectorStore ();
+  NixVectorStore &store = GetNixVectorStore ();
+  sgi::hash_map<Ipv4Address, uint32_t, Ipv4AddressHash>::const_iterator i = store.addresses.find (dest);
+  if (i == store.addresses.end ())
     {
       NS_LOG_ERROR ("Couldn't find dest node given the IP" << dest);
       return 0;
     }
 
-  return destNode;
+  return NodeList::GetNode (i->second);
 }
 
 uint32_t
@@ -395,7 +696,7 @@ Ipv4NixVectorRouting::FindTotalNeighbors ()
 }
 
 Ptr<BridgeNetDevice>
-Ipv4NixVectorRouting::NetDeviceIsBridged (Ptr<NetDevice> nd) const
+Ipv4NixVectorRouting::NetDeviceIsBridged (Ptr<NetDevice> nd)
 {
   NS_LOG_FUNCTION (nd);
 
@@ -489,6 +790,7 @@ Ipv4NixVectorRouting::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<
   Ptr<NixVector> nixVectorForPacket;
 
   NS_LOG_DEBUG ("Dest IP from header: " << header.GetDestination ());
+  CheckTopologyVersion ();
   // check if cache
   nixVectorInCache = GetNixVectorInCache (header.GetDestination ());
 
@@ -526,14 +828,22 @@ Ipv4NixVectorRouting::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<
       uint32_t numberOfBits = nixVectorForPacket->BitCount (m_totalNeighbors);
       uint32_t nodeIndex = nixVectorForPacket->ExtractNeighborIndex (numberOfBits);
 
+      Ipv4Address gatewayIp;
+      uint32_t index = FindNetDeviceForNixIndex (nodeIndex, gatewayIp);
+
       // Search here in a cache for this node index 
       // and look for a Ipv4Route
       rtentry = GetIpv4RouteInCache (header.GetDestination ());
 
-      if (!rtentry || !(rtentry->GetOutputDevice () == oif))
+      // The cached route may have been built for the node index of
+      // another packet, such as a packet forwarded from another source
+      // on its own path: it is reused only if it leads to the same
+      // neighbor.
+      if (!rtentry || rtentry->GetOutputDevice () != (oif ? oif : m_node->GetDevice (index))
+          || rtentry->GetGateway () != gatewayIp)
         {
-          // not in cache or a different specified output
-          // device is to be used
+          // not in cache, for another neighbor, or a different
+          // specified output device is to be used
 
           // first, make sure we erase existing (incorrect)
           // rtentry from the map
@@ -543,8 +853,6 @@ Ipv4NixVectorRouting::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<
             }
 
           NS_LOG_LOGIC ("Ipv4Route not in cache, build: ");
-          Ipv4Address gatewayIp;
-          uint32_t index = FindNetDeviceForNixIndex (nodeIndex, gatewayIp);
           int32_t interfaceIndex = 0;
 
           if (!oif)
@@ -616,6 +924,8 @@ Ipv4NixVectorRouting::RouteInput (Ptr<const Packet> p, const Ipv4Header &header,
   // If nixVector isn't in packet, something went wrong
   NS_ASSERT (nixVector);
 
+  CheckTopologyVersion ();
+
   // Get the interface number that we go out of, by extracting
   // from the nix-vector
   if (m_totalNeighbors == 0)
@@ -625,13 +935,21 @@ Ipv4NixVectorRouting::RouteInput (Ptr<const Packet> p, const Ipv4Header &header,
   uint32_t numberOfBits = nixVector->BitCount (m_totalNeighbors);
   uint32_t nodeIndex = nixVector->ExtractNeighborIndex (numberOfBits);
 
+  Ipv4Address gatewayIp;
+  uint32_t index = FindNetDeviceForNixIndex (nodeIndex, gatewayIp);
+
   rtentry = GetIpv4RouteInCache (header.GetDestination ());
-  // not in cache
-  if (!rtentry)
+  // not in cache, or built for the node index of another packet, such
+  // as a packet sent by this node on its own path
+  if (!rtentry || rtentry->GetOutputDevice () != m_node->GetDevice (index)
+      || rtentry->GetGateway () != gatewayIp)
     {
+      if (rtentry)
+        {
+          m_ipv4RouteCache.erase (header.GetDestination ());
+        }
+
       NS_LOG_LOGIC ("Ipv4Route not in cache, build: ");
-      Ipv4Address gatewayIp;
-      uint32_t index = FindNetDeviceForNixIndex (nodeIndex, gatewayIp);
       uint32_t interfaceIndex = (m_ipv4)->GetInterfaceForDevice (m_node->GetDevice (index));
       Ipv4InterfaceAddress ifAddr = m_ipv4->GetAddress (interfaceIndex, 0);
 
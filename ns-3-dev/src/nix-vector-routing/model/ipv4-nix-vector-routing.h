@@ -70,12 +70,26 @@ public:
 
   /**
    * @brief Called when run-time link topology change occurs
-   * which iterates through the node list and flushes any
-   * nix vector caches
+   * which increments the version of the topology, so that
+   * the global nix-vector store and the caches of every node
+   * are flushed before their next use
    *
    */
   void FlushGlobalNixRoutingCache (void);
 
+  /**
+   * @brief Compute the BFS trees of all the nodes in the global
+   * nix-vector store, for the current topology
+   *
+   * The BFS tree of a node is otherwise computed on demand, the
+   * first time the node looks for a route.  Computing all of them
+   * beforehand splits the work among several threads, when
+   * threading is enabled.
+   *
+   * @param nThreads the number of threads computing the trees
+   */
+  static void PrecomputeNixVectors (uint32_t nThreads);
+
 private:
   /* flushes the cache which stores nix-vector based on
    * destination IP */
@@ -95,6 +109,19 @@ private:
    *  BuildNixVector to return the built nix-vector */
   Ptr<NixVector> GetNixVector (Ptr<Node>, Ipv4Address, Ptr<NetDevice>);
 
+  /* returns the nix-vector from source to dest, both node ids, built
+   * from the BFS tree of source in the global nix-vector store.  The
+   * nix-vectors of the store are shared and must not be modified */
+  static Ptr<NixVector> GetSharedNixVector (uint32_t source, uint32_t dest);
+
+  /* rebuilds the view of the topology of the global nix-vector store
+   * if the topology version or the number of nodes changed */
+  static void UpdateNixVectorStore (void);
+
+  /* flushes the caches of this node if the topology version changed
+   * since they were filled */
+  void CheckTopologyVersion (void);
+
   /* checks the cache based on dest IP for the nix-vector */
   Ptr<NixVector> GetNixVectorInCache (Ipv4Address);
 
@@ -103,7 +130,7 @@ private:
 
   /* given a net-device returns all the adjacent net-devices,
    * essentially getting the neighbors on that channel */
-  void GetAdjacentNetDevices (Ptr<NetDevice>, Ptr<Channel>, NetDeviceContainer &);
+  static void GetAdjacentNetDevices (Ptr<NetDevice>, Ptr<Channel>, NetDeviceContainer &);
 
   /* iterates through the node list and finds the one
    * corresponding to the given Ipv4Address */
@@ -120,7 +147,7 @@ private:
   uint32_t FindTotalNeighbors (void);
 
   /* determine if the netdevice is bridged */
-  Ptr<BridgeNetDevice> NetDeviceIsBridged (Ptr<NetDevice> nd) const;
+  static Ptr<BridgeNetDevice> NetDeviceIsBridged (Ptr<NetDevice> nd);
 
 
   /* Nix index is with respect to the neighbors.  The net-device index must be
@@ -168,6 +195,10 @@ private:
   /* total neighbors used for nix-vector to determine
    * number of bits */
   uint32_t m_totalNeighbors;
+
+  /* version of the topology for which the caches
+   * of this node are valid */
+  uint32_t m_topologyVersion;
 };
 } // namespace ns3
 
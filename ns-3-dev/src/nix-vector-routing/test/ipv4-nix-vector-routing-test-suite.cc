@@ -0,0 +1,434 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-nix-vector-helper.h"
+#include "ns3/ipv4-nix-vector-routing.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+
+using namespace ns3;
+
+/**
+ * Base class of the nix-vector routing tests: builds topologies of nodes
+ * routed by nix-vectors, linked by simple channels, and looks up their
+ * routes.
+ */
+class NixVectorRoutingTestCase : public TestCase
+{
+public:
+  NixVectorRoutingTestCase (std::string name);
+
+protected:
+  /**
+   * Create nodes routed by nix-vectors.
+   *
+   * \param n the number of nodes
+   */
+  void CreateNodes (uint32_t n);
+  /**
+   * Link two nodes, and assign them addresses.
+   *
+   * \param a the index of the first node
+   * \param b the index of the second node
+   * \param network the address of the network of the link
+   * \return the addresses of the two nodes on the link
+   */
+  Ipv4InterfaceContainer Link (uint32_t a, uint32_t b, const char *network);
+  /**
+   * Look up the route from a node to an address.
+   *
+   * \param source the index of the node
+   * \param dest the destination address
+   * \param nixVector the nix-vector given to the packet, printed
+   * \return the route, or zero if there is none
+   */
+  Ptr<Ipv4Route> Route (uint32_t source, Ipv4Address dest, std::string &nixVector);
+  /**
+   * Create a grid of nodes, each linked to its right and bottom neighbors.
+   *
+   * \param size the number of nodes on a side of the grid
+   * \return the address of the first interface of each node
+   */
+  std::vector<Ipv4Address> CreateGrid (uint32_t size);
+
+  NodeContainer m_nodes;  //!< Nodes of the topology
+};
+
+NixVectorRoutingTestCase::NixVectorRoutingTestCase (std::string name)
+  : TestCase (name)
+{
+}
+
+void
+NixVectorRoutingTestCase::CreateNodes (uint32_t n)
+{
+  m_nodes = NodeContainer ();
+  m_nodes.Create (n);
+  Ipv4NixVectorHelper nixRouting;
+  InternetStackHelper internet;
+  internet.SetRoutingHelper (nixRouting);
+  internet.Install (m_nodes);
+}
+
+Ipv4InterfaceContainer
+NixVectorRoutingTestCase::Link (uint32_t a, uint32_t b, const char *network)
+{
+  Ptr<SimpleNetDevice> devA = CreateObject<SimpleNetDevice> ();
+  Ptr<SimpleNetDevice> devB = CreateObject<SimpleNetDevice> ();
+  devA->SetAddress (Mac48Address::Allocate ());
+  devB->SetAddress (Mac48Address::Allocate ());
+  m_nodes.Get (a)->AddDevice (devA);
+  m_nodes.Get (b)->AddDevice (devB);
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  devA->SetChannel (channel);
+  devB->SetChannel (channel);
+  NetDeviceContainer d;
+  d.Add (devA);
+  d.Add (devB);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase (network, "255.255.255.0");
+  return ipv4.Assign (d);
+}
+
+Ptr<Ipv4Route>
+NixVectorRoutingTestCase::Route (uint32_t source, Ipv4Address dest, std::string &nixVector)
+{
+  Ptr<Ipv4RoutingProtocol> routing = m_nodes.Get (source)->GetObject<Ipv4> ()->GetRoutingProtocol ();
+  Ipv4Header header;
+  header.SetDestination (dest);
+  Ptr<Packet> p = Create<Packet> ();
+  Socket::SocketErrno sockerr;
+  Ptr<Ipv4Route> route = routing->RouteOutput (p, header, 0, sockerr);
+  std::ostringstream oss;
+  if (p->GetNixVector ())
+    {
+      oss << *p->GetNixVector ();
+    }
+  nixVector = oss.str ();
+  return route;
+}
+
+std::vector<Ipv4Address>
+NixVectorRoutingTestCase::CreateGrid (uint32_t size)
+{
+  CreateNodes (size * size);
+  uint32_t network = 0;
+  for (uint32_t i = 0; i < size * size; i++)
+    {
+      // link each node to its right and bottom neighbors
+      if (i % size < size - 1)
+        {
+          std::ostringstream base;
+          base << "10.1." << network++ << ".0";
+          Link (i, i + 1, base.str ().c_str ());
+        }
+      if (i / size < size - 1)
+        {
+          std::ostringstream base;
+          base << "10.1." << network++ << ".0";
+          Link (i, i + size, base.str ().c_str ());
+        }
+    }
+  // the address of the first interface of each node, after the loopback
+  std::vector<Ipv4Address> addresses;
+  for (uint32_t i = 0; i < size * size; i++)
+    {
+      addresses.push_back (m_nodes.Get (i)->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ());
+    }
+  return addresses;
+}
+
+/**
+ * Test that the routes of a node are cached, and that the caches are
+ * flushed when an interface goes down or up, or when an address is added.
+ *
+ * The four nodes form a square: node 0 reaches node 3 through node 1,
+ * the first neighbor found by the BFS, or through node 2.
+ */
+class NixVectorRoutingCacheTestCase : public NixVectorRoutingTestCase
+{
+public:
+  NixVectorRoutingCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+NixVectorRoutingCacheTestCase::NixVectorRoutingCacheTestCase ()
+  : NixVectorRoutingTestCase ("Check that the nix-vector routes are cached and flushed on topology changes")
+{
+}
+
+void
+NixVectorRoutingCacheTestCase::DoRun (void)
+{
+  CreateNodes (4);
+  Ipv4InterfaceContainer i01 = Link (0, 1, "10.1.1.0");
+  Ipv4InterfaceContainer i02 = Link (0, 2, "10.1.2.0");
+  Ipv4InterfaceContainer i13 = Link (1, 3, "10.1.3.0");
+  Ipv4InterfaceContainer i23 = Link (2, 3, "10.1.4.0");
+  Ipv4Address dest = i23.GetAddress (1);
+
+  std::string nix1, nix2;
+  Ptr<Ipv4Route> route1 = Route (0, dest, nix1);
+  NS_TEST_ASSERT_MSG_NE (route1, 0, "no route to node 3");
+  NS_TEST_EXPECT_MSG_EQ (route1->GetGateway (), i01.GetAddress (1), "route not through node 1");
+
+  // the cached route is reused, with the same nix-vector
+  Ptr<Ipv4Route> route2 = Route (0, dest, nix2);
+  NS_TEST_EXPECT_MSG_EQ (route2, route1, "cached route not reused");
+  NS_TEST_EXPECT_MSG_EQ (nix2, nix1, "cached nix-vector not reused");
+
+  // node 1 loses its link to node 3: the route goes through node 2
+  Ptr<Ipv4> ipv4 = m_nodes.Get (1)->GetObject<Ipv4> ();
+  uint32_t interface = i13.Get (0).second;
+  ipv4->SetDown (interface);
+  route2 = Route (0, dest, nix2);
+  NS_TEST_ASSERT_MSG_NE (route2, 0, "no route to node 3 with interface down");
+  NS_TEST_EXPECT_MSG_NE (route2, route1, "route not flushed on interface down");
+  NS_TEST_EXPECT_MSG_EQ (route2->GetGateway (), i02.GetAddress (1), "route not through node 2");
+  NS_TEST_EXPECT_MSG_NE (nix2, nix1, "nix-vector not flushed on interface down");
+
+  // and through node 1 again once its interface is up
+  ipv4->SetUp (interface);
+  route2 = Route (0, dest, nix2);
+  NS_TEST_ASSERT_MSG_NE (route2, 0, "no route to node 3 with interface up");
+  NS_TEST_EXPECT_MSG_EQ (route2->GetGateway (), i01.GetAddress (1), "route not flushed on interface up");
+  NS_TEST_EXPECT_MSG_EQ (nix2, nix1, "nix-vector not flushed on interface up");
+
+  // an unknown address has no route, until it is added to node 3
+  Ipv4Address added ("10.1.5.1");
+  route2 = Route (0, added, nix2);
+  NS_TEST_EXPECT_MSG_EQ (route2, 0, "route to an unknown address");
+  ipv4 = m_nodes.Get (3)->GetObject<Ipv4> ();
+  ipv4->AddAddress (i23.Get (1).second, Ipv4InterfaceAddress (added, "255.255.255.0"));
+  route2 = Route (0, added, nix2);
+  NS_TEST_ASSERT_MSG_NE (route2, 0, "route not flushed on address added");
+  NS_TEST_EXPECT_MSG_EQ (route2->GetGateway (), i01.GetAddress (1), "route not through node 1");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Test that the nix-vectors of the trees precomputed by threads are the
+ * same as the ones computed on demand.
+ *
+ * The nodes form a grid, in which most of the routes have several
+ * shortest paths.
+ */
+class NixVectorRoutingPrecomputeTestCase : public NixVectorRoutingTestCase
+{
+public:
+  NixVectorRoutingPrecomputeTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+NixVectorRoutingPrecomputeTestCase::NixVectorRoutingPrecomputeTestCase ()
+  : NixVectorRoutingTestCase ("Check that precomputed nix-vectors match the ones computed on demand")
+{
+}
+
+void
+NixVectorRoutingPrecomputeTestCase::DoRun (void)
+{
+  const uint32_t size = 4;
+  std::vector<Ipv4Address> addresses = CreateGrid (size);
+
+  std::vector<std::string> onDemand;
+  for (uint32_t i = 0; i < size * size; i++)
+    {
+      for (uint32_t j = 0; j < size * size; j++)
+        {
+          std::string nixVector;
+          if (i != j)
+            {
+              NS_TEST_ASSERT_MSG_NE (Route (i, addresses[j], nixVector), 0,
+                                     "no route from " << i << " to " << j);
+            }
+          onDemand.push_back (nixVector);
+        }
+    }
+
+  DynamicCast<Ipv4NixVectorRouting> (m_nodes.Get (0)->GetObject<Ipv4> ()->GetRoutingProtocol ())
+    ->FlushGlobalNixRoutingCache ();
+  Ipv4NixVectorRouting::PrecomputeNixVectors (3);
+
+  for (uint32_t i = 0; i < size * size; i++)
+    {
+      for (uint32_t j = 0; j < size * size; j++)
+        {
+          std::string nixVector;
+          if (i != j)
+            {
+              NS_TEST_ASSERT_MSG_NE (Route (i, addresses[j], nixVector), 0,
+                                     "no precomputed route from " << i << " to " << j);
+            }
+          NS_TEST_EXPECT_MSG_EQ (nixVector, onDemand[i * size * size + j],
+                                 "precomputed nix-vector from " << i << " to " << j << " differs");
+        }
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Test that a node which both forwards packets and sends its own packets
+ * to a destination uses, for each packet, the route given by the packet's
+ * nix-vector, and not the route it cached for the other kind of packet.
+ *
+ * On a grid of 4 x 4 nodes, node 4 reaches node 1 through node 0. When
+ * node 0 sends to node 1 out of its link to node 4, the nix-vector is
+ * built on a tree where node 0 has no other neighbor, and node 4 forwards
+ * the packet through node 5.
+ */
+class NixVectorRoutingForwardTestCase : public NixVectorRoutingTestCase
+{
+public:
+  NixVectorRoutingForwardTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Send a packet from a node to a destination node, and forward it hop
+   * by hop as the nodes on its path would.
+   *
+   * \param source the index of the node
+   * \param oif the output device of the node, or zero
+   * \param dest the address of the destination node
+   * \param gateway set to the first hop of the packet
+   * \return the number of hops to the destination, or zero if it was
+   * not reached
+   */
+  uint32_t Send (uint32_t source, Ptr<NetDevice> oif, Ipv4Address dest, Ipv4Address &gateway);
+  /**
+   * Keep the route given by RouteInput.
+   *
+   * \param route the route
+   * \param p the packet forwarded
+   * \param header the header of the packet
+   */
+  void Unicast (Ptr<Ipv4Route> route, Ptr<const Packet> p, const Ipv4Header &header);
+
+  std::map<Ipv4Address, uint32_t> m_nodeOfAddress; //!< The node of each address
+  Ptr<Ipv4Route> m_forwarded;                      //!< The last route given by RouteInput
+};
+
+NixVectorRoutingForwardTestCase::NixVectorRoutingForwardTestCase ()
+  : NixVectorRoutingTestCase ("Check that nodes forwarding and sending packets to a destination use their nix-vectors")
+{
+}
+
+void
+NixVectorRoutingForwardTestCase::Unicast (Ptr<Ipv4Route> route, Ptr<const Packet> p, const Ipv4Header &header)
+{
+  m_forwarded = route;
+}
+
+uint32_t
+NixVectorRoutingForwardTestCase::Send (uint32_t source, Ptr<NetDevice> oif, Ipv4Address dest, Ipv4Address &gateway)
+{
+  Ipv4Header header;
+  header.SetDestination (dest);
+  Ptr<Packet> p = Create<Packet> ();
+  Socket::SocketErrno sockerr;
+  Ptr<Ipv4Route> route = m_nodes.Get (source)->GetObject<Ipv4> ()->GetRoutingProtocol ()
+    ->RouteOutput (p, header, oif, sockerr);
+  gateway = route ? route->GetGateway () : Ipv4Address ();
+  for (uint32_t hops = 1; route != 0 && hops <= m_nodes.GetN (); hops++)
+    {
+      uint32_t node = m_nodeOfAddress[route->GetGateway ()];
+      if (node == m_nodeOfAddress[dest])
+        {
+          return hops;
+        }
+      if (p->GetNixVector ()->GetRemainingBits () == 0)
+        {
+          // misrouted: the nix-vector ends before the destination
+          return 0;
+        }
+      m_forwarded = 0;
+      m_nodes.Get (node)->GetObject<Ipv4> ()->GetRoutingProtocol ()
+        ->RouteInput (p, header, 0,
+                      MakeCallback (&NixVectorRoutingForwardTestCase::Unicast, this),
+                      Ipv4RoutingProtocol::MulticastForwardCallback (),
+                      Ipv4RoutingProtocol::LocalDeliverCallback (),
+                      Ipv4RoutingProtocol::ErrorCallback ());
+      route = m_forwarded;
+    }
+  return 0;
+}
+
+void
+NixVectorRoutingForwardTestCase::DoRun (void)
+{
+  std::vector<Ipv4Address> addresses = CreateGrid (4);
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      Ptr<Ipv4> ipv4 = m_nodes.Get (i)->GetObject<Ipv4> ();
+      for (uint32_t interface = 1; interface < ipv4->GetNInterfaces (); interface++)
+        {
+          m_nodeOfAddress[ipv4->GetAddress (interface, 0).GetLocal ()] = i;
+        }
+    }
+  // the device of node 0 linked to node 4, and the address of node 0 on it
+  Ptr<Ipv4> ipv4 = m_nodes.Get (0)->GetObject<Ipv4> ();
+  Ptr<NetDevice> down = ipv4->GetNetDevice (2);
+  Ipv4Address address0 = ipv4->GetAddress (2, 0).GetLocal ();
+  NS_TEST_ASSERT_MSG_EQ (m_nodeOfAddress[Ipv4Address ("10.1.1.2")], 4, "the second link of node 0 is not to node 4");
+
+  // node 4 sends to node 1 through node 0, and caches this route
+  Ipv4Address gateway;
+  NS_TEST_EXPECT_MSG_EQ (Send (4, 0, addresses[1], gateway), 2, "packet from node 4 misrouted");
+  NS_TEST_EXPECT_MSG_EQ (gateway, address0, "packet from node 4 not sent through node 0");
+
+  // node 4 forwards the packet of node 0 through node 5, not on its own route
+  NS_TEST_EXPECT_MSG_EQ (Send (0, down, addresses[1], gateway), 3, "packet from node 0 misrouted at node 4");
+
+  // and still sends its own packets through node 0, not on the route of
+  // the forwarded packet
+  NS_TEST_EXPECT_MSG_EQ (Send (4, 0, addresses[1], gateway), 2, "packet from node 4 misrouted after forwarding");
+  NS_TEST_EXPECT_MSG_EQ (gateway, address0, "packet from node 4 not sent through node 0 after forwarding");
+
+  Simulator::Destroy ();
+}
+
+class NixVectorRoutingTestSuite : public TestSuite
+{
+public:
+  NixVectorRoutingTestSuite ();
+};
+
+NixVectorRoutingTestSuite::NixVectorRoutingTestSuite ()
+  : TestSuite ("nix-vector-routing", UNIT)
+{
+  AddTestCase (new NixVectorRoutingCacheTestCase, TestCase::QUICK);
+  AddTestCase (new NixVectorRoutingPrecomputeTestCase, TestCase::QUICK);
+  AddTestCase (new NixVectorRoutingForwardTestCase, TestCase::QUICK);
+}
+
+static NixVectorRoutingTestSuite g_nixVectorRoutingTestSuite;
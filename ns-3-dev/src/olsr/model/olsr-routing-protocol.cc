@@ -47,6 +47,7 @@
 #include "ns3/enum.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/ipv4-header.h"
+#include <algorithm>
 
 /********** Useful macros **********/
 
@@ -191,6 +192,8 @@ RoutingProtocol::GetTypeId (void)
 
 RoutingProtocol::RoutingProtocol ()
   : m_routingTableAssociation (0),
+    m_routingTableVersion (0),
+    m_routingTableExpiry (Seconds (-1)),
     m_ipv4 (0),
     m_helloTimer (Timer::CANCEL_ON_DESTROY),
     m_tcTimer (Timer::CANCEL_ON_DESTROY),
@@ -875,6 +878,19 @@ RoutingProtocol::GetMainAddress (Ipv4Address iface_addr) const
 void
 RoutingProtocol::RoutingTableComputation ()
 {
+  // The routing table only depends on the state sets, and on the expiration
+  // time of the links used to reach the neighbors: most received messages
+  // change neither, and need not cause a new computation.
+  if (m_state.GetVersion () == m_routingTableVersion
+      && Simulator::Now () <= m_routingTableExpiry)
+    {
+      NS_LOG_DEBUG (Simulator::Now ().GetSeconds () << " s: Node " << m_mainAddress
+                                                    << ": routing table is up to date");
+      return;
+    }
+  m_routingTableVersion = m_state.GetVersion ();
+  m_routingTableExpiry = Time::Max ();
+
   NS_LOG_DEBUG (Simulator::Now ().GetSeconds () << " s: Node " << m_mainAddress
                                                 << ": RoutingTableComputation begin...");
 
@@ -906,6 +922,7 @@ RoutingProtocol::RoutingTableComputation ()
                   NS_LOG_LOGIC ("Link tuple matches neighbor " << nb_tuple.neighborMainAddr
                                                                << " => adding routing table entry to neighbor");
                   lt = &link_tuple;
+                  m_routingTableExpiry = std::min (m_routingTableExpiry, link_tuple.time);
                   AddEntry (link_tuple.neighborIfaceAddr,
                             link_tuple.neighborIfaceAddr,
                             link_tuple.localIfaceAddr,
@@ -1023,57 +1040,71 @@ RoutingProtocol::RoutingTableComputation ()
         }
     }
 
-  for (uint32_t h = 2;; h++)
+  // 3.1. For each topology entry in the topology table, if its
+  // T_dest_addr does not correspond to R_dest_addr of any
+  // route entry in the routing table AND its T_last_addr
+  // corresponds to R_dest_addr of a route entry whose R_dist
+  // is equal to h, then a new route entry MUST be recorded in
+  // the routing table (if it does not already exist).
+  //
+  // Rather than scanning the whole topology set for each value of h,
+  // only the tuples whose T_last_addr is one of the destinations at
+  // distance h are looked at. They are visited in the order of the
+  // topology set, which selects the same routes as a full scan.
+  const TopologySet &topology = m_state.GetTopologySet ();
+  std::vector<Ipv4Address> destinations;
+  for (std::map<Ipv4Address, RoutingTableEntry>::const_iterator it = m_table.begin ();
+       it != m_table.end (); it++)
     {
-      bool added = false;
+      if (it->second.distance == 2)
+        {
+          destinations.push_back (it->first);
+        }
+    }
+  for (uint32_t h = 2; !destinations.empty (); h++)
+    {
+      std::vector<uint32_t> positions;
+      for (std::vector<Ipv4Address>::const_iterator it = destinations.begin ();
+           it != destinations.end (); it++)
+        {
+          const std::vector<uint32_t> &tuples = m_state.FindTopologyTuplePositions (*it);
+          positions.insert (positions.end (), tuples.begin (), tuples.end ());
+        }
+      std::sort (positions.begin (), positions.end ());
 
-      // 3.1. For each topology entry in the topology table, if its
-      // T_dest_addr does not correspond to R_dest_addr of any
-      // route entry in the routing table AND its T_last_addr
-      // corresponds to R_dest_addr of a route entry whose R_dist
-      // is equal to h, then a new route entry MUST be recorded in
-      // the routing table (if it does not already exist)
-      const TopologySet &topology = m_state.GetTopologySet ();
-      for (TopologySet::const_iterator it = topology.begin ();
-           it != topology.end (); it++)
+      destinations.clear ();
+      for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+           it != positions.end (); it++)
         {
-          const TopologyTuple &topology_tuple = *it;
+          const TopologyTuple &topology_tuple = topology[*it];
           NS_LOG_LOGIC ("Looking at topology tuple: " << topology_tuple);
 
           RoutingTableEntry destAddrEntry, lastAddrEntry;
-          bool have_destAddrEntry = Lookup (topology_tuple.destAddr, destAddrEntry);
-          bool have_lastAddrEntry = Lookup (topology_tuple.lastAddr, lastAddrEntry);
-          if (!have_destAddrEntry && have_lastAddrEntry && lastAddrEntry.distance == h)
-            {
-              NS_LOG_LOGIC ("Adding routing table entry based on the topology tuple.");
-              // then a new route entry MUST be recorded in
-              //                the routing table (if it does not already exist) where:
-              //                     R_dest_addr  = T_dest_addr;
-              //                     R_next_addr  = R_next_addr of the recorded
-              //                                    route entry where:
-              //                                    R_dest_addr == T_last_addr
-              //                     R_dist       = h+1; and
-              //                     R_iface_addr = R_iface_addr of the recorded
-              //                                    route entry where:
-              //                                       R_dest_addr == T_last_addr.
-              AddEntry (topology_tuple.destAddr,
-                        lastAddrEntry.nextAddr,
-                        lastAddrEntry.interface,
-                        h + 1);
-              added = true;
-            }
-          else
+          if (Lookup (topology_tuple.destAddr, destAddrEntry))
             {
               NS_LOG_LOGIC ("NOT adding routing table entry based on the topology tuple: "
-                            "have_destAddrEntry=" << have_destAddrEntry
-                                                  << " have_lastAddrEntry=" << have_lastAddrEntry
-                                                  << " lastAddrEntry.distance=" << (int) lastAddrEntry.distance
-                                                  << " (h=" << h << ")");
+                            "destination already has a route of distance " << destAddrEntry.distance);
+              continue;
             }
+          Lookup (topology_tuple.lastAddr, lastAddrEntry);
+          NS_ASSERT (lastAddrEntry.distance == h);
+          NS_LOG_LOGIC ("Adding routing table entry based on the topology tuple.");
+          // then a new route entry MUST be recorded in
+          //                the routing table (if it does not already exist) where:
+          //                     R_dest_addr  = T_dest_addr;
+          //                     R_next_addr  = R_next_addr of the recorded
+          //                                    route entry where:
+          //                                    R_dest_addr == T_last_addr
+          //                     R_dist       = h+1; and
+          //                     R_iface_addr = R_iface_addr of the recorded
+          //                                    route entry where:
+          //                                       R_dest_addr == T_last_addr.
+          AddEntry (topology_tuple.destAddr,
+                    lastAddrEntry.nextAddr,
+                    lastAddrEntry.interface,
+                    h + 1);
+          destinations.push_back (topology_tuple.destAddr);
         }
-
-      if (!added)
-        break;
     }
 
   // 4. For each entry in the multiple interface association base
@@ -1422,6 +1453,7 @@ RoutingProtocol::ProcessMid (const olsr::MessageHeader &msg,
       twoHopNeighbor->neighborMainAddr = GetMainAddress (twoHopNeighbor->neighborMainAddr);
       twoHopNeighbor->twoHopNeighborAddr = GetMainAddress (twoHopNeighbor->twoHopNeighborAddr);
     }
+  m_state.MarkModified ();
   NS_LOG_DEBUG ("Node " << m_mainAddress << " ProcessMid from " << senderIface << " -> END.");
 }
 
@@ -2099,6 +2131,7 @@ RoutingProtocol::LinkSensing (const olsr::MessageHeader &msg,
       NS_LOG_DEBUG ("Link tuple updated: " << int (updated));
     }
   link_tuple->time = std::max (link_tuple->time, link_tuple->asymTime);
+  m_state.MarkModified ();
 
   if (updated)
     {
@@ -2125,9 +2158,10 @@ RoutingProtocol::PopulateNeighborSet (const olsr::MessageHeader &msg,
                                       const olsr::MessageHeader::Hello &hello)
 {
   NeighborTuple *nb_tuple = m_state.FindNeighborTuple (msg.GetOriginatorAddress ());
-  if (nb_tuple != NULL)
+  if (nb_tuple != NULL && nb_tuple->willingness != hello.willingness)
     {
       nb_tuple->willingness = hello.willingness;
+      m_state.MarkModified ();
     }
 }
 
@@ -2485,6 +2519,10 @@ RoutingProtocol::LinkTupleUpdated (const LinkTuple &tuple, uint8_t willingness)
           NS_LOG_DEBUG (*nb_tuple << "->status = STATUS_NOT_SYM; changed:"
                                   << int (statusBefore != nb_tuple->status));
         }
+      if (statusBefore != nb_tuple->status)
+        {
+          m_state.MarkModified ();
+        }
     }
   else
     {
@@ -3222,16 +3260,25 @@ bool RoutingProtocol::RouteInput  (Ptr<const Packet> p,
 }
 void 
 RoutingProtocol::NotifyInterfaceUp (uint32_t i)
-{}
+{
+  // The interface addresses are used when adding routing table entries
+  m_state.MarkModified ();
+}
 void 
 RoutingProtocol::NotifyInterfaceDown (uint32_t i)
-{}
+{
+  m_state.MarkModified ();
+}
 void 
 RoutingProtocol::NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress address)
-{}
+{
+  m_state.MarkModified ();
+}
 void 
 RoutingProtocol::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress address)
-{}
+{
+  m_state.MarkModified ();
+}
 
 
 ///
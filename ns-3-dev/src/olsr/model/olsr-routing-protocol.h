@@ -166,6 +166,10 @@ private:
 
   /// Internal state with all needed data structs.
   OlsrState m_state;
+  /// Version of m_state from which the routing table was computed.
+  uint32_t m_routingTableVersion;
+  /// Time after which a link used by the routing table expires.
+  Time m_routingTableExpiry;
 
   Ptr<Ipv4> m_ipv4;
 
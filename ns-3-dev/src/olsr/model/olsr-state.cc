@@ -149,6 +149,7 @@ OlsrState::EraseNeighborTuple (const NeighborTuple &tuple)
       if (*it == tuple)
         {
           m_neighborSet.erase (it);
+          m_version++;
           break;
         }
     }
@@ -163,6 +164,7 @@ OlsrState::EraseNeighborTuple (const Ipv4Address &mainAddr)
       if (it->neighborMainAddr == mainAddr)
         {
           it = m_neighborSet.erase (it);
+          m_version++;
           break;
         }
     }
@@ -178,10 +180,12 @@ OlsrState::InsertNeighborTuple (NeighborTuple const &tuple)
         {
           // Update it
           *it = tuple;
+          m_version++;
           return;
         }
     }
   m_neighborSet.push_back (tuple);
+  m_version++;
 }
 
 /********** Neighbor 2 Hop Set Manipulation **********/
@@ -211,6 +215,7 @@ OlsrState::EraseTwoHopNeighborTuple (const TwoHopNeighborTuple &tuple)
       if (*it == tuple)
         {
           m_twoHopNeighborSet.erase (it);
+          m_version++;
           break;
         }
     }
@@ -227,6 +232,7 @@ OlsrState::EraseTwoHopNeighborTuples (const Ipv4Address &neighborMainAddr,
           && it->twoHopNeighborAddr == twoHopNeighborAddr)
         {
           it = m_twoHopNeighborSet.erase (it);
+          m_version++;
         }
       else
         {
@@ -244,6 +250,7 @@ OlsrState::EraseTwoHopNeighborTuples (const Ipv4Address &neighborMainAddr)
       if (it->neighborMainAddr == neighborMainAddr)
         {
           it = m_twoHopNeighborSet.erase (it);
+          m_version++;
         }
       else
         {
@@ -256,6 +263,7 @@ void
 OlsrState::InsertTwoHopNeighborTuple (TwoHopNeighborTuple const &tuple)
 {
   m_twoHopNeighborSet.push_back (tuple);
+  m_version++;
 }
 
 /********** MPR Set Manipulation **********/
@@ -283,32 +291,40 @@ OlsrState::GetMprSet () const
 DuplicateTuple*
 OlsrState::FindDuplicateTuple (Ipv4Address const &addr, uint16_t sequenceNumber)
 {
-  for (DuplicateSet::iterator it = m_duplicateSet.begin ();
-       it != m_duplicateSet.end (); it++)
+  DuplicateIndex::const_iterator it = m_duplicateIndex.find (std::make_pair (addr, sequenceNumber));
+  if (it == m_duplicateIndex.end ())
     {
-      if (it->address == addr && it->sequenceNumber == sequenceNumber)
-        return &(*it);
+      return NULL;
     }
-  return NULL;
+  return &m_duplicateSet[it->second];
 }
 
 void
 OlsrState::EraseDuplicateTuple (const DuplicateTuple &tuple)
 {
-  for (DuplicateSet::iterator it = m_duplicateSet.begin ();
-       it != m_duplicateSet.end (); it++)
+  DuplicateIndex::iterator it = m_duplicateIndex.find (std::make_pair (tuple.address, tuple.sequenceNumber));
+  if (it == m_duplicateIndex.end ())
     {
-      if (*it == tuple)
-        {
-          m_duplicateSet.erase (it);
-          break;
-        }
+      return;
+    }
+  // The order of the duplicate set is irrelevant: move the last tuple
+  // in place of the erased one.
+  uint32_t position = it->second;
+  m_duplicateIndex.erase (it);
+  if (position != m_duplicateSet.size () - 1)
+    {
+      m_duplicateSet[position] = m_duplicateSet.back ();
+      const DuplicateTuple &moved = m_duplicateSet[position];
+      m_duplicateIndex[std::make_pair (moved.address, moved.sequenceNumber)] = position;
     }
+  m_duplicateSet.pop_back ();
 }
 
 void
 OlsrState::InsertDuplicateTuple (DuplicateTuple const &tuple)
 {
+  m_duplicateIndex.insert (std::make_pair (std::make_pair (tuple.address, tuple.sequenceNumber),
+                                           m_duplicateSet.size ()));
   m_duplicateSet.push_back (tuple);
 }
 
@@ -352,6 +368,7 @@ OlsrState::EraseLinkTuple (const LinkTuple &tuple)
       if (*it == tuple)
         {
           m_linkSet.erase (it);
+          m_version++;
           break;
         }
     }
@@ -361,36 +378,76 @@ LinkTuple&
 OlsrState::InsertLinkTuple (LinkTuple const &tuple)
 {
   m_linkSet.push_back (tuple);
+  m_version++;
   return m_linkSet.back ();
 }
 
 /********** Topology Set Manipulation **********/
 
+void
+OlsrState::IndexTopologyTuple (uint32_t position) const
+{
+  const TopologyTuple &tuple = m_topologySet[position];
+  // insert does not replace the position of an earlier tuple with the same key
+  m_topologyIndex.insert (std::make_pair (std::make_pair (tuple.destAddr, tuple.lastAddr), position));
+  m_topologyLastAddrIndex[tuple.lastAddr].push_back (position);
+}
+
+void
+OlsrState::UpdateTopologyIndex (void) const
+{
+  if (m_topologyIndexValid)
+    {
+      return;
+    }
+  m_topologyIndex.clear ();
+  m_topologyLastAddrIndex.clear ();
+  m_topologyIndexValid = true;
+  for (uint32_t i = 0; i < m_topologySet.size (); i++)
+    {
+      IndexTopologyTuple (i);
+    }
+}
+
 TopologyTuple*
 OlsrState::FindTopologyTuple (Ipv4Address const &destAddr,
                               Ipv4Address const &lastAddr)
 {
-  for (TopologySet::iterator it = m_topologySet.begin ();
-       it != m_topologySet.end (); it++)
+  UpdateTopologyIndex ();
+  TopologyIndex::const_iterator it = m_topologyIndex.find (std::make_pair (destAddr, lastAddr));
+  if (it == m_topologyIndex.end ())
     {
-      if (it->destAddr == destAddr && it->lastAddr == lastAddr)
-        return &(*it);
+      return NULL;
     }
-  return NULL;
+  return &m_topologySet[it->second];
 }
 
 TopologyTuple*
 OlsrState::FindNewerTopologyTuple (Ipv4Address const & lastAddr, uint16_t ansn)
 {
-  for (TopologySet::iterator it = m_topologySet.begin ();
-       it != m_topologySet.end (); it++)
+  const std::vector<uint32_t> &positions = FindTopologyTuplePositions (lastAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (it->lastAddr == lastAddr && it->sequenceNumber > ansn)
-        return &(*it);
+      if (m_topologySet[*it].sequenceNumber > ansn)
+        return &m_topologySet[*it];
     }
   return NULL;
 }
 
+const std::vector<uint32_t> &
+OlsrState::FindTopologyTuplePositions (const Ipv4Address &lastAddr) const
+{
+  static const std::vector<uint32_t> empty;
+  UpdateTopologyIndex ();
+  TopologyLastAddrIndex::const_iterator it = m_topologyLastAddrIndex.find (lastAddr);
+  if (it == m_topologyLastAddrIndex.end ())
+    {
+      return empty;
+    }
+  return it->second;
+}
+
 void
 OlsrState::EraseTopologyTuple (const TopologyTuple &tuple)
 {
@@ -400,6 +457,8 @@ OlsrState::EraseTopologyTuple (const TopologyTuple &tuple)
       if (*it == tuple)
         {
           m_topologySet.erase (it);
+          m_topologyIndexValid = false;
+          m_version++;
           break;
         }
     }
@@ -408,6 +467,19 @@ OlsrState::EraseTopologyTuple (const TopologyTuple &tuple)
 void
 OlsrState::EraseOlderTopologyTuples (const Ipv4Address &lastAddr, uint16_t ansn)
 {
+  // Most TC messages only refresh the tuples of their originator: use the
+  // index to avoid scanning the set when there is nothing to erase.
+  const std::vector<uint32_t> &positions = FindTopologyTuplePositions (lastAddr);
+  bool found = false;
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end () && !found; it++)
+    {
+      found = (m_topologySet[*it].sequenceNumber < ansn);
+    }
+  if (!found)
+    {
+      return;
+    }
   for (TopologySet::iterator it = m_topologySet.begin ();
        it != m_topologySet.end ();)
     {
@@ -420,38 +492,60 @@ OlsrState::EraseOlderTopologyTuples (const Ipv4Address &lastAddr, uint16_t ansn)
           it++;
         }
     }
+  m_topologyIndexValid = false;
+  m_version++;
 }
 
 void
 OlsrState::InsertTopologyTuple (TopologyTuple const &tuple)
 {
   m_topologySet.push_back (tuple);
+  if (m_topologyIndexValid)
+    {
+      IndexTopologyTuple (m_topologySet.size () - 1);
+    }
+  m_version++;
 }
 
 /********** Interface Association Set Manipulation **********/
 
+void
+OlsrState::UpdateIfaceAssocIndex (void) const
+{
+  if (m_ifaceAssocIndexValid)
+    {
+      return;
+    }
+  m_ifaceAssocIndex.clear ();
+  m_ifaceAssocIndexValid = true;
+  for (uint32_t i = 0; i < m_ifaceAssocSet.size (); i++)
+    {
+      m_ifaceAssocIndex.insert (std::make_pair (m_ifaceAssocSet[i].ifaceAddr, i));
+    }
+}
+
 IfaceAssocTuple*
 OlsrState::FindIfaceAssocTuple (Ipv4Address const &ifaceAddr)
 {
-  for (IfaceAssocSet::iterator it = m_ifaceAssocSet.begin ();
-       it != m_ifaceAssocSet.end (); it++)
+  UpdateIfaceAssocIndex ();
+  IfaceAssocIndex::const_iterator it = m_ifaceAssocIndex.find (ifaceAddr);
+  if (it == m_ifaceAssocIndex.end ())
     {
-      if (it->ifaceAddr == ifaceAddr)
-        return &(*it);
+      return NULL;
     }
-  return NULL;
+  return &m_ifaceAssocSet[it->second];
 }
 
 const IfaceAssocTuple*
 OlsrState::FindIfaceAssocTuple (Ipv4Address const &ifaceAddr) const
 {
-  for (IfaceAssocSet::const_iterator it = m_ifaceAssocSet.begin ();
-       it != m_ifaceAssocSet.end (); it++)
+  UpdateIfaceAssocIndex ();
+  IfaceAssocIndex::const_iterator it = m_ifaceAssocIndex.find (ifaceAddr);
+  if (it == m_ifaceAssocIndex.end ())
     {
-      if (it->ifaceAddr == ifaceAddr)
-        return &(*it);
+      return NULL;
     }
-  return NULL;
+  return &m_ifaceAssocSet[it->second];
 }
 
 void
@@ -463,6 +557,8 @@ OlsrState::EraseIfaceAssocTuple (const IfaceAssocTuple &tuple)
       if (*it == tuple)
         {
           m_ifaceAssocSet.erase (it);
+          m_ifaceAssocIndexValid = false;
+          m_version++;
           break;
         }
     }
@@ -472,6 +568,11 @@ void
 OlsrState::InsertIfaceAssocTuple (const IfaceAssocTuple &tuple)
 {
   m_ifaceAssocSet.push_back (tuple);
+  if (m_ifaceAssocIndexValid)
+    {
+      m_ifaceAssocIndex.insert (std::make_pair (tuple.ifaceAddr, m_ifaceAssocSet.size () - 1));
+    }
+  m_version++;
 }
 
 std::vector<Ipv4Address>
@@ -512,6 +613,7 @@ OlsrState::EraseAssociationTuple (const AssociationTuple &tuple)
       if (*it == tuple)
         {
           m_associationSet.erase (it);
+          m_version++;
           break;
         }
     }
@@ -521,6 +623,7 @@ void
 OlsrState::InsertAssociationTuple (const AssociationTuple &tuple)
 {
   m_associationSet.push_back (tuple);
+  m_version++;
 }
 
 void
@@ -532,6 +635,7 @@ OlsrState::EraseAssociation (const Association &tuple)
       if (*it == tuple)
         {
           m_associations.erase (it);
+          m_version++;
           break;
         }
     }
@@ -541,6 +645,7 @@ void
 OlsrState::InsertAssociation (const Association &tuple)
 {
   m_associations.push_back (tuple);
+  m_version++;
 }
 
 }} // namespace olsr, ns3
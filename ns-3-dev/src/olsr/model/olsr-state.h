@@ -26,15 +26,62 @@
 #define OLSR_STATE_H
 
 #include "olsr-repositories.h"
+#include "ns3/sgi-hashmap.h"
+#include <utility>
 
 namespace ns3 {
 namespace olsr {
 
 /// This class encapsulates all data structures needed for maintaining internal state of an OLSR node.
+///
+/// The sets whose size grows with the size of the network (duplicate,
+/// topology and interface association sets) are indexed by hash tables,
+/// so that the lookups done for each received message do not scan them.
+/// The indexes of the topology and interface association sets hold the
+/// positions of the tuples in their set, preserving the order of the set;
+/// they are updated when a tuple is inserted, and rebuilt on the next
+/// lookup after a tuple has been erased.
 class OlsrState
 {
   //  friend class Olsr;
 
+  /// Hash function for a pair of addresses
+  struct AddressPairHash
+  {
+    size_t operator() (const std::pair<Ipv4Address, Ipv4Address> &x) const
+    {
+      return Ipv4AddressHash () (x.first) * 31 + Ipv4AddressHash () (x.second);
+    }
+  };
+  /// Hash function for an address and a sequence number
+  struct SequenceHash
+  {
+    size_t operator() (const std::pair<Ipv4Address, uint16_t> &x) const
+    {
+      return Ipv4AddressHash () (x.first) * 31 + x.second;
+    }
+  };
+  typedef sgi::hash_map<std::pair<Ipv4Address, uint16_t>, uint32_t, SequenceHash> DuplicateIndex;
+  typedef sgi::hash_map<std::pair<Ipv4Address, Ipv4Address>, uint32_t, AddressPairHash> TopologyIndex;
+  typedef sgi::hash_map<Ipv4Address, std::vector<uint32_t>, Ipv4AddressHash> TopologyLastAddrIndex;
+  typedef sgi::hash_map<Ipv4Address, uint32_t, Ipv4AddressHash> IfaceAssocIndex;
+
+  void IndexTopologyTuple (uint32_t position) const;
+  void UpdateTopologyIndex (void) const;
+  void UpdateIfaceAssocIndex (void) const;
+
+  /// Position of each tuple in m_duplicateSet, by address and sequence number
+  DuplicateIndex m_duplicateIndex;
+  /// Position of the first tuple in m_topologySet, by destination and last address
+  mutable TopologyIndex m_topologyIndex;
+  /// Positions of the tuples in m_topologySet, by last address
+  mutable TopologyLastAddrIndex m_topologyLastAddrIndex;
+  mutable bool m_topologyIndexValid;
+  /// Position of the first tuple in m_ifaceAssocSet, by interface address
+  mutable IfaceAssocIndex m_ifaceAssocIndex;
+  mutable bool m_ifaceAssocIndexValid;
+  uint32_t m_version;
+
 protected:
   LinkSet m_linkSet;    ///< Link Set (\RFC{3626}, section 4.2.1).
   NeighborSet m_neighborSet;            ///< Neighbor Set (\RFC{3626}, section 4.3.1).
@@ -50,8 +97,24 @@ protected:
 public:
 
   OlsrState ()
+    : m_topologyIndexValid (true),
+      m_ifaceAssocIndexValid (true),
+      m_version (0)
   {}
 
+  /// \returns a number which changes each time the sets used to compute
+  ///          the routing table are modified.
+  uint32_t GetVersion () const
+  {
+    return m_version;
+  }
+  /// Must be called after a tuple of a set used to compute the routing table
+  /// has been modified in place, through a pointer returned by a Find method.
+  void MarkModified ()
+  {
+    m_version++;
+  }
+
   // MPR selector
   const MprSelectorSet & GetMprSelectors () const
   {
@@ -133,12 +196,17 @@ public:
   void EraseOlderTopologyTuples (const Ipv4Address &lastAddr,
                                  uint16_t ansn);
   void InsertTopologyTuple (const TopologyTuple &tuple);
+  /// \returns the positions in the topology set of the tuples whose
+  ///          last address is lastAddr, in increasing order.
+  const std::vector<uint32_t> & FindTopologyTuplePositions (const Ipv4Address &lastAddr) const;
 
   // Interface association
   const IfaceAssocSet & GetIfaceAssocSet () const
   {
     return m_ifaceAssocSet;
   }
+  /// The interface addresses of the tuples must not be modified through
+  /// the returned reference.
   IfaceAssocSet & GetIfaceAssocSetMutable ()
   {
     return m_ifaceAssocSet;
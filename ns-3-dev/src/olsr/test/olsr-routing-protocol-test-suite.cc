@@ -167,6 +167,97 @@ OlsrMprTestCase::DoRun ()
   NS_TEST_EXPECT_MSG_EQ ((mpr.find ("10.0.0.9") == mpr.end ()), true, "Node 1 must NOT select node 8 as MPR");
 }
 
+/// Testcase for the indexes of the OLSR state sets
+class OlsrStateIndexTestCase : public TestCase {
+public:
+  OlsrStateIndexTestCase ();
+  /// \brief Run test case
+  virtual void DoRun (void);
+};
+
+OlsrStateIndexTestCase::OlsrStateIndexTestCase ()
+  : TestCase ("Check OLSR state set lookups and modification tracking")
+{
+}
+
+void
+OlsrStateIndexTestCase::DoRun ()
+{
+  OlsrState state;
+
+  /*
+   * Topology set, in insertion order:
+   *   0: 10.0.0.2 <- 10.0.0.1 (ansn 1)
+   *   1: 10.0.0.3 <- 10.0.0.1 (ansn 1)
+   *   2: 10.0.0.3 <- 10.0.0.4 (ansn 5)
+   */
+  TopologyTuple topology;
+  topology.expirationTime = Seconds (3600);
+  topology.sequenceNumber = 1;
+  topology.lastAddr = Ipv4Address ("10.0.0.1");
+  topology.destAddr = Ipv4Address ("10.0.0.2");
+  state.InsertTopologyTuple (topology);
+  topology.destAddr = Ipv4Address ("10.0.0.3");
+  state.InsertTopologyTuple (topology);
+  topology.sequenceNumber = 5;
+  topology.lastAddr = Ipv4Address ("10.0.0.4");
+  state.InsertTopologyTuple (topology);
+
+  NS_TEST_EXPECT_MSG_NE (state.FindTopologyTuple ("10.0.0.3", "10.0.0.4"), 0, "Topology tuple not found");
+  NS_TEST_EXPECT_MSG_EQ (state.FindTopologyTuple ("10.0.0.4", "10.0.0.3"), 0, "Unexpected topology tuple");
+  NS_TEST_EXPECT_MSG_EQ (state.FindTopologyTuplePositions ("10.0.0.1").size (), 2, "Wrong number of tuples");
+  NS_TEST_EXPECT_MSG_NE (state.FindNewerTopologyTuple ("10.0.0.4", 4), 0, "Newer tuple not found");
+  NS_TEST_EXPECT_MSG_EQ (state.FindNewerTopologyTuple ("10.0.0.4", 5), 0, "Unexpected newer tuple");
+
+  uint32_t version = state.GetVersion ();
+  state.EraseOlderTopologyTuples ("10.0.0.4", 5);
+  NS_TEST_EXPECT_MSG_EQ (state.GetVersion (), version, "Nothing was erased, the version must not change");
+  state.EraseOlderTopologyTuples ("10.0.0.1", 2);
+  NS_TEST_EXPECT_MSG_NE (state.GetVersion (), version, "Tuples were erased, the version must change");
+  NS_TEST_EXPECT_MSG_EQ (state.GetTopologySet ().size (), 1, "Older tuples not erased");
+  NS_TEST_EXPECT_MSG_EQ (state.FindTopologyTuple ("10.0.0.2", "10.0.0.1"), 0, "Erased tuple still found");
+  NS_TEST_EXPECT_MSG_EQ (state.FindTopologyTuplePositions ("10.0.0.1").size (), 0, "Erased tuple still indexed");
+  const std::vector<uint32_t> &positions = state.FindTopologyTuplePositions ("10.0.0.4");
+  NS_TEST_ASSERT_MSG_EQ (positions.size (), 1, "Wrong number of tuples");
+  NS_TEST_EXPECT_MSG_EQ (state.GetTopologySet ()[positions[0]].destAddr, Ipv4Address ("10.0.0.3"), "Wrong tuple position");
+
+  // The duplicate set is reordered when a tuple is erased
+  DuplicateTuple duplicate;
+  duplicate.address = Ipv4Address ("10.0.0.1");
+  duplicate.retransmitted = false;
+  duplicate.expirationTime = Seconds (30);
+  for (uint16_t i = 0; i < 4; i++)
+    {
+      duplicate.sequenceNumber = i;
+      state.InsertDuplicateTuple (duplicate);
+    }
+  duplicate.sequenceNumber = 1;
+  state.EraseDuplicateTuple (duplicate);
+  NS_TEST_EXPECT_MSG_EQ (state.FindDuplicateTuple ("10.0.0.1", 1), 0, "Erased tuple still found");
+  for (uint16_t i = 0; i < 4; i += 2)
+    {
+      DuplicateTuple *found = state.FindDuplicateTuple ("10.0.0.1", i);
+      NS_TEST_ASSERT_MSG_NE (found, 0, "Duplicate tuple not found");
+      NS_TEST_EXPECT_MSG_EQ (found->sequenceNumber, i, "Wrong duplicate tuple");
+    }
+  DuplicateTuple *moved = state.FindDuplicateTuple ("10.0.0.1", 3);
+  NS_TEST_ASSERT_MSG_NE (moved, 0, "Moved duplicate tuple not found");
+  NS_TEST_EXPECT_MSG_EQ (moved->sequenceNumber, 3, "Wrong duplicate tuple");
+
+  IfaceAssocTuple ifaceAssoc;
+  ifaceAssoc.mainAddr = Ipv4Address ("10.0.0.1");
+  ifaceAssoc.time = Seconds (3600);
+  ifaceAssoc.ifaceAddr = Ipv4Address ("10.0.1.1");
+  state.InsertIfaceAssocTuple (ifaceAssoc);
+  ifaceAssoc.ifaceAddr = Ipv4Address ("10.0.2.1");
+  state.InsertIfaceAssocTuple (ifaceAssoc);
+  ifaceAssoc.ifaceAddr = Ipv4Address ("10.0.1.1");
+  state.EraseIfaceAssocTuple (ifaceAssoc);
+  NS_TEST_EXPECT_MSG_EQ (state.FindIfaceAssocTuple ("10.0.1.1"), 0, "Erased tuple still found");
+  NS_TEST_ASSERT_MSG_NE (state.FindIfaceAssocTuple ("10.0.2.1"), 0, "Interface association tuple not found");
+  NS_TEST_EXPECT_MSG_EQ (state.FindIfaceAssocTuple ("10.0.2.1")->mainAddr, Ipv4Address ("10.0.0.1"), "Wrong tuple");
+}
+
 static class OlsrProtocolTestSuite : public TestSuite
 {
 public:
@@ -177,4 +268,5 @@ OlsrProtocolTestSuite::OlsrProtocolTestSuite()
   : TestSuite ("routing-olsr", UNIT)
 {
   AddTestCase (new OlsrMprTestCase (), TestCase::QUICK);
+  AddTestCase (new OlsrStateIndexTestCase (), TestCase::QUICK);
 }
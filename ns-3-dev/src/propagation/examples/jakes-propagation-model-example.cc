@@ -33,7 +33,7 @@ using namespace ns3;
 class JakesPropagationExample
 {
 public:
-  JakesPropagationExample ();
+  JakesPropagationExample (bool useTable);
   ~JakesPropagationExample ();
 private:
   Ptr<PropagationLossModel> m_loss;
@@ -45,10 +45,14 @@ private:
 
 };
 
-JakesPropagationExample::JakesPropagationExample () :
+JakesPropagationExample::JakesPropagationExample (bool useTable) :
   m_step (Seconds (0.0002)) //1/5000 part of the second
 {
   m_loss = CreateObject<JakesPropagationLossModel> ();
+  if (useTable)
+    {
+      m_loss->SetAttribute ("FadingTable", PointerValue (CreateObject<JakesFadingTable> ()));
+    }
   m_firstMobility = CreateObject<ConstantPositionMobilityModel> ();
   m_secondMobility = CreateObject<ConstantPositionMobilityModel> ();
   m_firstMobility->SetPosition (Vector (0, 0, 0));
@@ -69,9 +73,12 @@ void JakesPropagationExample::Next ()
 int main (int argc, char *argv[])
 {
   Config::SetDefault ("ns3::JakesProcess::NumberOfOscillators", UintegerValue (100));
+  Config::SetDefault ("ns3::JakesFadingTable::NumberOfOscillators", UintegerValue (100));
+  bool useTable = false;
   CommandLine cmd;
+  cmd.AddValue ("useTable", "Read the fading from a precomputed JakesFadingTable", useTable);
   cmd.Parse (argc, argv);
-  JakesPropagationExample example;
+  JakesPropagationExample example (useTable);
   Simulator::Stop (Seconds (1000));
   Simulator::Run ();
   Simulator::Destroy ();
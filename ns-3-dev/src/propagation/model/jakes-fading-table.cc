@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "jakes-fading-table.h"
+#include "jakes-propagation-loss-model.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/log.h"
+#include <complex>
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE ("JakesFadingTable");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (JakesFadingTable);
+
+TypeId
+JakesFadingTable::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::JakesFadingTable")
+    .SetParent<Object> ()
+    .AddConstructor<JakesFadingTable> ()
+    .AddAttribute ("DopplerFrequencyHz", "Corresponding doppler frequency[Hz]",
+                   DoubleValue (80),
+                   MakeDoubleAccessor (&JakesFadingTable::SetDopplerFrequencyHz),
+                   MakeDoubleChecker<double> (0.0, 1e4))
+    .AddAttribute ("NumberOfOscillators", "The number of oscillators",
+                   UintegerValue (20),
+                   MakeUintegerAccessor (&JakesFadingTable::m_nOscillators),
+                   MakeUintegerChecker<uint32_t> (4, 1000))
+    .AddAttribute ("NumberOfSamples", "The number of samples stored in the table",
+                   UintegerValue (65536),
+                   MakeUintegerAccessor (&JakesFadingTable::m_nSamples),
+                   MakeUintegerChecker<uint32_t> (2))
+    .AddAttribute ("SamplingInterval", "The time between two consecutive samples of the table",
+                   TimeValue (MicroSeconds (500)),
+                   MakeTimeAccessor (&JakesFadingTable::m_interval),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+JakesFadingTable::JakesFadingTable ()
+  : m_omegaDopplerMax (0),
+    m_nOscillators (0),
+    m_nSamples (0)
+{
+  NS_LOG_FUNCTION (this);
+  m_uniformVariable = CreateObject<UniformRandomVariable> ();
+  m_uniformVariable->SetAttribute ("Min", DoubleValue (-1.0 * JakesPropagationLossModel::PI));
+  m_uniformVariable->SetAttribute ("Max", DoubleValue (JakesPropagationLossModel::PI));
+}
+
+JakesFadingTable::~JakesFadingTable ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+JakesFadingTable::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_samples.clear ();
+  m_uniformVariable = 0;
+  Object::DoDispose ();
+}
+
+void
+JakesFadingTable::SetDopplerFrequencyHz (double dopplerFrequencyHz)
+{
+  NS_ASSERT_MSG (m_samples.empty (), "Cannot change the doppler frequency of a table already in use");
+  m_omegaDopplerMax = 2 * dopplerFrequencyHz * JakesPropagationLossModel::PI;
+}
+
+uint32_t
+JakesFadingTable::GetNSamples (void) const
+{
+  return m_nSamples;
+}
+
+int64_t
+JakesFadingTable::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  NS_ASSERT_MSG (m_samples.empty (), "Streams must be assigned before the table is first used");
+  m_uniformVariable->SetStream (stream);
+  return 1;
+}
+
+void
+JakesFadingTable::Generate (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_nOscillators != 0);
+  NS_ASSERT (m_omegaDopplerMax != 0);
+  NS_ASSERT (m_interval.IsStrictlyPositive ());
+
+  // Same construction as JakesProcess::ConstructOscillators: common initial
+  // phase and theta, one random amplitude phase per oscillator.
+  double phi = m_uniformVariable->GetValue ();
+  double theta = m_uniformVariable->GetValue ();
+  std::vector<std::complex<double> > amplitudes;
+  std::vector<double> omegas;
+  for (uint32_t i = 0; i < m_nOscillators; i++)
+    {
+      uint32_t n = i + 1;
+      double alpha = (2.0 * JakesPropagationLossModel::PI * n - JakesPropagationLossModel::PI + theta) / (4.0 * m_nOscillators);
+      omegas.push_back (m_omegaDopplerMax * std::cos (alpha));
+      double psi = m_uniformVariable->GetValue ();
+      amplitudes.push_back (std::complex<double> (std::cos (psi), std::sin (psi)) * 2.0 / std::sqrt (m_nOscillators));
+    }
+
+  double interval = m_interval.GetSeconds ();
+  m_samples.resize (m_nSamples);
+  for (uint32_t j = 0; j < m_nSamples; j++)
+    {
+      double t = j * interval;
+      std::complex<double> gain = std::complex<double> (0, 0);
+      for (uint32_t i = 0; i < m_nOscillators; i++)
+        {
+          gain += amplitudes[i] * std::cos (omegas[i] * t + phi);
+        }
+      m_samples[j] = 10 * std::log10 ((std::pow (gain.real (), 2) + std::pow (gain.imag (), 2)) / 2);
+    }
+  NS_LOG_LOGIC ("Generated " << m_nSamples << " samples spanning " << m_interval * m_nSamples);
+}
+
+double
+JakesFadingTable::GetChannelGainDb (uint32_t offset, Time t) const
+{
+  if (m_samples.empty ())
+    {
+      Generate ();
+    }
+  int64_t step = m_interval.GetTimeStep ();
+  int64_t now = t.GetTimeStep ();
+  uint32_t index = (offset + static_cast<uint64_t> (now / step)) % m_nSamples;
+  uint32_t next = (index + 1 == m_nSamples) ? 0 : index + 1;
+  double fraction = static_cast<double> (now % step) / step;
+  return m_samples[index] + fraction * (m_samples[next] - m_samples[index]);
+}
+
+} // namespace ns3
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef JAKES_FADING_TABLE_H
+#define JAKES_FADING_TABLE_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+#include <vector>
+
+namespace ns3
+{
+/**
+ * \ingroup fading
+ *
+ * \brief Precomputed Jakes fading trace shared by many propagation links.
+ *
+ * The table holds a single realization of the sum-of-sinusoids process
+ * described in JakesProcess, sampled every SamplingInterval over
+ * NumberOfSamples points and stored as channel gain in dB.  The trace is
+ * generated once, on first use, and then read circularly: every link keeps
+ * only its own sample offset into the table, so that the per-call cost is a
+ * table lookup with linear interpolation, and the per-link state is a single
+ * integer instead of a full set of oscillators.
+ *
+ * Links drawing offsets that are further apart than the coherence time of
+ * the process (roughly 0.4 / DopplerFrequencyHz) see uncorrelated fading.
+ * The period of the trace, SamplingInterval * NumberOfSamples, should thus
+ * be large compared with the coherence time multiplied by the number of
+ * links that must be mutually independent.
+ *
+ * A single table can be shared by several JakesPropagationLossModel
+ * instances through their FadingTable attribute.
+ */
+class JakesFadingTable : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+  JakesFadingTable ();
+  virtual ~JakesFadingTable ();
+
+  /**
+   * \param offset the sample offset of the link into the table
+   * \param t the time at which the gain is requested
+   * \returns the channel gain [dB] seen by the link at time t
+   */
+  double GetChannelGainDb (uint32_t offset, Time t) const;
+  /**
+   * \returns the number of samples in the table
+   */
+  uint32_t GetNSamples (void) const;
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this table.  Return the number of streams (possibly zero) that
+   * have been assigned.  Must be called before the table is first used.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this table
+   */
+  int64_t AssignStreams (int64_t stream);
+
+private:
+  virtual void DoDispose (void);
+  void SetDopplerFrequencyHz (double dopplerFrequencyHz);
+  /// Fill m_samples with a realization of the Jakes process
+  void Generate (void) const;
+
+  /// Channel gain [dB] at each sampling instant
+  mutable std::vector<float> m_samples;
+  ///\name Attributes:
+  ///\{
+  double m_omegaDopplerMax;
+  uint32_t m_nOscillators;
+  uint32_t m_nSamples;
+  Time m_interval;
+  ///\}
+  Ptr<UniformRandomVariable> m_uniformVariable;
+};
+} // namespace ns3
+#endif // JAKES_FADING_TABLE_H
@@ -20,6 +20,8 @@
 
 #include "jakes-propagation-loss-model.h"
 #include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
 #include "ns3/log.h"
 
 NS_LOG_COMPONENT_DEFINE ("Jakes");
@@ -47,6 +49,12 @@ JakesPropagationLossModel::GetTypeId ()
   static TypeId tid = TypeId ("ns3::JakesPropagationLossModel")
     .SetParent<PropagationLossModel> ()
     .AddConstructor<JakesPropagationLossModel> ()
+    .AddAttribute ("FadingTable",
+                   "If set, fading is read from this precomputed table instead of "
+                   "being computed by a JakesProcess for each pair of nodes.",
+                   PointerValue (),
+                   MakePointerAccessor (&JakesPropagationLossModel::m_fadingTable),
+                   MakePointerChecker<JakesFadingTable> ())
   ;
   return tid;
 }
@@ -56,6 +64,10 @@ JakesPropagationLossModel::DoCalcRxPower (double txPowerDbm,
                                           Ptr<MobilityModel> a,
                                           Ptr<MobilityModel> b) const
 {
+  if (m_fadingTable != 0)
+    {
+      return txPowerDbm + m_fadingTable->GetChannelGainDb (GetTableOffset (a, b), Simulator::Now ());
+    }
   Ptr<JakesProcess> pathData = m_propagationCache.GetPathData (a, b, 0 /**Spectrum model uid is not used in PropagationLossModel*/);
   if (pathData == 0)
     {
@@ -66,6 +78,23 @@ JakesPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm + pathData->GetChannelGainDb ();
 }
 
+uint32_t
+JakesPropagationLossModel::GetTableOffset (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const
+{
+  /// Links are supposed to be symmetrical!
+  LinkId key = LinkId (std::min (a, b), std::max (a, b));
+  std::map<LinkId, uint32_t>::const_iterator it = m_tableOffsets.find (key);
+  if (it != m_tableOffsets.end ())
+    {
+      return it->second;
+    }
+  // Map the uniform variable from [-PI, PI) onto [0, NumberOfSamples)
+  double u = (m_uniformVariable->GetValue () + PI) / (2 * PI);
+  uint32_t offset = static_cast<uint32_t> (u * m_fadingTable->GetNSamples ()) % m_fadingTable->GetNSamples ();
+  m_tableOffsets.insert (std::make_pair (key, offset));
+  return offset;
+}
+
 Ptr<UniformRandomVariable>
 JakesPropagationLossModel::GetUniformRandomVariable () const
 {
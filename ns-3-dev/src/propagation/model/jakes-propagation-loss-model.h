@@ -23,6 +23,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-cache.h"
 #include "ns3/jakes-process.h"
+#include "ns3/jakes-fading-table.h"
+#include <map>
 
 namespace ns3
 {
@@ -31,6 +33,12 @@ namespace ns3
  *
  * \brief a  jakes narrowband propagation model.
  * Symmetrical cache for JakesProcess
+ *
+ * By default, every pair of nodes owns a JakesProcess which sums all its
+ * oscillators on each call.  When the FadingTable attribute is set, the
+ * model instead reads the fading from the given JakesFadingTable, and only
+ * stores a random sample offset into the table for each pair of nodes.
+ * The same table may be shared by several models.
  */
 
 class JakesPropagationLossModel : public PropagationLossModel
@@ -53,6 +61,18 @@ private:
   Ptr<UniformRandomVariable> m_uniformVariable;
 private:
   mutable PropagationCache<JakesProcess> m_propagationCache;
+
+  /// Symmetrical identifier of a link: the pair is ordered by pointer value
+  typedef std::pair<Ptr<const MobilityModel>, Ptr<const MobilityModel> > LinkId;
+  /**
+   * \param a the mobility model of one end of the link
+   * \param b the mobility model of the other end of the link
+   * \returns the sample offset of the link into m_fadingTable
+   */
+  uint32_t GetTableOffset (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const;
+
+  Ptr<JakesFadingTable> m_fadingTable;
+  mutable std::map<LinkId, uint32_t> m_tableOffsets;
 };
 
 } // namespace ns3
@@ -22,6 +22,9 @@
 #include "ns3/config.h"
 #include "ns3/double.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/jakes-propagation-loss-model.h"
+#include "ns3/pointer.h"
+#include "ns3/uinteger.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/simulator.h"
 
@@ -436,6 +439,68 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class JakesFadingTablePropagationLossModelTestCase : public TestCase
+{
+public:
+  JakesFadingTablePropagationLossModelTestCase ();
+  virtual ~JakesFadingTablePropagationLossModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void CheckSymmetry (Ptr<PropagationLossModel> loss, Ptr<MobilityModel> a, Ptr<MobilityModel> b);
+};
+
+JakesFadingTablePropagationLossModelTestCase::JakesFadingTablePropagationLossModelTestCase ()
+  : TestCase ("Test JakesPropagationLossModel with a precomputed JakesFadingTable")
+{
+}
+
+JakesFadingTablePropagationLossModelTestCase::~JakesFadingTablePropagationLossModelTestCase ()
+{
+}
+
+void
+JakesFadingTablePropagationLossModelTestCase::CheckSymmetry (Ptr<PropagationLossModel> loss, Ptr<MobilityModel> a, Ptr<MobilityModel> b)
+{
+  NS_TEST_EXPECT_MSG_EQ (loss->CalcRxPower (0, a, b), loss->CalcRxPower (0, b, a), "Link a <-> b is not symmetrical");
+}
+
+void
+JakesFadingTablePropagationLossModelTestCase::DoRun (void)
+{
+  uint32_t nSamples = 20000;
+  Time interval = MicroSeconds (500);
+  Ptr<JakesFadingTable> table = CreateObject<JakesFadingTable> ();
+  table->SetAttribute ("NumberOfSamples", UintegerValue (nSamples));
+  table->SetAttribute ("SamplingInterval", TimeValue (interval));
+  table->AssignStreams (1);
+
+  // The time average of the sum-of-sinusoids power gain is unity
+  double sum = 0;
+  for (uint32_t i = 0; i < nSamples; ++i)
+    {
+      sum += std::pow (10.0, table->GetChannelGainDb (0, interval * i) / 10.0);
+    }
+  NS_TEST_EXPECT_MSG_EQ_TOL (sum / nSamples, 1.0, 0.1, "Mean power gain of the table is not unity");
+
+  // Offsets wrap around the table, and gains are interpolated between samples
+  NS_TEST_EXPECT_MSG_EQ (table->GetChannelGainDb (5, Seconds (0)), table->GetChannelGainDb (0, interval * (nSamples + 5)), "Table is not circular");
+  double first = table->GetChannelGainDb (7, Seconds (0));
+  double second = table->GetChannelGainDb (8, Seconds (0));
+  double middle = table->GetChannelGainDb (7, interval / 2);
+  NS_TEST_EXPECT_MSG_EQ_TOL (middle, (first + second) / 2, 1e-6, "Gain is not interpolated between samples");
+
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<JakesPropagationLossModel> loss = CreateObject<JakesPropagationLossModel> ();
+  loss->SetAttribute ("FadingTable", PointerValue (table));
+  loss->AssignStreams (2);
+  Simulator::Schedule (Seconds (0), &JakesFadingTablePropagationLossModelTestCase::CheckSymmetry, this, loss, a, b);
+  Simulator::Schedule (Seconds (1.23456), &JakesFadingTablePropagationLossModelTestCase::CheckSymmetry, this, loss, a, b);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -450,6 +515,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new JakesFadingTablePropagationLossModelTestCase, TestCase::QUICK);
 }
 
 static PropagationLossModelsTestSuite propagationLossModelsTestSuite;
@@ -0,0 +1,264 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "parameter-sweep.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/process-pool.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include <sstream>
+#include <iostream>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE ("ParameterSweep");
+
+namespace ns3 {
+
+/**
+ * \param s a string
+ * \param separator a separator
+ * \return the parts of the string between the separators
+ */
+static std::vector<std::string>
+Split (std::string const &s, char separator)
+{
+  std::vector<std::string> parts;
+  std::string::size_type start = 0;
+  while (true)
+    {
+      std::string::size_type end = s.find (separator, start);
+      parts.push_back (s.substr (start, end - start));
+      if (end == std::string::npos)
+        {
+          return parts;
+        }
+      start = end + 1;
+    }
+}
+
+/**
+ * Take or release the lock of a file. The lock belongs to the process,
+ * so that it is released if the process dies while holding it.
+ *
+ * \param fd the file
+ * \param type F_WRLCK to take the lock, F_UNLCK to release it
+ */
+static void
+LockFile (int fd, short type)
+{
+  struct flock lock;
+  std::memset (&lock, 0, sizeof (lock));
+  lock.l_type = type;
+  lock.l_whence = SEEK_SET;
+  while (::fcntl (fd, F_SETLKW, &lock) < 0)
+    {
+      NS_ABORT_MSG_IF (errno != EINTR, "ParameterSweep::Run(): fcntl() failed: " << std::strerror (errno));
+    }
+}
+
+ParameterSweep::ParameterSweep ()
+  : m_parallel (1),
+    m_experiment ("sweep"),
+    m_strategy ("default")
+{
+  NS_LOG_FUNCTION (this);
+  long processors = ::sysconf (_SC_NPROCESSORS_ONLN);
+  if (processors > 0)
+    {
+      m_parallel = processors;
+    }
+}
+
+void
+ParameterSweep::AddCommandLine (CommandLine &cmd)
+{
+  NS_LOG_FUNCTION (this << &cmd);
+  cmd.AddValue ("sweep", "Parameters to sweep, as Name=value,value;Name=value,value", m_sweepArgument);
+  cmd.AddValue ("runs", "Range of RngRun values to sweep, as first:last", m_runsArgument);
+  cmd.AddValue ("parallel", "Maximum number of simulations running at the same time", m_parallel);
+}
+
+void
+ParameterSweep::AddParameter (std::string name, std::string values)
+{
+  NS_LOG_FUNCTION (this << name << values);
+  m_parameters.push_back (std::make_pair (name, Split (values, ',')));
+}
+
+void
+ParameterSweep::AddRuns (uint32_t first, uint32_t last)
+{
+  NS_LOG_FUNCTION (this << first << last);
+  NS_ABORT_MSG_IF (first > last, "Empty range of runs " << first << ":" << last);
+  std::vector<std::string> runs;
+  for (uint32_t run = first; run <= last; run++)
+    {
+      std::ostringstream oss;
+      oss << run;
+      runs.push_back (oss.str ());
+    }
+  m_parameters.push_back (std::make_pair (std::string ("RngRun"), runs));
+}
+
+void
+ParameterSweep::SetParallel (uint32_t parallel)
+{
+  NS_LOG_FUNCTION (this << parallel);
+  m_parallel = parallel;
+}
+
+void
+ParameterSweep::SetOutput (Ptr<DataOutputInterface> output)
+{
+  NS_LOG_FUNCTION (this << output);
+  m_output = output;
+}
+
+void
+ParameterSweep::SetExperiment (std::string experiment, std::string strategy)
+{
+  NS_LOG_FUNCTION (this << experiment << strategy);
+  m_experiment = experiment;
+  m_strategy = strategy;
+}
+
+uint32_t
+ParameterSweep::GetNPoints (void) const
+{
+  uint32_t points = 1;
+  for (uint32_t i = 0; i < m_parameters.size (); i++)
+    {
+      points *= m_parameters[i].second.size ();
+    }
+  return points;
+}
+
+void
+ParameterSweep::ParseCommandLine (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_sweepArgument.empty ())
+    {
+      std::vector<std::string> parameters = Split (m_sweepArgument, ';');
+      for (uint32_t i = 0; i < parameters.size (); i++)
+        {
+          std::string::size_type equal = parameters[i].find ('=');
+          NS_ABORT_MSG_IF (equal == std::string::npos, "Invalid parameter \"" << parameters[i] << "\" in --sweep");
+          AddParameter (parameters[i].substr (0, equal), parameters[i].substr (equal + 1));
+        }
+      m_sweepArgument.clear ();
+    }
+  if (!m_runsArgument.empty ())
+    {
+      uint32_t first;
+      uint32_t last;
+      char colon;
+      std::istringstream iss (m_runsArgument);
+      iss >> first >> colon >> last;
+      NS_ABORT_MSG_IF (iss.fail () || colon != ':', "Invalid range \"" << m_runsArgument << "\" in --runs");
+      AddRuns (first, last);
+      m_runsArgument.clear ();
+    }
+}
+
+void
+ParameterSweep::SetPoint (uint32_t point, DataCollector &dc)
+{
+  NS_LOG_FUNCTION (this << point);
+  std::ostringstream input;
+  bool reseed = false;
+  uint32_t index = point;
+  for (uint32_t i = 0; i < m_parameters.size (); i++)
+    {
+      std::string const &name = m_parameters[i].first;
+      std::vector<std::string> const &values = m_parameters[i].second;
+      std::string const &value = values[index % values.size ()];
+      index /= values.size ();
+
+      if (name[0] == '/')
+        {
+          Config::Set (name, StringValue (value));
+        }
+      else if (Config::SetGlobalFailSafe (name, StringValue (value)))
+        {
+          reseed = reseed || name == "RngRun" || name == "RngSeed";
+        }
+      else if (!Config::SetDefaultFailSafe (name, StringValue (value)))
+        {
+          NS_FATAL_ERROR ("Cannot set parameter " << name << " to " << value);
+        }
+      input << (i > 0 ? ";" : "") << name << "=" << value;
+      dc.AddMetadata (name, value);
+    }
+  if (reseed)
+    {
+      RandomVariableStream::ResetAllStreams ();
+    }
+  std::ostringstream run;
+  run << point;
+  dc.DescribeRun (m_experiment, m_strategy, input.str (), run.str ());
+}
+
+uint32_t
+ParameterSweep::Run (Callback<void, DataCollector &> simulate)
+{
+  NS_LOG_FUNCTION (this);
+  ParseCommandLine ();
+  NS_ABORT_MSG_IF (m_parallel == 0, "At least one simulation must run at a time");
+
+  // The lock of this anonymous file is the permission to write to the
+  // output, so that the workers write one at a time.
+  char lockName[] = "/tmp/ns-3-sweep-XXXXXX";
+  int lock = ::mkstemp (lockName);
+  NS_ABORT_MSG_IF (lock < 0, "ParameterSweep::Run(): mkstemp() failed: " << std::strerror (errno));
+  ::unlink (lockName);
+
+  ProcessPool pool (m_parallel);
+  for (uint32_t point = 0; point < GetNPoints (); point++)
+    {
+      pid_t pid = pool.Fork ();
+      if (pid == 0)
+        {
+          DataCollector dc;
+          SetPoint (point, dc);
+          simulate (dc);
+          if (m_output != 0)
+            {
+              LockFile (lock, F_WRLCK);
+              m_output->Output (dc);
+              LockFile (lock, F_UNLCK);
+            }
+          Simulator::Destroy ();
+          std::cout.flush ();
+          std::cerr.flush ();
+          std::fflush (0);
+          ::_exit (0);
+        }
+      NS_LOG_INFO ("Point " << point << " runs in process " << pid);
+    }
+  pool.Wait ();
+  ::close (lock);
+  return pool.GetNFailed ();
+}
+
+} // namespace ns3
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include "ns3/callback.h"
+#include "ns3/command-line.h"
+#include "ns3/ptr.h"
+#include "ns3/data-collector.h"
+#include "ns3/data-output-interface.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ *
+ * \brief Run a simulation for every point of a parameter space, in
+ * parallel worker processes forked from a common topology.
+ *
+ * The script builds its topology once, then calls Run with a callback
+ * which runs the simulation and adds its results to a DataCollector. For
+ * each point of the parameter space, the sweep forks a worker process,
+ * which shares the memory of the topology with the others until it
+ * modifies it, sets the parameters of the point, calls the callback and
+ * writes the collector to the DataOutputInterface of the sweep. The
+ * workers write their output one at a time, so that all the points can
+ * share a single output, such as a SqliteDataOutput database.
+ *
+ * A parameter is set, in this order of preference, as
+ * - an attribute of the existing objects, if its name is a path starting
+ *   with "/", see Config::Set;
+ * - a global value, such as "RngRun", see Config::SetGlobal;
+ * - a default attribute value, for the objects created afterwards, see
+ *   Config::SetDefault.
+ *
+ * If a point changes "RngRun" or "RngSeed", the random variables already
+ * created are restarted with the new run (see
+ * RandomVariableStream::ResetAllStreams), so that a worker draws the
+ * same values as a separate process run with --RngRun, provided that
+ * the construction of the topology draws no random value.
+ *
+ * The parameter space can also be given on the command line:
+ * \code
+ *   ./waf --run "my-script --sweep=ns3::OnOffApplication::DataRate=1Mbps,2Mbps --runs=1:10 --parallel=4"
+ * \endcode
+ *
+ * The workers exit without returning from Run, and without running the
+ * destructors of static objects; Run only returns in the parent process.
+ */
+class ParameterSweep
+{
+public:
+  ParameterSweep ();
+
+  /**
+   * Add the --sweep, --runs and --parallel arguments to a command line.
+   * They are applied when Run is called.
+   *
+   * \param cmd the command line
+   */
+  void AddCommandLine (CommandLine &cmd);
+
+  /**
+   * \param name the name of the parameter
+   * \param values the values of the parameter, separated by commas
+   */
+  void AddParameter (std::string name, std::string values);
+
+  /**
+   * Sweep the "RngRun" global value over a range.
+   *
+   * \param first the first run number
+   * \param last the last run number, included
+   */
+  void AddRuns (uint32_t first, uint32_t last);
+
+  /**
+   * \param parallel the maximum number of workers running at the same
+   *        time. Defaults to the number of processors.
+   */
+  void SetParallel (uint32_t parallel);
+
+  /**
+   * \param output the output of the data collectors of the workers
+   */
+  void SetOutput (Ptr<DataOutputInterface> output);
+
+  /**
+   * \param experiment the experiment label of the data collectors
+   * \param strategy the strategy label of the data collectors
+   */
+  void SetExperiment (std::string experiment, std::string strategy);
+
+  /**
+   * \return the number of points of the parameter space
+   */
+  uint32_t GetNPoints (void) const;
+
+  /**
+   * Run a worker for each point of the parameter space, and wait for
+   * them to exit.
+   *
+   * \param simulate called in each worker to run the simulation and add
+   *        its results to the data collector, which already holds the
+   *        parameters of the point as metadata.
+   * \return the number of workers which failed
+   */
+  uint32_t Run (Callback<void, DataCollector &> simulate);
+
+private:
+  /**
+   * Parse the arguments given on the command line.
+   */
+  void ParseCommandLine (void);
+
+  /**
+   * Set the parameters of a point, and describe it in a data collector.
+   *
+   * \param point the index of the point
+   * \param dc the data collector
+   */
+  void SetPoint (uint32_t point, DataCollector &dc);
+
+  /// The names and values of the parameters
+  std::vector<std::pair<std::string, std::vector<std::string> > > m_parameters;
+  uint32_t m_parallel;                  //!< Maximum number of workers running
+  Ptr<DataOutputInterface> m_output;    //!< Output of the data collectors
+  std::string m_experiment;             //!< Experiment label
+  std::string m_strategy;               //!< Strategy label
+  std::string m_sweepArgument;          //!< Value of --sweep
+  std::string m_runsArgument;           //!< Value of --runs
+};
+
+} // namespace ns3
+
+#endif /* PARAMETER_SWEEP_H */
@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <cstdio>
+#include <unistd.h>
+
+#include "ns3/test.h"
+#include "ns3/parameter-sweep.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/double.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup stats
+ *
+ * \brief Append the metadata of the data collectors to a text file
+ */
+class LineDataOutput : public DataOutputInterface
+{
+public:
+  virtual void Output (DataCollector &dc)
+  {
+    std::ofstream os (m_filePrefix.c_str (), std::ios::app);
+    os << dc.GetRunLabel ();
+    for (MetadataList::iterator i = dc.MetadataBegin (); i != dc.MetadataEnd (); ++i)
+      {
+        os << " " << i->first << " " << i->second;
+      }
+    os << std::endl;
+  }
+};
+
+/**
+ * \ingroup stats
+ *
+ * \brief Append the run labels to a text file, but kill the worker of
+ * one point while it writes its output
+ */
+class DyingDataOutput : public DataOutputInterface
+{
+public:
+  virtual void Output (DataCollector &dc)
+  {
+    if (dc.GetRunLabel () == "1")
+      {
+        _exit (1);
+      }
+    std::ofstream os (m_filePrefix.c_str (), std::ios::app);
+    os << dc.GetRunLabel () << std::endl;
+  }
+};
+
+/**
+ * \ingroup stats
+ *
+ * \brief Check that the workers of a sweep run all the points, with the
+ * random values of their run.
+ */
+class ParameterSweepTestCase : public TestCase
+{
+public:
+  ParameterSweepTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /// Draw values from the random variable of the topology and from a new one
+  void Simulate (DataCollector &dc);
+
+  Ptr<UniformRandomVariable> m_random; //!< Random variable created before the sweep
+  Ptr<NormalRandomVariable> m_normal; //!< Random variable drawn from before the sweep
+};
+
+ParameterSweepTestCase::ParameterSweepTestCase ()
+  : TestCase ("Check that the workers of ParameterSweep run all the points")
+{
+}
+
+void
+ParameterSweepTestCase::Simulate (DataCollector &dc)
+{
+  dc.AddMetadata ("x", m_random->GetValue ());
+  Ptr<UniformRandomVariable> y = CreateObject<UniformRandomVariable> ();
+  dc.AddMetadata ("y", y->GetValue ());
+  dc.AddMetadata ("z", m_normal->GetValue ());
+}
+
+void
+ParameterSweepTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("parameter-sweep.txt");
+  uint32_t run = RngSeedManager::GetRun ();
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (7);
+  // the normal values are drawn in pairs: keep the second one of the
+  // parent's run cached when the sweep starts
+  m_normal = CreateObject<NormalRandomVariable> ();
+  m_normal->SetStream (8);
+  m_normal->GetValue ();
+
+  Ptr<LineDataOutput> output = CreateObject<LineDataOutput> ();
+  output->SetFilePrefix (filename);
+  ParameterSweep sweep;
+  sweep.AddParameter ("ns3::UniformRandomVariable::Max", "2,4");
+  sweep.AddRuns (1, 3);
+  sweep.SetParallel (2);
+  sweep.SetOutput (output);
+  NS_TEST_ASSERT_MSG_EQ (sweep.GetNPoints (), 6, "The sweep must have 6 points");
+  uint32_t failed = sweep.Run (MakeCallback (&ParameterSweepTestCase::Simulate, this));
+  NS_TEST_ASSERT_MSG_EQ (failed, 0, "No worker must fail");
+  NS_TEST_EXPECT_MSG_EQ (RngSeedManager::GetRun (), run, "The sweep must not change the run of the parent");
+
+  std::ifstream is (filename.c_str ());
+  std::map<uint32_t, std::string> lines;
+  std::string line;
+  while (std::getline (is, line))
+    {
+      uint32_t point;
+      std::istringstream (line) >> point;
+      lines[point] = line;
+    }
+  is.close ();
+  std::remove (filename.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (lines.size (), 6, "All the points must be output");
+
+  for (uint32_t point = 0; point < 6; point++)
+    {
+      std::istringstream iss (lines[point]);
+      uint32_t label, pointRun;
+      double max, x, y, z;
+      std::string maxKey, runKey, xKey, yKey, zKey;
+      iss >> label >> maxKey >> max >> runKey >> pointRun >> xKey >> x >> yKey >> y >> zKey >> z;
+      NS_TEST_ASSERT_MSG_EQ (iss.fail (), false, "Cannot parse the output of point " << point);
+      NS_TEST_EXPECT_MSG_EQ (max, (point % 2 == 0 ? 2 : 4), "Wrong Max for point " << point);
+      NS_TEST_EXPECT_MSG_EQ (pointRun, 1 + point / 2, "Wrong run for point " << point);
+      NS_TEST_EXPECT_MSG_EQ ((y >= 0 && y <= max), true, "The default value of point " << point << " was not set");
+
+      // the random variable of the topology restarts with the run of the point
+      RngSeedManager::SetRun (pointRun);
+      Ptr<UniformRandomVariable> expected = CreateObject<UniformRandomVariable> ();
+      expected->SetStream (7);
+      double value = expected->GetValue ();
+      NS_TEST_EXPECT_MSG_EQ_TOL (x, value, 1e-5, "Wrong random value for point " << point);
+      Ptr<NormalRandomVariable> expectedNormal = CreateObject<NormalRandomVariable> ();
+      expectedNormal->SetStream (8);
+      value = expectedNormal->GetValue ();
+      NS_TEST_EXPECT_MSG_EQ_TOL (z, value, 1e-4, "Wrong normal value for point " << point);
+    }
+  RngSeedManager::SetRun (run);
+}
+
+/**
+ * \ingroup stats
+ *
+ * \brief Check that the other workers still write their output when a
+ * worker dies while writing its own.
+ */
+class ParameterSweepFailureTestCase : public TestCase
+{
+public:
+  ParameterSweepFailureTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /// Do nothing
+  void Simulate (DataCollector &dc);
+};
+
+ParameterSweepFailureTestCase::ParameterSweepFailureTestCase ()
+  : TestCase ("Check that a worker dying while writing its output does not block the others")
+{
+}
+
+void
+ParameterSweepFailureTestCase::Simulate (DataCollector &dc)
+{
+}
+
+void
+ParameterSweepFailureTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("parameter-sweep-failure.txt");
+  uint32_t run = RngSeedManager::GetRun ();
+  Ptr<DyingDataOutput> output = CreateObject<DyingDataOutput> ();
+  output->SetFilePrefix (filename);
+  ParameterSweep sweep;
+  sweep.AddRuns (1, 4);
+  sweep.SetParallel (2);
+  sweep.SetOutput (output);
+  uint32_t failed = sweep.Run (MakeCallback (&ParameterSweepFailureTestCase::Simulate, this));
+  NS_TEST_EXPECT_MSG_EQ (failed, 1, "Exactly one worker must fail");
+
+  std::ifstream is (filename.c_str ());
+  uint32_t lines = 0;
+  std::string line;
+  while (std::getline (is, line))
+    {
+      lines++;
+    }
+  is.close ();
+  std::remove (filename.c_str ());
+  NS_TEST_EXPECT_MSG_EQ (lines, 3, "The other points must be output");
+  RngSeedManager::SetRun (run);
+}
+
+/**
+ * \ingroup stats
+ *
+ * \brief ParameterSweep TestSuite
+ */
+class ParameterSweepTestSuite : public TestSuite
+{
+public:
+  ParameterSweepTestSuite ();
+};
+
+ParameterSweepTestSuite::ParameterSweepTestSuite ()
+  : TestSuite ("parameter-sweep", UNIT)
+{
+  AddTestCase (new ParameterSweepTestCase, TestCase::QUICK);
+  AddTestCase (new ParameterSweepFailureTestCase, TestCase::QUICK);
+}
+
+static ParameterSweepTestSuite g_parameterSweepTestSuite;
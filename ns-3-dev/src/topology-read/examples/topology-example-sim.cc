@@ -115,36 +115,23 @@ int main (int argc, char *argv[])
   Ipv4AddressHelper address;
   address.SetBase ("10.0.0.0", "255.255.255.252");
 
-  int totlinks = inFile->LinksSize ();
-
-  NS_LOG_INFO ("creating node containers");
-  NodeContainer* nc = new NodeContainer[totlinks];
-  TopologyReader::ConstLinksIterator iter;
-  int i = 0;
-  for ( iter = inFile->LinksBegin (); iter != inFile->LinksEnd (); iter++, i++ )
-    {
-      nc[i] = NodeContainer (iter->GetFromNode (), iter->GetToNode ());
-    }
-
-  NS_LOG_INFO ("creating net device containers");
-  NetDeviceContainer* ndc = new NetDeviceContainer[totlinks];
+  // The links are created and numbered in a single pass: large
+  // topologies have too many links to keep a container per link.
+  NS_LOG_INFO ("creating net devices and ipv4 interfaces");
   PointToPointHelper p2p;
-  for (int i = 0; i < totlinks; i++)
-    {
-      // p2p.SetChannelAttribute ("Delay", TimeValue(MilliSeconds(weight[i])));
-      p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
-      p2p.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
-      ndc[i] = p2p.Install (nc[i]);
-    }
-
-  // it crates little subnets, one for each couple of nodes.
-  NS_LOG_INFO ("creating ipv4 interfaces");
-  Ipv4InterfaceContainer* ipic = new Ipv4InterfaceContainer[totlinks];
-  for (int i = 0; i < totlinks; i++)
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
+  NetDeviceContainer devices;
+  TopologyReader::ConstLinksIterator iter;
+  for ( iter = inFile->LinksBegin (); iter != inFile->LinksEnd (); iter++ )
     {
-      ipic[i] = address.Assign (ndc[i]);
+      // it creates little subnets, one for each couple of nodes.
+      NetDeviceContainer link = p2p.Install (iter->GetFromNode (), iter->GetToNode ());
+      address.Assign (link);
       address.NewNetwork ();
+      devices.Add (link);
     }
+  NS_LOG_INFO ("created " << devices.GetN () / 2 << " links");
 
 
   uint32_t totalNodes = nodes.GetN ();
@@ -199,10 +186,6 @@ int main (int argc, char *argv[])
   Simulator::Run ();
   Simulator::Destroy ();
 
-  delete[] ipic;
-  delete[] ndc;
-  delete[] nc;
-
   NS_LOG_INFO ("Done.");
 
   return 0;
@@ -19,9 +19,7 @@
  * Author: Valerio Sartini (Valesar@gmail.com)
  */
 
-#include <fstream>
 #include <cstdlib>
-#include <sstream>
 
 #include "ns3/log.h"
 
@@ -55,12 +53,11 @@ InetTopologyReader::~InetTopologyReader ()
 NodeContainer
 InetTopologyReader::Read (void)
 {
-  std::ifstream topgen;
-  topgen.open (GetFileName ().c_str ());
-  std::map<std::string, Ptr<Node> > nodeMap;
+  InputFile topgen;
+  NodeMap nodeMap;
   NodeContainer nodes;
 
-  if ( !topgen.is_open () )
+  if ( !topgen.Open (GetFileName ()) )
     {
       NS_LOG_WARN ("Inet topology file object is not open, check file name and permissions");
       return nodes;
@@ -76,54 +73,49 @@ InetTopologyReader::Read (void)
   int totnode = 0;
   int totlink = 0;
 
-  std::istringstream lineBuffer;
-  std::string line;
+  const char *begin;
+  const char *end;
+  std::string token;
 
-  getline (topgen,line);
-  lineBuffer.str (line);
-
-  lineBuffer >> totnode;
-  lineBuffer >> totlink;
+  if (topgen.GetLine (begin, end))
+    {
+      if (InputFile::GetToken (begin, end, token))
+        {
+          totnode = std::atoi (token.c_str ());
+        }
+      if (InputFile::GetToken (begin, end, token))
+        {
+          totlink = std::atoi (token.c_str ());
+        }
+    }
   NS_LOG_INFO ("Inet topology should have " << totnode << " nodes and " << totlink << " links");
 
-  for (int i = 0; i < totnode && !topgen.eof (); i++)
+  // Skip the node coordinates
+  for (int i = 0; i < totnode; i++)
     {
-      getline (topgen,line);
+      if (!topgen.GetLine (begin, end))
+        {
+          break;
+        }
     }
 
-  for (int i = 0; i < totlink && !topgen.eof (); i++)
+  for (int i = 0; i < totlink && topgen.GetLine (begin, end); i++)
     {
-      getline (topgen,line);
-      lineBuffer.clear ();
-      lineBuffer.str (line);
-
-      lineBuffer >> from;
-      lineBuffer >> to;
-      lineBuffer >> linkAttr;
+      from.clear ();
+      to.clear ();
+      linkAttr.clear ();
+      InputFile::GetToken (begin, end, from);
+      InputFile::GetToken (begin, end, to);
+      InputFile::GetToken (begin, end, linkAttr);
 
       if ( (!from.empty ()) && (!to.empty ()) )
         {
           NS_LOG_INFO ( "Link " << linksNumber << " from: " << from << " to: " << to);
 
-          if ( nodeMap[from] == 0 )
-            {
-              NS_LOG_INFO ( "Node " << nodesNumber << " name: " << from);
-              Ptr<Node> tmpNode = CreateObject<Node> ();
-              nodeMap[from] = tmpNode;
-              nodes.Add (tmpNode);
-              nodesNumber++;
-            }
-
-          if (nodeMap[to] == 0)
-            {
-              NS_LOG_INFO ( "Node " << nodesNumber << " name: " << to);
-              Ptr<Node> tmpNode = CreateObject<Node> ();
-              nodeMap[to] = tmpNode;
-              nodes.Add (tmpNode);
-              nodesNumber++;
-            }
+          Ptr<Node> fromNode = FindOrCreateNode (nodeMap, from, nodes, nodesNumber);
+          Ptr<Node> toNode = FindOrCreateNode (nodeMap, to, nodes, nodesNumber);
 
-          Link link ( nodeMap[from], from, nodeMap[to], to );
+          Link link ( fromNode, from, toNode, to );
           if ( !linkAttr.empty () )
             {
               NS_LOG_INFO ( "Link " << linksNumber << " weight: " << linkAttr);
@@ -136,7 +128,6 @@ InetTopologyReader::Read (void)
     }
 
   NS_LOG_INFO ("Inet topology created with " << nodesNumber << " nodes and " << linksNumber << " links");
-  topgen.close ();
 
   return nodes;
 }
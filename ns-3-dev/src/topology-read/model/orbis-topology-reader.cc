@@ -19,10 +19,8 @@
  * Author: Valerio Sartini (valesar@gmail.com)
  */
 
-#include <fstream>
 #include <cstdlib>
 #include <iostream>
-#include <sstream>
 
 #include "ns3/log.h"
 #include "orbis-topology-reader.h"
@@ -55,63 +53,43 @@ OrbisTopologyReader::~OrbisTopologyReader ()
 NodeContainer
 OrbisTopologyReader::Read (void)
 {
-  std::ifstream topgen;
-  topgen.open (GetFileName ().c_str ());
-  std::map<std::string, Ptr<Node> > nodeMap;
+  InputFile topgen;
+  NodeMap nodeMap;
   NodeContainer nodes;
 
-  if ( !topgen.is_open () )
+  if ( !topgen.Open (GetFileName ()) )
     {
       return nodes;
     }
 
   std::string from;
   std::string to;
-  std::istringstream lineBuffer;
-  std::string line;
+  const char *begin;
+  const char *end;
 
   int linksNumber = 0;
   int nodesNumber = 0;
 
-  while (!topgen.eof ())
+  while (topgen.GetLine (begin, end))
     {
-      line.clear ();
-      lineBuffer.clear ();
       from.clear ();
       to.clear ();
-
-      getline (topgen,line);
-      lineBuffer.str (line);
-      lineBuffer >> from;
-      lineBuffer >> to;
+      InputFile::GetToken (begin, end, from);
+      InputFile::GetToken (begin, end, to);
 
       if ( (!from.empty ()) && (!to.empty ()) )
         {
           NS_LOG_INFO ( linksNumber << " From: " << from << " to: " << to );
-          if ( nodeMap[from] == 0 )
-            {
-              Ptr<Node> tmpNode = CreateObject<Node> ();
-              nodeMap[from] = tmpNode;
-              nodes.Add (tmpNode);
-              nodesNumber++;
-            }
-
-          if (nodeMap[to] == 0)
-            {
-              Ptr<Node> tmpNode = CreateObject<Node> ();
-              nodeMap[to] = tmpNode;
-              nodes.Add (tmpNode);
-              nodesNumber++;
-            }
-
-          Link link ( nodeMap[from], from, nodeMap[to], to );
+          Ptr<Node> fromNode = FindOrCreateNode (nodeMap, from, nodes, nodesNumber);
+          Ptr<Node> toNode = FindOrCreateNode (nodeMap, to, nodes, nodesNumber);
+
+          Link link ( fromNode, from, toNode, to );
           AddLink (link);
 
           linksNumber++;
         }
     }
   NS_LOG_INFO ("Orbis topology created with " << nodesNumber << " nodes and " << linksNumber << " links");
-  topgen.close ();
 
   return nodes;
 }
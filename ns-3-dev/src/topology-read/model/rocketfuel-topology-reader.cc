@@ -18,10 +18,9 @@
  * Author: Hajime Tazaki (tazaki@sfc.wide.ad.jp)
  */
 
-#include <fstream>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include <sstream>
 #include <regex.h>
 
 #include "ns3/log.h"
@@ -177,13 +176,7 @@ RocketfuelTopologyReader::GenerateFromMapsFile (int argc, char *argv[])
   // Create node and link
   if (!uid.empty ())
     {
-      if (m_nodeMap[uid] == 0)
-        {
-          Ptr<Node> tmpNode = CreateObject<Node> ();
-          m_nodeMap[uid] = tmpNode;
-          nodes.Add (tmpNode);
-          m_nodesNumber++;
-        }
+      Ptr<Node> uidNode = FindOrCreateNode (m_nodeMap, uid, nodes, m_nodesNumber);
 
       for (uint32_t i = 0; i < neigh_list.size (); ++i)
         {
@@ -194,15 +187,9 @@ RocketfuelTopologyReader::GenerateFromMapsFile (int argc, char *argv[])
               return nodes;
             }
 
-          if (m_nodeMap[nuid] == 0)
-            {
-              Ptr<Node> tmpNode = CreateObject<Node> ();
-              m_nodeMap[nuid] = tmpNode;
-              nodes.Add (tmpNode);
-              m_nodesNumber++;
-            }
+          Ptr<Node> nuidNode = FindOrCreateNode (m_nodeMap, nuid, nodes, m_nodesNumber);
           NS_LOG_INFO (m_linksNumber << ":" << m_nodesNumber << " From: " << uid << " to: " << nuid);
-          Link link (m_nodeMap[uid], uid, m_nodeMap[nuid], nuid);
+          Link link (uidNode, uid, nuidNode, nuid);
           AddLink (link);
           m_linksNumber++;
         }
@@ -235,37 +222,18 @@ RocketfuelTopologyReader::GenerateFromWeightsFile (int argc, char *argv[])
   // Create node and link
   if (!sname.empty () && !tname.empty ())
     {
-      if (m_nodeMap[sname] == 0)
-        {
-          Ptr<Node> tmpNode = CreateObject<Node> ();
-          m_nodeMap[sname] = tmpNode;
-          nodes.Add (tmpNode);
-          m_nodesNumber++;
-        }
-
-      if (m_nodeMap[tname] == 0)
-        {
-          Ptr<Node> tmpNode = CreateObject<Node> ();
-          m_nodeMap[tname] = tmpNode;
-          nodes.Add (tmpNode);
-          m_nodesNumber++;
-        }
+      Ptr<Node> sNode = FindOrCreateNode (m_nodeMap, sname, nodes, m_nodesNumber);
+      Ptr<Node> tNode = FindOrCreateNode (m_nodeMap, tname, nodes, m_nodesNumber);
       NS_LOG_INFO (m_linksNumber << ":" << m_nodesNumber << " From: " << sname << " to: " << tname);
-      TopologyReader::ConstLinksIterator iter;
-      bool found = false;
-      for (iter = LinksBegin (); iter != LinksEnd (); iter++)
-        {
-          if ((iter->GetFromNode () == m_nodeMap[tname])
-              && (iter->GetToNode () == m_nodeMap[sname]))
-            {
-              found = true;
-              break;
-            }
-        }
+
+      // Skip the link if it was already read in the opposite direction
+      bool found = m_weightsLinks.find (std::make_pair (tNode->GetId (), sNode->GetId ()))
+        != m_weightsLinks.end ();
 
       if (!found)
         {
-          Link link (m_nodeMap[sname], sname, m_nodeMap[tname], tname);
+          m_weightsLinks.insert (std::make_pair (sNode->GetId (), tNode->GetId ()));
+          Link link (sNode, sname, tNode, tname);
           AddLink (link);
           m_linksNumber++;
         }
@@ -321,87 +289,62 @@ RocketfuelTopologyReader::GetFileType (const char *line)
 NodeContainer
 RocketfuelTopologyReader::Read (void)
 {
-  std::ifstream topgen;
-  topgen.open (GetFileName ().c_str ());
+  InputFile topgen;
   NodeContainer nodes;
 
-  std::istringstream lineBuffer;
   std::string line;
+  const char *begin;
+  const char *end;
   int lineNumber = 0;
   enum RF_FileType ftype = RF_UNKNOWN;
   char errbuf[512];
+  regex_t regex;
+  bool compiled = false;
 
-  if (!topgen.is_open ())
+  if (!topgen.Open (GetFileName ()))
     {
       NS_LOG_WARN ("Couldn't open the file " << GetFileName ());
       return nodes;
     }
 
-  while (!topgen.eof ())
+  while (topgen.GetLine (begin, end))
     {
       int ret;
       int argc;
       char *argv[REGMATCH_MAX];
-      char *buf;
+      regmatch_t regmatch[REGMATCH_MAX];
 
       lineNumber++;
-      line.clear ();
-      lineBuffer.clear ();
-
-      getline (topgen, line);
-      buf = (char *)line.c_str ();
+      line.assign (begin, end);
 
       if (lineNumber == 1)
         {
-          ftype = GetFileType (buf);
+          ftype = GetFileType (line.c_str ());
           if (ftype == RF_UNKNOWN)
             {
               NS_LOG_INFO ("Unknown File Format (" << GetFileName () << ")");
               break;
             }
-        }
-
-      regmatch_t regmatch[REGMATCH_MAX];
-      regex_t regex;
 
-      if (ftype == RF_MAPS)
-        {
-          ret = regcomp (&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
+          // The same pattern matches every line of the file: compile it once
+          ret = regcomp (&regex, ftype == RF_MAPS ? ROCKETFUEL_MAPS_LINE : ROCKETFUEL_WEIGHTS_LINE,
+                         REG_EXTENDED | REG_NEWLINE);
           if (ret != 0)
             {
               regerror (ret, &regex, errbuf, sizeof (errbuf));
-              regfree (&regex);
-              break;
-            }
-
-          ret = regexec (&regex, buf, REGMATCH_MAX, regmatch, 0);
-          if (ret == REG_NOMATCH)
-            {
-              NS_LOG_WARN ("match failed (maps file): %s" << buf);
-              regfree (&regex);
+              NS_LOG_WARN ("regcomp failed: " << errbuf);
               break;
             }
+          compiled = true;
         }
-      else if (ftype == RF_WEIGHTS)
-        {
-          ret = regcomp (&regex, ROCKETFUEL_WEIGHTS_LINE, REG_EXTENDED | REG_NEWLINE);
-          if (ret != 0)
-            {
-              regerror (ret, &regex, errbuf, sizeof (errbuf));
-              regfree (&regex);
-              break;
-            }
 
-          ret = regexec (&regex, buf, REGMATCH_MAX, regmatch, 0);
-          if (ret == REG_NOMATCH)
-            {
-              NS_LOG_WARN ("match failed (weights file): %s" << buf);
-              regfree (&regex);
-              break;
-            }
+      ret = regexec (&regex, line.c_str (), REGMATCH_MAX, regmatch, 0);
+      if (ret == REG_NOMATCH)
+        {
+          NS_LOG_WARN ("match failed (" << (ftype == RF_MAPS ? "maps" : "weights") << " file): " << line);
+          break;
         }
 
-      line = buf;
       argc = 0;
 
       /* regmatch[0] is the entire strings that matched */
@@ -423,21 +366,17 @@ RocketfuelTopologyReader::Read (void)
         {
           nodes.Add (GenerateFromMapsFile (argc, argv));
         }
-      else if (ftype == RF_WEIGHTS)
-        {
-          nodes.Add (GenerateFromWeightsFile (argc, argv));
-        }
       else
         {
-          NS_LOG_WARN ("Unsupported file format (only Maps/Weights are supported)");
+          nodes.Add (GenerateFromWeightsFile (argc, argv));
         }
+    }
 
+  if (compiled)
+    {
       regfree (&regex);
     }
 
-
-  topgen.close ();
-
   return nodes;
 }
 
@@ -21,6 +21,9 @@
 #ifndef ROCKETFUEL_TOPOLOGY_READER_H
 #define ROCKETFUEL_TOPOLOGY_READER_H
 
+#include <set>
+#include <utility>
+
 #include "ns3/nstime.h"
 #include "topology-reader.h"
 
@@ -109,7 +112,8 @@ private:
 
   int m_linksNumber; //!< number of links
   int m_nodesNumber; //!< number of nodes
-  std::map<std::string, Ptr<Node> > m_nodeMap; //!< map of the nodes (name, node)
+  NodeMap m_nodeMap; //!< map of the nodes (name, node)
+  std::set<std::pair<uint32_t, uint32_t> > m_weightsLinks; //!< (from, to) node ids of the links read from a weights file
 
 private:
   /**
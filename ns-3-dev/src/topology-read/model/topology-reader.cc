@@ -19,6 +19,12 @@
  * Author: Valerio Sartini (valesar@gmail.com)
  */
 
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "ns3/log.h"
 
 #include "topology-reader.h"
@@ -94,6 +100,135 @@ TopologyReader::AddLink (Link link)
 }
 
 
+Ptr<Node>
+TopologyReader::FindOrCreateNode (NodeMap &nodeMap, const std::string &name,
+                                  NodeContainer &nodes, int &nodesNumber)
+{
+  Ptr<Node> &node = nodeMap[name];
+  if (node == 0)
+    {
+      NS_LOG_INFO ("Node " << nodesNumber << " name: " << name);
+      node = CreateObject<Node> ();
+      nodes.Add (node);
+      nodesNumber++;
+    }
+  return node;
+}
+
+size_t
+TopologyReader::NodeNameHash::operator() (const std::string &name) const
+{
+  return sgi::hash<const char *> () (name.c_str ());
+}
+
+
+TopologyReader::InputFile::InputFile ()
+  : m_data (0),
+    m_size (0),
+    m_position (0),
+    m_mapped (false)
+{
+}
+
+TopologyReader::InputFile::~InputFile ()
+{
+  Close ();
+}
+
+bool
+TopologyReader::InputFile::Open (const std::string &fileName)
+{
+  Close ();
+  int fd = open (fileName.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      return false;
+    }
+  struct stat st;
+  if (fstat (fd, &st) == 0 && st.st_size > 0)
+    {
+      void *data = mmap (0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED)
+        {
+          madvise (data, st.st_size, MADV_SEQUENTIAL);
+          m_data = static_cast<const char *> (data);
+          m_size = st.st_size;
+          m_mapped = true;
+          close (fd);
+          return true;
+        }
+    }
+  // Not a regular file, or mmap is not supported: read it in one buffer
+  char chunk[65536];
+  ssize_t n;
+  while ((n = read (fd, chunk, sizeof (chunk))) > 0)
+    {
+      m_buffer.insert (m_buffer.end (), chunk, chunk + n);
+    }
+  close (fd);
+  if (n < 0)
+    {
+      m_buffer.clear ();
+      return false;
+    }
+  m_data = m_buffer.empty () ? 0 : &m_buffer[0];
+  m_size = m_buffer.size ();
+  return true;
+}
+
+void
+TopologyReader::InputFile::Close (void)
+{
+  if (m_mapped)
+    {
+      munmap (const_cast<char *> (m_data), m_size);
+    }
+  std::vector<char> ().swap (m_buffer);
+  m_data = 0;
+  m_size = 0;
+  m_position = 0;
+  m_mapped = false;
+}
+
+bool
+TopologyReader::InputFile::GetLine (const char *&begin, const char *&end)
+{
+  if (m_position >= m_size)
+    {
+      return false;
+    }
+  begin = m_data + m_position;
+  const char *newline = static_cast<const char *> (memchr (begin, '\n', m_size - m_position));
+  end = newline ? newline : m_data + m_size;
+  m_position = end - m_data + 1;
+  if (end > begin && *(end - 1) == '\r')
+    {
+      --end;
+    }
+  return true;
+}
+
+bool
+TopologyReader::InputFile::GetToken (const char *&cursor, const char *end, std::string &token)
+{
+  while (cursor < end && (*cursor == ' ' || *cursor == '\t'))
+    {
+      ++cursor;
+    }
+  if (cursor == end)
+    {
+      return false;
+    }
+  const char *start = cursor;
+  while (cursor < end && *cursor != ' ' && *cursor != '\t')
+    {
+      ++cursor;
+    }
+  token.assign (start, cursor);
+  return true;
+}
+
+
 TopologyReader::Link::Link ( Ptr<Node> fromPtr, const std::string &fromName, Ptr<Node> toPtr, const std::string &toName )
 {
   m_fromPtr = fromPtr;
@@ -25,9 +25,11 @@
 #include <string>
 #include <map>
 #include <list>
+#include <vector>
 
 #include "ns3/object.h"
 #include "ns3/node-container.h"
+#include "ns3/sgi-hashmap.h"
 
 
 namespace ns3 {
@@ -199,6 +201,96 @@ private:
    */
   void AddLink (Link link);
 
+protected:
+  /**
+   * \brief Read-only view of an input file, scanned line by line.
+   *
+   * The file is mapped in memory when possible, or else read in a single
+   * buffer, so that large topology files are parsed without a stream
+   * extraction nor a string copy for each line.
+   */
+  class InputFile
+  {
+public:
+    InputFile ();
+    ~InputFile ();
+
+    /**
+     * \brief Opens a file.
+     * \param fileName the name of the file
+     * \return true if the file could be opened
+     */
+    bool Open (const std::string &fileName);
+    /**
+     * \brief Gets the next line of the file.
+     * \param begin set to the first character of the line
+     * \param end set past the last character of the line, end of line excluded
+     * \return false if the end of the file was reached
+     */
+    bool GetLine (const char *&begin, const char *&end);
+    /**
+     * \brief Extracts the next blank-separated token of a line.
+     * \param cursor the position in the line, moved past the token
+     * \param end the end of the line
+     * \param token the token found
+     * \return false if there is no more token on the line
+     */
+    static bool GetToken (const char *&cursor, const char *end, std::string &token);
+
+private:
+    /**
+     * \brief Copy constructor
+     *
+     * Defined and unimplemented to avoid misuse
+     */
+    InputFile (const InputFile&);
+    /**
+     * \brief Copy constructor
+     *
+     * Defined and unimplemented to avoid misuse
+     * \returns
+     */
+    InputFile& operator= (const InputFile&);
+    /**
+     * \brief Releases the contents of the file.
+     */
+    void Close (void);
+
+    const char *m_data;         //!< Contents of the file
+    size_t m_size;              //!< Size of the file
+    size_t m_position;          //!< Start of the next line
+    bool m_mapped;              //!< True if the file is mapped in memory
+    std::vector<char> m_buffer; //!< Contents of the file, when it could not be mapped
+  };
+
+  /**
+   * \brief Hash function for the node names.
+   */
+  struct NodeNameHash
+  {
+    /**
+     * \param name a node name
+     * \return the hash of the name
+     */
+    size_t operator() (const std::string &name) const;
+  };
+
+  /**
+   * \brief Nodes indexed by their name in the topology file.
+   */
+  typedef sgi::hash_map<std::string, Ptr<Node>, NodeNameHash> NodeMap;
+
+  /**
+   * \brief Returns the node with a given name, creating it if needed.
+   * \param nodeMap the nodes already created
+   * \param name the name of the node
+   * \param nodes the container the node is added to, if created
+   * \param nodesNumber the number of nodes created, incremented if the node is created
+   * \return the node
+   */
+  static Ptr<Node> FindOrCreateNode (NodeMap &nodeMap, const std::string &name,
+                                     NodeContainer &nodes, int &nodesNumber);
+
 private:
 
   /**
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//-----------------------------------------------------------------------------
+// Unit tests
+//-----------------------------------------------------------------------------
+
+#include <fstream>
+#include <cstdio>
+
+#include "ns3/test.h"
+#include "ns3/inet-topology-reader.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup topology
+ *
+ * \brief Check the line and token reader of TopologyReader on the line
+ * endings and sizes which the topology files may have.
+ */
+class TopologyReaderInputFileTest : public TestCase
+{
+public:
+  TopologyReaderInputFileTest ();
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Reads an Inet topology from the given contents.
+   * \param contents the contents of the topology file
+   * \param nodes set to the nodes read
+   * \return the reader, holding the links read
+   */
+  Ptr<InetTopologyReader> Read (const std::string &contents, NodeContainer &nodes);
+  /**
+   * \brief Checks the nodes and links of a topology with the links 0-1 and 1-2.
+   * \param contents the contents of the topology file
+   * \param description the description of the contents, for the messages
+   */
+  void CheckTopology (const std::string &contents, const std::string &description);
+};
+
+TopologyReaderInputFileTest::TopologyReaderInputFileTest ()
+  : TestCase ("Check the line endings and the end of the topology files")
+{
+}
+
+Ptr<InetTopologyReader>
+TopologyReaderInputFileTest::Read (const std::string &contents, NodeContainer &nodes)
+{
+  std::string filename = CreateTempDirFilename ("topology.txt");
+  std::ofstream os (filename.c_str (), std::ios::binary);
+  os << contents;
+  os.close ();
+
+  Ptr<InetTopologyReader> reader = CreateObject<InetTopologyReader> ();
+  reader->SetFileName (filename);
+  nodes = reader->Read ();
+  std::remove (filename.c_str ());
+  return reader;
+}
+
+void
+TopologyReaderInputFileTest::CheckTopology (const std::string &contents, const std::string &description)
+{
+  NodeContainer nodes;
+  Ptr<InetTopologyReader> reader = Read (contents, nodes);
+  NS_TEST_ASSERT_MSG_EQ (nodes.GetN (), 3, "Wrong number of nodes with " << description);
+  NS_TEST_ASSERT_MSG_EQ (reader->LinksSize (), 2, "Wrong number of links with " << description);
+
+  TopologyReader::ConstLinksIterator link = reader->LinksBegin ();
+  NS_TEST_EXPECT_MSG_EQ (link->GetFromNodeName (), "0", "Wrong first node with " << description);
+  NS_TEST_EXPECT_MSG_EQ (link->GetToNodeName (), "1", "Wrong first node with " << description);
+  NS_TEST_EXPECT_MSG_EQ (link->GetAttribute ("Weight"), "10", "Wrong first weight with " << description);
+  ++link;
+  NS_TEST_EXPECT_MSG_EQ (link->GetFromNodeName (), "1", "Wrong last node with " << description);
+  NS_TEST_EXPECT_MSG_EQ (link->GetToNodeName (), "2", "Wrong last node with " << description);
+  NS_TEST_EXPECT_MSG_EQ (link->GetAttribute ("Weight"), "20", "Wrong last weight with " << description);
+}
+
+void
+TopologyReaderInputFileTest::DoRun (void)
+{
+  // the end of line characters must not be part of the last token of a line
+  CheckTopology ("3 2\n0 10 10\n1 20 20\n2 30 30\n0 1 10\n1 2 20\n", "LF line endings");
+  CheckTopology ("3 2\r\n0 10 10\r\n1 20 20\r\n2 30 30\r\n0 1 10\r\n1 2 20\r\n", "CRLF line endings");
+
+  // the last line is read up to the end of the file
+  CheckTopology ("3 2\n0 10 10\n1 20 20\n2 30 30\n0 1 10\n1 2 20", "no newline at the end");
+  CheckTopology ("3 2\r\n0 10 10\r\n1 20 20\r\n2 30 30\r\n0 1 10\r\n1 2 20", "CRLF and no newline at the end");
+
+  // an empty file is opened, and has no line
+  NodeContainer nodes;
+  Ptr<InetTopologyReader> reader = Read ("", nodes);
+  NS_TEST_EXPECT_MSG_EQ (nodes.GetN (), 0, "An empty file has no node");
+  NS_TEST_EXPECT_MSG_EQ (reader->LinksSize (), 0, "An empty file has no link");
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup topology
+ *
+ * \brief TopologyReader TestSuite
+ */
+class TopologyReaderTestSuite : public TestSuite
+{
+public:
+  TopologyReaderTestSuite ();
+};
+
+TopologyReaderTestSuite::TopologyReaderTestSuite ()
+  : TestSuite ("topology-reader", UNIT)
+{
+  AddTestCase (new TopologyReaderInputFileTest (), TestCase::QUICK);
+}
+
+static TopologyReaderTestSuite topologyReaderTestSuite;
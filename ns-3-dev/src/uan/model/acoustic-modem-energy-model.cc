@@ -229,6 +229,7 @@ AcousticModemEnergyModel::ChangeState (int newState)
 
   // update current state & last update time stamp
   SetMicroModemState (newState);
+  m_source->NotifyLoadChanged ();
 
   // some debug message
   NS_LOG_DEBUG ("AcousticModemEnergyModel:Total energy consumption at node #" <<
@@ -26,6 +26,8 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 
 #include "uan-channel.h"
@@ -37,6 +39,9 @@
 #include "uan-noise-model-default.h"
 #include "uan-prop-model-ideal.h"
 
+#include <algorithm>
+#include <cmath>
+
 NS_LOG_COMPONENT_DEFINE ("UanChannel");
 namespace ns3 {
 
@@ -58,6 +63,18 @@ UanChannel::GetTypeId ()
                    PointerValue (CreateObject<UanNoiseModelDefault> ()),
                    MakePointerAccessor (&UanChannel::m_noise),
                    MakePointerChecker<UanNoiseModel> ())
+    .AddAttribute ("MaxRange",
+                   "The distance in meters beyond which transmissions are not delivered, "
+                   "or 0 to deliver them to all the devices.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&UanChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("CachePaths",
+                   "Cache the delay, path loss and PDP between the devices which are not moving. "
+                   "Only valid with deterministic propagation models.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&UanChannel::m_cachePaths),
+                   MakeBooleanChecker ())
   ;
 
   return tid;
@@ -66,7 +83,11 @@ UanChannel::GetTypeId ()
 UanChannel::UanChannel ()
   : Channel (),
     m_prop (0),
-    m_cleared (false)
+    m_cleared (false),
+    m_maxRange (0.0),
+    m_cachePaths (false),
+    m_indexed (false),
+    m_cellSize (0.0)
 {
 }
 
@@ -97,6 +118,18 @@ UanChannel::Clear ()
         }
     }
   m_devList.clear ();
+  for (uint32_t i = 0; i < m_mobility.size (); i++)
+    {
+      m_mobility[i]->TraceDisconnectWithoutContext ("CourseChange",
+                                                    MakeCallback (&UanChannel::CourseChanged, this));
+    }
+  m_mobility.clear ();
+  m_grid.clear ();
+  m_moving.clear ();
+  m_static.clear ();
+  m_staticMobility.clear ();
+  m_paths.clear ();
+  m_indexed = false;
   if (m_prop)
     {
       m_prop->Clear ();
@@ -140,6 +173,61 @@ UanChannel::AddDevice (Ptr<UanNetDevice> dev, Ptr<UanTransducer> trans)
 {
   NS_LOG_DEBUG ("Adding dev/trans pair number " << m_devList.size ());
   m_devList.push_back (std::make_pair (dev, trans));
+  m_indexed = false;
+}
+
+std::pair<int64_t, int64_t>
+UanChannel::GetCell (const Vector &pos) const
+{
+  return std::make_pair (static_cast<int64_t> (std::floor (pos.x / m_cellSize)),
+                         static_cast<int64_t> (std::floor (pos.y / m_cellSize)));
+}
+
+void
+UanChannel::IndexDevices (void)
+{
+  NS_LOG_DEBUG ("Indexing " << m_devList.size () << " devices");
+  m_grid.clear ();
+  m_moving.clear ();
+  m_static.assign (m_devList.size (), false);
+  m_staticMobility.clear ();
+  m_paths.clear ();
+  m_cellSize = m_maxRange;
+  for (uint32_t i = 0; i < m_devList.size (); i++)
+    {
+      if (i == m_mobility.size ())
+        {
+          Ptr<MobilityModel> mobility = m_devList[i].first->GetNode ()->GetObject<MobilityModel> ();
+          NS_ASSERT (mobility != 0);
+          mobility->TraceConnectWithoutContext ("CourseChange",
+                                                MakeCallback (&UanChannel::CourseChanged, this));
+          m_mobility.push_back (mobility);
+        }
+      Vector velocity = m_mobility[i]->GetVelocity ();
+      if (velocity.x != 0 || velocity.y != 0 || velocity.z != 0)
+        {
+          m_moving.push_back (i);
+          continue;
+        }
+      m_static[i] = true;
+      m_staticMobility.insert (PeekPointer (m_mobility[i]));
+      if (m_maxRange > 0)
+        {
+          m_grid[GetCell (m_mobility[i]->GetPosition ())].push_back (i);
+        }
+    }
+  m_indexed = true;
+}
+
+void
+UanChannel::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  // Moving devices are not indexed by position, nor are their paths cached
+  if (m_staticMobility.find (PeekPointer (mobility)) != m_staticMobility.end ())
+    {
+      NS_LOG_DEBUG ("Static device moved, invalidating the index");
+      m_indexed = false;
+    }
 }
 
 void
@@ -147,10 +235,11 @@ UanChannel::TxPacket (Ptr<UanTransducer> src, Ptr<Packet> packet,
                       double txPowerDb, UanTxMode txMode)
 {
   Ptr<MobilityModel> senderMobility = 0;
+  uint32_t srcIndex = 0;
 
   NS_LOG_DEBUG ("Channel scheduling");
   for (UanDeviceList::const_iterator i = m_devList.begin (); i
-       != m_devList.end (); i++)
+       != m_devList.end (); i++, srcIndex++)
     {
 
       if (src == i->second)
@@ -160,40 +249,106 @@ UanChannel::TxPacket (Ptr<UanTransducer> src, Ptr<Packet> packet,
         }
     }
   NS_ASSERT (senderMobility != 0);
-  uint32_t j = 0;
-  UanDeviceList::const_iterator i = m_devList.begin ();
-  for (; i != m_devList.end (); i++)
+
+  if (m_maxRange > 0 || m_cachePaths)
+    {
+      if (!m_indexed || m_cellSize != m_maxRange)
+        {
+          IndexDevices ();
+        }
+    }
+
+  if (m_maxRange <= 0)
+    {
+      for (uint32_t j = 0; j < m_devList.size (); j++)
+        {
+          if (src != m_devList[j].second)
+            {
+              Deliver (srcIndex, j, senderMobility, packet, txPowerDb, txMode);
+            }
+        }
+      return;
+    }
+
+  // The devices in range are static devices of the cells around the
+  // sender, or moving devices.
+  Vector senderPos = senderMobility->GetPosition ();
+  std::vector<uint32_t> candidates (m_moving);
+  std::pair<int64_t, int64_t> cell = GetCell (senderPos);
+  for (int64_t x = cell.first - 1; x <= cell.first + 1; x++)
+    {
+      for (int64_t y = cell.second - 1; y <= cell.second + 1; y++)
+        {
+          Grid::const_iterator it = m_grid.find (std::make_pair (x, y));
+          if (it != m_grid.end ())
+            {
+              candidates.insert (candidates.end (), it->second.begin (), it->second.end ());
+            }
+        }
+    }
+  // Schedule the receptions in the order of the devices, as without range
+  std::sort (candidates.begin (), candidates.end ());
+  for (std::vector<uint32_t>::const_iterator j = candidates.begin (); j != candidates.end (); j++)
     {
-      if (src != i->second)
+      if (src != m_devList[*j].second
+          && CalculateDistance (senderPos, m_mobility[*j]->GetPosition ()) <= m_maxRange)
         {
-          NS_LOG_DEBUG ("Scheduling " << i->first->GetMac ()->GetAddress ());
-          Ptr<MobilityModel> rcvrMobility = i->first->GetNode ()->GetObject<MobilityModel> ();
-          Time delay = m_prop->GetDelay (senderMobility, rcvrMobility, txMode);
-          UanPdp pdp = m_prop->GetPdp (senderMobility, rcvrMobility, txMode);
-          double rxPowerDb = txPowerDb - m_prop->GetPathLossDb (senderMobility,
-                                                                rcvrMobility,
-                                                                txMode);
-
-          NS_LOG_DEBUG ("txPowerDb=" << txPowerDb << "dB, rxPowerDb="
-                                     << rxPowerDb << "dB, distance="
-                                     << senderMobility->GetDistanceFrom (rcvrMobility)
-                                     << "m, delay=" << delay);
-
-          uint32_t dstNodeId = i->first->GetNode ()->GetId ();
-          Ptr<Packet> copy = packet->Copy ();
-          Simulator::ScheduleWithContext (dstNodeId, delay,
-                                          &UanChannel::SendUp,
-                                          this,
-                                          j,
-                                          copy,
-                                          rxPowerDb,
-                                          txMode,
-                                          pdp);
+          Deliver (srcIndex, *j, senderMobility, packet, txPowerDb, txMode);
         }
-      j++;
     }
 }
 
+void
+UanChannel::Deliver (uint32_t src, uint32_t dst, Ptr<MobilityModel> senderMobility,
+                     Ptr<Packet> packet, double txPowerDb, UanTxMode txMode)
+{
+  Ptr<UanNetDevice> dev = m_devList[dst].first;
+  NS_LOG_DEBUG ("Scheduling " << dev->GetMac ()->GetAddress ());
+  Ptr<MobilityModel> rcvrMobility = dev->GetNode ()->GetObject<MobilityModel> ();
+  Time delay;
+  UanPdp pdp;
+  double pathLossDb;
+  if (m_cachePaths && m_static[src] && m_static[dst])
+    {
+      PathCache::key_type key = std::make_pair (std::make_pair (src, dst), txMode.GetUid ());
+      PathCache::iterator it = m_paths.find (key);
+      if (it == m_paths.end ())
+        {
+          Path path;
+          path.delay = m_prop->GetDelay (senderMobility, rcvrMobility, txMode);
+          path.pdp = m_prop->GetPdp (senderMobility, rcvrMobility, txMode);
+          path.pathLossDb = m_prop->GetPathLossDb (senderMobility, rcvrMobility, txMode);
+          it = m_paths.insert (std::make_pair (key, path)).first;
+        }
+      delay = it->second.delay;
+      pdp = it->second.pdp;
+      pathLossDb = it->second.pathLossDb;
+    }
+  else
+    {
+      delay = m_prop->GetDelay (senderMobility, rcvrMobility, txMode);
+      pdp = m_prop->GetPdp (senderMobility, rcvrMobility, txMode);
+      pathLossDb = m_prop->GetPathLossDb (senderMobility, rcvrMobility, txMode);
+    }
+  double rxPowerDb = txPowerDb - pathLossDb;
+
+  NS_LOG_DEBUG ("txPowerDb=" << txPowerDb << "dB, rxPowerDb="
+                             << rxPowerDb << "dB, distance="
+                             << senderMobility->GetDistanceFrom (rcvrMobility)
+                             << "m, delay=" << delay);
+
+  uint32_t dstNodeId = dev->GetNode ()->GetId ();
+  Ptr<Packet> copy = packet->Copy ();
+  Simulator::ScheduleWithContext (dstNodeId, delay,
+                                  &UanChannel::SendUp,
+                                  this,
+                                  dst,
+                                  copy,
+                                  rxPowerDb,
+                                  txMode,
+                                  pdp);
+}
+
 void
 UanChannel::SetNoiseModel (Ptr<UanNoiseModel> noise)
 {
@@ -28,6 +28,8 @@
 #include "ns3/uan-noise-model.h"
 
 #include <list>
+#include <map>
+#include <set>
 #include <vector>
 
 namespace ns3 {
@@ -41,6 +43,21 @@ class UanTxMode;
  * \ingroup uan
  *
  * Channel class used by UAN devices.
+ *
+ * By default, every transmission is delivered to all the other devices
+ * of the channel, and the propagation model is queried for each of them.
+ * Two attributes reduce this cost in large sensor fields:
+ *
+ * - MaxRange drops the transmissions to the devices farther than a given
+ *   distance. The devices which were not moving when the channel last
+ *   indexed them are kept in a grid of cells as large as the range, so
+ *   that only the devices of the cells around the sender are considered.
+ *   Moving devices are always checked. The index is rebuilt when a device
+ *   is added or when a device which was not moving changes course.
+ *
+ * - CachePaths caches the delay, path loss and PDP between two devices
+ *   which are not moving, for each transmission mode. It must only be
+ *   used with propagation models which are deterministic.
  */
 class UanChannel : public Channel
 {
@@ -112,11 +129,62 @@ public:
   void Clear (void);
 
 private:
+  /** The propagation of a transmission between two devices. */
+  struct Path
+  {
+    Time delay;         //!< The propagation delay.
+    double pathLossDb;  //!< The path loss, in dB.
+    UanPdp pdp;         //!< The power delay profile.
+  };
+  /** Paths, indexed by (sender, receiver) device numbers and mode uid. */
+  typedef std::map<std::pair<std::pair<uint32_t, uint32_t>, uint32_t>, Path> PathCache;
+  /** Device numbers, indexed by grid cell coordinates. */
+  typedef std::map<std::pair<int64_t, int64_t>, std::vector<uint32_t> > Grid;
+
   UanDeviceList m_devList;     //!< The list of devices on this channel.
   Ptr<UanPropModel> m_prop;    //!< The propagation model.
   Ptr<UanNoiseModel> m_noise;  //!< The noise model.
   /** Has Clear ever been called on the channel. */
   bool m_cleared;              
+  double m_maxRange;           //!< Maximum delivery distance in m, or 0.
+  bool m_cachePaths;           //!< Cache the paths between static devices.
+  bool m_indexed;              //!< Is the device index up to date.
+  double m_cellSize;           //!< Size of the grid cells, in m.
+  Grid m_grid;                 //!< The static devices, by grid cell.
+  std::vector<uint32_t> m_moving;                //!< The moving devices.
+  std::vector<bool> m_static;                    //!< Is device i static.
+  std::vector<Ptr<MobilityModel> > m_mobility;   //!< Mobility of device i.
+  std::set<const MobilityModel *> m_staticMobility;  //!< Static mobility models.
+  PathCache m_paths;           //!< The cached paths.
+
+  /**
+   * Index the devices by position, and connect to the CourseChange
+   * trace of the devices added since the last index.
+   */
+  void IndexDevices (void);
+  /**
+   * \param mobility The mobility model whose course changed.
+   *
+   * Invalidate the index and the cached paths if a static device moved.
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+  /**
+   * \param pos A position.
+   * \return The coordinates of the grid cell containing pos.
+   */
+  std::pair<int64_t, int64_t> GetCell (const Vector &pos) const;
+  /**
+   * Schedule the reception of a packet by a device.
+   *
+   * \param src Number of the sending device.
+   * \param dst Number of the receiving device.
+   * \param senderMobility Mobility of the sender.
+   * \param packet The packet.
+   * \param txPowerDb Transmission power in dB.
+   * \param txMode Mode of the packet.
+   */
+  void Deliver (uint32_t src, uint32_t dst, Ptr<MobilityModel> senderMobility,
+                Ptr<Packet> packet, double txPowerDb, UanTxMode txMode);
 
   /**
    * Send a packet up to the receiving UanTransducer.
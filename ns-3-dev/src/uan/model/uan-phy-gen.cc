@@ -34,6 +34,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/energy-source-container.h"
 #include "ns3/acoustic-modem-energy-model.h"
+#include <algorithm>
 
 
 NS_LOG_COMPONENT_DEFINE ("UanPhyGen");
@@ -76,21 +77,44 @@ UanPhyCalcSinrDefault::CalcSinrDb (Ptr<Packet> pkt,
                                    UanPdp pdp,
                                    const UanTransducer::ArrivalList &arrivalList) const
 {
-  if (mode.GetModType () == UanTxMode::OTHER)
+  double arrivalPowerKp = 0;
+  UanTransducer::ArrivalList::const_iterator it = arrivalList.begin ();
+  for (; it != arrivalList.end (); it++)
     {
-      NS_LOG_WARN ("Calculating SINR for unsupported modulation type");
+      arrivalPowerKp += DbToKp (it->GetRxPowerDb ());
     }
+  return SinrDb (rxPowerDb, ambNoiseDb, mode, arrivalPowerKp, arrivalList.size ());
+}
 
-  double intKp = -DbToKp (rxPowerDb); // This packet is in the arrivalList
-  UanTransducer::ArrivalList::const_iterator it = arrivalList.begin ();
-  for (; it != arrivalList.end (); it++)
+double
+UanPhyCalcSinrDefault::CalcSinrDbAtTransducer (Ptr<Packet> pkt,
+                                               Time arrTime,
+                                               double rxPowerDb,
+                                               double ambNoiseDb,
+                                               UanTxMode mode,
+                                               UanPdp pdp,
+                                               Ptr<UanTransducer> transducer) const
+{
+  return SinrDb (rxPowerDb, ambNoiseDb, mode, transducer->GetArrivalPowerKp (),
+                 transducer->GetArrivalList ().size ());
+}
+
+double
+UanPhyCalcSinrDefault::SinrDb (double rxPowerDb, double ambNoiseDb, UanTxMode mode,
+                               double arrivalPowerKp, uint32_t nArrivals) const
+{
+  if (mode.GetModType () == UanTxMode::OTHER)
     {
-      intKp += DbToKp (it->GetRxPowerDb ());
+      NS_LOG_WARN ("Calculating SINR for unsupported modulation type");
     }
 
+  // This packet is in the arrivals.  The running total of the transducer
+  // may round slightly below the power of a lone packet.
+  double intKp = std::max (arrivalPowerKp - DbToKp (rxPowerDb), 0.0);
+
   double totalIntDb = KpToDb (intKp + DbToKp (ambNoiseDb));
 
-  NS_LOG_DEBUG ("Calculating SINR:  RxPower = " << rxPowerDb << " dB.  Number of interferers = " << arrivalList.size () << "  Interference + noise power = " << totalIntDb << " dB.  SINR = " << rxPowerDb - totalIntDb << " dB.");
+  NS_LOG_DEBUG ("Calculating SINR:  RxPower = " << rxPowerDb << " dB.  Number of interferers = " << nArrivals << "  Interference + noise power = " << totalIntDb << " dB.  SINR = " << rxPowerDb - totalIntDb << " dB.");
   return rxPowerDb - totalIntDb;
 }
 
@@ -896,13 +920,19 @@ double
 UanPhyGen::CalculateSinrDb (Ptr<Packet> pkt, Time arrTime, double rxPowerDb, UanTxMode mode, UanPdp pdp)
 {
   double noiseDb = m_channel->GetNoiseDbHz ( (double) mode.GetCenterFreqHz () / 1000.0) + 10 * std::log10 (mode.GetBandwidthHz ());
-  return m_sinr->CalcSinrDb (pkt, arrTime, rxPowerDb, noiseDb, mode, pdp, m_transducer->GetArrivalList ());
+  return m_sinr->CalcSinrDbAtTransducer (pkt, arrTime, rxPowerDb, noiseDb, mode, pdp, m_transducer);
 }
 
 double
 UanPhyGen::GetInterferenceDb (Ptr<Packet> pkt)
 {
 
+  if (!pkt)
+    {
+      // The transducer keeps the total power of the arrivals
+      return KpToDb (m_transducer->GetArrivalPowerKp ());
+    }
+
   const UanTransducer::ArrivalList &arrivalList = m_transducer->GetArrivalList ();
 
   UanTransducer::ArrivalList::const_iterator it = arrivalList.begin ();
@@ -162,6 +162,41 @@ public:
                              UanPdp pdp,
                              const UanTransducer::ArrivalList &arrivalList
                              ) const;
+  /**
+   * Calculate the SINR value for a packet arriving at a transducer.
+   *
+   * The interference is the total power of the arrivals kept by the
+   * transducer, less the power of the packet.
+   *
+   * \param pkt Packet to calculate SINR for.
+   * \param arrTime Arrival time of pkt.
+   * \param rxPowerDb The received signal strength of the packet in dB re 1 uPa.
+   * \param ambNoiseDb Ambient channel noise in dB re 1 uPa.
+   * \param mode TX Mode of pkt.
+   * \param pdp  Power delay profile of pkt.
+   * \param transducer The transducer receiving pkt, which is in its arrival list.
+   * \return The SINR in dB re 1 uPa.
+   */
+  virtual double CalcSinrDbAtTransducer (Ptr<Packet> pkt,
+                                         Time arrTime,
+                                         double rxPowerDb,
+                                         double ambNoiseDb,
+                                         UanTxMode mode,
+                                         UanPdp pdp,
+                                         Ptr<UanTransducer> transducer
+                                         ) const;
+
+private:
+  /**
+   * \param rxPowerDb The received signal strength of the packet in dB re 1 uPa.
+   * \param ambNoiseDb Ambient channel noise in dB re 1 uPa.
+   * \param mode TX Mode of the packet.
+   * \param arrivalPowerKp The total power of the arrivals, the packet included.
+   * \param nArrivals The number of arrivals, for logging.
+   * \return The SINR in dB re 1 uPa.
+   */
+  double SinrDb (double rxPowerDb, double ambNoiseDb, UanTxMode mode,
+                 double arrivalPowerKp, uint32_t nArrivals) const;
 
 };  // class UanPhyCalcSinrDefault
 
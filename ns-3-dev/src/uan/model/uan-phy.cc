@@ -31,6 +31,18 @@ TypeId UanPhyCalcSinr::GetTypeId (void)
   return tid;
 }
 
+double
+UanPhyCalcSinr::CalcSinrDbAtTransducer (Ptr<Packet> pkt,
+                                        Time arrTime,
+                                        double rxPowerDb,
+                                        double ambNoiseDb,
+                                        UanTxMode mode,
+                                        UanPdp pdp,
+                                        Ptr<UanTransducer> transducer) const
+{
+  return CalcSinrDb (pkt, arrTime, rxPowerDb, ambNoiseDb, mode, pdp, transducer->GetArrivalList ());
+}
+
 void
 UanPhyCalcSinr::Clear ()
 {
@@ -64,6 +64,31 @@ public:
                              UanPdp pdp,
                              const UanTransducer::ArrivalList &arrivalList
                              ) const = 0;
+  /**
+   * Calculate the SINR value for a packet arriving at a transducer.
+   *
+   * The default implementation calls CalcSinrDb with the arrival list
+   * of the transducer.  Models which only need the total power of the
+   * arrivals override it to read UanTransducer::GetArrivalPowerKp instead
+   * of scanning the list.
+   *
+   * \param pkt Packet to calculate SINR for.
+   * \param arrTime Arrival time of pkt.
+   * \param rxPowerDb The received signal strength of the packet in dB re 1 uPa.
+   * \param ambNoiseDb Ambient channel noise in dB re 1 uPa.
+   * \param mode TX Mode of pkt.
+   * \param pdp  Power delay profile of pkt.
+   * \param transducer The transducer receiving pkt, which is in its arrival list.
+   * \return The SINR in dB re 1 uPa.
+   */
+  virtual double CalcSinrDbAtTransducer (Ptr<Packet> pkt,
+                                         Time arrTime,
+                                         double rxPowerDb,
+                                         double ambNoiseDb,
+                                         UanTxMode mode,
+                                         UanPdp pdp,
+                                         Ptr<UanTransducer> transducer
+                                         ) const;
   /**
    * Register this type.
    * \return The object TypeId.
@@ -26,6 +26,8 @@
 #include "ns3/log.h"
 #include "ns3/pointer.h"
 
+#include <cmath>
+
 
 NS_LOG_COMPONENT_DEFINE ("UanTransducerHd");
 
@@ -36,6 +38,7 @@ NS_OBJECT_ENSURE_REGISTERED (UanTransducerHd);
 UanTransducerHd::UanTransducerHd ()
   : UanTransducer (),
     m_state (RX),
+    m_arrivalPowerKp (0),
     m_endTxTime (Seconds (0)),
     m_cleared (false)
 {
@@ -75,6 +78,7 @@ UanTransducerHd::Clear ()
     }
   m_phyList.clear ();
   m_arrivalList.clear ();
+  m_arrivalPowerKp = 0;
   m_endTxEvent.Cancel ();
 }
 
@@ -120,6 +124,12 @@ UanTransducerHd::GetArrivalList (void) const
   return m_arrivalList;
 }
 
+double
+UanTransducerHd::GetArrivalPowerKp (void) const
+{
+  return m_arrivalPowerKp;
+}
+
 void
 UanTransducerHd::Receive (Ptr<Packet> packet,
                           double rxPowerDb,
@@ -133,8 +143,9 @@ UanTransducerHd::Receive (Ptr<Packet> packet,
                             Simulator::Now ());
 
   m_arrivalList.push_back (arrival);
+  m_arrivalPowerKp += std::pow (10, rxPowerDb / 10.0);
   Time txDelay = Seconds (packet->GetSize () * 8.0 / txMode.GetDataRateBps ());
-  Simulator::Schedule (txDelay, &UanTransducerHd::RemoveArrival, this, arrival);
+  Simulator::Schedule (txDelay, &UanTransducerHd::RemoveArrival, this, packet);
   NS_LOG_DEBUG (Simulator::Now ().GetSeconds () << " Transducer in receive");
   if (m_state == RX)
     {
@@ -221,16 +232,32 @@ UanTransducerHd::GetPhyList (void) const
 }
 
 void
-UanTransducerHd::RemoveArrival (UanPacketArrival arrival)
+UanTransducerHd::RemoveArrival (Ptr<Packet> packet)
 {
 
   // Remove entry from arrival list
   ArrivalList::iterator it = m_arrivalList.begin ();
   for (; it != m_arrivalList.end (); it++)
     {
-      if (it->GetPacket () == arrival.GetPacket ())
+      if (it->GetPacket () == packet)
         {
+          double powerKp = std::pow (10, it->GetRxPowerDb () / 10.0);
           m_arrivalList.erase (it);
+          if (2 * powerKp < m_arrivalPowerKp)
+            {
+              m_arrivalPowerKp -= powerKp;
+            }
+          else
+            {
+              // Sum the remaining arrivals again rather than cancel most
+              // of the total, which would lose the precision of the others
+              m_arrivalPowerKp = 0;
+              ArrivalList::const_iterator ait = m_arrivalList.begin ();
+              for (; ait != m_arrivalList.end (); ait++)
+                {
+                  m_arrivalPowerKp += std::pow (10, ait->GetRxPowerDb () / 10.0);
+                }
+            }
           break;
         }
     }
@@ -52,6 +52,7 @@ public:
   virtual bool IsRx (void) const;
   virtual bool IsTx (void) const;
   virtual const ArrivalList &GetArrivalList (void) const;
+  virtual double GetArrivalPowerKp (void) const;
   virtual void Receive (Ptr<Packet> packet, double rxPowerDb, UanTxMode txMode, UanPdp pdp);
   virtual void Transmit (Ptr<UanPhy> src, Ptr<Packet> packet, double txPowerDb, UanTxMode txMode);
   virtual void SetChannel (Ptr<UanChannel> chan);
@@ -63,6 +64,7 @@ public:
 private:
   State m_state;              //!< Transducer state.
   ArrivalList m_arrivalList;  //!< List of arriving packets which overlap in time.
+  double m_arrivalPowerKp;    //!< Total power of the arriving packets.
   UanPhyList m_phyList;       //!< List of physical layers attached above this tranducer.
   Ptr<UanChannel> m_channel;  //!< The attached channel.
   EventId m_endTxEvent;       //!< Event scheduled for end of transmission.
@@ -72,9 +74,9 @@ private:
   /**
    * Remove an entry from the arrival list.
    *
-   * \param arrival The packet arrival to remove.
+   * \param packet The packet of the arrival to remove.
    */
-  void RemoveArrival (UanPacketArrival arrival);
+  void RemoveArrival (Ptr<Packet> packet);
   /** Handle end of transmission event. */
   void EndTx (void);
 protected:
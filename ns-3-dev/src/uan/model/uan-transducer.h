@@ -181,6 +181,12 @@ public:
    * \return List of all packets currently crossing this node in the water.
    */
   virtual const ArrivalList &GetArrivalList (void) const = 0;
+  /**
+   * Get the total power of the packets in the arrival list.
+   *
+   * \return Sum of the received powers, in linear units (not dB).
+   */
+  virtual double GetArrivalPowerKp (void) const = 0;
   /**
    * Notify this object that a new packet has arrived at this nodes location
    *
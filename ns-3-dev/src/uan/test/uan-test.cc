@@ -30,6 +30,8 @@
 #include "ns3/node.h"
 #include "ns3/object-factory.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/callback.h"
 
 using namespace ns3;
@@ -47,6 +49,7 @@ private:
   bool RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender);
   void SendOnePacket (Ptr<UanNetDevice> dev, uint32_t mode);
   ObjectFactory m_phyFac;
+  ObjectFactory m_channelFac;
   uint32_t m_bytesRx;
 
 };
@@ -107,7 +110,7 @@ UanTest::DoOnePhyTest (Time txTime1,
                        uint32_t mode2)
 {
 
-  Ptr<UanChannel> channel = CreateObject<UanChannel> ();
+  Ptr<UanChannel> channel = m_channelFac.Create<UanChannel> ();
   channel->SetAttribute ("PropagationModel", PointerValue (prop));
 
   Ptr<UanNetDevice> dev0 = CreateNode (Vector (r1,50,50), channel);
@@ -214,6 +217,32 @@ UanTest::DoPhyTests ()
   NS_TEST_ASSERT_MSG_EQ_RETURNS_BOOL (DoOnePhyTest (Seconds (1.0), Seconds (2.99), 50, 50, prop, 2, 3),
                                       34, "Expected no collision");
 
+  // Range culling and path cache
+  m_phyFac = ObjectFactory ();
+  m_phyFac.SetTypeId ("ns3::UanPhyGen");
+  m_phyFac.Set ("PerModel", PointerValue (perDef));
+  m_phyFac.Set ("SinrModel", PointerValue (sinrDef));
+  m_phyFac.Set ("SupportedModes", UanModesListValue (mList));
+
+  m_channelFac.Set ("CachePaths", BooleanValue (true));
+  NS_TEST_ASSERT_MSG_EQ_RETURNS_BOOL (DoOnePhyTest (Seconds (1.0), Seconds (3.001), 50, 50, prop),
+                                      34, "Expected no collision with cached paths");
+  NS_TEST_ASSERT_MSG_EQ_RETURNS_BOOL (DoOnePhyTest (Seconds (1.0), Seconds (2.99), 50, 50, prop),
+                                      0, "Expected collision with cached paths");
+
+  // Only the nearest sender is in range
+  m_channelFac.Set ("MaxRange", DoubleValue (60));
+  NS_TEST_ASSERT_MSG_EQ_RETURNS_BOOL (DoOnePhyTest (Seconds (1.0), Seconds (2.99), 50, 500, prop),
+                                      17, "Expected the packet out of range to be dropped");
+  // Both senders are 50 m away, in the grid cells next to the receiver
+  m_channelFac.Set ("MaxRange", DoubleValue (40));
+  NS_TEST_ASSERT_MSG_EQ_RETURNS_BOOL (DoOnePhyTest (Seconds (1.0), Seconds (2.99), 50, 50, prop),
+                                      0, "Expected both packets out of range");
+  m_channelFac.Set ("MaxRange", DoubleValue (60));
+  m_channelFac.Set ("CachePaths", BooleanValue (false));
+  NS_TEST_ASSERT_MSG_EQ_RETURNS_BOOL (DoOnePhyTest (Seconds (1.0), Seconds (2.99), 50, 50, prop),
+                                      0, "Expected collision of the packets in range");
+
   return false;
 }
 
@@ -221,6 +250,8 @@ void
 UanTest::DoRun (void)
 {
 
+  m_channelFac.SetTypeId ("ns3::UanChannel");
+
   Ptr<UanPhyPerUmodem> per = CreateObject<UanPhyPerUmodem> ();
   Ptr<Packet> pkt = Create<Packet> (1000);
   double error = per->CalcPer (pkt, 9, UanPhyGen::GetDefaultModes ()[0]);
@@ -216,6 +216,18 @@ VisualSimulatorImpl::GetContext (void) const
   return m_simulator->GetContext ();
 }
 
+uint64_t
+VisualSimulatorImpl::GetEventCount (void) const
+{
+  return m_simulator->GetEventCount ();
+}
+
+uint32_t
+VisualSimulatorImpl::GetPendingEventCount (void) const
+{
+  return m_simulator->GetPendingEventCount ();
+}
+
 void
 VisualSimulatorImpl::RunRealSimulator (void)
 {
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// Benchmark of the BS downlink schedulers with a large number of
+// subscriber stations (SS).
+//
+// A single base station serves --ss subscriber stations. Each SS has one
+// downlink service flow, whose scheduling type cycles through UGS, rtPS,
+// nrtPS and BE, fed by a UDP client on the base station. The script
+// reports the number of packets received by the SSs, which should not
+// depend much on the scheduler, the wall-clock time the simulation takes
+// per simulated second, and the number of events processed as counted by
+// Simulator::GetEventCount, cancelled events included.
+//
+// Usage: ./waf --run "wimax-large-scale --ss=200 --scheduler=heap"
+//
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/wimax-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/ipcs-classifier-record.h"
+#include "ns3/service-flow.h"
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE ("WimaxLargeScale");
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  uint32_t nSs = 200;
+  double duration = 10;
+  double start = 6;
+  double interval = 0.1;
+  std::string schedulerName = "heap";
+
+  CommandLine cmd;
+  cmd.AddValue ("ss", "number of subscriber stations", nSs);
+  cmd.AddValue ("duration", "duration of the simulation in seconds", duration);
+  cmd.AddValue ("start", "time at which the traffic starts, in seconds", start);
+  cmd.AddValue ("interval", "interval between two packets of a flow, in seconds", interval);
+  cmd.AddValue ("scheduler", "scheduler of the BS: simple, rtps or heap", schedulerName);
+  cmd.Parse (argc, argv);
+
+  WimaxHelper::SchedulerType scheduler;
+  if (schedulerName == "simple")
+    {
+      scheduler = WimaxHelper::SCHED_TYPE_SIMPLE;
+    }
+  else if (schedulerName == "rtps")
+    {
+      scheduler = WimaxHelper::SCHED_TYPE_RTPS;
+    }
+  else if (schedulerName == "heap")
+    {
+      scheduler = WimaxHelper::SCHED_TYPE_HEAP;
+    }
+  else
+    {
+      NS_FATAL_ERROR ("Unknown scheduler " << schedulerName);
+    }
+
+  NodeContainer ssNodes;
+  NodeContainer bsNodes;
+  ssNodes.Create (nSs);
+  bsNodes.Create (1);
+
+  WimaxHelper wimax;
+  NetDeviceContainer ssDevs = wimax.Install (ssNodes,
+                                             WimaxHelper::DEVICE_TYPE_SUBSCRIBER_STATION,
+                                             WimaxHelper::SIMPLE_PHY_TYPE_OFDM,
+                                             scheduler);
+  NetDeviceContainer bsDevs = wimax.Install (bsNodes,
+                                             WimaxHelper::DEVICE_TYPE_BASE_STATION,
+                                             WimaxHelper::SIMPLE_PHY_TYPE_OFDM,
+                                             scheduler);
+
+  InternetStackHelper stack;
+  stack.Install (bsNodes);
+  stack.Install (ssNodes);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.0.0.0");
+  Ipv4InterfaceContainer ssInterfaces = address.Assign (ssDevs);
+  address.Assign (bsDevs);
+
+  ServiceFlow::SchedulingType types[] = { ServiceFlow::SF_TYPE_UGS, ServiceFlow::SF_TYPE_RTPS,
+                                          ServiceFlow::SF_TYPE_NRTPS, ServiceFlow::SF_TYPE_BE };
+  uint16_t port = 100;
+  ApplicationContainer serverApps;
+  ApplicationContainer clientApps;
+  for (uint32_t i = 0; i < nSs; i++)
+    {
+      Ptr<SubscriberStationNetDevice> ss = ssDevs.Get (i)->GetObject<SubscriberStationNetDevice> ();
+      ss->SetModulationType (WimaxPhy::MODULATION_TYPE_QAM16_12);
+
+      UdpServerHelper udpServer (port);
+      serverApps.Add (udpServer.Install (ssNodes.Get (i)));
+
+      UdpClientHelper udpClient (ssInterfaces.GetAddress (i), port);
+      udpClient.SetAttribute ("MaxPackets", UintegerValue ((uint32_t)((duration - start) / interval) + 1));
+      udpClient.SetAttribute ("Interval", TimeValue (Seconds (interval)));
+      udpClient.SetAttribute ("PacketSize", UintegerValue (256));
+      clientApps.Add (udpClient.Install (bsNodes.Get (0)));
+
+      IpcsClassifierRecord classifier (Ipv4Address ("0.0.0.0"),
+                                       Ipv4Mask ("0.0.0.0"),
+                                       ssInterfaces.GetAddress (i),
+                                       Ipv4Mask ("255.255.255.255"),
+                                       0,
+                                       65000,
+                                       port,
+                                       port,
+                                       17,
+                                       1);
+      ServiceFlow serviceFlow = wimax.CreateServiceFlow (ServiceFlow::SF_DIRECTION_DOWN,
+                                                         types[i % 4],
+                                                         classifier);
+      ss->AddServiceFlow (serviceFlow);
+    }
+  serverApps.Start (Seconds (start));
+  serverApps.Stop (Seconds (duration));
+  clientApps.Start (Seconds (start));
+  clientApps.Stop (Seconds (duration));
+
+  Simulator::Stop (Seconds (duration + 0.1));
+
+  std::cout << "Starting simulation of " << nSs << " SSs with the " << schedulerName << " scheduler for "
+            << duration << " s ..." << std::endl;
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  double wallTime = clock.End () / 1000.0;
+  uint64_t events = Simulator::GetEventCount ();
+
+  uint32_t received = 0;
+  for (uint32_t i = 0; i < serverApps.GetN (); i++)
+    {
+      received += DynamicCast<UdpServer> (serverApps.Get (i))->GetReceived ();
+    }
+  Simulator::Destroy ();
+
+  std::cout << "Packets received: " << received << std::endl
+            << "Wall-clock time: " << wallTime << " s, "
+            << wallTime / duration << " s per simulated second" << std::endl
+            << "Events processed (cancelled included): " << events << std::endl;
+  return 0;
+}
@@ -174,6 +174,9 @@ Ptr<UplinkScheduler> WimaxHelper::CreateUplinkScheduler (SchedulerType scheduler
     case SCHED_TYPE_MBQOS:
       uplinkScheduler = CreateObject<UplinkSchedulerMBQoS> (Seconds (0.25));
       break;
+    case SCHED_TYPE_HEAP:
+      uplinkScheduler = CreateObject<UplinkSchedulerSimple> ();
+      break;
     default:
       NS_FATAL_ERROR ("Invalid scheduling type");
       break;
@@ -195,6 +198,9 @@ Ptr<BSScheduler> WimaxHelper::CreateBSScheduler (SchedulerType schedulerType)
     case SCHED_TYPE_MBQOS:
       bsScheduler = CreateObject<BSSchedulerSimple> ();
       break;
+    case SCHED_TYPE_HEAP:
+      bsScheduler = CreateObject<BSSchedulerHeap> ();
+      break;
     default:
       NS_FATAL_ERROR ("Invalid scheduling type");
       break;
@@ -409,12 +415,20 @@ void WimaxHelper::AsciiRxEvent (Ptr<OutputStreamWrapper> stream,
                                 Ptr<const Packet> packet,
                                 const Mac48Address &source)
 {
+  if (!stream->Accept (packet))
+    {
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " from: " << source << " ";
   *stream->GetStream () << path << std::endl;
 }
 
 void WimaxHelper::AsciiTxEvent (Ptr<OutputStreamWrapper> stream, std::string path, Ptr<const Packet> packet, const Mac48Address &dest)
 {
+  if (!stream->Accept (packet))
+    {
+      return;
+    }
   *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " to: " << dest << " ";
   *stream->GetStream () << path << std::endl;
 }
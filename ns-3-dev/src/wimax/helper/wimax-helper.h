@@ -39,6 +39,7 @@
 #include "ns3/bs-scheduler.h"
 #include "ns3/bs-scheduler-simple.h"
 #include "ns3/bs-scheduler-rtps.h"
+#include "ns3/bs-scheduler-heap.h"
 #include "ns3/trace-helper.h"
 
 namespace ns3 {
@@ -87,8 +88,9 @@ public:
   {
     SCHED_TYPE_SIMPLE, /**< A simple priority-based FCFS scheduler */
     SCHED_TYPE_RTPS, /**< A simple scheduler - rtPS based scheduler */
-    SCHED_TYPE_MBQOS
+    SCHED_TYPE_MBQOS,
     /**< An migration-based uplink scheduler */
+    SCHED_TYPE_HEAP /**< The simple scheduler, with per-class priority queues in the BS */
 
   };
   /**
@@ -655,7 +655,15 @@ BaseStationNetDevice::Enqueue (Ptr<Packet> packet, const MacHeaderType &hdrType,
 
   hdr.SetCid (connection->GetCid ());
 
-  return connection->Enqueue (packet, hdrType, hdr);
+  if (!connection->Enqueue (packet, hdrType, hdr))
+    {
+      return false;
+    }
+  if (m_scheduler != 0)
+    {
+      m_scheduler->NotifyEnqueue (connection);
+    }
+  return true;
 }
 
 void
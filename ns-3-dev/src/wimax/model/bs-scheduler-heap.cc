@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "bs-scheduler-heap.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "bs-net-device.h"
+#include "wimax-connection.h"
+#include "service-flow.h"
+#include "service-flow-record.h"
+
+NS_LOG_COMPONENT_DEFINE ("BSSchedulerHeap");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (BSSchedulerHeap);
+
+TypeId BSSchedulerHeap::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::BSSchedulerHeap")
+    .SetParent<BSSchedulerSimple> ()
+    .AddConstructor<BSSchedulerHeap> ()
+  ;
+  return tid;
+}
+
+BSSchedulerHeap::BSSchedulerHeap ()
+  : BSSchedulerSimple ()
+{
+}
+
+BSSchedulerHeap::BSSchedulerHeap (Ptr<BaseStationNetDevice> bs)
+  : BSSchedulerSimple (bs)
+{
+}
+
+BSSchedulerHeap::~BSSchedulerHeap (void)
+{
+}
+
+void
+BSSchedulerHeap::DoDispose (void)
+{
+  m_basic.clear ();
+  m_primary.clear ();
+  m_ugs.deadlines.clear ();
+  m_ugs.flows.clear ();
+  m_rtps.deadlines.clear ();
+  m_rtps.flows.clear ();
+  m_nrtps.clear ();
+  m_be.clear ();
+  BSSchedulerSimple::DoDispose ();
+}
+
+void
+BSSchedulerHeap::NotifyEnqueue (Ptr<WimaxConnection> connection)
+{
+  uint16_t cid = connection->GetCid ().GetIdentifier ();
+  switch (connection->GetType ())
+    {
+    case Cid::BASIC:
+      m_basic.insert (std::make_pair (cid, connection));
+      break;
+    case Cid::PRIMARY:
+      m_primary.insert (std::make_pair (cid, connection));
+      break;
+    case Cid::TRANSPORT:
+    case Cid::MULTICAST:
+      {
+        ServiceFlow *serviceFlow = connection->GetServiceFlow ();
+        if (serviceFlow == 0)
+          {
+            break;
+          }
+        switch (serviceFlow->GetSchedulingType ())
+          {
+          case ServiceFlow::SF_TYPE_UGS:
+            Insert (m_ugs, serviceFlow);
+            break;
+          case ServiceFlow::SF_TYPE_RTPS:
+            Insert (m_rtps, serviceFlow);
+            break;
+          case ServiceFlow::SF_TYPE_NRTPS:
+            m_nrtps.insert (std::make_pair (cid, connection));
+            break;
+          case ServiceFlow::SF_TYPE_BE:
+            m_be.insert (std::make_pair (cid, connection));
+            break;
+          default:
+            break;
+          }
+        break;
+      }
+    default:
+      // the broadcast and initial ranging connections are checked directly
+      break;
+    }
+}
+
+Time
+BSSchedulerHeap::GetDeadline (ServiceFlow *serviceFlow)
+{
+  return serviceFlow->GetRecord ()->GetDlTimeStamp () + MilliSeconds (serviceFlow->GetMaximumLatency ())
+         - GetBs ()->GetPhy ()->GetFrameDuration ();
+}
+
+void
+BSSchedulerHeap::Insert (DeadlineQueue &queue, ServiceFlow *serviceFlow)
+{
+  uint16_t cid = serviceFlow->GetConnection ()->GetCid ().GetIdentifier ();
+  if (queue.flows.find (cid) != queue.flows.end ())
+    {
+      return;
+    }
+  Time deadline = GetDeadline (serviceFlow);
+  queue.flows.insert (std::make_pair (cid, std::make_pair (deadline, serviceFlow)));
+  queue.deadlines.insert (std::make_pair (deadline, cid));
+}
+
+Ptr<WimaxConnection>
+BSSchedulerHeap::SelectFrom (ConnectionQueue &queue)
+{
+  while (!queue.empty ())
+    {
+      ConnectionQueue::iterator i = queue.begin ();
+      if (i->second->HasPackets ())
+        {
+          return i->second;
+        }
+      queue.erase (i);
+    }
+  return 0;
+}
+
+ServiceFlow *
+BSSchedulerHeap::SelectFrom (DeadlineQueue &queue)
+{
+  Time currentTime = Simulator::Now ();
+  while (!queue.deadlines.empty ())
+    {
+      std::set<std::pair<Time, uint16_t> >::iterator i = queue.deadlines.begin ();
+      if (i->first >= currentTime)
+        {
+          // no other flow is late either
+          return 0;
+        }
+      uint16_t cid = i->second;
+      queue.deadlines.erase (i);
+      std::map<uint16_t, std::pair<Time, ServiceFlow *> >::iterator flow = queue.flows.find (cid);
+      ServiceFlow *serviceFlow = flow->second.second;
+      if (!serviceFlow->HasPackets ())
+        {
+          queue.flows.erase (flow);
+          continue;
+        }
+      serviceFlow->GetRecord ()->SetDlTimeStamp (currentTime);
+      flow->second.first = GetDeadline (serviceFlow);
+      queue.deadlines.insert (std::make_pair (flow->second.first, cid));
+      return serviceFlow;
+    }
+  return 0;
+}
+
+bool
+BSSchedulerHeap::SelectConnection (Ptr<WimaxConnection> &connection)
+{
+  connection = 0;
+  NS_LOG_INFO ("BS Scheduler: Selecting connection...");
+  if (GetBs ()->GetBroadcastConnection ()->HasPackets ())
+    {
+      NS_LOG_INFO ("Return GetBroadcastConnection");
+      connection = GetBs ()->GetBroadcastConnection ();
+      return true;
+    }
+  if (GetBs ()->GetInitialRangingConnection ()->HasPackets ())
+    {
+      NS_LOG_INFO ("Return GetInitialRangingConnection");
+      connection = GetBs ()->GetInitialRangingConnection ();
+      return true;
+    }
+
+  connection = SelectFrom (m_basic);
+  if (connection != 0)
+    {
+      NS_LOG_INFO ("Return Basic");
+      return true;
+    }
+  connection = SelectFrom (m_primary);
+  if (connection != 0)
+    {
+      NS_LOG_INFO ("Return Primary");
+      return true;
+    }
+
+  ServiceFlow *serviceFlow = SelectFrom (m_ugs);
+  if (serviceFlow != 0)
+    {
+      NS_LOG_INFO ("Return UGS SF: CID = " << serviceFlow->GetCid () << "SFID = " << serviceFlow->GetSfid ());
+      connection = serviceFlow->GetConnection ();
+      return true;
+    }
+  serviceFlow = SelectFrom (m_rtps);
+  if (serviceFlow != 0)
+    {
+      NS_LOG_INFO ("Return RTPS SF: CID = " << serviceFlow->GetCid () << "SFID = " << serviceFlow->GetSfid ());
+      connection = serviceFlow->GetConnection ();
+      return true;
+    }
+
+  connection = SelectFrom (m_nrtps);
+  if (connection != 0)
+    {
+      NS_LOG_INFO ("Return NRTPS SF: CID = " << connection->GetCid ());
+      return true;
+    }
+  connection = SelectFrom (m_be);
+  if (connection != 0)
+    {
+      NS_LOG_INFO ("Return BE SF: CID = " << connection->GetCid ());
+      return true;
+    }
+
+  NS_LOG_INFO ("NO connection is selected!");
+  return false;
+}
+
+} // namespace ns3
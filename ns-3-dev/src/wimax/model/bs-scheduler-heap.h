@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BS_SCHEDULER_HEAP_H
+#define BS_SCHEDULER_HEAP_H
+
+#include <map>
+#include <set>
+#include "ns3/nstime.h"
+#include "bs-scheduler-simple.h"
+
+namespace ns3 {
+
+class WimaxConnection;
+class ServiceFlow;
+
+/**
+ * \ingroup wimax
+ * \brief BS downlink scheduler keeping the backlogged connections in priority queues
+ *
+ * This scheduler serves the connections in the same priority order as
+ * BSSchedulerSimple: broadcast, initial ranging, basic, primary, UGS,
+ * rtPS, nrtPS and BE connections, a UGS or rtPS service flow being
+ * served only once its maximum latency would be exceeded in the next
+ * frame. Instead of walking all the connections and service flows of
+ * the BS each time a connection is selected, it keeps one priority
+ * queue of backlogged connections per class, which is filled as the
+ * packets are enqueued:
+ *  - the basic, primary, nrtPS and BE connections are served in the
+ *    order of their CIDs;
+ *  - the UGS and rtPS service flows are served earliest deadline first,
+ *    the deadline being the time at which the maximum latency of the
+ *    flow would be exceeded in the next frame.
+ *
+ * A connection stays in its queue until it is found empty, so the cost of
+ * selecting a connection does not depend on the number of subscriber
+ * stations.
+ */
+class BSSchedulerHeap : public BSSchedulerSimple
+{
+public:
+  BSSchedulerHeap ();
+  BSSchedulerHeap (Ptr<BaseStationNetDevice> bs);
+  ~BSSchedulerHeap (void);
+
+  static TypeId GetTypeId (void);
+
+  /*
+   * \brief Selects the first backlogged connection of the highest priority class
+   * \param connection will point to a connection that have packets to be sent
+   * \returns false if no connection has packets to be sent, true otherwise
+   */
+  bool SelectConnection (Ptr<WimaxConnection> &connection);
+  /*
+   * \brief Adds the connection to the queue of its class, if not there yet
+   * \param connection the connection on which a packet has been enqueued
+   */
+  void NotifyEnqueue (Ptr<WimaxConnection> connection);
+
+private:
+  virtual void DoDispose (void);
+
+  /// Backlogged connections of a class, by CID
+  typedef std::map<uint16_t, Ptr<WimaxConnection> > ConnectionQueue;
+
+  /// Backlogged UGS or rtPS service flows
+  struct DeadlineQueue
+  {
+    /// The flows by deadline, then CID
+    std::set<std::pair<Time, uint16_t> > deadlines;
+    /// The deadline and service flow of each queued CID
+    std::map<uint16_t, std::pair<Time, ServiceFlow *> > flows;
+  };
+
+  /**
+   * \param queue the queue to select from
+   * \returns the first connection of the queue with packets, or 0
+   *
+   * The empty connections found at the head of the queue are removed.
+   */
+  Ptr<WimaxConnection> SelectFrom (ConnectionQueue &queue);
+  /**
+   * \param queue the queue to select from
+   * \returns the service flow with the earliest deadline, if it has packets
+   *          and its deadline has passed, or 0
+   *
+   * The selected service flow is timestamped and moved to its new deadline.
+   */
+  ServiceFlow * SelectFrom (DeadlineQueue &queue);
+  /**
+   * \param queue the queue to add the service flow to
+   * \param serviceFlow the UGS or rtPS service flow
+   */
+  void Insert (DeadlineQueue &queue, ServiceFlow *serviceFlow);
+  /**
+   * \param serviceFlow a UGS or rtPS service flow
+   * \returns the time after which the maximum latency of the flow would be
+   *          exceeded if it were not served in the current frame
+   */
+  Time GetDeadline (ServiceFlow *serviceFlow);
+
+  ConnectionQueue m_basic;
+  ConnectionQueue m_primary;
+  DeadlineQueue m_ugs;
+  DeadlineQueue m_rtps;
+  ConnectionQueue m_nrtps;
+  ConnectionQueue m_be;
+};
+
+} // namespace ns3
+
+#endif /* BS_SCHEDULER_HEAP_H */
@@ -86,6 +86,11 @@ Ptr<BaseStationNetDevice> BSScheduler::GetBs (void)
   return m_bs;
 }
 
+void
+BSScheduler::NotifyEnqueue (Ptr<WimaxConnection> connection)
+{
+}
+
 bool
 BSScheduler::CheckForFragmentation (Ptr<WimaxConnection> connection,
                                     int availableSymbols,
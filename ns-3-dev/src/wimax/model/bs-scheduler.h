@@ -94,6 +94,16 @@ public:
   virtual Ptr<BaseStationNetDevice> GetBs (void);
   virtual void SetBs (Ptr<BaseStationNetDevice> bs);
 
+  /*
+   * \brief Notifies the scheduler that a packet has been enqueued on a connection
+   * \param connection the connection on which the packet has been enqueued
+   *
+   * This is called by the BS each time a packet is enqueued for the downlink.
+   * Schedulers which keep track of the backlogged connections can override it;
+   * the default implementation does nothing.
+   */
+  virtual void NotifyEnqueue (Ptr<WimaxConnection> connection);
+
   /*
    * \brief Check if the packet fragmentation is possible for transport connection.
    * \param connection the downlink connection
@@ -57,44 +57,65 @@ SSManager::CreateSSRecord (const Mac48Address &macAddress)
 {
   SSRecord *ssRecord = new SSRecord (macAddress);
   m_ssRecords->push_back (ssRecord);
+  // the first record created for an address is the one found by
+  // GetSSRecord (const Mac48Address &)
+  m_macIndex.insert (std::make_pair (macAddress, ssRecord));
   return ssRecord;
 }
 
 SSRecord*
 SSManager::GetSSRecord (const Mac48Address &macAddress) const
 {
-  for (std::vector<SSRecord*>::iterator iter = m_ssRecords->begin (); iter != m_ssRecords->end (); ++iter)
+  sgi::hash_map<Mac48Address, SSRecord*, Mac48AddressHash>::const_iterator i = m_macIndex.find (macAddress);
+  if (i != m_macIndex.end ())
     {
-      if ((*iter)->GetMacAddress () == macAddress)
-        {
-          return *iter;
-        }
+      return i->second;
     }
 
   NS_LOG_DEBUG ("GetSSRecord: SSRecord not found!");
   return 0;
 }
 
+bool
+SSManager::HasCid (SSRecord *ssRecord, Cid cid)
+{
+  if (ssRecord->GetBasicCid () == cid || ssRecord->GetPrimaryCid () == cid)
+    {
+      return true;
+    }
+  std::vector<ServiceFlow*> sf = ssRecord->GetServiceFlows (ServiceFlow::SF_TYPE_ALL);
+  for (std::vector<ServiceFlow*>::iterator iter = sf.begin (); iter != sf.end (); ++iter)
+    {
+      if ((*iter)->GetConnection ()->GetCid () == cid)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
 SSRecord*
 SSManager::GetSSRecord (Cid cid) const
 {
-  for (std::vector<SSRecord*>::iterator iter1 = m_ssRecords->begin (); iter1 != m_ssRecords->end (); ++iter1)
+  // The cids of a record are assigned after its creation, so the cache is
+  // filled on lookup, and an entry is checked against its record before
+  // being used.
+  sgi::hash_map<uint16_t, SSRecord*>::iterator cached = m_cidCache.find (cid.GetIdentifier ());
+  if (cached != m_cidCache.end ())
     {
-      SSRecord *ssRecord = *iter1;
-      if (ssRecord->GetBasicCid () == cid || ssRecord->GetPrimaryCid () == cid)
+      if (HasCid (cached->second, cid))
         {
-          return ssRecord;
+          return cached->second;
         }
-      else
+      m_cidCache.erase (cached);
+    }
+
+  for (std::vector<SSRecord*>::iterator iter = m_ssRecords->begin (); iter != m_ssRecords->end (); ++iter)
+    {
+      if (HasCid (*iter, cid))
         {
-          std::vector<ServiceFlow*> sf = ssRecord->GetServiceFlows (ServiceFlow::SF_TYPE_ALL);
-          for (std::vector<ServiceFlow*>::iterator iter2 = sf.begin (); iter2 != sf.end (); ++iter2)
-            {
-              if ((*iter2)->GetConnection ()->GetCid () == cid)
-                {
-                  return ssRecord;
-                }
-            }
+          m_cidCache[cid.GetIdentifier ()] = *iter;
+          return *iter;
         }
     }
 
@@ -111,14 +132,7 @@ SSManager::GetSSRecords (void) const
 bool
 SSManager::IsInRecord (const Mac48Address &macAddress) const
 {
-  for (std::vector<SSRecord*>::iterator iter = m_ssRecords->begin (); iter != m_ssRecords->end (); ++iter)
-    {
-      if ((*iter)->GetMacAddress () == macAddress)
-        {
-          return true;
-        }
-    }
-  return false;
+  return m_macIndex.find (macAddress) != m_macIndex.end ();
 }
 
 bool
@@ -134,22 +148,42 @@ SSManager::DeleteSSRecord (Cid cid)
   for (std::vector<SSRecord*>::iterator iter1 = m_ssRecords->begin (); iter1 != m_ssRecords->end (); ++iter1)
     {
       SSRecord *ssRecord = *iter1;
-      if (ssRecord->GetBasicCid () == cid || ssRecord->GetPrimaryCid () == cid)
+      if (HasCid (ssRecord, cid))
         {
           m_ssRecords->erase (iter1);
+          Unindex (ssRecord);
           return;
         }
+    }
+}
+
+void
+SSManager::Unindex (SSRecord *ssRecord)
+{
+  for (sgi::hash_map<uint16_t, SSRecord*>::iterator i = m_cidCache.begin (); i != m_cidCache.end (); )
+    {
+      if (i->second == ssRecord)
+        {
+          m_cidCache.erase (i++);
+        }
       else
         {
-          std::vector<ServiceFlow*> sf = ssRecord->GetServiceFlows (ServiceFlow::SF_TYPE_ALL);
-          for (std::vector<ServiceFlow*>::const_iterator iter2 = sf.begin (); iter2 != sf.end (); ++iter2)
-            {
-              if ((*iter2)->GetConnection ()->GetCid () == cid)
-                {
-                  m_ssRecords->erase (iter1);
-                  return;
-                }
-            }
+          ++i;
+        }
+    }
+  sgi::hash_map<Mac48Address, SSRecord*, Mac48AddressHash>::iterator mac = m_macIndex.find (ssRecord->GetMacAddress ());
+  if (mac == m_macIndex.end () || mac->second != ssRecord)
+    {
+      return;
+    }
+  m_macIndex.erase (mac);
+  // another record of the same address, if any, is now found first
+  for (std::vector<SSRecord*>::iterator iter = m_ssRecords->begin (); iter != m_ssRecords->end (); ++iter)
+    {
+      if ((*iter)->GetMacAddress () == ssRecord->GetMacAddress ())
+        {
+          m_macIndex.insert (std::make_pair ((*iter)->GetMacAddress (), *iter));
+          return;
         }
     }
 }
@@ -24,6 +24,8 @@
 #define SS_MANAGER_H
 
 #include <stdint.h>
+#include "ns3/mac48-address.h"
+#include "ns3/sgi-hashmap.h"
 #include "cid.h"
 #include "ss-record.h"
 
@@ -33,6 +35,9 @@ namespace ns3 {
  * \ingroup wimax
  * \brief this class manages a list of SSrecord
  * \see SSrecord
+ *
+ * The records are indexed by MAC address, and the records found by CID
+ * are cached, so that looking a record up does not walk the list.
  */
 class SSManager : public Object
 {
@@ -59,7 +64,24 @@ public:
   uint32_t GetNSSs (void) const;
   uint32_t GetNRegisteredSSs (void) const;
 private:
+  /**
+   * \param ssRecord the record to check
+   * \param cid the cid to be matched
+   * \return true if the basic, primary or a transport cid of the record is cid
+   */
+  static bool HasCid (SSRecord *ssRecord, Cid cid);
+  /**
+   * \param ssRecord a record removed from the list
+   *
+   * Remove the record from the MAC address index and the cid cache.
+   */
+  void Unindex (SSRecord *ssRecord);
+
   std::vector<SSRecord*> *m_ssRecords;
+  /// The records by MAC address
+  sgi::hash_map<Mac48Address, SSRecord*, Mac48AddressHash> m_macIndex;
+  /// The records found by GetSSRecord (Cid), by cid identifier
+  mutable sgi::hash_map<uint16_t, SSRecord*> m_cidCache;
 };
 
 } // namespace ns3
@@ -36,6 +36,13 @@
 #include "ns3/mobility-helper.h"
 #include <iostream>
 #include "ns3/global-route-manager.h"
+#include "ns3/bs-net-device.h"
+#include "ns3/bs-scheduler-heap.h"
+#include "ns3/simple-ofdm-wimax-phy.h"
+#include "ns3/wimax-connection.h"
+#include "ns3/service-flow.h"
+#include "ns3/service-flow-record.h"
+#include "ns3/pointer.h"
 
 using namespace ns3;
 
@@ -49,10 +56,11 @@ private:
   virtual void DoRun (void);
   bool DoRunOnce (WimaxHelper::SchedulerType scheduler);
 
+  uint32_t m_received; //!< packets received in the last run
 };
 
 Ns3WimaxSchedulingTestCase::Ns3WimaxSchedulingTestCase ()
-  : TestCase ("Test the 2 different schedulers")
+  : TestCase ("Test the 3 different schedulers")
 {
 }
 
@@ -138,6 +146,7 @@ Ns3WimaxSchedulingTestCase::DoRunOnce (WimaxHelper::SchedulerType scheduler)
   ssDevs.Get (1)->GetObject<SubscriberStationNetDevice> ()->AddServiceFlow (UlServiceFlowUgs);
 
   Simulator::Run ();
+  m_received = DynamicCast<UdpServer> (serverApps.Get (0))->GetReceived ();
   Simulator::Destroy ();
   return false;
 
@@ -150,13 +159,103 @@ Ns3WimaxSchedulingTestCase::DoRun ()
     {
       return;
     }
+  uint32_t simpleReceived = m_received;
   if (DoRunOnce (WimaxHelper::SCHED_TYPE_RTPS) == true)
     {
       return;
     }
+  // The heap scheduler serves the classes in the same order as the simple
+  // scheduler, but the UGS and rtPS flows earliest deadline first. With
+  // the single rtPS flow of this scenario, only the number of packets
+  // delivered is compared (see Ns3WimaxHeapSchedulerTestCase for the order).
+  if (DoRunOnce (WimaxHelper::SCHED_TYPE_HEAP) == true)
+    {
+      return;
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_received, simpleReceived, "The heap and simple schedulers delivered different numbers of packets");
 }
 
 
+// =============================================================================
+/*
+ * Test that the heap scheduler serves the UGS flow with the earliest
+ * deadline first, whatever the order of the CIDs and of the enqueues.
+ */
+class Ns3WimaxHeapSchedulerTestCase : public TestCase
+{
+public:
+  Ns3WimaxHeapSchedulerTestCase ();
+  virtual ~Ns3WimaxHeapSchedulerTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Select (void);
+
+  Ptr<BSSchedulerHeap> m_scheduler;
+  Ptr<WimaxConnection> m_late;  //!< UGS connection with the latest deadline
+  Ptr<WimaxConnection> m_early; //!< UGS connection with the earliest deadline
+};
+
+Ns3WimaxHeapSchedulerTestCase::Ns3WimaxHeapSchedulerTestCase ()
+  : TestCase ("Test the earliest deadline first order of the heap scheduler")
+{
+}
+
+Ns3WimaxHeapSchedulerTestCase::~Ns3WimaxHeapSchedulerTestCase ()
+{
+}
+
+void
+Ns3WimaxHeapSchedulerTestCase::Select (void)
+{
+  // both deadlines have passed: the flow with the smaller maximum latency
+  // is served first, then the other one, then none until a deadline
+  Ptr<WimaxConnection> connection;
+  NS_TEST_ASSERT_MSG_EQ (m_scheduler->SelectConnection (connection), true, "A connection must be selected");
+  NS_TEST_EXPECT_MSG_EQ (connection, m_early, "The flow with the earliest deadline must be served first");
+  NS_TEST_ASSERT_MSG_EQ (m_scheduler->SelectConnection (connection), true, "A second connection must be selected");
+  NS_TEST_EXPECT_MSG_EQ (connection, m_late, "The flow with the latest deadline must be served second");
+  NS_TEST_EXPECT_MSG_EQ (m_scheduler->SelectConnection (connection), false, "No deadline has passed since the flows were served");
+}
+
+void
+Ns3WimaxHeapSchedulerTestCase::DoRun (void)
+{
+  Ptr<BaseStationNetDevice> bs = CreateObject<BaseStationNetDevice> ();
+  bs->SetPhy (CreateObject<SimpleOfdmWimaxPhy> ());
+  bs->SetAttribute ("BroadcastConnection",
+                    PointerValue (CreateObject<WimaxConnection> (Cid::Broadcast (), Cid::BROADCAST)));
+  bs->SetAttribute ("InitialRangingConnection",
+                    PointerValue (CreateObject<WimaxConnection> (Cid::InitialRanging (), Cid::INITIAL_RANGING)));
+  m_scheduler = CreateObject<BSSchedulerHeap> (bs);
+
+  // the flow with the lowest CID, enqueued first, has the latest deadline
+  m_late = CreateObject<WimaxConnection> (Cid (100), Cid::TRANSPORT);
+  m_early = CreateObject<WimaxConnection> (Cid (101), Cid::TRANSPORT);
+  ServiceFlow late (1, ServiceFlow::SF_DIRECTION_DOWN, m_late);
+  ServiceFlow early (2, ServiceFlow::SF_DIRECTION_DOWN, m_early);
+  late.SetServiceSchedulingType (ServiceFlow::SF_TYPE_UGS);
+  early.SetServiceSchedulingType (ServiceFlow::SF_TYPE_UGS);
+  late.SetMaximumLatency (100);
+  early.SetMaximumLatency (20);
+
+  GenericMacHeader hdr;
+  m_late->Enqueue (Create<Packet> (100), MacHeaderType (), hdr);
+  m_early->Enqueue (Create<Packet> (100), MacHeaderType (), hdr);
+  m_scheduler->NotifyEnqueue (m_late);
+  m_scheduler->NotifyEnqueue (m_early);
+
+  Simulator::Schedule (Seconds (1), &Ns3WimaxHeapSchedulerTestCase::Select, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  m_scheduler->Dispose ();
+  bs->Dispose ();
+  m_scheduler = 0;
+  m_late = 0;
+  m_early = 0;
+}
+
 // =============================================================================
 class Ns3WimaxSFTypeTestCase : public TestCase
 {
@@ -289,6 +388,7 @@ Ns3WimaxQoSTestSuite::Ns3WimaxQoSTestSuite ()
 {
   AddTestCase (new Ns3WimaxSFTypeTestCase, TestCase::QUICK);
   AddTestCase (new Ns3WimaxSchedulingTestCase, TestCase::QUICK);
+  AddTestCase (new Ns3WimaxHeapSchedulerTestCase, TestCase::QUICK);
 }
 
 static Ns3WimaxQoSTestSuite ns3WimaxQoSTestSuite;
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+#define LOG(x)   std::cout << x << std::endl
+
+// Output field width
+int g_fwidth = 14;
+
+/**
+ * A trace source and sink with the signature of the packet traces of
+ * the devices, which take a Ptr to a packet.
+ */
+class Sink : public Object
+{
+public:
+  Sink () : m_count (0) {}
+  void Receive (Ptr<const Object> p)
+  {
+    m_count++;
+  }
+  uint32_t m_count;
+};
+
+static uint32_t g_count = 0;
+
+static void
+Receive (Ptr<const Object> p)
+{
+  g_count++;
+}
+
+static void
+ReceiveBound (uint32_t n, Ptr<const Object> p)
+{
+  g_count += n;
+}
+
+/**
+ * Time n invocations of a callable with the same argument, and print
+ * the rate.
+ */
+template <typename CALLABLE>
+static void
+Run (std::string name, const CALLABLE &callable, Ptr<const Object> p, uint32_t n)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      callable (p);
+    }
+  double elapsed = clock.End () / 1000.0;
+  LOG (std::left << std::setw (28) << name <<
+       std::right << std::setw (g_fwidth) << elapsed <<
+       std::setw (g_fwidth) << (elapsed > 0 ? n / elapsed : 0) <<
+       std::setw (g_fwidth) << (n > 0 ? elapsed / n * 1e9 : 0));
+}
+
+/**
+ * Time n invocations of a trace source with the given number of sinks.
+ */
+static void
+RunTrace (uint32_t sinks, Ptr<Sink> sink, Ptr<const Object> p, uint32_t n)
+{
+  TracedCallback<Ptr<const Object> > trace;
+  for (uint32_t i = 0; i < sinks; i++)
+    {
+      trace.ConnectWithoutContext (MakeCallback (&Sink::Receive, sink));
+    }
+  std::ostringstream oss;
+  oss << "TracedCallback, " << sinks << " sinks";
+  Run (oss.str (), trace, p, n);
+}
+
+/**
+ * Time n constructions and copies of a callback.
+ */
+static void
+RunMake (Ptr<Sink> sink, uint32_t n)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Callback<void, Ptr<const Object> > cb = MakeCallback (&Sink::Receive, sink);
+      Callback<void, Ptr<const Object> > copy = cb;
+    }
+  double elapsed = clock.End () / 1000.0;
+  LOG (std::left << std::setw (28) << "MakeCallback + copy" <<
+       std::right << std::setw (g_fwidth) << elapsed <<
+       std::setw (g_fwidth) << (elapsed > 0 ? n / elapsed : 0) <<
+       std::setw (g_fwidth) << (n > 0 ? elapsed / n * 1e9 : 0));
+}
+
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 10000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the invocation of Callback and TracedCallback\n"
+             "instances with the signature of a packet trace.");
+  cmd.AddValue ("n", "number of invocations of each kind (default 1E7)", n);
+  cmd.Parse (argc, argv);
+
+  Ptr<Sink> sink = CreateObject<Sink> ();
+  Ptr<const Object> p = CreateObject<Object> ();
+
+  LOG ("invocations: " << n);
+  LOG ("");
+  LOG (std::left << std::setw (28) << "Operation" <<
+       std::right << std::setw (g_fwidth) << "Time (s)" <<
+       std::setw (g_fwidth) << "Rate (op/s)" <<
+       std::setw (g_fwidth) << "Per (ns/op)");
+
+  Run ("function pointer", &Receive, p, n);
+  Run ("Callback, function", MakeCallback (&Receive), p, n);
+  Run ("Callback, member", MakeCallback (&Sink::Receive, sink), p, n);
+  Run ("Callback, bound", MakeBoundCallback (&ReceiveBound, 1U), p, n);
+  RunTrace (0, sink, p, n);
+  RunTrace (1, sink, p, n);
+  RunTrace (4, sink, p, n);
+  RunMake (sink, n);
+
+  LOG ("");
+  LOG ("sink calls: " << g_count + sink->m_count);
+  return 0;
+}
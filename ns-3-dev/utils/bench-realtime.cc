@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include <utility>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+#define LOG(x)   std::cout << x << std::endl
+
+// Output field width
+int g_fwidth = 12;
+
+/**
+ * Flood the realtime simulator with events scheduled from several
+ * threads, as done by emulated network devices receiving packets, and
+ * measure the rate at which the simulation thread executes them.
+ */
+class Bench
+{
+public:
+  Bench (uint32_t threads, uint32_t events)
+    : m_nThreads (threads),
+      m_events (events),
+      m_count (0)
+  { };
+
+  void RunBench (void);
+private:
+  void Start (void);
+  static void Flood (std::pair<Bench *, uint32_t> context);
+  void Cb (void);
+
+  uint32_t m_nThreads;
+  uint32_t m_events;
+  uint32_t m_count;
+  std::vector<Ptr<SystemThread> > m_threads;
+  SystemWallClockMs m_time;
+};
+
+void
+Bench::RunBench (void)
+{
+  m_count = 0;
+  Simulator::Schedule (Seconds (0), &Bench::Start, this);
+  Simulator::Run ();
+  double simu = m_time.End ();
+  simu /= 1000;
+
+  for (uint32_t i = 0; i < m_threads.size (); i++)
+    {
+      m_threads[i]->Join ();
+    }
+  m_threads.clear ();
+
+  LOG (std::setw (g_fwidth) << simu <<
+       std::setw (g_fwidth) << (simu > 0 ? m_count / simu : 0) <<
+       std::setw (g_fwidth) << (m_count > 0 ? simu / m_count : 0));
+  Simulator::Destroy ();
+}
+
+void
+Bench::Start (void)
+{
+  m_time.Start ();
+  if (m_nThreads * m_events == 0)
+    {
+      // Cb never runs to stop the simulation
+      Simulator::Stop ();
+      return;
+    }
+  for (uint32_t i = 0; i < m_nThreads; i++)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeBoundCallback (&Bench::Flood, std::make_pair (this, i)));
+      m_threads.push_back (thread);
+      thread->Start ();
+    }
+}
+
+void
+Bench::Flood (std::pair<Bench *, uint32_t> context)
+{
+  Bench *me = context.first;
+  for (uint32_t i = 0; i < me->m_events; i++)
+    {
+      Simulator::ScheduleWithContext (context.second, Seconds (0), &Bench::Cb, me);
+    }
+}
+
+void
+Bench::Cb (void)
+{
+  ++m_count;
+  if (m_count == m_nThreads * m_events)
+    {
+      Simulator::Stop ();
+    }
+}
+
+
+int main (int argc, char *argv[])
+{
+  uint32_t threads = 4;
+  uint32_t events = 100000;
+  uint32_t runs = 1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the injection of events in the realtime simulator\n"
+             "by threads other than the simulation thread.");
+  cmd.AddValue ("threads", "number of injecting threads (default 4)", threads);
+  cmd.AddValue ("events",  "number of events injected by each thread (default 1E5)", events);
+  cmd.AddValue ("runs",    "number of runs (default 1)", runs);
+  cmd.Parse (argc, argv);
+
+  GlobalValue::Bind ("SimulatorImplementationType",
+                     StringValue ("ns3::RealtimeSimulatorImpl"));
+
+  LOG ("threads: " << threads);
+  LOG ("events per thread: " << events);
+  LOG ("");
+  LOG (std::left << std::setw (g_fwidth) << "Run #" <<
+       std::left << std::setw (g_fwidth) << "Time (s)" <<
+       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+       std::left << std::setw (g_fwidth) << "Per (s/ev)");
+
+  Bench bench (threads, events);
+  for (uint32_t i = 0; i < runs; i++)
+    {
+      std::cout << std::left << std::setw (g_fwidth) << i;
+      bench.RunBench ();
+    }
+  return 0;
+}
@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+#define LOG(x)   std::cout << x << std::endl
+
+// Output field width
+int g_fwidth = 14;
+
+/**
+ * Print the time of an operation, and its rate.
+ */
+static void
+Report (std::string name, double elapsed, uint32_t n)
+{
+  LOG (std::left << std::setw (28) << name <<
+       std::right << std::setw (g_fwidth) << n <<
+       std::setw (g_fwidth) << elapsed <<
+       std::setw (g_fwidth) << (n > 0 ? elapsed / n * 1e9 : 0));
+}
+
+/**
+ * Register a chain of types with many attributes and trace sources,
+ * as the modules do when the program starts.
+ */
+static void
+Register (uint32_t types, uint32_t attributes)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  TypeId parent = Object::GetTypeId ();
+  for (uint32_t i = 0; i < types; i++)
+    {
+      std::ostringstream name;
+      name << "ns3::BenchStartup" << i;
+      TypeId tid = TypeId (name.str ().c_str ())
+        .SetParent (parent);
+      for (uint32_t j = 0; j < attributes; j++)
+        {
+          std::ostringstream attribute;
+          attribute << "Attribute" << i << "_" << j;
+          tid.AddAttribute (attribute.str (), "A benchmark attribute",
+                            UintegerValue (j),
+                            Ptr<const AttributeAccessor> (),
+                            MakeUintegerChecker<uint32_t> ());
+          std::ostringstream source;
+          source << "Source" << i << "_" << j;
+          tid.AddTraceSource (source.str (), "A benchmark trace source",
+                              Ptr<const TraceSourceAccessor> ());
+        }
+      parent = tid;
+    }
+  Report ("register", clock.End () / 1000.0, types * attributes * 2);
+}
+
+/**
+ * Look up every attribute and trace source of the registered types from
+ * the first one, by name.
+ */
+static void
+Lookup (std::string name, uint32_t first, uint32_t repetitions)
+{
+  uint32_t n = 0;
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t r = 0; r < repetitions; r++)
+    {
+      for (uint32_t i = first; i < TypeId::GetRegisteredN (); i++)
+        {
+          TypeId tid = TypeId::GetRegistered (i);
+          for (uint32_t j = 0; j < tid.GetAttributeN (); j++)
+            {
+              struct TypeId::AttributeInformation info;
+              tid.LookupAttributeByName (tid.GetAttribute (j).name, &info);
+              n++;
+            }
+          for (uint32_t j = 0; j < tid.GetTraceSourceN (); j++)
+            {
+              tid.LookupTraceSourceByName (tid.GetTraceSource (j).name);
+              n++;
+            }
+        }
+    }
+  Report (name, clock.End () / 1000.0, n);
+}
+
+/**
+ * Types commonly created by the programs, if their module is enabled.
+ */
+static const char *g_stockTypes[] = {
+  "ns3::Node",
+  "ns3::UniformRandomVariable",
+  "ns3::ConstantRandomVariable",
+  "ns3::ExponentialRandomVariable",
+  "ns3::DropTailQueue",
+  "ns3::PointToPointNetDevice",
+  "ns3::PointToPointChannel",
+  "ns3::CsmaNetDevice",
+  "ns3::CsmaChannel",
+  "ns3::ArpL3Protocol",
+  "ns3::Ipv4L3Protocol",
+  "ns3::Icmpv4L4Protocol",
+  "ns3::UdpL4Protocol",
+  "ns3::TcpL4Protocol",
+  "ns3::Ipv6L3Protocol",
+  "ns3::ConstantPositionMobilityModel",
+  "ns3::YansWifiPhy",
+  "ns3::YansWifiChannel",
+  "ns3::AdhocWifiMac",
+  "ns3::OnOffApplication",
+  "ns3::PacketSink",
+};
+
+/**
+ * Configure the types registered by the modules, as a program does the
+ * first time it uses them: set the default value of their attributes,
+ * then create an object of some common types.
+ */
+static void
+Stock (uint32_t types)
+{
+  uint32_t n = 0;
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < types; i++)
+    {
+      TypeId tid = TypeId::GetRegistered (i);
+      for (uint32_t j = 0; j < tid.GetAttributeN (); j++)
+        {
+          struct TypeId::AttributeInformation info = tid.GetAttribute (j);
+          Config::SetDefaultFailSafe (tid.GetName () + "::" + info.name, *info.initialValue);
+          n++;
+        }
+    }
+  Report ("stock set default (first)", clock.End () / 1000.0, n);
+
+  std::vector<Ptr<Object> > objects;
+  clock.Start ();
+  for (uint32_t i = 0; i < sizeof (g_stockTypes) / sizeof (g_stockTypes[0]); i++)
+    {
+      TypeId tid;
+      if (TypeId::LookupByNameFailSafe (g_stockTypes[i], &tid))
+        {
+          ObjectFactory factory;
+          factory.SetTypeId (tid);
+          objects.push_back (factory.Create ());
+        }
+    }
+  Report ("stock create (first)", clock.End () / 1000.0, objects.size ());
+
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      objects[i]->Dispose ();
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t types = 20;
+  uint32_t attributes = 200;
+  uint32_t repetitions = 100;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the registration of the TypeIds and the lookups\n"
+             "of their attributes and trace sources by name.  The first\n"
+             "lookup of a type builds its index of names, the next ones\n"
+             "use it.\n\n"
+             "The types of the modules are registered by static constructors,\n"
+             "before main: their registration is not timed, only their first\n"
+             "lookups, default values and objects.  The registration is timed\n"
+             "on a chain of benchmark types.");
+  cmd.AddValue ("types", "number of types registered in a chain (default 20)", types);
+  cmd.AddValue ("attributes", "number of attributes and trace sources of each type (default 200)", attributes);
+  cmd.AddValue ("repetitions", "number of repetitions of the warm lookups (default 100)", repetitions);
+  cmd.Parse (argc, argv);
+
+  LOG (std::left << std::setw (28) << "Operation" <<
+       std::right << std::setw (g_fwidth) << "Count" <<
+       std::setw (g_fwidth) << "Time (s)" <<
+       std::setw (g_fwidth) << "Per (ns/op)");
+
+  uint32_t stock = TypeId::GetRegisteredN ();
+  Lookup ("stock lookup (first)", 0, 1);
+  Stock (stock);
+  Lookup ("stock lookup", 0, repetitions);
+
+  Register (types, attributes);
+  Lookup ("lookup (first)", stock, 1);
+  Lookup ("lookup", stock, repetitions);
+  Simulator::Destroy ();
+
+  LOG ("");
+  LOG ("stock types: " << stock);
+  LOG ("types: " << TypeId::GetRegisteredN ());
+  return 0;
+}
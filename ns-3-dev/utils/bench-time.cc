@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+#define LOG(x)   std::cout << x << std::endl
+
+// Output field width
+int g_fwidth = 14;
+
+// Inputs of the operations, cycled through so that the compiler can not
+// fold the operations
+std::vector<double> g_doubles;
+std::vector<Time> g_times;
+std::vector<int64x64_t> g_hps;
+
+/**
+ * \param i the iteration number
+ * \returns the result of an operation, accumulated by the caller so that
+ *          the operation is not optimized out
+ */
+typedef double (*Operation)(uint32_t i);
+
+static double
+Int64x64Add (uint32_t i)
+{
+  return (g_hps[i & 1023] + g_hps[(i + 1) & 1023]).GetHigh ();
+}
+
+static double
+Int64x64Mul (uint32_t i)
+{
+  return (g_hps[i & 1023] * g_hps[(i + 1) & 1023]).GetHigh ();
+}
+
+static double
+Int64x64Div (uint32_t i)
+{
+  return (g_hps[i & 1023] / g_hps[(i + 1) & 1023]).GetHigh ();
+}
+
+static double
+Int64x64FromDouble (uint32_t i)
+{
+  return int64x64_t (g_doubles[i & 1023]).GetHigh ();
+}
+
+static double
+Int64x64GetDouble (uint32_t i)
+{
+  return g_hps[i & 1023].GetDouble ();
+}
+
+static double
+TimeAdd (uint32_t i)
+{
+  return (g_times[i & 1023] + g_times[(i + 1) & 1023]).GetTimeStep ();
+}
+
+static double
+TimeCompare (uint32_t i)
+{
+  return g_times[i & 1023] < g_times[(i + 1) & 1023];
+}
+
+static double
+TimeGetSeconds (uint32_t i)
+{
+  return g_times[i & 1023].GetSeconds ();
+}
+
+static double
+TimeGetPicoSeconds (uint32_t i)
+{
+  return g_times[i & 1023].ToDouble (Time::PS);
+}
+
+static double
+TimeGetMicroSeconds (uint32_t i)
+{
+  return g_times[i & 1023].GetMicroSeconds ();
+}
+
+static double
+TimeToGetDouble (uint32_t i)
+{
+  return g_times[i & 1023].To (Time::PS).GetDouble ();
+}
+
+static double
+TimeSeconds (uint32_t i)
+{
+  return Seconds (g_doubles[i & 1023]).GetTimeStep ();
+}
+
+static double
+TimeFromInt64x64 (uint32_t i)
+{
+  return Time::From (int64x64_t (g_doubles[i & 1023]), Time::S).GetTimeStep ();
+}
+
+static double
+TimeMicroSeconds (uint32_t i)
+{
+  return MicroSeconds (i).GetTimeStep ();
+}
+
+/**
+ * Time an operation, and print its rate.
+ */
+static void
+Run (std::string name, Operation operation, uint32_t n)
+{
+  double sink = 0;
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      sink += operation (i);
+    }
+  double elapsed = clock.End () / 1000.0;
+  LOG (std::left << std::setw (24) << name <<
+       std::right << std::setw (g_fwidth) << elapsed <<
+       std::setw (g_fwidth) << (elapsed > 0 ? n / elapsed : 0) <<
+       std::setw (g_fwidth) << (n > 0 ? elapsed / n * 1e9 : 0) <<
+       "   (" << sink << ")");
+}
+
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 10000000;
+  std::string resolution = "NS";
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the int64x64_t arithmetic and the Time operations\n"
+             "and conversions.  The last column is a checksum which keeps\n"
+             "the operations from being optimized out.");
+  cmd.AddValue ("n", "number of operations of each kind (default 1E7)", n);
+  cmd.AddValue ("resolution", "time resolution: S, MS, US, NS, PS or FS (default NS)", resolution);
+  cmd.Parse (argc, argv);
+
+  if (resolution == "S")
+    {
+      Time::SetResolution (Time::S);
+    }
+  else if (resolution == "MS")
+    {
+      Time::SetResolution (Time::MS);
+    }
+  else if (resolution == "US")
+    {
+      Time::SetResolution (Time::US);
+    }
+  else if (resolution == "PS")
+    {
+      Time::SetResolution (Time::PS);
+    }
+  else if (resolution == "FS")
+    {
+      Time::SetResolution (Time::FS);
+    }
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < 1024; i++)
+    {
+      double value = rng->GetValue (0.001, 100);
+      g_doubles.push_back (value);
+      g_times.push_back (Seconds (rng->GetValue (0, 1000)));
+      g_hps.push_back (int64x64_t (rng->GetValue (1, 1000)));
+    }
+
+  LOG ("operations: " << n << ", resolution: " << resolution);
+  LOG ("");
+  LOG (std::left << std::setw (24) << "Operation" <<
+       std::right << std::setw (g_fwidth) << "Time (s)" <<
+       std::setw (g_fwidth) << "Rate (op/s)" <<
+       std::setw (g_fwidth) << "Per (ns/op)");
+
+  Run ("int64x64_t +", &Int64x64Add, n);
+  Run ("int64x64_t *", &Int64x64Mul, n);
+  Run ("int64x64_t /", &Int64x64Div, n);
+  Run ("int64x64_t (double)", &Int64x64FromDouble, n);
+  Run ("int64x64_t::GetDouble", &Int64x64GetDouble, n);
+  Run ("Time +", &TimeAdd, n);
+  Run ("Time <", &TimeCompare, n);
+  Run ("Time::GetSeconds", &TimeGetSeconds, n);
+  Run ("Time::ToDouble (PS)", &TimeGetPicoSeconds, n);
+  Run ("Time::To (PS)", &TimeToGetDouble, n);
+  Run ("Time::GetMicroSeconds", &TimeGetMicroSeconds, n);
+  Run ("Seconds (double)", &TimeSeconds, n);
+  Run ("Time::From (int64x64_t)", &TimeFromInt64x64, n);
+  Run ("MicroSeconds (uint64_t)", &TimeMicroSeconds, n);
+
+  return 0;
+}